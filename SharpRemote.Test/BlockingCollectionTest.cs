@@ -38,6 +38,29 @@ namespace SharpRemote.Test
 			}
 		}
 
+		[Test]
+		[Description("Verifies that items of a higher priority are dequeued first, but that lower priorities aren't starved")]
+		public void TestEnqueuePriority()
+		{
+			using (var queue = new BlockingQueue<int>(100))
+			{
+				for (int i = 0; i < 10; ++i)
+					queue.Enqueue(i, Priority.Bulk);
+				for (int i = 10; i < 20; ++i)
+					queue.Enqueue(i);
+				queue.Enqueue(42, Priority.High);
+				queue.Count.Should().Be(21);
+
+				queue.Dequeue().Should().Be(42, "because high priority items should be dequeued first");
+
+				var values = Enumerable.Range(0, 20).Select(unused => queue.Dequeue()).ToList();
+				values.Where(x => x >= 10).Should().Equal(Enumerable.Range(10, 10), "because items of the same priority must be dequeued in order");
+				values.Where(x => x < 10).Should().Equal(Enumerable.Range(0, 10), "because items of the same priority must be dequeued in order");
+				values.IndexOf(0).Should().BeLessThan(10, "because bulk items shouldn't be starved until all normal items have been dequeued");
+				queue.Count.Should().Be(0);
+			}
+		}
+
 		[Test]
 		public void TestEnqueueBeyondCapacity1()
 		{
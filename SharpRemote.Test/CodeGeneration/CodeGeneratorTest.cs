@@ -1,10 +1,458 @@
-﻿using NUnit.Framework;
+﻿using System;
+using System.Diagnostics;
+using System.IO;
+using System.Reflection;
+using System.Reflection.Emit;
+using FluentAssertions;
+using Moq;
+using NUnit.Framework;
+using SharpRemote.CodeGeneration;
+using SharpRemote.Test.Types.Interfaces;
+using SharpRemote.Test.Types.Interfaces.PrimitiveTypes;
+using SharpRemote.Test.Types.Structs;
 
 namespace SharpRemote.Test.CodeGeneration
 {
 	[TestFixture]
 	public sealed class CodeGeneratorTest
 	{
-		
+		private static readonly Type[] Interfaces =
+		{
+			typeof(IVoidMethodNoParameters),
+			typeof(IReturnComplexType),
+			typeof(IEventInt32),
+			typeof(IVoidMethodStructParameter),
+			typeof(IReturnsIntTask),
+			typeof(IInvokeAttributeMethods),
+			typeof(IGetInt32Property),
+			typeof(IGetStringProperty),
+			typeof(IFactory)
+		};
+
+		private static readonly Type[] PregeneratedInterfaces =
+		{
+			typeof(IVoidMethodNoParameters),
+			typeof(IGetInt32Property),
+			typeof(IVoidMethodStructParameter),
+			typeof(IReturnComplexType)
+		};
+
+		private string _pregeneratedDirectory;
+		private string _pregeneratedPath;
+		private string _cacheDirectory;
+
+		[OneTimeSetUp]
+		public void OneTimeSetUp()
+		{
+			// The pregenerated assembly is named after the assembly declaring the interfaces and thus
+			// can only be loaded once per process: All tests have to share the same one.
+			_pregeneratedDirectory = CreateTemporaryDirectoryName();
+			_pregeneratedPath = CodeGenerator.Pregenerate(PregeneratedInterfaces, _pregeneratedDirectory);
+		}
+
+		[OneTimeTearDown]
+		public void OneTimeTearDown()
+		{
+			TryDelete(_pregeneratedDirectory);
+		}
+
+		[SetUp]
+		public void SetUp()
+		{
+			_cacheDirectory = CreateTemporaryDirectoryName();
+		}
+
+		[TearDown]
+		public void TearDown()
+		{
+			TryDelete(_cacheDirectory);
+		}
+
+		private static string CreateTemporaryDirectoryName()
+		{
+			return Path.Combine(Path.GetTempPath(), "SharpRemote", "Test", Guid.NewGuid().ToString("N"));
+		}
+
+		private static void TryDelete(string directory)
+		{
+			try
+			{
+				Directory.Delete(directory, recursive: true);
+			}
+			catch (IOException e)
+			{
+				// Assemblies which have been loaded cannot be deleted until the process exits...
+				Console.WriteLine(e);
+			}
+			catch (UnauthorizedAccessException e)
+			{
+				Console.WriteLine(e);
+			}
+		}
+
+		private string CachedAssemblyPath(params Type[] interfaceTypes)
+		{
+			var fileName = string.Format("SharpRemote.GeneratedCode.{0}.dll", CodeGenerator.ComputeCacheKey(interfaceTypes));
+			return Path.Combine(_cacheDirectory, fileName);
+		}
+
+		[Test]
+		public void TestCtorInvalidArguments()
+		{
+			new Action(() => new CodeGenerator(null, _cacheDirectory))
+				.Should().Throw<ArgumentNullException>();
+			new Action(() => new CodeGenerator(Interfaces, null))
+				.Should().Throw<ArgumentNullException>();
+			new Action(() => new CodeGenerator(new[] {typeof(string)}, _cacheDirectory))
+				.Should().Throw<ArgumentException>()
+				.WithMessage("Proxies can only be created for interfaces: System.String is not an interface");
+		}
+
+		[Test]
+		[Description("Verifies that the cache key doesn't depend on the order of the interfaces, but on the interfaces themselves")]
+		public void TestComputeCacheKey()
+		{
+			var key = CodeGenerator.ComputeCacheKey(new[] {typeof(IVoidMethodNoParameters), typeof(IGetInt32Property)});
+			key.Should().HaveLength(32);
+			CodeGenerator.ComputeCacheKey(new[] {typeof(IGetInt32Property), typeof(IVoidMethodNoParameters)})
+			             .Should().Be(key);
+			CodeGenerator.ComputeCacheKey(new[] {typeof(IVoidMethodNoParameters)})
+			             .Should().NotBe(key);
+			CodeGenerator.ComputeCacheKey(new[] {typeof(IVoidMethodNoParameters), typeof(IGetStringProperty)})
+			             .Should().NotBe(key);
+		}
+
+		[Test]
+		[Description("Verifies that the generated code is saved to the cache directory and loaded from there the next time")]
+		public void TestCache()
+		{
+			var path = CachedAssemblyPath(Interfaces);
+
+			var generator = new CodeGenerator(Interfaces, _cacheDirectory);
+			File.Exists(path).Should().BeTrue("because the generated code should have been saved");
+			generator.GenerateProxy<IVoidMethodNoParameters>().Assembly.IsDynamic.Should().BeTrue();
+			Directory.GetFileSystemEntries(_cacheDirectory).Should().ContainSingle("because no temporary files should be left behind")
+			         .Which.Should().Be(path);
+
+			var cachedGenerator = new CodeGenerator(Interfaces, _cacheDirectory);
+			foreach (var proxyType in new[]
+			{
+				cachedGenerator.GenerateProxy<IVoidMethodNoParameters>(),
+				cachedGenerator.GenerateServant<IVoidMethodNoParameters>(),
+				cachedGenerator.GenerateProxy<IFactory>(),
+				cachedGenerator.GenerateServant<IFactory>()
+			})
+			{
+				proxyType.Assembly.IsDynamic.Should().BeFalse();
+				proxyType.Assembly.Location.Should().Be(path);
+			}
+		}
+
+		[Test]
+		[Description("Verifies that interfaces which haven't been specified upfront are still generated on-demand")]
+		public void TestCacheUnknownInterface()
+		{
+			new CodeGenerator(new[] {typeof(IVoidMethodNoParameters)}, _cacheDirectory);
+			var generator = new CodeGenerator(new[] {typeof(IVoidMethodNoParameters)}, _cacheDirectory);
+			generator.GenerateProxy<IVoidMethodNoParameters>().Assembly.IsDynamic.Should().BeFalse();
+			generator.GenerateProxy<IGetInt32Property>().Assembly.IsDynamic.Should().BeTrue();
+			generator.GenerateServant<IGetInt32Property>().Assembly.IsDynamic.Should().BeTrue();
+		}
+
+		[Test]
+		[Description("Verifies that a corrupted cache file is replaced by newly generated code")]
+		public void TestCacheCorrupted()
+		{
+			var path = CachedAssemblyPath(typeof(IGetStringProperty));
+			Directory.CreateDirectory(_cacheDirectory);
+			File.WriteAllBytes(path, new byte[] {1, 2, 3, 4});
+
+			var generator = new CodeGenerator(new[] {typeof(IGetStringProperty)}, _cacheDirectory);
+			generator.GenerateProxy<IGetStringProperty>().Assembly.IsDynamic.Should().BeTrue();
+			new FileInfo(path).Length.Should().BeGreaterThan(4, "because the corrupted file should have been replaced");
+
+			generator = new CodeGenerator(new[] {typeof(IGetStringProperty)}, _cacheDirectory);
+			generator.GenerateProxy<IGetStringProperty>().Assembly.Location.Should().Be(path);
+		}
+
+		[Test]
+		[Description("Verifies that proxies and servants loaded from a populated cache can actually call each other")]
+		public void TestCacheRoundtrip()
+		{
+			new CodeGenerator(Interfaces, _cacheDirectory);
+			var generator = new CodeGenerator(Interfaces, _cacheDirectory);
+			generator.GenerateProxy<IReturnComplexType>().Assembly.Location.Should().Be(CachedAssemblyPath(Interfaces));
+			generator.GenerateServant<IReturnComplexType>().Assembly.Location.Should().Be(CachedAssemblyPath(Interfaces));
+
+			var complexSubject = new Mock<IReturnComplexType>();
+			complexSubject.Setup(x => x.CommitInstallation(It.IsAny<long>()))
+			              .Returns((long x) => new PropertyStruct {Value = x.ToString()});
+			CreateServantAndProxy(generator, complexSubject.Object).CommitInstallation(9001)
+			                                                       .Value.Should().Be("9001");
+
+			var propertySubject = new Mock<IGetInt32Property>();
+			propertySubject.Setup(x => x.Value).Returns(42);
+			CreateServantAndProxy(generator, propertySubject.Object).Value.Should().Be(42);
+
+			// Servants hold a weak reference to their subjects, so in order for this test to run 100% of the time,
+			// we need to keep the subjects alive.
+			GC.KeepAlive(complexSubject.Object);
+			GC.KeepAlive(propertySubject.Object);
+		}
+
+		private static T CreateServantAndProxy<T>(CodeGenerator generator, T subject)
+		{
+			const ulong objectId = 1;
+			var endPoint = new Mock<IRemotingEndPoint>().Object;
+			var channel = new Mock<IEndPointChannel>();
+			var servant = generator.CreateServant(endPoint, channel.Object, objectId, subject);
+			channel.Setup(x => x.CallRemoteMethod(It.IsAny<ulong>(), It.IsAny<string>(), It.IsAny<string>(), It.IsAny<MemoryStream>()))
+			       .Returns((ulong id, string interfaceName, string methodName, MemoryStream arguments) =>
+			       {
+				       id.Should().Be(objectId);
+
+				       var reader = arguments != null ? new BinaryReader(arguments) : null;
+				       var result = new MemoryStream();
+				       servant.Invoke(methodName, reader, new BinaryWriter(result));
+				       result.Position = 0;
+				       return result;
+			       });
+
+			return generator.CreateProxy<T>(endPoint, channel.Object, objectId);
+		}
+
+		[Test]
+		[Description("Verifies that changing an interface changes the cache key, even if its name stays the same")]
+		public void TestComputeCacheKeyChangedInterface()
+		{
+			var original = DefineInterface("IContract", typeof(int));
+			var changed = DefineInterface("IContract", typeof(string));
+			changed.AssemblyQualifiedName.Should().Be(original.AssemblyQualifiedName);
+
+			var key = CodeGenerator.ComputeCacheKey(new[] {original});
+			CodeGenerator.ComputeCacheKey(new[] {original}).Should().Be(key);
+			CodeGenerator.ComputeCacheKey(new[] {changed}).Should().NotBe(key);
+			CodeGenerator.ComputeCacheKey(new[] {typeof(IVoidMethodNoParameters), original})
+			             .Should().NotBe(CodeGenerator.ComputeCacheKey(new[] {typeof(IVoidMethodNoParameters), changed}));
+		}
+
+		/// <summary>
+		///     Emits an interface with a single method "Get" into an assembly of its own.
+		///     Every invocation emits a new assembly with the very same name, which is what
+		///     a client observes when the contract assembly has been rebuilt.
+		/// </summary>
+		/// <param name="name"></param>
+		/// <param name="returnType"></param>
+		/// <returns></returns>
+		private static Type DefineInterface(string name, Type returnType)
+		{
+			var assemblyName = new AssemblyName("SharpRemote.Test.Contracts");
+			var assembly = AssemblyBuilder.DefineDynamicAssembly(assemblyName, AssemblyBuilderAccess.Run);
+			var module = assembly.DefineDynamicModule(assemblyName.Name);
+			var typeBuilder = module.DefineType("SharpRemote.Test.Contracts." + name,
+			                                    TypeAttributes.Public | TypeAttributes.Interface | TypeAttributes.Abstract);
+			typeBuilder.DefineMethod("Get",
+			                         MethodAttributes.Public | MethodAttributes.Abstract | MethodAttributes.Virtual |
+			                         MethodAttributes.HideBySig | MethodAttributes.NewSlot,
+			                         returnType,
+			                         Type.EmptyTypes);
+			return typeBuilder.CreateType();
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Compares the time it takes to provide proxies and servants with and without the on-disk cache")]
+		public void TestCacheStartupPerformance()
+		{
+			var sw = Stopwatch.StartNew();
+			var generator = new CodeGenerator();
+			foreach (var interfaceType in Interfaces)
+			{
+				typeof(CodeGenerator).GetMethod("GenerateProxy").MakeGenericMethod(interfaceType).Invoke(generator, null);
+				typeof(CodeGenerator).GetMethod("GenerateServant").MakeGenericMethod(interfaceType).Invoke(generator, null);
+			}
+			Console.WriteLine("Without cache: {0:F1}ms", sw.Elapsed.TotalMilliseconds);
+
+			sw.Restart();
+			new CodeGenerator(Interfaces, _cacheDirectory);
+			Console.WriteLine("Cold cache: {0:F1}ms", sw.Elapsed.TotalMilliseconds);
+
+			sw.Restart();
+			new CodeGenerator(Interfaces, _cacheDirectory);
+			Console.WriteLine("Cached: {0:F1}ms", sw.Elapsed.TotalMilliseconds);
+		}
+
+		[Test]
+		[Description("Verifies that Prepare generates proxies and servants and reports interfaces which cannot be remoted")]
+		public void TestPrepare()
+		{
+			var generator = new CodeGenerator();
+			var preparedTypes = generator.Prepare(new[]
+			{
+				typeof(IVoidMethodNoParameters),
+				typeof(string),
+				typeof(IFactory)
+			});
+
+			preparedTypes.Should().HaveCount(3);
+			preparedTypes[0].Type.Should().Be<IVoidMethodNoParameters>();
+			preparedTypes[0].Succeeded.Should().BeTrue();
+			preparedTypes[0].Elapsed.Should().BeGreaterThan(TimeSpan.Zero);
+			preparedTypes[1].Type.Should().Be<string>();
+			preparedTypes[1].Exception.Should().BeOfType<ArgumentException>();
+			preparedTypes[2].Type.Should().Be<IFactory>();
+			preparedTypes[2].Succeeded.Should().BeTrue();
+		}
+
+		[Test]
+		[Description("Verifies that Prepare generates proxies and servants for all public interfaces of an assembly")]
+		public void TestPrepareAssembly()
+		{
+			var generator = new CodeGenerator();
+			var preparedTypes = generator.Prepare(typeof(IVoidMethodNoParameters).Assembly);
+			foreach (var preparedType in preparedTypes)
+				Console.WriteLine(preparedType);
+
+			preparedTypes.Should().Contain(x => x.Type == typeof(IVoidMethodNoParameters) && x.Succeeded);
+			preparedTypes.Should().Contain(x => x.Type == typeof(IReturnComplexType) && x.Succeeded);
+			preparedTypes.Should().OnlyContain(x => x.Type.IsInterface);
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Compares the latency of the first call on a proxy with and without preparing it upfront")]
+		public void TestPrepareFirstCallPerformance()
+		{
+			var value = new FieldStruct {A = 1, B = 2, C = "3"};
+
+			var sw = Stopwatch.StartNew();
+			CallDo(new CodeGenerator(), value);
+			Console.WriteLine("First call without warmup: {0:F1}ms", sw.Elapsed.TotalMilliseconds);
+
+			var generator = new CodeGenerator();
+			sw.Restart();
+			var preparedTypes = generator.Prepare(Interfaces);
+			Console.WriteLine("Warmup: {0:F1}ms", sw.Elapsed.TotalMilliseconds);
+			foreach (var preparedType in preparedTypes)
+				Console.WriteLine("  {0}", preparedType);
+
+			sw.Restart();
+			CallDo(generator, value);
+			Console.WriteLine("First call after warmup: {0:F1}ms", sw.Elapsed.TotalMilliseconds);
+		}
+
+		private CodeGenerator CreatePregenerated()
+		{
+			var contracts = typeof(IVoidMethodNoParameters).Assembly;
+			return new CodeGenerator(null, new PregeneratedCode(assembly => assembly == contracts ? _pregeneratedPath : null));
+		}
+
+		[Test]
+		public void TestPregenerateInvalidArguments()
+		{
+			new Action(() => CodeGenerator.Pregenerate(null, _cacheDirectory))
+				.Should().Throw<ArgumentNullException>();
+			new Action(() => CodeGenerator.Pregenerate(Interfaces, null))
+				.Should().Throw<ArgumentNullException>();
+			new Action(() => CodeGenerator.Pregenerate(new[] {typeof(IVoidMethodNoParameters), typeof(IDisposable)}, _cacheDirectory))
+				.Should().Throw<ArgumentException>()
+				.WithMessage("All interfaces must be declared in the same assembly, but they are declared in: SharpRemote.Test, mscorlib");
+		}
+
+		[Test]
+		[Description("Verifies that pregenerated proxies and servants are used and that the remaining ones are generated at runtime")]
+		public void TestPregenerate()
+		{
+			var path = _pregeneratedPath;
+			path.Should().Be(Path.Combine(_pregeneratedDirectory, "SharpRemote.Test.SharpRemote.dll"));
+			File.Exists(path).Should().BeTrue();
+
+			var generator = CreatePregenerated();
+			generator.GenerateProxy<IVoidMethodNoParameters>().Assembly.Location.Should().Be(path);
+			generator.GenerateServant<IVoidMethodNoParameters>().Assembly.Location.Should().Be(path);
+			generator.GenerateProxy<IGetInt32Property>().Assembly.Location.Should().Be(path);
+			generator.GenerateServant<IGetInt32Property>().Assembly.Location.Should().Be(path);
+
+			generator.GenerateProxy<IGetStringProperty>().Assembly.IsDynamic.Should().BeTrue();
+			generator.GenerateServant<IGetStringProperty>().Assembly.IsDynamic.Should().BeTrue();
+		}
+
+		[Test]
+		[Description("Verifies that pregenerated proxies and servants produce exactly the same output as the ones generated at runtime")]
+		public void TestPregeneratedOutputIsIdentical()
+		{
+			var pregenerated = CreatePregenerated();
+			pregenerated.GenerateProxy<IVoidMethodStructParameter>().Assembly.Location.Should().Be(_pregeneratedPath);
+			var emitted = new CodeGenerator();
+			emitted.GenerateProxy<IVoidMethodStructParameter>().Assembly.IsDynamic.Should().BeTrue();
+
+			var value = new FieldStruct {A = Math.PI, B = 42, C = "Hello, World!"};
+			var pregeneratedArguments = CallDo(pregenerated, value);
+			var emittedArguments = CallDo(emitted, value);
+			pregeneratedArguments.Should().NotBeEmpty();
+			pregeneratedArguments.Should().Equal(emittedArguments);
+
+			var pregeneratedResult = InvokeCommitInstallation(pregenerated, 9001);
+			var emittedResult = InvokeCommitInstallation(emitted, 9001);
+			pregeneratedResult.Should().NotBeEmpty();
+			pregeneratedResult.Should().Equal(emittedResult);
+		}
+
+		private static byte[] CallDo(CodeGenerator generator, FieldStruct value)
+		{
+			byte[] arguments = null;
+			var endPoint = new Mock<IRemotingEndPoint>();
+			var channel = new Mock<IEndPointChannel>();
+			channel.Setup(x => x.CallRemoteMethod(It.IsAny<ulong>(), It.IsAny<string>(), It.IsAny<string>(), It.IsAny<MemoryStream>()))
+			       .Returns((ulong objectId, string interfaceName, string methodName, MemoryStream stream) =>
+			       {
+				       arguments = stream.ToArray();
+				       return null;
+			       });
+
+			var proxy = generator.CreateProxy<IVoidMethodStructParameter>(endPoint.Object, channel.Object, 1);
+			proxy.Do(value);
+			return arguments;
+		}
+
+		private static byte[] InvokeCommitInstallation(CodeGenerator generator, long id)
+		{
+			var subject = new Mock<IReturnComplexType>();
+			subject.Setup(x => x.CommitInstallation(It.IsAny<long>()))
+			       .Returns((long x) => new PropertyStruct {Value = x.ToString()});
+
+			var servant = generator.CreateServant(new Mock<IRemotingEndPoint>().Object,
+			                                      new Mock<IEndPointChannel>().Object,
+			                                      1,
+			                                      subject.Object);
+
+			var arguments = new MemoryStream();
+			new BinaryWriter(arguments).Write(id);
+			arguments.Position = 0;
+
+			var result = new MemoryStream();
+			servant.Invoke("CommitInstallation", new BinaryReader(arguments), new BinaryWriter(result));
+
+			// Servants hold a weak reference to their subjects, so in order for this test to run 100% of the time,
+			// we need to keep the subject alive.
+			GC.KeepAlive(subject.Object);
+			return result.ToArray();
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Compares the time it takes to create and call the first proxy with and without pregenerated code")]
+		public void TestPregeneratedStartupPerformance()
+		{
+			var value = new FieldStruct {A = 1, B = 2, C = "3"};
+
+			var sw = Stopwatch.StartNew();
+			CallDo(CreatePregenerated(), value);
+			Console.WriteLine("Pregenerated: {0:F1}ms", sw.Elapsed.TotalMilliseconds);
+
+			sw.Restart();
+			CallDo(new CodeGenerator(), value);
+			Console.WriteLine("Generated at runtime: {0:F1}ms", sw.Elapsed.TotalMilliseconds);
+		}
 	}
-}
\ No newline at end of file
+}
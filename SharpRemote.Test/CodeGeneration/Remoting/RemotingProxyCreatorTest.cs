@@ -225,6 +225,51 @@ namespace SharpRemote.Test.CodeGeneration.Remoting
 			proxy.Value.Should().Be((float) Math.PI);
 		}
 
+		[Test]
+		[Description("Verifies that a method with the PriorityAttribute passes its priority to the channel")]
+		public void TestPriority1()
+		{
+			var proxy = TestGenerate<IPriorityMethods>();
+			_channel.Setup(
+				x => x.CallRemoteMethod(It.IsAny<ulong>(), It.IsAny<string>(), It.IsAny<string>(), It.IsAny<MemoryStream>(), It.IsAny<Priority>()))
+			        .Returns((ulong objectId, string interfaceName, string methodName, Stream stream, Priority priority) =>
+				        {
+					        objectId.Should().Be(((IProxy) proxy).ObjectId);
+					        methodName.Should().Be("GetStatus");
+					        priority.Should().Be(Priority.High);
+
+					        var outStream = new MemoryStream();
+					        var outWriter = new BinaryWriter(outStream);
+					        outWriter.Write(42);
+					        outStream.Position = 0;
+					        return outStream;
+				        });
+
+			proxy.GetStatus().Should().Be(42);
+		}
+
+		[Test]
+		[Description("Verifies that a method without the PriorityAttribute doesn't pass any priority to the channel")]
+		public void TestPriority2()
+		{
+			var proxy = TestGenerate<IPriorityMethods>();
+			_channel.Setup(
+				x => x.CallRemoteMethod(It.IsAny<ulong>(), It.IsAny<string>(), It.IsAny<string>(), It.IsAny<MemoryStream>()))
+			        .Returns((ulong objectId, string interfaceName, string methodName, Stream stream) =>
+				        {
+					        objectId.Should().Be(((IProxy) proxy).ObjectId);
+					        methodName.Should().Be("GetValue");
+
+					        var outStream = new MemoryStream();
+					        var outWriter = new BinaryWriter(outStream);
+					        outWriter.Write(1337);
+					        outStream.Position = 0;
+					        return outStream;
+				        });
+
+			proxy.GetValue().Should().Be(1337);
+		}
+
 		[Test]
 		public void TestGetStringProperty()
 		{
@@ -524,6 +569,14 @@ namespace SharpRemote.Test.CodeGeneration.Remoting
 				.WithMessage("Proxies can only be created for interfaces: System.Int64 is not an interface");
 		}
 
+		[Test]
+		public void TestStreamedNonEnumerable()
+		{
+			new Action(() => _creator.GenerateProxy<IStreamedNonEnumerable>())
+				.Should().Throw<ArgumentException>()
+				.WithMessage("Unable to create proxy for type 'IStreamedNonEnumerable': Method IStreamedNonEnumerable.Foo has the Streamed attribute applied, but its return type is not IEnumerable<T> - this is not supported");
+		}
+
 		[Test]
 		[Description("Verifies that an object where it's known at compile time that it is a by reference type is marshalled correctly without embedding type information")]
 		public void TestReturnByReference1()
@@ -3,6 +3,7 @@ using System.IO;
 using System.Linq;
 using System.Reflection;
 using System.Reflection.Emit;
+using System.Threading;
 using System.Threading.Tasks;
 using FluentAssertions;
 using Moq;
@@ -145,6 +146,88 @@ namespace SharpRemote.Test.CodeGeneration.Remoting
 			GC.KeepAlive(subject.Object);
 		}
 
+		[Test]
+		[Description("Verifies that a coalesced event is delivered less often than it's raised, but that the latest value is delivered")]
+		public void TestCoalescedEvent()
+		{
+			var subject = new Mock<ICoalescedEvents>();
+			IServant servant = TestGenerate(subject.Object);
+
+			const int numRaises = 1000;
+			int numDeliveries = 0;
+			using (var lastValueDelivered = new ManualResetEventSlim())
+			{
+				_channel.Setup(
+					x => x.CallRemoteMethodAsync(It.IsAny<ulong>(), It.IsAny<string>(), It.IsAny<string>(), It.IsAny<MemoryStream>(), It.IsAny<Priority>()))
+				        .Returns((ulong id, string interfaceName, string methodName, MemoryStream stream, Priority priority) =>
+					        {
+						        id.Should().Be(servant.ObjectId);
+						        methodName.Should().Be("Progress");
+						        Interlocked.Increment(ref numDeliveries);
+						        if (new BinaryReader(stream).ReadInt32() == numRaises)
+							        lastValueDelivered.Set();
+						        return Task.FromResult<MemoryStream>(null);
+					        });
+
+				for (int i = 1; i <= numRaises; ++i)
+				{
+					subject.Raise(x => x.Progress += null, i);
+				}
+
+				lastValueDelivered.Wait(TimeSpan.FromSeconds(10))
+				                  .Should().BeTrue("because the latest value must always be delivered");
+				numDeliveries.Should().BeLessThan(numRaises);
+			}
+
+			// Servants hold a weak reference to their subjects, so in order for this test to run 100% of the time,
+			// we need to keep the subject alive.
+			GC.KeepAlive(subject.Object);
+		}
+
+		[Test]
+		[Description("Verifies that a disposed servant no longer delivers its coalesced events")]
+		public void TestDisposeCoalescedEvent()
+		{
+			var subject = new Mock<ICoalescedEvents>();
+			IServant servant = TestGenerate(subject.Object);
+			servant.Should().BeAssignableTo<IDisposable>();
+
+			int numDeliveries = 0;
+			_channel.Setup(
+				x => x.CallRemoteMethodAsync(It.IsAny<ulong>(), It.IsAny<string>(), It.IsAny<string>(), It.IsAny<MemoryStream>(), It.IsAny<Priority>()))
+			        .Returns((ulong id, string interfaceName, string methodName, MemoryStream stream, Priority priority) =>
+				        {
+					        Interlocked.Increment(ref numDeliveries);
+					        return Task.FromResult<MemoryStream>(null);
+				        });
+
+			subject.Raise(x => x.Progress += null, 1);
+			subject.Raise(x => x.Progress += null, 2);
+			((IDisposable) servant).Dispose();
+			subject.Raise(x => x.Progress += null, 3);
+
+			Thread.Sleep(TimeSpan.FromMilliseconds(200));
+			numDeliveries.Should().Be(1, "because the pending raise is dropped when the servant is disposed");
+
+			GC.KeepAlive(subject.Object);
+		}
+
+		[Test]
+		public void TestCoalescedEventReturnsValue()
+		{
+			new Action(() => _creator.GenerateServant<ICoalescedEventReturnsValue>())
+				.Should().Throw<ArgumentException>()
+				.WithMessage("Unable to create servant for type 'ICoalescedEventReturnsValue': Event ICoalescedEventReturnsValue.Foo is coalesced, but its delegate returns a value - this is not supported");
+		}
+
+		[Test]
+		public void TestStreamedNonEnumerable()
+		{
+			new Action(() => _creator.GenerateServant<IStreamedNonEnumerable>())
+				.Should().Throw<ArgumentException>()
+				.WithMessage("Unable to create servant for type 'IStreamedNonEnumerable': Method IStreamedNonEnumerable.Foo has the Streamed attribute applied, but its return type is not IEnumerable<T> - this is not supported");
+		}
+
 		[Test]
 		public void TestGetProperty()
 		{
@@ -252,6 +335,49 @@ namespace SharpRemote.Test.CodeGeneration.Remoting
 				.Should().Throw<ArgumentException>();
 		}
 
+		[Test]
+		[Description("Verifies that a method with the InvokeAttribute set to Inline has no task scheduler")]
+		public void TestGetTaskScheduler7()
+		{
+			var subject = new Mock<IInvokeAttributeMethods>();
+			IServant servant = TestGenerate(subject.Object);
+			servant.GetTaskScheduler("Inline")
+			       .Should().BeNull();
+		}
+
+		[Test]
+		[Description("Verifies that GetDispatchingStrategy returns the strategy specified by the InvokeAttribute, if present")]
+		public void TestGetDispatchingStrategy1()
+		{
+			var subject = new Mock<IInvokeAttributeMethods>();
+			IServant servant = TestGenerate(subject.Object);
+			servant.GetDispatchingStrategy("NoAttribute").Should().Be(Dispatch.DoNotSerialize);
+			servant.GetDispatchingStrategy("DoNotSerialize").Should().Be(Dispatch.DoNotSerialize);
+			servant.GetDispatchingStrategy("SerializePerType").Should().Be(Dispatch.SerializePerType);
+			servant.GetDispatchingStrategy("SerializePerObject1").Should().Be(Dispatch.SerializePerObject);
+			servant.GetDispatchingStrategy("SerializePerMethod1").Should().Be(Dispatch.SerializePerMethod);
+			servant.GetDispatchingStrategy("Inline").Should().Be(Dispatch.Inline);
+		}
+
+		[Test]
+		[Description("Verifies that GetDispatchingStrategy throws when the given method doesn't exist")]
+		public void TestGetDispatchingStrategy2()
+		{
+			var subject = new Mock<IInvokeAttributeMethods>();
+			IServant servant = TestGenerate(subject.Object);
+			new Action(() => servant.GetDispatchingStrategy("DoesntExist"))
+				.Should().Throw<ArgumentException>();
+		}
+
+		[Test]
+		[Description("Verifies that a servant can't be created when an inline method returns a task, as it would block the read thread")]
+		public void TestInlineReturnsTask()
+		{
+			new Action(() => _creator.GenerateServant<IInlineReturnsTask>())
+				.Should().Throw<ArgumentException>()
+				.WithMessage("Unable to create servant for type 'IInlineReturnsTask': Method IInlineReturnsTask.DoStuff is dispatched inline, but returns a task - this is not supported");
+		}
+
 		[Test]
 		public void TestIntMethodTypeParameters()
 		{
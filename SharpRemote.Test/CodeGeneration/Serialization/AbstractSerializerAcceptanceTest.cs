@@ -1,6 +1,7 @@
 ﻿using System;
 using System.Collections.Generic;
 using System.IO;
+using System.Linq;
 using FluentAssertions;
 using log4net.Core;
 using NUnit.Framework;
@@ -309,6 +310,86 @@ namespace SharpRemote.Test.CodeGeneration.Serialization
 			}
 		}
 
+		[Test]
+		public void TestMethodCallByteSegment()
+		{
+			var serializer = Create();
+			using (var stream = new MemoryStream())
+			{
+				var bytes = Enumerable.Range(0, 100).Select(x => (byte) x).ToArray();
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					writer.WriteArgument(new ArraySegment<byte>(bytes, 10, 20));
+					writer.WriteArgument(new ArraySegment<byte>(bytes, 50, 0));
+					writer.WriteArgument(default(ArraySegment<byte>));
+					writer.WriteArgument(new ArraySegment<byte>(bytes, 90, 10));
+				}
+
+				PrintAndRewind(stream);
+
+				using (var reader = CreateMethodCallReader(serializer, stream))
+				{
+					ArraySegment<byte> actualValue;
+					reader.ReadNextArgumentAsByteSegment(out actualValue).Should().BeTrue();
+					actualValue.Should().Equal(bytes.Skip(10).Take(20));
+
+					reader.ReadNextArgumentAsByteSegment(out actualValue).Should().BeTrue();
+					actualValue.Array.Should().NotBeNull();
+					actualValue.Should().BeEmpty();
+
+					reader.ReadNextArgumentAsByteSegment(out actualValue).Should().BeTrue();
+					actualValue.Array.Should().BeNull();
+
+					byte[] actualBytes;
+					reader.ReadNextArgumentAsBytes(out actualBytes).Should().BeTrue("because segments are written in the same format as byte arrays");
+					actualBytes.Should().Equal(bytes.Skip(90));
+
+					reader.ReadNextArgumentAsByteSegment(out actualValue).Should()
+					      .BeFalse("because there are no more arguments");
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that delta encoded values survive a roundtrip, no matter how many of their members changed")]
+		public void TestMethodCallDeltaEncoded()
+		{
+			var serializer = Create();
+			var time = new DateTime(2020, 1, 1, 12, 0, 0, DateTimeKind.Utc);
+			var quotes = Enumerable.Range(0, 100).Select(i => new DeltaQuote
+			{
+				Symbol = i % 3 == 0 ? "MSFT" : "AAPL",
+				Bid = 100 + i % 7,
+				Ask = i % 10 == 0 ? double.NaN : 101,
+				Volume = i / 10,
+				Time = i % 20 == 0 ? time.ToLocalTime() : time,
+				Exchange = i % 5 == 0 ? null : "NASDAQ"
+			}).ToList();
+
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					foreach (var quote in quotes)
+						writer.WriteArgument(quote);
+				}
+
+				PrintAndRewind(stream);
+
+				using (var reader = CreateMethodCallReader(serializer, stream))
+				{
+					foreach (var quote in quotes)
+					{
+						object actualValue;
+						reader.ReadNextArgument(out actualValue).Should().BeTrue();
+						actualValue.Should().BeOfType<DeltaQuote>();
+						actualValue.Should().BeEquivalentTo(quote);
+						((DeltaQuote) actualValue).Time.Kind.Should().Be(quote.Time.Kind);
+					}
+				}
+			}
+		}
+
 		[Test]
 		public void TestMethodCallTwoParameters()
 		{
@@ -1050,6 +1131,55 @@ namespace SharpRemote.Test.CodeGeneration.Serialization
 			}
 		}
 
+		[Test]
+		[Description("Verifies that byte arrays and segments returned by a method survive a roundtrip")]
+		public void TestMethodResultByteSegment()
+		{
+			var serializer = Create();
+			var bytes = Enumerable.Range(0, 100).Select(x => (byte) x).ToArray();
+			foreach (var value in new[]
+			{
+				new ArraySegment<byte>(bytes, 10, 20),
+				new ArraySegment<byte>(bytes, 50, 0),
+				default(ArraySegment<byte>)
+			})
+			{
+				using (var stream = new MemoryStream())
+				{
+					const int rpcId = 10;
+					using (var writer = serializer.CreateMethodResultWriter(stream, rpcId))
+					{
+						writer.WriteResult(value);
+					}
+
+					PrintAndRewind(stream);
+
+					using (var reader = CreateMethodResultReader(serializer, stream))
+					{
+						reader.RpcId.Should().Be(rpcId);
+
+						ArraySegment<byte> actualValue;
+						reader.ReadResultByteSegment(out actualValue).Should().BeTrue();
+						if (value.Array == null)
+							actualValue.Array.Should().BeNull();
+						else
+							actualValue.Should().Equal(value);
+					}
+
+					stream.Position = 0;
+					using (var reader = CreateMethodResultReader(serializer, stream))
+					{
+						byte[] actualBytes;
+						reader.ReadResultBytes(out actualBytes).Should().BeTrue("because segments are written in the same format as byte arrays");
+						if (value.Array == null)
+							actualBytes.Should().BeNull();
+						else
+							actualBytes.Should().Equal(value);
+					}
+				}
+			}
+		}
+
 		[Test]
 		public void TestMethodResultUInt16([ValueSource(nameof(UInt16Values))] ushort value)
 		{
@@ -1285,6 +1415,33 @@ namespace SharpRemote.Test.CodeGeneration.Serialization
 
 		#endregion
 
+		[Test]
+		[Description("Verifies that RegisterTypes registers all types and reports those which cannot be serialized instead of throwing")]
+		public void TestRegisterTypes()
+		{
+			var serializer = Create();
+			var preparedTypes = serializer.RegisterTypes(new[]
+			{
+				typeof(FieldStruct),
+				typeof(MissingDataContractStruct),
+				typeof(PropertySealedClass)
+			});
+
+			preparedTypes.Should().HaveCount(3);
+			preparedTypes[0].Type.Should().Be<FieldStruct>();
+			preparedTypes[0].Succeeded.Should().BeTrue();
+			preparedTypes[0].Elapsed.Should().BeGreaterThan(TimeSpan.Zero);
+			preparedTypes[1].Type.Should().Be<MissingDataContractStruct>();
+			preparedTypes[1].Succeeded.Should().BeFalse();
+			preparedTypes[1].Exception.Should().BeOfType<ArgumentException>();
+			preparedTypes[2].Type.Should().Be<PropertySealedClass>();
+			preparedTypes[2].Succeeded.Should().BeTrue();
+
+			serializer.IsTypeRegistered<FieldStruct>().Should().BeTrue();
+			serializer.IsTypeRegistered<MissingDataContractStruct>().Should().BeFalse();
+			serializer.IsTypeRegistered<PropertySealedClass>().Should().BeTrue();
+		}
+
 		#region Constraint violations
 
 		[Test]
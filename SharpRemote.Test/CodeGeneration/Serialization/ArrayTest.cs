@@ -1,6 +1,11 @@
 ﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using FluentAssertions;
 using NUnit.Framework;
 using SharpRemote.Test.Types.Classes;
+using SharpRemote.Test.Types.Enums;
 using SharpRemote.Test.Types.Structs;
 
 namespace SharpRemote.Test.CodeGeneration.Serialization
@@ -18,6 +23,151 @@ namespace SharpRemote.Test.CodeGeneration.Serialization
 			_serializer.ShouldRoundtripEnumeration(new byte[] {1, 0, 42, 244});
 		}
 
+		[Test]
+		public void TestDoubleArray()
+		{
+			_serializer.RegisterType<double[]>();
+			_serializer.ShouldRoundtripEnumeration(new double[0]);
+			_serializer.ShouldRoundtripEnumeration(new[] {Math.PI});
+			_serializer.ShouldRoundtripEnumeration(new[] {double.MinValue, double.MaxValue, double.NaN, double.NegativeInfinity, double.PositiveInfinity, double.Epsilon});
+		}
+
+		[Test]
+		[Description("Verifies that arrays which are larger than the chunks they're copied in roundtrip")]
+		public void TestLargeDoubleArray()
+		{
+			_serializer.RegisterType<double[]>();
+			var values = new double[100003];
+			for (int i = 0; i < values.Length; ++i)
+				values[i] = i * Math.E;
+			_serializer.ShouldRoundtripEnumeration(values);
+		}
+
+		[Test]
+		[Description("Verifies that arrays of blittable types are written exactly as if every element had been written on its own")]
+		public void TestIntArrayWireFormat()
+		{
+			_serializer.RegisterType<int[]>();
+			using (var stream = new MemoryStream())
+			using (var writer = new BinaryWriter(stream))
+			{
+				_serializer.WriteObject(writer, new[] {1, -2, 0x01020304}, null);
+
+				var expected = new byte[] {3, 0, 0, 0, 1, 0, 0, 0, 0xFE, 0xFF, 0xFF, 0xFF, 4, 3, 2, 1};
+				var actual = stream.ToArray();
+				actual.Skip(actual.Length - expected.Length).Should().Equal(expected);
+			}
+		}
+
+		[Test]
+		public void TestFieldVector3Array()
+		{
+			_serializer.RegisterType<FieldVector3[]>();
+			_serializer.ShouldRoundtripEnumeration(new FieldVector3[0]);
+			_serializer.ShouldRoundtripEnumeration(new[]
+			{
+				new FieldVector3 {X = 1, Y = 2, Z = 3},
+				new FieldVector3 {X = -Math.PI, Y = double.MaxValue, Z = double.NaN}
+			});
+		}
+
+		[Test]
+		[Description("Verifies that arrays of structs with padding between their fields roundtrip")]
+		public void TestFieldPaddedStructArray()
+		{
+			_serializer.RegisterType<FieldPaddedStruct[]>();
+			_serializer.ShouldRoundtripEnumeration(new FieldPaddedStruct[0]);
+			_serializer.ShouldRoundtripEnumeration(new[]
+			{
+				new FieldPaddedStruct {A = 1, B = int.MinValue},
+				new FieldPaddedStruct {A = byte.MaxValue, B = 42}
+			});
+		}
+
+		private static ColumnarTick[] CreateColumnarTicks()
+		{
+			return new[]
+			{
+				new ColumnarTick
+				{
+					Timestamp = long.MinValue,
+					Price = double.NaN,
+					Quantity = 42,
+					Side = ByteEnum.C,
+					IsTrade = true,
+					Yield = 0.5f,
+					Venue = "XETRA",
+					Flags = Int32Enum.A
+				},
+				new ColumnarTick(),
+				new ColumnarTick
+				{
+					Timestamp = long.MaxValue,
+					Price = -Math.PI,
+					Quantity = int.MinValue,
+					Side = ByteEnum.B,
+					Yield = float.NegativeInfinity,
+					Venue = "",
+					Flags = Int32Enum.C
+				}
+			};
+		}
+
+		[Test]
+		public void TestColumnarStructArray()
+		{
+			_serializer.RegisterType<ColumnarTick[]>();
+			_serializer.ShouldRoundtripEnumeration(new ColumnarTick[0]);
+			_serializer.ShouldRoundtripEnumeration(new[] {new ColumnarTick {Yield = 1, Venue = "a"}});
+			_serializer.ShouldRoundtripEnumeration(CreateColumnarTicks());
+		}
+
+		[Test]
+		[Description("Verifies that members without the [DataMember] attribute are not written to any column")]
+		public void TestColumnarStructArrayNotSerialized()
+		{
+			_serializer.RegisterType<ColumnarTick[]>();
+			var actual = _serializer.Roundtrip(new[] {new ColumnarTick {Quantity = 1, NotSerialized = 42}});
+			actual.Should().Equal(new ColumnarTick {Quantity = 1});
+		}
+
+		[Test]
+		[Description("Verifies that columnar arrays which are larger than the chunks their columns are copied in roundtrip")]
+		public void TestLargeColumnarStructArray()
+		{
+			_serializer.RegisterType<ColumnarTick[]>();
+			var values = new ColumnarTick[100003];
+			for (int i = 0; i < values.Length; ++i)
+			{
+				values[i] = new ColumnarTick
+				{
+					Timestamp = i,
+					Price = i * Math.E,
+					Quantity = -i,
+					IsTrade = i % 3 == 0,
+					Yield = i % 7 == 0 ? (float?) null : i,
+					Venue = i % 5 == 0 ? null : "X"
+				};
+			}
+			_serializer.ShouldRoundtripEnumeration(values);
+		}
+
+		[Test]
+		public void TestColumnarStructList()
+		{
+			_serializer.RegisterType<List<ColumnarTick>>();
+			_serializer.ShouldRoundtripEnumeration(new List<ColumnarTick>());
+			_serializer.ShouldRoundtripEnumeration(new List<ColumnarTick>(CreateColumnarTicks()));
+		}
+
+		[Test]
+		[Description("Verifies that stacks of [Columnar] structs, which are written in reverse order, still roundtrip")]
+		public void TestColumnarStructStack()
+		{
+			_serializer.RegisterType<Stack<ColumnarTick>>();
+			_serializer.ShouldRoundtripEnumeration(new Stack<ColumnarTick>(CreateColumnarTicks()));
+		}
+
 		[Test]
 		public void TestFieldStructArray()
 		{
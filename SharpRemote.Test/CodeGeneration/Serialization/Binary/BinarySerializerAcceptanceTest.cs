@@ -1,12 +1,21 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.IO;
+using System.Linq;
 using System.Reflection;
 using System.Reflection.Emit;
 using System.Text;
+using System.Threading;
+using System.Threading.Tasks;
 using FluentAssertions;
+using Moq;
 using NUnit.Framework;
+using SharpRemote.CodeGeneration.Serialization.Binary;
 using SharpRemote.Test.Types.Classes;
+using SharpRemote.Test.Types.Enums;
+using SharpRemote.Test.Types.Interfaces;
+using SharpRemote.Test.Types.Structs;
 
 namespace SharpRemote.Test.CodeGeneration.Serialization.Binary
 {
@@ -31,6 +40,18 @@ namespace SharpRemote.Test.CodeGeneration.Serialization.Binary
 			return new BinarySerializer2(_module);
 		}
 
+		/// <summary>
+		///     Creates a serializer which compiles its methods into its own module so that it can be used
+		///     alongside one returned by <see cref="Create" /> (e.g. as the receiving end of a connection).
+		/// </summary>
+		/// <returns></returns>
+		private static ISerializer2 CreateOnOwnModule()
+		{
+			var assemblyName = new AssemblyName("SharpRemote.GeneratedCode.Serializer.Peer");
+			var assembly = AssemblyBuilder.DefineDynamicAssembly(assemblyName, AssemblyBuilderAccess.Run);
+			return new BinarySerializer2(assembly.DefineDynamicModule(assemblyName.Name + ".dll"));
+		}
+
 		protected override void Save()
 		{
 			var fname = "SharpRemote.GeneratedCode.Serializer.dll";
@@ -79,6 +100,1093 @@ namespace SharpRemote.Test.CodeGeneration.Serialization.Binary
 			actualMessage.Challenge.Should().Be(challenge);
 		}
 
+		[Test]
+		[Description("Verifies that the name of a type is written only once per message, no matter how many objects of that type are written")]
+		public void TestMethodCallRepeatedTypes()
+		{
+			var serializer = Create();
+			const int count = 100;
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					for (int i = 0; i < count; ++i)
+					{
+						writer.WriteArgument(new FieldInt32 {Value = i});
+						writer.WriteArgument(new FieldString {Value = i.ToString()});
+					}
+				}
+
+				var typeNameLength = typeof(FieldInt32).AssemblyQualifiedName.Length +
+				                     typeof(FieldString).AssemblyQualifiedName.Length;
+				stream.Length.Should().BeLessThan(typeNameLength * 2,
+				                                  "because each type name should've been written only once");
+
+				stream.Position = 0;
+				using (var reader = CreateMethodCallReader(serializer, stream))
+				{
+					for (int i = 0; i < count; ++i)
+					{
+						object value;
+						reader.ReadNextArgument(out value).Should().BeTrue();
+						value.Should().Be(new FieldInt32 {Value = i});
+
+						reader.ReadNextArgument(out value).Should().BeTrue();
+						value.Should().Be(new FieldString {Value = i.ToString()});
+					}
+				}
+			}
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Measures the size and deserialization time of a message with many polymorphic objects of the same type")]
+		public void TestMethodCallManyObjectsPerformance()
+		{
+			var serializer = Create();
+			const int count = 10000;
+			serializer.RegisterType<FieldInt32>();
+
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					for (int i = 0; i < count; ++i)
+						writer.WriteArgument(new FieldInt32 {Value = i});
+				}
+
+				// Without a type table, every object would be preceded by its type's full name
+				// (plus a length prefix and a null marker).
+				var typeNameLength = Encoding.UTF8.GetByteCount(typeof(FieldInt32).AssemblyQualifiedName);
+				var lengthWithoutTypeTable = stream.Length + (long) (count - 1) * (typeNameLength + 2);
+				Console.WriteLine("{0} objects: {1} bytes (would be {2} bytes if every object was written with its type's name)",
+				                  count,
+				                  stream.Length,
+				                  lengthWithoutTypeTable);
+
+				const int numRepetitions = 100;
+				var sw = Stopwatch.StartNew();
+				for (int n = 0; n < numRepetitions; ++n)
+				{
+					stream.Position = 0;
+					using (var reader = CreateMethodCallReader(serializer, stream))
+					{
+						object value;
+						while (reader.ReadNextArgument(out value))
+						{
+						}
+					}
+				}
+				sw.Stop();
+				Console.WriteLine("Deserialization: {0:F2}ms per message", sw.Elapsed.TotalMilliseconds / numRepetitions);
+			}
+		}
+
+		[Test]
+		[Description("Verifies that many threads may serialize a previously unknown type at the same time")]
+		public void TestMethodCallConcurrentFirstUse()
+		{
+			var serializer = Create();
+			const int numThreads = 16;
+			using (var barrier = new Barrier(numThreads))
+			{
+				var tasks = Enumerable.Range(0, numThreads).Select(n => Task.Factory.StartNew(() =>
+				{
+					barrier.SignalAndWait();
+					using (var stream = new MemoryStream())
+					{
+						using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+						{
+							writer.WriteArgument(new FieldInt32 {Value = n});
+						}
+
+						stream.Position = 0;
+						using (var reader = CreateMethodCallReader(serializer, stream))
+						{
+							object value;
+							reader.ReadNextArgument(out value).Should().BeTrue();
+							return value;
+						}
+					}
+				}, TaskCreationOptions.LongRunning)).ToArray();
+
+				Task.WaitAll(tasks);
+				for (int n = 0; n < numThreads; ++n)
+				{
+					tasks[n].Result.Should().BeOfType<FieldInt32>();
+					((FieldInt32) tasks[n].Result).Value.Should().Be(n);
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that different [ByReference] implementations of the same interface can be serialized without registering the interface first")]
+		public void TestMethodCallByReferenceImplementations()
+		{
+			var serializer = Create();
+			var first = new ByReferenceClass(1);
+			var second = new ByReferenceClass2(2);
+
+			var endPoint = new Mock<IRemotingEndPoint>();
+			endPoint.Setup(x => x.GetExistingOrCreateNewServant<IByReferenceType>(It.IsAny<IByReferenceType>()))
+			        .Returns((IByReferenceType subject) =>
+			        {
+				        var servant = new Mock<IServant>();
+				        servant.Setup(x => x.ObjectId).Returns((ulong) subject.Value);
+				        return servant.Object;
+			        });
+
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo", endPoint.Object))
+				{
+					writer.WriteArgument((object) first);
+					writer.WriteArgument((object) second);
+					writer.WriteArgument((object) first);
+				}
+			}
+
+			endPoint.Verify(x => x.GetExistingOrCreateNewServant<IByReferenceType>(first), Times.Exactly(2));
+			endPoint.Verify(x => x.GetExistingOrCreateNewServant<IByReferenceType>(second), Times.Once);
+
+			new Action(() => serializer.RegisterType<IByReferenceType>())
+				.Should().NotThrow("because the interface has been registered along with its first implementation");
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Measures how well serialization of polymorphic objects scales with the number of threads")]
+		public void TestMethodCallMultiThreadedPerformance()
+		{
+			var serializer = Create();
+			serializer.RegisterType<FieldInt32>();
+
+			const int numMessagesPerThread = 2000;
+			const int numArguments = 100;
+			foreach (var numThreads in new[] {1, 2, 4, 8, 16, 32})
+			{
+				using (var barrier = new Barrier(numThreads + 1))
+				{
+					var threads = Enumerable.Range(0, numThreads).Select(unused => new Thread(() =>
+					{
+						using (var stream = new MemoryStream())
+						{
+							barrier.SignalAndWait();
+							for (int n = 0; n < numMessagesPerThread; ++n)
+							{
+								stream.SetLength(0);
+								using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+								{
+									for (int i = 0; i < numArguments; ++i)
+										writer.WriteArgument((object) new FieldInt32 {Value = i});
+								}
+							}
+						}
+					})).ToList();
+
+					foreach (var thread in threads)
+						thread.Start();
+
+					barrier.SignalAndWait();
+					var sw = Stopwatch.StartNew();
+					foreach (var thread in threads)
+						thread.Join();
+					sw.Stop();
+
+					var numMessages = numThreads * numMessagesPerThread;
+					Console.WriteLine("{0} thread(s): {1:F0} messages/s",
+					                  numThreads,
+					                  numMessages / sw.Elapsed.TotalSeconds);
+				}
+			}
+		}
+
+		[Test]
+		public void TestChooseIntegerEncoding()
+		{
+			BinarySerializer2.ChooseIntegerEncoding(IntegerEncoding.None, IntegerEncoding.None).Should().Be(IntegerEncoding.Fixed,
+				"because endpoints which don't know about integer encodings only support fixed size integers");
+			BinarySerializer2.ChooseIntegerEncoding(IntegerEncoding.Fixed, IntegerEncoding.Fixed | IntegerEncoding.Varint).Should().Be(IntegerEncoding.Fixed);
+			BinarySerializer2.ChooseIntegerEncoding(IntegerEncoding.Fixed | IntegerEncoding.Varint, IntegerEncoding.None).Should().Be(IntegerEncoding.Fixed);
+			BinarySerializer2.ChooseIntegerEncoding(IntegerEncoding.Fixed | IntegerEncoding.Varint, IntegerEncoding.Fixed | IntegerEncoding.Varint).Should().Be(IntegerEncoding.Varint);
+			BinarySerializer2.ChooseIntegerEncoding(IntegerEncoding.Varint, IntegerEncoding.Varint).Should().Be(IntegerEncoding.Varint);
+		}
+
+		[Test]
+		public void TestCtorInvalidIntegerEncoding()
+		{
+			new Action(() => new BinarySerializer2(_module, null, IntegerEncoding.None))
+				.Should().Throw<ArgumentException>();
+			new Action(() => new BinarySerializer2(_module, null, IntegerEncoding.Fixed | IntegerEncoding.Varint))
+				.Should().Throw<ArgumentException>();
+		}
+
+		[Test]
+		[Description("Verifies that integer arguments survive a roundtrip when they're encoded as varints")]
+		public void TestMethodCallVarintArguments()
+		{
+			var serializer = new BinarySerializer2(_module, null, IntegerEncoding.Varint);
+			serializer.IntegerEncoding.Should().Be(IntegerEncoding.Varint);
+
+			var ints = new[] {0, 1, -1, 63, -64, 64, -65, int.MaxValue, int.MinValue};
+			var uints = new[] {0u, 1u, 127u, 128u, uint.MaxValue};
+			var longs = new[] {0L, 1L, -1L, int.MaxValue + 1L, int.MinValue - 1L, long.MaxValue, long.MinValue};
+			var ulongs = new[] {0UL, 127UL, 128UL, uint.MaxValue + 1UL, ulong.MaxValue};
+
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					foreach (var value in ints)
+						writer.WriteArgument(value);
+					foreach (var value in uints)
+						writer.WriteArgument(value);
+					foreach (var value in longs)
+						writer.WriteArgument(value);
+					foreach (var value in ulongs)
+						writer.WriteArgument(value);
+				}
+
+				stream.Position = 0;
+				using (var reader = CreateMethodCallReader(serializer, stream))
+				{
+					foreach (var value in ints)
+					{
+						int actualValue;
+						reader.ReadNextArgumentAsInt32(out actualValue).Should().BeTrue();
+						actualValue.Should().Be(value);
+					}
+					foreach (var value in uints)
+					{
+						uint actualValue;
+						reader.ReadNextArgumentAsUInt32(out actualValue).Should().BeTrue();
+						actualValue.Should().Be(value);
+					}
+					foreach (var value in longs)
+					{
+						long actualValue;
+						reader.ReadNextArgumentAsInt64(out actualValue).Should().BeTrue();
+						actualValue.Should().Be(value);
+					}
+					foreach (var value in ulongs)
+					{
+						ulong actualValue;
+						reader.ReadNextArgumentAsUInt64(out actualValue).Should().BeTrue();
+						actualValue.Should().Be(value);
+					}
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that varints which don't fit into their type are rejected instead of being silently truncated")]
+		public void TestReadMalformedVarint()
+		{
+			ReadVarint(BinarySerializer2.ReadVarintAsUInt32, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F).Should().Be(uint.MaxValue);
+			new Action(() => ReadVarint(BinarySerializer2.ReadVarintAsUInt32, 0xFF, 0xFF, 0xFF, 0xFF, 0x10))
+				.Should().Throw<SerializationException>();
+			new Action(() => ReadVarint(BinarySerializer2.ReadVarintAsUInt32, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00))
+				.Should().Throw<SerializationException>();
+
+			ReadVarint(BinarySerializer2.ReadVarintAsUInt64, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01).Should().Be(ulong.MaxValue);
+			new Action(() => ReadVarint(BinarySerializer2.ReadVarintAsUInt64, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02))
+				.Should().Throw<SerializationException>();
+			new Action(() => ReadVarint(BinarySerializer2.ReadVarintAsUInt64, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00))
+				.Should().Throw<SerializationException>();
+		}
+
+		private static T ReadVarint<T>(Func<BinaryReader, T> read, params byte[] data)
+		{
+			using (var reader = new BinaryReader(new MemoryStream(data)))
+			{
+				return read(reader);
+			}
+		}
+
+		[Test]
+		[Description("Verifies that integer and enum fields of data contracts survive a roundtrip when they're encoded as varints")]
+		public void TestMethodCallVarintDataContracts()
+		{
+			var serializer = new BinarySerializer2(_module, null, IntegerEncoding.Varint);
+			var values = new object[]
+			{
+				new FieldInt32 {Value = -42},
+				new FieldInt32 {Value = int.MinValue},
+				new FieldUInt32 {Value = uint.MaxValue},
+				new FieldInt32Enum {Value = Int32Enum.B},
+				new FieldUInt32Enum {Value = UInt32Enum.C},
+				new FieldStruct {A = 1.5, B = 300, C = "Foo"}
+			};
+
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					foreach (var value in values)
+						writer.WriteArgument(value);
+				}
+
+				stream.Position = 0;
+				using (var reader = CreateMethodCallReader(serializer, stream))
+				{
+					foreach (var value in values)
+					{
+						object actualValue;
+						reader.ReadNextArgument(out actualValue).Should().BeTrue();
+						actualValue.Should().Be(value);
+					}
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that small integers occupy less space when they're encoded as varints")]
+		public void TestMethodCallVarintSize()
+		{
+			var fixedLength = WriteInt32Arguments(Create(), 1000, 100);
+			var varintLength = WriteInt32Arguments(new BinarySerializer2(_module, null, IntegerEncoding.Varint), 1000, 100);
+			varintLength.Should().BeLessThan(fixedLength - 1000 * 2,
+				"because every small integer should've occupied one byte instead of four");
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Compares size and speed of integer heavy messages between fixed size and varint encoded integers")]
+		public void TestMethodCallIntegerEncodingPerformance()
+		{
+			const int count = 10000;
+			foreach (var serializer in new[] {(BinarySerializer2) Create(), new BinarySerializer2(_module, null, IntegerEncoding.Varint)})
+			{
+				serializer.RegisterType<FieldInt32>();
+
+				using (var stream = new MemoryStream())
+				{
+					const int numRepetitions = 100;
+					var sw = Stopwatch.StartNew();
+					for (int n = 0; n < numRepetitions; ++n)
+					{
+						stream.SetLength(0);
+						using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+						{
+							for (int i = 0; i < count; ++i)
+								writer.WriteArgument(new FieldInt32 {Value = i});
+						}
+					}
+					var serializationTime = sw.Elapsed;
+
+					sw.Restart();
+					for (int n = 0; n < numRepetitions; ++n)
+					{
+						stream.Position = 0;
+						using (var reader = CreateMethodCallReader(serializer, stream))
+						{
+							object value;
+							while (reader.ReadNextArgument(out value))
+							{
+							}
+						}
+					}
+					var deserializationTime = sw.Elapsed;
+
+					Console.WriteLine("{0}: {1} bytes, serialization: {2:F2}ms, deserialization: {3:F2}ms per message",
+					                  serializer.IntegerEncoding,
+					                  stream.Length,
+					                  serializationTime.TotalMilliseconds / numRepetitions,
+					                  deserializationTime.TotalMilliseconds / numRepetitions);
+				}
+			}
+		}
+
+		[Test]
+		public void TestChooseStringEncoding()
+		{
+			BinarySerializer2.ChooseStringEncoding(StringEncoding.None, StringEncoding.None).Should().Be(StringEncoding.Inline,
+				"because endpoints which don't know about string encodings only support inline strings");
+			BinarySerializer2.ChooseStringEncoding(StringEncoding.Inline, StringEncoding.Inline | StringEncoding.Table).Should().Be(StringEncoding.Inline);
+			BinarySerializer2.ChooseStringEncoding(StringEncoding.Inline | StringEncoding.Table, StringEncoding.None).Should().Be(StringEncoding.Inline);
+			BinarySerializer2.ChooseStringEncoding(StringEncoding.Inline | StringEncoding.Table, StringEncoding.Inline | StringEncoding.Table).Should().Be(StringEncoding.Table);
+		}
+
+		[Test]
+		public void TestCtorInvalidStringEncoding()
+		{
+			new Action(() => new BinarySerializer2(_module, null, IntegerEncoding.Fixed, StringEncoding.None))
+				.Should().Throw<ArgumentException>();
+			new Action(() => new BinarySerializer2(_module, null, IntegerEncoding.Fixed, StringEncoding.Inline | StringEncoding.Table))
+				.Should().Throw<ArgumentException>();
+		}
+
+		[Test]
+		[Description("Verifies that strings survive a roundtrip when they're written to a string table and that repeated strings are deserialized into the same instance")]
+		public void TestMethodCallStringTableArguments()
+		{
+			var serializer = new BinarySerializer2(_module, null, IntegerEncoding.Fixed, StringEncoding.Table);
+			serializer.StringEncoding.Should().Be(StringEncoding.Table);
+
+			var strings = new[] {"Completed", null, "", "Completed", "Pending", "", "Pending", null};
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					foreach (var value in strings)
+						writer.WriteArgument(value);
+					writer.WriteArgument(new FieldString {Value = "Completed"});
+					writer.WriteArgument((object) "Pending");
+				}
+
+				stream.Position = 0;
+				using (var reader = CreateMethodCallReader(serializer, stream))
+				{
+					var actualStrings = new string[strings.Length];
+					for (int i = 0; i < strings.Length; ++i)
+						reader.ReadNextArgumentAsString(out actualStrings[i]).Should().BeTrue();
+					actualStrings.Should().Equal(strings);
+					actualStrings[3].Should().BeSameAs(actualStrings[0]);
+					actualStrings[6].Should().BeSameAs(actualStrings[4]);
+
+					object value;
+					reader.ReadNextArgument(out value).Should().BeTrue();
+					((FieldString) value).Value.Should().BeSameAs(actualStrings[0]);
+					reader.ReadNextArgument(out value).Should().BeTrue();
+					value.Should().BeSameAs(actualStrings[4]);
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that strings beyond the capacity of the string table are still written (in full) and read correctly")]
+		public void TestMethodCallStringTableOverflow()
+		{
+			var serializer = new BinarySerializer2(_module, null, IntegerEncoding.Fixed, StringEncoding.Table);
+			var strings = Enumerable.Range(0, BinaryMessageWriter.MaxStringTableSize + 100)
+			                        .Select(i => i.ToString())
+			                        .ToList();
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					foreach (var value in strings.Concat(strings))
+						writer.WriteArgument(value);
+				}
+
+				stream.Position = 0;
+				using (var reader = CreateMethodCallReader(serializer, stream))
+				{
+					foreach (var expected in strings.Concat(strings))
+					{
+						string value;
+						reader.ReadNextArgumentAsString(out value).Should().BeTrue();
+						value.Should().Be(expected);
+					}
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that repeated strings occupy less space when they're written to a string table")]
+		public void TestMethodCallStringTableSize()
+		{
+			var inlineLength = WriteStringArguments(Create(), 1000);
+			var tableLength = WriteStringArguments(new BinarySerializer2(_module, null, IntegerEncoding.Fixed, StringEncoding.Table), 1000);
+			tableLength.Should().BeLessThan(inlineLength / 5,
+				"because every repeated string should've occupied one byte instead of its full length");
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Compares size, speed and retained memory of messages with many repeated strings between inline strings and a string table")]
+		public void TestMethodCallStringEncodingPerformance()
+		{
+			const int count = 50000;
+			var statuses = new[] {"Completed", "Pending", "Failed", "Cancelled"};
+			foreach (var serializer in new[] {(BinarySerializer2) Create(), new BinarySerializer2(_module, null, IntegerEncoding.Fixed, StringEncoding.Table)})
+			{
+				serializer.RegisterType<FieldString>();
+
+				using (var stream = new MemoryStream())
+				{
+					const int numRepetitions = 10;
+					var sw = Stopwatch.StartNew();
+					for (int n = 0; n < numRepetitions; ++n)
+					{
+						stream.SetLength(0);
+						using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+						{
+							for (int i = 0; i < count; ++i)
+								writer.WriteArgument(new FieldString {Value = statuses[i % statuses.Length]});
+						}
+					}
+					var serializationTime = sw.Elapsed;
+
+					var values = new object[count];
+					var memoryBefore = GC.GetTotalMemory(forceFullCollection: true);
+					sw.Restart();
+					for (int n = 0; n < numRepetitions; ++n)
+					{
+						stream.Position = 0;
+						using (var reader = CreateMethodCallReader(serializer, stream))
+						{
+							for (int i = 0; i < count; ++i)
+								reader.ReadNextArgument(out values[i]);
+						}
+					}
+					var deserializationTime = sw.Elapsed;
+					var retainedMemory = GC.GetTotalMemory(forceFullCollection: true) - memoryBefore;
+					GC.KeepAlive(values);
+
+					Console.WriteLine("{0}: {1} bytes, serialization: {2:F2}ms, deserialization: {3:F2}ms per message, {4} bytes retained by the deserialized values",
+					                  serializer.StringEncoding,
+					                  stream.Length,
+					                  serializationTime.TotalMilliseconds / numRepetitions,
+					                  deserializationTime.TotalMilliseconds / numRepetitions,
+					                  retainedMemory);
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that an object which is referenced multiple times is written once and deserialized into one instance")]
+		public void TestRoundtripSharedReference()
+		{
+			var shared = new SharedTreeNode {Value = 42};
+			var root = new SharedTreeNode {Left = shared, Right = shared, Value = 1};
+
+			var actual = Roundtrip(root);
+			actual.Value.Should().Be(1);
+			actual.Left.Should().NotBeNull();
+			actual.Left.Value.Should().Be(42);
+			actual.Right.Should().BeSameAs(actual.Left);
+		}
+
+		[Test]
+		[Description("Verifies that cyclic object graphs can be serialized when their types preserve references")]
+		public void TestRoundtripCycle()
+		{
+			var root = new SharedTreeNode {Value = 1};
+			var child = new SharedTreeNode {Value = 2, Left = root};
+			root.Left = root;
+			root.Right = child;
+
+			var actual = Roundtrip(root);
+			actual.Left.Should().BeSameAs(actual);
+			actual.Right.Value.Should().Be(2);
+			actual.Right.Left.Should().BeSameAs(actual);
+		}
+
+		[Test]
+		[Description("Verifies that references are preserved across the arguments of the same method call")]
+		public void TestMethodCallSharedReferenceArguments()
+		{
+			var serializer = Create();
+			var shared = new SharedTreeNode {Value = 3};
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					writer.WriteArgument(shared);
+					writer.WriteArgument(new SharedTreeNode {Left = shared});
+					writer.WriteArgument(shared);
+				}
+
+				stream.Position = 0;
+				using (var reader = CreateMethodCallReader(serializer, stream))
+				{
+					object first, second, third;
+					reader.ReadNextArgument(out first).Should().BeTrue();
+					reader.ReadNextArgument(out second).Should().BeTrue();
+					reader.ReadNextArgument(out third).Should().BeTrue();
+
+					first.Should().BeOfType<SharedTreeNode>();
+					((SharedTreeNode) first).Value.Should().Be(3);
+					((SharedTreeNode) second).Left.Should().BeSameAs(first);
+					third.Should().BeSameAs(first);
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that references are not preserved across messages")]
+		public void TestMethodCallSharedReferenceIsWrittenOncePerMessage()
+		{
+			var serializer = Create();
+			var shared = new SharedTreeNode {Value = 3};
+
+			var first = WriteArguments(serializer, shared, shared);
+			var second = WriteArguments(serializer, shared, shared);
+			second.Should().Be(first, "because the second message mustn't refer to objects of the first");
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Measures the size and time needed to serialize a graph in which every node is shared by two parents")]
+		public void TestSharedReferencePerformance()
+		{
+			const int depth = 16;
+			var serializer = (BinarySerializer2) Create();
+
+			BinaryTreeNode tree = null;
+			SharedTreeNode sharedTree = null;
+			for (int i = 0; i < depth; ++i)
+			{
+				tree = new BinaryTreeNode {Left = tree, Right = tree, Value = i};
+				sharedTree = new SharedTreeNode {Left = sharedTree, Right = sharedTree, Value = i};
+			}
+
+			var treeTime = Measure(serializer, tree);
+			var sharedTreeTime = Measure(serializer, sharedTree);
+
+			Console.WriteLine("{0} nodes, {1} distinct", (1 << depth) - 1, depth);
+			Console.WriteLine("By value:  {0} bytes, {1:F3}ms per roundtrip",
+			                  serializer.SerializeWithoutTypeInformation(tree).Length,
+			                  treeTime.TotalMilliseconds);
+			Console.WriteLine("Reference: {0} bytes, {1:F3}ms per roundtrip",
+			                  serializer.SerializeWithoutTypeInformation(sharedTree).Length,
+			                  sharedTreeTime.TotalMilliseconds);
+		}
+
+		[Test]
+		[Description("Verifies that struct arguments written without boxing can be read with and without boxing")]
+		public void TestMethodCallStructArguments()
+		{
+			var serializer = Create();
+			var value = new FieldVector3 {X = 1, Y = -2, Z = Math.PI};
+
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					writer.WriteArgument(value);
+					writer.WriteArgument(value);
+					writer.WriteArgument((object) value);
+					writer.WriteArgument(Int32Enum.C);
+				}
+
+				stream.Position = 0;
+				using (var reader = CreateMethodCallReader(serializer, stream))
+				{
+					FieldVector3 actualValue;
+					object actualObject;
+					Int32Enum actualEnum;
+					reader.ReadNextArgumentAsStruct(out actualValue).Should().BeTrue();
+					actualValue.Should().Be(value);
+					reader.ReadNextArgument(out actualObject).Should().BeTrue();
+					actualObject.Should().Be(value);
+					reader.ReadNextArgumentAsStruct(out actualValue).Should().BeTrue();
+					actualValue.Should().Be(value);
+					reader.ReadNextArgumentAsStruct(out actualEnum).Should().BeTrue();
+					actualEnum.Should().Be(Int32Enum.C);
+					reader.ReadNextArgumentAsStruct(out actualValue).Should().BeFalse();
+				}
+			}
+		}
+
+		[Test]
+		public void TestMethodResultStruct()
+		{
+			var serializer = Create();
+			var value = new FieldVector3 {X = 1, Y = -2, Z = Math.PI};
+
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodResultWriter(stream, 1))
+				{
+					writer.WriteResult(value);
+				}
+
+				stream.Position = 0;
+				IMethodCallReader unused;
+				IMethodResultReader reader;
+				serializer.CreateMethodReader(stream, out unused, out reader);
+				using (reader)
+				{
+					FieldVector3 actualValue;
+					reader.ReadResultStruct(out actualValue).Should().BeTrue();
+					actualValue.Should().Be(value);
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that pooled data contracts are rented from the instance pool when they are read")]
+		public void TestMethodCallPooledDataContract()
+		{
+			var serializer = Create();
+			var first = ReadArgument(serializer, new PooledPacket {SequenceNumber = 1});
+			InstancePool.Return(first);
+
+			var second = ReadArgument(serializer, new PooledPacket {SequenceNumber = 2});
+			second.Should().BeSameAs(first);
+			second.SequenceNumber.Should().Be(2);
+		}
+
+		[Test]
+		[Description("Verifies that only those members of a delta encoded value are written which differ from the last snapshot")]
+		public void TestMethodCallDeltaEncodedSize()
+		{
+			var serializer = Create();
+			var quote = new DeltaQuote
+			{
+				Symbol = "MSFT",
+				Bid = 100,
+				Ask = 101,
+				Volume = 1000,
+				Time = new DateTime(2020, 1, 1, 12, 0, 0, DateTimeKind.Utc),
+				Exchange = "NASDAQ"
+			};
+
+			var snapshotLength = WriteArguments(serializer, quote);
+			var unchangedLength = WriteArguments(serializer, quote);
+			quote.Bid = 99;
+			var deltaLength = WriteArguments(serializer, quote);
+
+			unchangedLength.Should().BeLessThan(snapshotLength);
+			deltaLength.Should().Be(unchangedLength + sizeof(double), "because only the bid has changed");
+		}
+
+		[Test]
+		[Description("Verifies that every SnapshotInterval-th value is written in full")]
+		public void TestMethodCallDeltaEncodedSnapshotInterval()
+		{
+			var serializer = Create();
+			var position = new DeltaPosition {X = 1, Y = 2, Name = "Foo"};
+			var lengths = Enumerable.Range(0, 9).Select(unused => WriteArguments(serializer, position)).ToList();
+
+			lengths[4].Should().Be(lengths[0]);
+			lengths[8].Should().Be(lengths[0]);
+			lengths.Where((unused, i) => i % 4 != 0).Should().OnlyContain(x => x < lengths[0]);
+		}
+
+		[Test]
+		[Description("Verifies that values with different keys are delta encoded against their own snapshot")]
+		public void TestMethodCallDeltaEncodedKeys()
+		{
+			var serializer = Create();
+			var msft = new DeltaQuote {Symbol = "MSFT", Bid = 100, Exchange = "NASDAQ"};
+			var ibm = new DeltaQuote {Symbol = "IBM", Bid = 150, Exchange = "NYSE"};
+
+			var msftSnapshotLength = WriteArguments(serializer, msft);
+			var ibmSnapshotLength = WriteArguments(CreateOnOwnModule(), ibm);
+			WriteArguments(serializer, ibm).Should().Be(ibmSnapshotLength, "because the first IBM quote is a snapshot as well");
+
+			WriteArguments(serializer, msft).Should().BeLessThan(msftSnapshotLength);
+			WriteArguments(serializer, ibm).Should().BeLessThan(ibmSnapshotLength);
+		}
+
+		[Test]
+		[Description("Verifies that the least recently used stream is discarded once there are more than MaxStreams keys and that the receiver can still read the values of a key which is used again")]
+		public void TestMethodCallDeltaEncodedMaxStreams()
+		{
+			var sender = Create();
+			var receiver = CreateOnOwnModule();
+			var msft = new DeltaTick {Symbol = "MSFT", Price = 100};
+			var ibm = new DeltaTick {Symbol = "IBM", Price = 150};
+			var aapl = new DeltaTick {Symbol = "AAPL", Price = 300};
+
+			var snapshotLength = WriteArguments(CreateOnOwnModule(), msft);
+			DeltaRoundtrip(sender, receiver, msft).Should().Be(snapshotLength);
+			DeltaRoundtrip(sender, receiver, msft).Should().BeLessThan(snapshotLength);
+			DeltaRoundtrip(sender, receiver, ibm);
+			DeltaRoundtrip(sender, receiver, aapl);
+
+			DeltaRoundtrip(sender, receiver, msft).Should().Be(snapshotLength, "because the stream of MSFT has been discarded in favour of AAPL");
+			DeltaRoundtrip(sender, receiver, msft).Should().BeLessThan(snapshotLength);
+			msft.Price = 101;
+			DeltaRoundtrip(sender, receiver, msft);
+		}
+
+		private static long DeltaRoundtrip(ISerializer2 sender, ISerializer2 receiver, DeltaTick value)
+		{
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = sender.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					writer.WriteArgument(value);
+				}
+
+				stream.Position = 0;
+				using (var reader = CreateMethodCallReader(receiver, stream))
+				{
+					object actualValue;
+					reader.ReadNextArgument(out actualValue).Should().BeTrue();
+					actualValue.Should().BeEquivalentTo(value);
+				}
+
+				return stream.Length;
+			}
+		}
+
+		[Test]
+		[Description("Verifies that a delta can't be read by a serializer which hasn't read the snapshot it refers to")]
+		public void TestMethodCallDeltaEncodedMissingSnapshot()
+		{
+			var sender = Create();
+			var receiver = CreateOnOwnModule();
+			WriteArguments(sender, new DeltaPosition {X = 1});
+
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = sender.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					writer.WriteArgument(new DeltaPosition {X = 2});
+				}
+
+				stream.Position = 0;
+				using (var reader = CreateMethodCallReader(receiver, stream))
+				{
+					object unused;
+					new Action(() => reader.ReadNextArgument(out unused))
+						.Should().Throw<SerializationException>()
+						.WithMessage("Unable to deserialize a delta of 'SharpRemote.Test.Types.Structs.DeltaPosition': Snapshot #1 has not been received");
+				}
+			}
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Compares the size and roundtrip time of slowly changing values with and without delta encoding")]
+		public void TestMethodCallDeltaEncodedPerformance()
+		{
+			const int count = 10000;
+			var time = new DateTime(2020, 1, 1, 12, 0, 0, DateTimeKind.Utc);
+
+			foreach (var deltaEncoded in new[] {false, true})
+			{
+				var serializer = Create();
+				var values = Enumerable.Range(0, count).Select(i => deltaEncoded
+					? (object) new DeltaQuote {Symbol = "MSFT", Bid = 100 + i % 3, Ask = 101, Volume = 1000, Time = time, Exchange = "NASDAQ"}
+					: new Quote {Symbol = "MSFT", Bid = 100 + i % 3, Ask = 101, Volume = 1000, Time = time, Exchange = "NASDAQ"}).ToList();
+
+				// Warmup, so that the serialization methods are compiled already
+				ReadArgument(serializer, values[0]);
+
+				long length = 0;
+				var sw = Stopwatch.StartNew();
+				using (var stream = new MemoryStream())
+				{
+					foreach (var value in values)
+					{
+						stream.SetLength(0);
+						using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+						{
+							writer.WriteArgument(value);
+						}
+						length += stream.Length;
+
+						stream.Position = 0;
+						using (var reader = CreateMethodCallReader(serializer, stream))
+						{
+							object unused;
+							reader.ReadNextArgument(out unused);
+						}
+					}
+				}
+				sw.Stop();
+
+				Console.WriteLine("{0}: {1:F1} bytes per message, {2:F2}µs per roundtrip",
+				                  deltaEncoded ? "Delta encoded" : "Plain",
+				                  (double) length / count,
+				                  sw.Elapsed.TotalMilliseconds * 1000 / count);
+			}
+		}
+
+		[Test]
+		public void TestMethodResultByteSegment()
+		{
+			var serializer = Create();
+			var bytes = Enumerable.Range(0, 100).Select(x => (byte) x).ToArray();
+
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodResultWriter(stream, 1))
+				{
+					writer.WriteResult(new ArraySegment<byte>(bytes, 40, 30));
+				}
+
+				stream.Position = 0;
+				IMethodCallReader unused;
+				IMethodResultReader reader;
+				serializer.CreateMethodReader(stream, out unused, out reader);
+				using (reader)
+				{
+					ArraySegment<byte> actualValue;
+					reader.ReadResultByteSegment(out actualValue).Should().BeTrue();
+					actualValue.Should().Equal(bytes.Skip(40).Take(30));
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that byte segments are read as slices of the message's buffer when it is accessible")]
+		public void TestMethodCallByteSegmentIsSlice()
+		{
+			var serializer = Create();
+			var bytes = Enumerable.Range(0, 100).Select(x => (byte) x).ToArray();
+
+			byte[] message;
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					writer.WriteArgument(new ArraySegment<byte>(bytes, 10, 20));
+				}
+				message = stream.ToArray();
+			}
+
+			using (var stream = new MemoryStream(message, 0, message.Length, false, true))
+			{
+				IMethodCallReader reader;
+				IMethodResultReader unused;
+				serializer.CreateMethodReader(stream, out reader, out unused);
+				using (reader)
+				{
+					ArraySegment<byte> actualValue;
+					reader.ReadNextArgumentAsByteSegment(out actualValue).Should().BeTrue();
+					actualValue.Array.Should().BeSameAs(message);
+					actualValue.Should().Equal(bytes.Skip(10).Take(20));
+				}
+			}
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Compares the amount of memory allocated per struct argument when it's written and read with and without boxing")]
+		public void TestMethodCallStructArgumentAllocations()
+		{
+			const int count = 100000;
+			var serializer = Create();
+			var value = new FieldVector3 {X = 1, Y = -2, Z = Math.PI};
+			AppDomain.MonitoringIsEnabled = true;
+
+			using (var stream = new MemoryStream(count * 64))
+			{
+				foreach (var boxed in new[] {true, false})
+				{
+					// Warmup, so that the serialization methods are compiled already
+					for (int n = 0; n < 2; ++n)
+					{
+						stream.Position = 0;
+						var allocatedBefore = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize;
+						using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+						{
+							for (int i = 0; i < count; ++i)
+							{
+								if (boxed)
+									writer.WriteArgument((object) value);
+								else
+									writer.WriteArgument(value);
+							}
+						}
+						var allocatedByWrite = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize - allocatedBefore;
+
+						stream.Position = 0;
+						allocatedBefore = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize;
+						using (var reader = CreateMethodCallReader(serializer, stream))
+						{
+							object actualObject;
+							FieldVector3 actualValue;
+							for (int i = 0; i < count; ++i)
+							{
+								if (boxed)
+									reader.ReadNextArgument(out actualObject);
+								else
+									reader.ReadNextArgumentAsStruct(out actualValue);
+							}
+						}
+						var allocatedByRead = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize - allocatedBefore;
+
+						if (n == 1)
+							Console.WriteLine("{0}: {1:F1} bytes allocated per written argument, {2:F1} bytes allocated per read argument",
+							                  boxed ? "Boxed" : "Generic",
+							                  (double) allocatedByWrite / count,
+							                  (double) allocatedByRead / count);
+					}
+				}
+			}
+		}
+
+		private static TimeSpan Measure<T>(BinarySerializer2 serializer, T value)
+		{
+			// Warmup
+			serializer.Deserialize<T>(serializer.SerializeWithoutTypeInformation(value));
+
+			const int numRepetitions = 100;
+			var sw = Stopwatch.StartNew();
+			for (int i = 0; i < numRepetitions; ++i)
+				serializer.Deserialize<T>(serializer.SerializeWithoutTypeInformation(value));
+			sw.Stop();
+			return TimeSpan.FromTicks(sw.Elapsed.Ticks / numRepetitions);
+		}
+
+		private static T ReadArgument<T>(ISerializer2 serializer, T value)
+		{
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					writer.WriteArgument(value);
+				}
+
+				stream.Position = 0;
+				IMethodCallReader reader;
+				IMethodResultReader unused;
+				serializer.CreateMethodReader(stream, out reader, out unused);
+				using (reader)
+				{
+					object actualValue;
+					reader.ReadNextArgument(out actualValue).Should().BeTrue();
+					return (T) actualValue;
+				}
+			}
+		}
+
+		private static long WriteArguments(ISerializer2 serializer, params object[] arguments)
+		{
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					foreach (var argument in arguments)
+						writer.WriteArgument(argument);
+				}
+				return stream.Length;
+			}
+		}
+
+		private static long WriteInt32Arguments(ISerializer2 serializer, int count, int maxValue)
+		{
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					for (int i = 0; i < count; ++i)
+						writer.WriteArgument(i % maxValue - maxValue / 2);
+				}
+				return stream.Length;
+			}
+		}
+
+		private static long WriteStringArguments(ISerializer2 serializer, int count)
+		{
+			var statuses = new[] {"Completed", "Pending", "Failed", "Cancelled"};
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					for (int i = 0; i < count; ++i)
+						writer.WriteArgument(statuses[i % statuses.Length]);
+				}
+				return stream.Length;
+			}
+		}
+
+		private static IMethodCallReader CreateMethodCallReader(ISerializer2 serializer, Stream stream)
+		{
+			IMethodCallReader callReader;
+			IMethodResultReader unused;
+			serializer.CreateMethodReader(stream, out callReader, out unused);
+			return callReader;
+		}
+
 		private T Roundtrip<T>(T message)
 		{
 			var serializer = (BinarySerializer2)Create();
@@ -0,0 +1,265 @@
+﻿using System;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Reflection.Emit;
+using System.Text;
+using FluentAssertions;
+using NUnit.Framework;
+using SharpRemote.CodeGeneration.Serialization.Binary;
+using SharpRemote.Test.Types.Structs;
+
+namespace SharpRemote.Test.CodeGeneration.Serialization.Binary
+{
+	[TestFixture]
+	public sealed class BufferedBinarySerializerAcceptanceTest
+		: AbstractSerializerAcceptanceTest
+	{
+		private AssemblyBuilder _assembly;
+		private ModuleBuilder _module;
+
+		[SetUp]
+		public void Setup()
+		{
+			var assemblyName = new AssemblyName("SharpRemote.GeneratedCode.Serializer");
+			_assembly = AssemblyBuilder.DefineDynamicAssembly(assemblyName, AssemblyBuilderAccess.RunAndSave);
+			string moduleName = assemblyName.Name + ".dll";
+			_module = _assembly.DefineDynamicModule(moduleName);
+		}
+
+		protected override ISerializer2 Create()
+		{
+			return new BufferedBinarySerializer2(_module);
+		}
+
+		protected override void Save()
+		{
+			var fname = "SharpRemote.GeneratedCode.Serializer.dll";
+			try
+			{
+				_assembly.Save(fname);
+				TestContext.Out.WriteLine("Assembly written to: {0}", Path.Combine(Directory.GetCurrentDirectory(), fname));
+			}
+			catch (Exception e)
+			{
+				TestContext.Out.WriteLine("Couldn't write assembly: {0}", e);
+			}
+		}
+
+		[Test]
+		[Description("Verifies that the buffered writer encodes every value exactly like a BinaryWriter does")]
+		public void TestWriterCompatibility()
+		{
+			using (var expected = new MemoryStream())
+			using (var actual = new MemoryStream())
+			{
+				using (var writer = new BinaryWriter(expected, Encoding.UTF8, true))
+					WriteValues(writer);
+				using (var writer = new BufferedBinaryMessageWriter(actual))
+					WriteValues(writer);
+
+				actual.ToArray().Should().Equal(expected.ToArray());
+			}
+		}
+
+		[Test]
+		[Description("Verifies that the buffered reader decodes every value exactly like a BinaryReader does")]
+		public void TestReaderCompatibility()
+		{
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = new BinaryWriter(stream, Encoding.UTF8, true))
+					WriteValues(writer);
+
+				stream.Position = 0;
+				using (var reader = new BufferedBinaryMessageReader(stream))
+				{
+					reader.ReadBoolean().Should().BeTrue();
+					reader.ReadByte().Should().Be(byte.MaxValue);
+					reader.ReadSByte().Should().Be(sbyte.MinValue);
+					reader.ReadInt16().Should().Be(short.MinValue);
+					reader.ReadUInt16().Should().Be(ushort.MaxValue);
+					reader.ReadInt32().Should().Be(-42);
+					reader.ReadUInt32().Should().Be(uint.MaxValue);
+					reader.ReadInt64().Should().Be(long.MinValue);
+					reader.ReadUInt64().Should().Be(0x0102030405060708UL);
+					reader.ReadSingle().Should().Be((float) Math.PI);
+					reader.ReadDouble().Should().Be(Math.E);
+					reader.ReadDecimal().Should().Be(-79228162514264337593543950335m);
+					reader.ReadDecimal().Should().Be(0.0001m);
+					reader.ReadString().Should().Be("");
+					reader.ReadString().Should().Be("Grüße ☃");
+					reader.ReadString().Should().Be(new string('a', 1000));
+					reader.ReadBytes(3).Should().Equal(1, 2, 3);
+					reader.EndOfMessage.Should().BeTrue();
+
+					new Action(() => reader.ReadByte()).Should().Throw<EndOfStreamException>();
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that a message which exceeds the initial size of the buffer can be written and read again")]
+		public void TestMethodCallLargeArguments()
+		{
+			var serializer = Create();
+			var bytes = new byte[100000];
+			new Random(42).NextBytes(bytes);
+			var text = new string('x', 50000);
+
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					writer.WriteArgument(bytes);
+					writer.WriteArgument(text);
+					writer.WriteArgument(42);
+				}
+
+				stream.Position = 0;
+				IMethodCallReader reader;
+				IMethodResultReader unused;
+				serializer.CreateMethodReader(stream, out reader, out unused);
+				using (reader)
+				{
+					byte[] actualBytes;
+					reader.ReadNextArgumentAsBytes(out actualBytes).Should().BeTrue();
+					actualBytes.Should().Equal(bytes);
+
+					string actualText;
+					reader.ReadNextArgumentAsString(out actualText).Should().BeTrue();
+					actualText.Should().Be(text);
+
+					int actualValue;
+					reader.ReadNextArgumentAsInt32(out actualValue).Should().BeTrue();
+					actualValue.Should().Be(42);
+
+					object value;
+					reader.ReadNextArgument(out value).Should().BeFalse();
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that byte segments are read as slices of the reader's buffer instead of being copied")]
+		public void TestMethodCallByteSegmentIsSlice()
+		{
+			var serializer = Create();
+			var bytes = Enumerable.Range(0, 100).Select(x => (byte) x).ToArray();
+
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					writer.WriteArgument(new ArraySegment<byte>(bytes, 10, 20));
+				}
+
+				stream.Position = 0;
+				IMethodCallReader reader;
+				IMethodResultReader unused;
+				serializer.CreateMethodReader(stream, out reader, out unused);
+				using (reader)
+				{
+					ArraySegment<byte> actualValue;
+					reader.ReadNextArgumentAsByteSegment(out actualValue).Should().BeTrue();
+					actualValue.Should().Equal(bytes.Skip(10).Take(20));
+					actualValue.Offset.Should().BeGreaterThan(0, "because the segment should point into the message instead of being a copy");
+				}
+			}
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Compares the time it takes to encode and decode method calls between BinarySerializer2 and BufferedBinarySerializer2")]
+		public void TestMethodCallPerformance()
+		{
+			Measure(new BinarySerializer2());
+			Measure(Create());
+		}
+
+		private static void Measure(ISerializer2 serializer)
+		{
+			const int numArguments = 100;
+			const int numRepetitions = 10000;
+			serializer.RegisterType<FieldStruct>();
+
+			using (var stream = new MemoryStream())
+			{
+				var sw = Stopwatch.StartNew();
+				for (int n = 0; n < numRepetitions; ++n)
+				{
+					stream.SetLength(0);
+					using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+					{
+						for (int i = 0; i < numArguments; ++i)
+						{
+							writer.WriteArgument(i);
+							writer.WriteArgument(i * Math.PI);
+							writer.WriteArgument(new FieldStruct {A = i, B = i, C = "Foo"});
+						}
+					}
+				}
+				var encodingTime = sw.Elapsed;
+
+				sw.Restart();
+				for (int n = 0; n < numRepetitions; ++n)
+				{
+					stream.Position = 0;
+					IMethodCallReader reader;
+					IMethodResultReader unused;
+					serializer.CreateMethodReader(stream, out reader, out unused);
+					using (reader)
+					{
+						for (int i = 0; i < numArguments; ++i)
+						{
+							int intValue;
+							reader.ReadNextArgumentAsInt32(out intValue);
+							double doubleValue;
+							reader.ReadNextArgumentAsDouble(out doubleValue);
+							object value;
+							reader.ReadNextArgument(out value);
+						}
+					}
+				}
+				var decodingTime = sw.Elapsed;
+
+				Console.WriteLine("{0}: {1} bytes, encoding: {2:F1}µs, decoding: {3:F1}µs per message",
+				                  serializer.GetType().Name,
+				                  stream.Length,
+				                  encodingTime.TotalMilliseconds * 1000 / numRepetitions,
+				                  decodingTime.TotalMilliseconds * 1000 / numRepetitions);
+			}
+		}
+
+		private static void WriteValues(BinaryWriter writer)
+		{
+			writer.Write(true);
+			writer.Write(byte.MaxValue);
+			writer.Write(sbyte.MinValue);
+			writer.Write(short.MinValue);
+			writer.Write(ushort.MaxValue);
+			writer.Write(-42);
+			writer.Write(uint.MaxValue);
+			writer.Write(long.MinValue);
+			writer.Write(0x0102030405060708UL);
+			writer.Write((float) Math.PI);
+			writer.Write(Math.E);
+			writer.Write(-79228162514264337593543950335m);
+			writer.Write(0.0001m);
+			writer.Write("");
+			writer.Write("Grüße ☃");
+			writer.Write(new string('a', 1000));
+			writer.Write(new byte[] {1, 2, 3});
+		}
+
+		protected override string Format(MemoryStream stream)
+		{
+			var value = stream.ToArray();
+			var stringBuilder = new StringBuilder(value.Length * 2);
+			foreach (var b in value)
+				stringBuilder.AppendFormat("{0:x2}", b);
+			return stringBuilder.ToString();
+		}
+	}
+}
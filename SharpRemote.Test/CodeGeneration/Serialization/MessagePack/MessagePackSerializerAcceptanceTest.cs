@@ -0,0 +1,289 @@
+﻿using System;
+using System.Diagnostics;
+using System.IO;
+using System.Reflection;
+using System.Reflection.Emit;
+using System.Runtime.Serialization;
+using System.Text;
+using FluentAssertions;
+using NUnit.Framework;
+using SharpRemote.Test.Types.Structs;
+
+namespace SharpRemote.Test.CodeGeneration.Serialization.MessagePack
+{
+	[TestFixture]
+	public sealed class MessagePackSerializerAcceptanceTest
+		: AbstractSerializerAcceptanceTest
+	{
+		private AssemblyBuilder _assembly;
+		private ModuleBuilder _module;
+
+		[SetUp]
+		public void Setup()
+		{
+			var assemblyName = new AssemblyName("SharpRemote.GeneratedCode.Serializer");
+			_assembly = AssemblyBuilder.DefineDynamicAssembly(assemblyName, AssemblyBuilderAccess.RunAndSave);
+			string moduleName = assemblyName.Name + ".dll";
+			_module = _assembly.DefineDynamicModule(moduleName);
+		}
+
+		protected override ISerializer2 Create()
+		{
+			return new MessagePackSerializer(_module);
+		}
+
+		protected override void Save()
+		{
+			var fname = "SharpRemote.GeneratedCode.Serializer.dll";
+			try
+			{
+				_assembly.Save(fname);
+				TestContext.Out.WriteLine("Assembly written to: {0}", Path.Combine(Directory.GetCurrentDirectory(), fname));
+			}
+			catch (Exception e)
+			{
+				TestContext.Out.WriteLine("Couldn't write assembly: {0}", e);
+			}
+		}
+
+		[Test]
+		[Description("Verifies that a method call is written as a sequence of MessagePack objects")]
+		public void TestMethodCallWireFormat()
+		{
+			var serializer = Create();
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					writer.WriteArgument(42);
+					writer.WriteArgument(-1);
+					writer.WriteArgument(70000);
+					writer.WriteArgument("hi");
+					writer.WriteArgument((string) null);
+				}
+
+				Format(stream).Should().Be("00" + // message type (positive fixint)
+				                           "02" + // grain id (positive fixint)
+				                           "a3466f6f" + // method name (fixstr)
+				                           "01" + // rpc id (positive fixint)
+				                           "2a" + // 42 (positive fixint)
+				                           "ff" + // -1 (negative fixint)
+				                           "ce00011170" + // 70000 (uint 32)
+				                           "a26869" + // "hi" (fixstr)
+				                           "c0"); // null (nil)
+			}
+		}
+
+		[Test]
+		[Description("Verifies that the members of a struct are written as an array, in the order of their declaration")]
+		public void TestMethodCallStructWireFormat()
+		{
+			var serializer = Create();
+			serializer.RegisterType<FieldVector3>();
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					writer.WriteArgument(new FieldVector3 {X = 1, Y = 2, Z = 3});
+				}
+
+				Format(stream).Should().EndWith("93" + // fixarray of 3 members
+				                                "cb3ff0000000000000" + // 1.0 (float 64)
+				                                "cb4000000000000000" + // 2.0 (float 64)
+				                                "cb4008000000000000"); // 3.0 (float 64)
+			}
+		}
+
+		[Test]
+		[Description("Verifies that only the first occurrence of a type within a message is written by name")]
+		public void TestMethodCallRepeatedTypeWireFormat()
+		{
+			var serializer = Create();
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					writer.WriteArgument((object) "a");
+					writer.WriteArgument((object) "b");
+				}
+
+				Format(stream).Should().EndWith("92" + // fixarray of type and value
+				                                "01" + // id of the first type written as part of this message
+				                                "a162"); // "b" (fixstr)
+			}
+
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					writer.WriteArgument((object) "a");
+					writer.WriteArgument((object) "b");
+				}
+
+				stream.Position = 0;
+				using (var reader = CreateMethodCallReader(serializer, stream))
+				{
+					object value;
+					reader.ReadNextArgument(out value).Should().BeTrue();
+					value.Should().Be("a");
+					reader.ReadNextArgument(out value).Should().BeTrue();
+					value.Should().Be("b");
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that an integer which doesn't fit into the requested type isn't silently truncated")]
+		public void TestReadIntegerOutOfRange()
+		{
+			var serializer = Create();
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					writer.WriteArgument(300);
+				}
+
+				stream.Position = 0;
+				using (var reader = CreateMethodCallReader(serializer, stream))
+				{
+					byte value;
+					new Action(() => reader.ReadNextArgumentAsByte(out value))
+						.Should().Throw<SerializationException>();
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that an exception is written as a plain map of its type, message, stack trace and inner exception")]
+		public void TestExceptionWireFormat()
+		{
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = new BinaryWriter(stream, Encoding.UTF8, true))
+				{
+					MessagePackSerializer.WriteValue(writer, new Exception("Foo"));
+				}
+
+				var typeName = Format(new MemoryStream(Encoding.UTF8.GetBytes(typeof(Exception).AssemblyQualifiedName)));
+				Format(stream).Should().Be("84" + // fixmap of 4 entries
+				                           "a454797065" + // "Type"
+				                           "d9" + typeof(Exception).AssemblyQualifiedName.Length.ToString("x2") + typeName +
+				                           "a74d657373616765" + // "Message"
+				                           "a3466f6f" + // "Foo"
+				                           "aa537461636b5472616365" + // "StackTrace"
+				                           "c0" + // nil
+				                           "ae496e6e6572457863657074696f6e" + // "InnerException"
+				                           "c0"); // nil
+			}
+		}
+
+		[Test]
+		[Description("Verifies that the inner exception and the stack trace of an exception are preserved")]
+		public void TestRoundtripExceptionWithInnerException()
+		{
+			Exception original;
+			try
+			{
+				throw new InvalidOperationException("Foo", new ArgumentException("Bar"));
+			}
+			catch (Exception e)
+			{
+				original = e;
+			}
+
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = new BinaryWriter(stream, Encoding.UTF8, true))
+				{
+					MessagePackSerializer.WriteValue(writer, original);
+				}
+
+				stream.Position = 0;
+				using (var reader = new BinaryReader(stream))
+				{
+					var exception = MessagePackSerializer.ReadValueAsException(reader);
+					exception.Should().BeOfType<InvalidOperationException>();
+					exception.Message.Should().Be("Foo");
+					exception.StackTrace.Should().Contain(original.StackTrace);
+					exception.InnerException.Should().BeOfType<ArgumentException>();
+					exception.InnerException.Message.Should().Be("Bar");
+				}
+			}
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Compares size and speed of a method call between the binary, xml and MessagePack serializers")]
+		public void TestMethodCallPerformanceComparedToOtherSerializers()
+		{
+			const int count = 1000;
+			foreach (var serializer in new ISerializer2[] {new BinarySerializer2(_module), new XmlSerializer(_module), Create()})
+			{
+				serializer.RegisterType<FieldVector3>();
+
+				using (var stream = new MemoryStream())
+				{
+					const int numRepetitions = 100;
+					var sw = Stopwatch.StartNew();
+					for (int n = 0; n < numRepetitions; ++n)
+					{
+						stream.SetLength(0);
+						using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+						{
+							for (int i = 0; i < count; ++i)
+							{
+								writer.WriteArgument(i);
+								writer.WriteArgument(new FieldVector3 {X = i, Y = -i, Z = 0.5 * i});
+								writer.WriteArgument("Arg" + i);
+							}
+						}
+					}
+					var serializationTime = sw.Elapsed;
+
+					sw.Restart();
+					for (int n = 0; n < numRepetitions; ++n)
+					{
+						stream.Position = 0;
+						using (var reader = CreateMethodCallReader(serializer, stream))
+						{
+							for (int i = 0; i < count; ++i)
+							{
+								int number;
+								reader.ReadNextArgumentAsInt32(out number).Should().BeTrue();
+								FieldVector3 vector;
+								reader.ReadNextArgumentAsStruct(out vector).Should().BeTrue();
+								string text;
+								reader.ReadNextArgumentAsString(out text).Should().BeTrue();
+							}
+						}
+					}
+					var deserializationTime = sw.Elapsed;
+
+					Console.WriteLine("{0}: {1} bytes, serialization: {2:F2}ms, deserialization: {3:F2}ms per message",
+					                  serializer.GetType().Name,
+					                  stream.Length,
+					                  serializationTime.TotalMilliseconds / numRepetitions,
+					                  deserializationTime.TotalMilliseconds / numRepetitions);
+				}
+			}
+		}
+
+		private static IMethodCallReader CreateMethodCallReader(ISerializer2 serializer, Stream stream)
+		{
+			IMethodCallReader callReader;
+			IMethodResultReader unused;
+			serializer.CreateMethodReader(stream, out callReader, out unused);
+			return callReader;
+		}
+
+		protected override string Format(MemoryStream stream)
+		{
+			var value = stream.ToArray();
+			var stringBuilder = new StringBuilder(value.Length * 2);
+			foreach (var b in value)
+				stringBuilder.AppendFormat("{0:x2}", b);
+			return stringBuilder.ToString();
+		}
+	}
+}
@@ -0,0 +1,80 @@
+﻿using System;
+using FluentAssertions;
+using NUnit.Framework;
+using SharpRemote.Test.Types.Classes;
+
+namespace SharpRemote.Test.CodeGeneration.Serialization
+{
+	[TestFixture]
+	public partial class SerializationTest
+	{
+		[Test]
+		public void TestPooledRoundtrip()
+		{
+			var value = new PooledPacket {SequenceNumber = 42, Data = new byte[] {1, 2, 3}, Header = new byte[] {4}};
+			var actualValue = _serializer.Roundtrip(value);
+			actualValue.Should().NotBeSameAs(value);
+			actualValue.SequenceNumber.Should().Be(42);
+			actualValue.Data.Should().Equal(1, 2, 3);
+			actualValue.Header.Should().Equal(4);
+
+			value.Data = null;
+			value.Header = null;
+			actualValue = _serializer.Roundtrip(value);
+			actualValue.Data.Should().BeNull();
+			actualValue.Header.Should().BeNull();
+		}
+
+		[Test]
+		[Description("Verifies that an instance which has been returned to the pool is handed out by the next deserialization")]
+		public void TestPooledInstanceIsReused()
+		{
+			var value = new PooledPacket {SequenceNumber = 1, Data = new byte[] {1, 2, 3}, Header = new byte[] {4}};
+			var first = _serializer.Roundtrip(value);
+			var firstData = first.Data;
+			var firstHeader = first.Header;
+			InstancePool.Return(first);
+
+			value.SequenceNumber = 2;
+			value.Data = new byte[] {5, 6, 7};
+			value.Header = new byte[] {8, 9};
+			var second = _serializer.Roundtrip(value);
+			second.Should().BeSameAs(first);
+			second.SequenceNumber.Should().Be(2);
+			second.Data.Should().BeSameAs(firstData, "because the array has the same length as the one of the returned instance");
+			second.Data.Should().Equal(5, 6, 7);
+			second.Header.Should().NotBeSameAs(firstHeader, "because the array has a different length");
+			second.Header.Should().Equal(8, 9);
+		}
+
+#if DEBUG
+		[Test]
+		[Description("Verifies that returning the same instance twice is detected instead of handing it out twice")]
+		public void TestPooledReturnTwice()
+		{
+			var value = _serializer.Roundtrip(new PooledPacket {SequenceNumber = 1});
+			InstancePool.Return(value);
+			new Action(() => InstancePool.Return(value))
+				.Should().Throw<InvalidOperationException>()
+				.WithMessage("This instance of 'SharpRemote.Test.Types.Classes.PooledPacket' has already been returned to the pool");
+
+			_serializer.Roundtrip(new PooledPacket {SequenceNumber = 2}).Should().BeSameAs(value);
+			_serializer.Roundtrip(new PooledPacket {SequenceNumber = 3}).Should().NotBeSameAs(value);
+		}
+#endif
+
+		[Test]
+		public void TestPooledReturnNull()
+		{
+			new Action(() => InstancePool.Return(null)).Should().Throw<ArgumentNullException>();
+		}
+
+		[Test]
+		public void TestPooledReturnNotPooled()
+		{
+			new Action(() => InstancePool.Return(new DataPacket()))
+				.Should().Throw<ArgumentException>()
+				.WithMessage("The type 'SharpRemote.Test.Types.Classes.DataPacket' is not marked with the [Pooled] attribute");
+		}
+	}
+}
@@ -377,6 +377,14 @@ namespace SharpRemote.Test.CodeGeneration.Serialization
 
 		#endregion
 
+		[Test]
+		[Description("Verifies that arrays of [Columnar] structs may only contain members which can be written as a flat column")]
+		public void TestNonFlatColumnarStructArray()
+		{
+			TestFailRegister<NonFlatColumnarStruct[]>(
+				"The data member 'Values' of the [Columnar] type 'SharpRemote.Test.Types.Structs.NonFlatColumnarStruct' must be of a primitive type, an enum, a string, a DateTime, a TimeSpan, a decimal, a Guid or a nullable thereof");
+		}
+
 		#region Singletons with ByReference not allowed
 
 		[Test]
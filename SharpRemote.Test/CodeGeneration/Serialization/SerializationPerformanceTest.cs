@@ -1,9 +1,12 @@
 ﻿using System;
 using System.Diagnostics;
 using System.IO;
+using System.IO.Compression;
 using System.Runtime.Serialization;
 using Moq;
 using NUnit.Framework;
+using SharpRemote.Test.Types.Enums;
+using SharpRemote.Test.Types.Structs;
 
 namespace SharpRemote.Test.CodeGeneration.Serialization
 {
@@ -106,6 +109,138 @@ namespace SharpRemote.Test.CodeGeneration.Serialization
 			Measure(value, numSamples);
 		}
 
+		[Test]
+		[PerformanceTest]
+		[Description("Measures the throughput of writing and reading double arrays of various sizes, which are copied as one block of memory")]
+		public void TestDoubleArrayThroughput()
+		{
+			var serializer = new BinarySerializer();
+			serializer.RegisterType<double[]>();
+
+			foreach (var length in new[] {1000, 10000, 100000, 1000000, 10000000})
+			{
+				var value = new double[length];
+				for (int i = 0; i < value.Length; ++i)
+					value[i] = i * Math.PI;
+
+				var numSamples = Math.Max(1, 10000000 / length);
+				using (var data = new MemoryStream())
+				using (var writer = new BinaryWriter(data))
+				using (var reader = new BinaryReader(data))
+				{
+					var sw = Stopwatch.StartNew();
+					for (int i = 0; i < numSamples; ++i)
+					{
+						data.Position = 0;
+						serializer.WriteObject(writer, value, null);
+					}
+					var writeTime = sw.Elapsed;
+
+					sw.Restart();
+					for (int i = 0; i < numSamples; ++i)
+					{
+						data.Position = 0;
+						serializer.ReadObject(reader, null);
+					}
+					var readTime = sw.Elapsed;
+
+					var totalBytes = (double) data.Length * numSamples;
+					Console.WriteLine("{0} elements ({1}): write {2:F0} MB/s, read {3:F0} MB/s",
+					                  length,
+					                  TestHelpers.FormatBytes(data.Length),
+					                  totalBytes / writeTime.TotalSeconds / (1024 * 1024),
+					                  totalBytes / readTime.TotalSeconds / (1024 * 1024));
+				}
+			}
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Compares writing and reading 1M ticks row by row against writing and reading them column by column, both raw and compressed")]
+		public void TestColumnarStructArray()
+		{
+			const int length = 1000000;
+			var rows = new RowTick[length];
+			var columns = new ColumnarTick[length];
+			var rng = new Random(42);
+			var timestamp = DateTime.UtcNow.Ticks;
+			var price = 100.0;
+			for (int i = 0; i < length; ++i)
+			{
+				timestamp += rng.Next(1000);
+				price += Math.Round(rng.NextDouble() - 0.5, 2);
+				var tick = new ColumnarTick
+				{
+					Timestamp = timestamp,
+					Price = price,
+					Quantity = rng.Next(1, 100) * 100,
+					Side = rng.Next(2) == 0 ? ByteEnum.A : ByteEnum.C,
+					IsTrade = rng.Next(4) == 0,
+					Yield = rng.Next(10) == 0 ? (float?) null : 0.01f * rng.Next(500),
+					Venue = rng.Next(2) == 0 ? "XETRA" : "NASDAQ",
+					Flags = Int32Enum.B
+				};
+				columns[i] = tick;
+				rows[i] = new RowTick
+				{
+					Timestamp = tick.Timestamp,
+					Price = tick.Price,
+					Quantity = tick.Quantity,
+					Side = tick.Side,
+					IsTrade = tick.IsTrade,
+					Yield = tick.Yield,
+					Venue = tick.Venue,
+					Flags = tick.Flags
+				};
+			}
+
+			MeasureArray("Row", rows);
+			MeasureArray("Columnar", columns);
+		}
+
+		private static void MeasureArray<T>(string name, T[] value)
+		{
+			var serializer = new BinarySerializer();
+			serializer.RegisterType<T[]>();
+
+			const int numSamples = 10;
+			using (var data = new MemoryStream())
+			using (var writer = new BinaryWriter(data))
+			using (var reader = new BinaryReader(data))
+			{
+				var sw = Stopwatch.StartNew();
+				for (int i = 0; i < numSamples; ++i)
+				{
+					data.Position = 0;
+					serializer.WriteObject(writer, value, null);
+				}
+				var writeTime = sw.Elapsed;
+
+				sw.Restart();
+				for (int i = 0; i < numSamples; ++i)
+				{
+					data.Position = 0;
+					serializer.ReadObject(reader, null);
+				}
+				var readTime = sw.Elapsed;
+
+				long compressedLength;
+				using (var compressed = new MemoryStream())
+				{
+					using (var deflate = new DeflateStream(compressed, CompressionMode.Compress, true))
+						deflate.Write(data.GetBuffer(), 0, (int) data.Length);
+					compressedLength = compressed.Length;
+				}
+
+				Console.WriteLine("{0}: {1} raw, {2} compressed, write {3:F1} ms, read {4:F1} ms",
+				                  name,
+				                  TestHelpers.FormatBytes(data.Length),
+				                  TestHelpers.FormatBytes(compressedLength),
+				                  writeTime.TotalMilliseconds / numSamples,
+				                  readTime.TotalMilliseconds / numSamples);
+			}
+		}
+
 		[Test]
 		[PerformanceTest]
 		public void TestObjectIntArray()
@@ -0,0 +1,117 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Reflection;
+using System.Reflection.Emit;
+using FluentAssertions;
+using NUnit.Framework;
+using SharpRemote.Test.Types.Classes;
+using SharpRemote.Test.Types.Enums;
+using SharpRemote.Test.Types.Structs;
+
+namespace SharpRemote.Test.CodeGeneration.Serialization
+{
+	[TestFixture]
+	public partial class SerializationTest
+	{
+		[Test]
+		[Description("Verifies that the size of fixed-size values is computed exactly")]
+		public void TestSerializedSizeFixedSize()
+		{
+			ShouldComputeSerializedSize(true);
+			ShouldComputeSerializedSize((byte) 42);
+			ShouldComputeSerializedSize((short) -1);
+			ShouldComputeSerializedSize(42);
+			ShouldComputeSerializedSize(42L);
+			ShouldComputeSerializedSize(Math.PI);
+			ShouldComputeSerializedSize(1.5m);
+			ShouldComputeSerializedSize(TimeSpan.FromSeconds(1));
+			ShouldComputeSerializedSize(DateTime.Now);
+			ShouldComputeSerializedSize(Guid.NewGuid());
+			ShouldComputeSerializedSize(Int32Enum.B);
+			ShouldComputeSerializedSize(new FieldVector3 {X = 1, Y = 2, Z = 3});
+			ShouldComputeSerializedSize(new FieldPaddedStruct {A = 1, B = 2});
+		}
+
+		[Test]
+		[Description("Verifies that the size of strings is computed exactly")]
+		public void TestSerializedSizeString()
+		{
+			ShouldComputeSerializedSize<string>(null);
+			ShouldComputeSerializedSize("");
+			ShouldComputeSerializedSize("Hello, World!");
+			ShouldComputeSerializedSize("Grüße, 世界");
+			ShouldComputeSerializedSize(new string('a', 200));
+			ShouldComputeSerializedSize(new string('ä', 100000));
+		}
+
+		[Test]
+		[Description("Verifies that the size of arrays of strings or fixed-size values is computed exactly")]
+		public void TestSerializedSizeArray()
+		{
+			ShouldComputeSerializedSize<byte[]>(null);
+			ShouldComputeSerializedSize(new byte[0]);
+			ShouldComputeSerializedSize(new byte[100003]);
+			ShouldComputeSerializedSize(new[] {1, 2, 3});
+			ShouldComputeSerializedSize(new[] {Int32Enum.A, Int32Enum.C});
+			ShouldComputeSerializedSize(new FieldVector3[1000]);
+			ShouldComputeSerializedSize(new FieldPaddedStruct[1000]);
+			ShouldComputeSerializedSize<string[]>(null);
+			ShouldComputeSerializedSize(new[] {"a", null, "Grüße", ""});
+		}
+
+		[Test]
+		[Description("Verifies that no code is emitted for types whose size cannot be computed cheaply")]
+		public void TestSerializedSizeNotSupported()
+		{
+			foreach (var type in new[] {typeof(object), typeof(List<int>), typeof(object[]), typeof(int[,]), typeof(FieldObjectStruct), typeof(FieldSealedClass)})
+			{
+				var method = new DynamicMethod("GetSerializedSize", typeof(long), new[] {type}, GetType().Module, true);
+				var gen = method.GetILGenerator();
+				_serializer.EmitGetSerializedSize(gen, () => gen.Emit(OpCodes.Ldarg_0), type)
+				           .Should().BeFalse("because the size of {0} can't be computed cheaply", type);
+				gen.ILOffset.Should().Be(0);
+			}
+		}
+
+		private void ShouldComputeSerializedSize<T>(T value)
+		{
+			// The write methods of the serializer can only be called from within its own module
+			var typeBuilder = _serializer.Module.DefineType("SerializedSize" + Guid.NewGuid().ToString("N"),
+			                                                TypeAttributes.Public | TypeAttributes.Class);
+
+			var getSize = typeBuilder.DefineMethod("GetSerializedSize", MethodAttributes.Public | MethodAttributes.Static,
+			                                       typeof(long), new[] {typeof(T)});
+			var gen = getSize.GetILGenerator();
+			_serializer.EmitGetSerializedSize(gen, () => gen.Emit(OpCodes.Ldarg_0), typeof(T)).Should().BeTrue();
+			gen.Emit(OpCodes.Ret);
+
+			var write = typeBuilder.DefineMethod("WriteValue", MethodAttributes.Public | MethodAttributes.Static,
+			                                     typeof(void), new[] {typeof(BinaryWriter), typeof(T), typeof(ISerializer)});
+			gen = write.GetILGenerator();
+			_serializer.EmitWriteValue(gen,
+			                           () => gen.Emit(OpCodes.Ldarg_0),
+			                           () => gen.Emit(OpCodes.Ldarg_1),
+			                           () => gen.Emit(OpCodes.Ldarga_S, (byte) 1),
+			                           () => gen.Emit(OpCodes.Ldarg_2),
+			                           () => gen.Emit(OpCodes.Ldnull),
+			                           typeof(T));
+			gen.Emit(OpCodes.Ret);
+
+			var type = typeBuilder.CreateType();
+			var writeValue = (Action<BinaryWriter, T, ISerializer>) type.GetMethod("WriteValue")
+			                                                           .CreateDelegate(typeof(Action<BinaryWriter, T, ISerializer>));
+			var getSerializedSize = (Func<T, long>) type.GetMethod("GetSerializedSize")
+			                                            .CreateDelegate(typeof(Func<T, long>));
+
+			using (var stream = new MemoryStream())
+			using (var writer = new BinaryWriter(stream))
+			{
+				writeValue(writer, value, _serializer);
+				writer.Flush();
+
+				getSerializedSize(value).Should().Be(stream.Length, "because the size of {0} should be computed exactly", typeof(T));
+			}
+		}
+	}
+}
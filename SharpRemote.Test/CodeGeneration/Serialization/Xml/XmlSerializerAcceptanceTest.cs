@@ -1,9 +1,14 @@
 ﻿using System;
+using System.Diagnostics;
 using System.IO;
+using System.Linq;
 using System.Reflection;
 using System.Reflection.Emit;
 using System.Text;
+using System.Threading.Tasks;
+using FluentAssertions;
 using NUnit.Framework;
+using SharpRemote.Test.Types.Structs;
 
 namespace SharpRemote.Test.CodeGeneration.Serialization.Xml
 {
@@ -42,6 +47,110 @@ namespace SharpRemote.Test.CodeGeneration.Serialization.Xml
 			//}
 		}
 
+		[Test]
+		[Description("Verifies that many threads may read messages of the same serializer at the same time")]
+		public void TestMethodCallConcurrentRead()
+		{
+			var serializer = Create();
+			serializer.RegisterType<FieldVector3>();
+
+			byte[] message;
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+				{
+					for (int i = 0; i < 100; ++i)
+						writer.WriteArgument(new FieldVector3 {X = i, Y = -i, Z = 0.5 * i});
+				}
+				message = stream.ToArray();
+			}
+
+			var tasks = Enumerable.Range(0, 8).Select(unused => Task.Factory.StartNew(() =>
+			{
+				for (int n = 0; n < 100; ++n)
+				{
+					using (var stream = new MemoryStream(message))
+					using (var reader = CreateMethodCallReader(serializer, stream))
+					{
+						for (int i = 0; i < 100; ++i)
+						{
+							FieldVector3 value;
+							reader.ReadNextArgumentAsStruct(out value).Should().BeTrue();
+							value.Should().Be(new FieldVector3 {X = i, Y = -i, Z = 0.5 * i});
+						}
+					}
+				}
+			}, TaskCreationOptions.LongRunning)).ToArray();
+
+			Task.WaitAll(tasks);
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Measures the size as well as serialization and deserialization time of messages with many values of the test types")]
+		public void TestMethodCallPerformance()
+		{
+			var serializer = Create();
+			MeasureMethodCall(serializer, i => i);
+			MeasureMethodCall(serializer, i => new FieldInt32 {Value = i});
+			MeasureMethodCall(serializer, i => new FieldUInt32 {Value = (uint) i});
+			MeasureMethodCall(serializer, i => new FieldDecimal {Value = i / 3m});
+			MeasureMethodCall(serializer, i => new FieldString {Value = "Value" + i});
+			MeasureMethodCall(serializer, i => new PropertyStruct {Value = "Value" + i});
+			MeasureMethodCall(serializer, i => new FieldVector3 {X = i, Y = -i, Z = 0.5 * i});
+		}
+
+		private static void MeasureMethodCall<T>(ISerializer2 serializer, Func<int, T> createValue) where T : struct
+		{
+			const int count = 1000;
+			const int numRepetitions = 100;
+			serializer.RegisterType<T>();
+
+			var values = Enumerable.Range(0, count).Select(createValue).ToList();
+			using (var stream = new MemoryStream())
+			{
+				var sw = Stopwatch.StartNew();
+				for (int n = 0; n < numRepetitions; ++n)
+				{
+					stream.SetLength(0);
+					using (var writer = serializer.CreateMethodCallWriter(stream, 1, 2, "Foo"))
+					{
+						foreach (var value in values)
+							writer.WriteArgument(value);
+					}
+				}
+				var serializationTime = sw.Elapsed;
+
+				sw.Restart();
+				for (int n = 0; n < numRepetitions; ++n)
+				{
+					stream.Position = 0;
+					using (var reader = CreateMethodCallReader(serializer, stream))
+					{
+						T value;
+						while (reader.ReadNextArgumentAsStruct(out value))
+						{
+						}
+					}
+				}
+				var deserializationTime = sw.Elapsed;
+
+				Console.WriteLine("{0}: {1} bytes, serialization: {2:F2}ms, deserialization: {3:F2}ms per message",
+				                  typeof(T).Name,
+				                  stream.Length,
+				                  serializationTime.TotalMilliseconds / numRepetitions,
+				                  deserializationTime.TotalMilliseconds / numRepetitions);
+			}
+		}
+
+		private static IMethodCallReader CreateMethodCallReader(ISerializer2 serializer, Stream stream)
+		{
+			IMethodCallReader callReader;
+			IMethodResultReader unused;
+			serializer.CreateMethodReader(stream, out callReader, out unused);
+			return callReader;
+		}
+
 		protected override string Format(MemoryStream stream)
 		{
 			using (var reader = new StreamReader(stream, Encoding.Default, detectEncodingFromByteOrderMarks: true,
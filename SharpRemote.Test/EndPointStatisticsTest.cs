@@ -119,6 +119,17 @@ namespace SharpRemote.Test
 			statistics.CreateReport().Should().Contain(string.Format("Pending method invocations: {0}", numPendingMethodInvocations));
 		}
 
+		[Test]
+		public void TestLogNumRejectedMethodInvocations([Values(0, 42, 1000)] int numRejectedMethodInvocations)
+		{
+			var statistics = new EndPointStatistics(_endPoint.Object);
+
+			_endPoint.Setup(x => x.NumRejectedMethodInvocations).Returns(numRejectedMethodInvocations);
+			statistics.Update();
+
+			statistics.CreateReport().Should().Contain(string.Format("Rejected method invocations: {0}", numRejectedMethodInvocations));
+		}
+
 		[Test]
 		[SetCulture("en-US")]
 		public void TestLogNumServantsCollected()
@@ -0,0 +1,42 @@
+﻿using FluentAssertions;
+using NUnit.Framework;
+
+namespace SharpRemote.Test
+{
+	[TestFixture]
+	public sealed class InvocationQuotaTest
+	{
+		[Test]
+		public void TestTryEnter()
+		{
+			var quota = new InvocationQuota(2);
+			quota.TryEnter().Should().BeTrue();
+			quota.TryEnter().Should().BeTrue();
+			quota.TryEnter().Should().BeFalse("because the quota is exhausted");
+			quota.Count.Should().Be(2);
+
+			quota.Leave();
+			quota.Count.Should().Be(1);
+			quota.TryEnter().Should().BeTrue();
+		}
+
+		[Test]
+		[Description("Verifies that an invocation is only admitted when both the quota and its parent admit it")]
+		public void TestTryEnterParent()
+		{
+			var parent = new InvocationQuota(2);
+			var quota1 = new InvocationQuota(2, parent);
+			var quota2 = new InvocationQuota(2, parent);
+
+			quota1.TryEnter().Should().BeTrue();
+			quota1.TryEnter().Should().BeTrue();
+			quota2.TryEnter().Should().BeFalse("because the parent's quota is exhausted");
+			quota2.Count.Should().Be(0, "because a rejected invocation must not count towards the quota");
+
+			quota1.Leave();
+			parent.Count.Should().Be(1);
+			quota2.TryEnter().Should().BeTrue();
+			parent.Count.Should().Be(2);
+		}
+	}
+}
@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.ComponentModel;
 using System.Diagnostics;
@@ -43,10 +44,14 @@ namespace SharpRemote.Test.Remoting
 			Connect(_client, _server);
 		}
 
-		protected abstract IRemotingEndPoint CreateServer();
+		protected abstract IRemotingEndPoint CreateServer(HeartbeatSettings heartbeatSettings = null,
+		                                                  LatencySettings latencySettings = null,
+		                                                  EndPointSettings endPointSettings = null);
 		protected abstract void Bind(IRemotingEndPoint server);
 
-		protected abstract IRemotingEndPoint CreateClient();
+		protected abstract IRemotingEndPoint CreateClient(HeartbeatSettings heartbeatSettings = null,
+		                                                  LatencySettings latencySettings = null,
+		                                                  EndPointSettings endPointSettings = null);
 		protected abstract void Connect(IRemotingEndPoint client, IRemotingEndPoint server);
 
 		[OneTimeTearDown]
@@ -58,6 +63,25 @@ namespace SharpRemote.Test.Remoting
 			_client.TryDispose();
 		}
 
+		/// <summary>
+		///     Creates a connected pair of endpoints whose server executes at most the given number of
+		///     invocations in parallel and queues the remaining ones by their priority.
+		///     Neither endpoint sends heartbeats or measures latency so that the only invocations
+		///     queued on the server are the ones made by the test.
+		/// </summary>
+		private void CreatePriorityEndPoints(int maxParallelInvocations,
+		                                     out IRemotingEndPoint server,
+		                                     out IRemotingEndPoint client)
+		{
+			server = CreateServer(HeartbeatSettings.Dont,
+			                      LatencySettings.DontMeasure,
+			                      new EndPointSettings {MaxParallelInvocations = maxParallelInvocations});
+			Bind(server);
+
+			client = CreateClient(HeartbeatSettings.Dont, LatencySettings.DontMeasure);
+			Connect(client, server);
+		}
+
 		[Test]
 		[NUnit.Framework.Description("Verifies (since overloaded methods are not yet supported) that types which contains two or more methods of the same name are not supported and an appropriate exception is thrown")]
 		public void TestTypeWithOverloadedMethods()
@@ -320,6 +344,810 @@ namespace SharpRemote.Test.Remoting
 			GC.KeepAlive(subject);
 		}
 
+		[Test]
+		[NUnit.Framework.Description("Verifies that a method dispatched inline can be invoked and returns its value")]
+		public void TestInline1()
+		{
+			const ulong servantId = 40;
+			var subject = new Mock<IInlineMethods>();
+			subject.Setup(x => x.GetInline()).Returns(42);
+
+			_server.CreateServant(servantId, subject.Object);
+			var proxy = _client.CreateProxy<IInlineMethods>(servantId);
+			proxy.GetInline().Should().Be(42);
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[NUnit.Framework.Description("Verifies that a method dispatched inline which synchronously calls back into the remote endpoint fails instead of deadlocking the connection")]
+		public void TestInlineCallback()
+		{
+			const ulong servantId = 63;
+			const ulong callbackId = 64;
+			var callback = new Mock<IInlineMethods>();
+			callback.Setup(x => x.GetDefault()).Returns(9001);
+			_client.CreateServant(callbackId, callback.Object);
+
+			var callbackProxy = _server.CreateProxy<IInlineMethods>(callbackId);
+			var subject = new Mock<IInlineMethods>();
+			subject.Setup(x => x.GetInline()).Returns(() => callbackProxy.GetDefault());
+			subject.Setup(x => x.GetDefault()).Returns(() => callbackProxy.GetDefault());
+
+			_server.CreateServant(servantId, subject.Object);
+			var proxy = _client.CreateProxy<IInlineMethods>(servantId);
+			new Action(() => proxy.GetInline())
+				.Should().Throw<InvalidOperationException>()
+				.WithMessage("*a method with Dispatch.Inline may not synchronously call back into the remote endpoint*");
+
+			_client.IsConnected.Should().BeTrue();
+			proxy.GetDefault().Should().Be(9001, "because methods which aren't dispatched inline may call back");
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+			GC.KeepAlive(callback);
+		}
+
+		[Test]
+		[NUnit.Framework.Description("Verifies that an exception thrown by a method dispatched inline is marshalled and doesn't tear down the connection")]
+		public void TestInline2()
+		{
+			const ulong servantId = 41;
+			var subject = new Mock<IInlineMethods>();
+			subject.Setup(x => x.GetInline()).Returns(() => { throw new ArgumentException("Foobar"); });
+			subject.Setup(x => x.GetDefault()).Returns(9001);
+
+			_server.CreateServant(servantId, subject.Object);
+			var proxy = _client.CreateProxy<IInlineMethods>(servantId);
+			new Action(() => proxy.GetInline())
+				.Should().Throw<ArgumentException>()
+				.WithMessage("Foobar");
+
+			_client.IsConnected.Should().BeTrue();
+			proxy.GetDefault().Should().Be(9001);
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[PerformanceTest]
+		[NUnit.Framework.Description("Measures the latency of a trivial method when dispatched inline vs. when dispatched through the task scheduler")]
+		public void TestInlineLatency()
+		{
+			const ulong servantId = 42;
+			var subject = new Mock<IInlineMethods>();
+			subject.Setup(x => x.GetInline()).Returns(42);
+			subject.Setup(x => x.GetDefault()).Returns(42);
+
+			_server.CreateServant(servantId, subject.Object);
+			var proxy = _client.CreateProxy<IInlineMethods>(servantId);
+
+			const int numSamples = 10000;
+			for (int i = 0; i < 100; ++i)
+			{
+				proxy.GetInline();
+				proxy.GetDefault();
+			}
+
+			var sw = Stopwatch.StartNew();
+			for (int i = 0; i < numSamples; ++i)
+			{
+				proxy.GetDefault();
+			}
+			sw.Stop();
+			Console.WriteLine("Default: {0:F4}ms per call", sw.Elapsed.TotalMilliseconds/numSamples);
+
+			sw.Restart();
+			for (int i = 0; i < numSamples; ++i)
+			{
+				proxy.GetInline();
+			}
+			sw.Stop();
+			Console.WriteLine("Inline: {0:F4}ms per call", sw.Elapsed.TotalMilliseconds/numSamples);
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[NUnit.Framework.Description("Verifies that methods with a priority other than normal can be invoked")]
+		public void TestPriority1()
+		{
+			const ulong servantId = 43;
+			var subject = new Mock<IPriorityMethods>();
+			subject.Setup(x => x.GetStatus()).Returns(42);
+			subject.Setup(x => x.GetValue()).Returns(1337);
+			byte[] uploaded = null;
+			subject.Setup(x => x.Upload(It.IsAny<byte[]>())).Callback((byte[] data) => uploaded = data);
+
+			IRemotingEndPoint server, client;
+			CreatePriorityEndPoints(2, out server, out client);
+			try
+			{
+				server.CreateServant(servantId, subject.Object);
+				var proxy = client.CreateProxy<IPriorityMethods>(servantId);
+
+				proxy.GetStatus().Should().Be(42);
+				proxy.GetValue().Should().Be(1337);
+				proxy.Upload(new byte[] {1, 2, 3});
+				uploaded.Should().Equal(new byte[] {1, 2, 3});
+			}
+			finally
+			{
+				client.TryDispose();
+				server.TryDispose();
+			}
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[NUnit.Framework.Description("Verifies that high and normal priority invocations overtake bulk invocations which are queued on the server")]
+		public void TestPriority2()
+		{
+			const ulong servantId = 65;
+			var invocations = new ConcurrentQueue<string>();
+			var uploadStarted = new ManualResetEventSlim();
+			var releaseUploads = new ManualResetEventSlim();
+			var subject = new Mock<IPriorityMethods>();
+			subject.Setup(x => x.GetStatus()).Callback(() => invocations.Enqueue("GetStatus")).Returns(42);
+			subject.Setup(x => x.GetValue()).Callback(() => invocations.Enqueue("GetValue")).Returns(1337);
+			subject.Setup(x => x.Upload(It.IsAny<byte[]>())).Callback((byte[] data) =>
+			{
+				invocations.Enqueue("Upload" + data[0]);
+				uploadStarted.Set();
+				releaseUploads.Wait();
+			});
+
+			IRemotingEndPoint server, client;
+			CreatePriorityEndPoints(1, out server, out client);
+			try
+			{
+				server.CreateServant(servantId, subject.Object);
+				var proxy = client.CreateProxy<IPriorityMethods>(servantId);
+				var timeout = TimeSpan.FromSeconds(10);
+
+				// The first upload blocks the server's only worker...
+				var uploads = new List<Task> {Task.Factory.StartNew(() => proxy.Upload(new byte[] {0}), TaskCreationOptions.LongRunning)};
+				uploadStarted.Wait(timeout).Should().BeTrue();
+
+				// ...and therefore every subsequent invocation must be queued.
+				const int numQueuedUploads = 4;
+				for (int i = 1; i <= numQueuedUploads; ++i)
+				{
+					var data = new[] {(byte) i};
+					uploads.Add(Task.Factory.StartNew(() => proxy.Upload(data), TaskCreationOptions.LongRunning));
+				}
+				WaitFor(() => server.NumQueuedMethodInvocations == numQueuedUploads, timeout).Should().BeTrue();
+
+				var status = Task.Factory.StartNew(() => proxy.GetStatus(), TaskCreationOptions.LongRunning);
+				WaitFor(() => server.NumQueuedMethodInvocations == numQueuedUploads + 1, timeout).Should().BeTrue();
+
+				var value = Task.Factory.StartNew(() => proxy.GetValue(), TaskCreationOptions.LongRunning);
+				WaitFor(() => server.NumQueuedMethodInvocations == numQueuedUploads + 2, timeout).Should().BeTrue();
+
+				releaseUploads.Set();
+				status.Wait(timeout).Should().BeTrue();
+				status.Result.Should().Be(42);
+				value.Wait(timeout).Should().BeTrue();
+				value.Result.Should().Be(1337);
+				Task.WaitAll(uploads.ToArray(), timeout).Should().BeTrue();
+
+				// The bulk uploads have been queued long before the other invocations, yet they
+				// must only be executed once there's nothing more important left to do.
+				// The order of the queued uploads amongst themselves depends on the order in which
+				// they've been sent and is therefore not verified.
+				var order = invocations.ToList();
+				order.Take(3).Should().Equal("Upload0", "GetStatus", "GetValue");
+				order.Skip(3).Should().BeEquivalentTo("Upload1", "Upload2", "Upload3", "Upload4");
+			}
+			finally
+			{
+				releaseUploads.Set();
+				client.TryDispose();
+				server.TryDispose();
+			}
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[PerformanceTest]
+		[NUnit.Framework.Description("Measures the latency of high and normal priority calls while the server is flooded with bulk calls")]
+		public void TestPriorityLatency()
+		{
+			const ulong servantId = 44;
+			var subject = new Mock<IPriorityMethods>();
+			subject.Setup(x => x.GetStatus()).Returns(42);
+			subject.Setup(x => x.GetValue()).Returns(42);
+			subject.Setup(x => x.Upload(It.IsAny<byte[]>())).Callback(() => Thread.Sleep(1));
+
+			IRemotingEndPoint server, client;
+			CreatePriorityEndPoints(2, out server, out client);
+			server.CreateServant(servantId, subject.Object);
+			var proxy = client.CreateProxy<IPriorityMethods>(servantId);
+
+			const int numSamples = 1000;
+			const int numUploaders = 64;
+			var data = new byte[64*1024];
+			var uploadCancellation = new CancellationTokenSource();
+			var uploaders = Enumerable.Range(0, numUploaders).Select(unused => Task.Factory.StartNew(() =>
+			{
+				while (!uploadCancellation.IsCancellationRequested)
+					proxy.Upload(data);
+			}, TaskCreationOptions.LongRunning)).ToArray();
+
+			try
+			{
+				var high = new List<double>(numSamples);
+				var normal = new List<double>(numSamples);
+				for (int i = 0; i < numSamples; ++i)
+				{
+					var sw = Stopwatch.StartNew();
+					proxy.GetStatus();
+					high.Add(sw.Elapsed.TotalMilliseconds);
+
+					sw.Restart();
+					proxy.GetValue();
+					normal.Add(sw.Elapsed.TotalMilliseconds);
+				}
+
+				high.Sort();
+				normal.Sort();
+				Console.WriteLine("High: p50 {0:F4}ms, p99 {1:F4}ms", high[numSamples/2], high[numSamples*99/100]);
+				Console.WriteLine("Normal: p50 {0:F4}ms, p99 {1:F4}ms", normal[numSamples/2], normal[numSamples*99/100]);
+			}
+			finally
+			{
+				uploadCancellation.Cancel();
+				Task.WaitAll(uploaders);
+
+				client.TryDispose();
+				server.TryDispose();
+			}
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[PerformanceTest]
+		[NUnit.Framework.Description("Measures the throughput of inbound calls when they are made by an increasing number of concurrent callers")]
+		public void TestConcurrentInboundCalls()
+		{
+			const ulong servantId = 45;
+			var subject = new Returns42();
+			_server.CreateServant(servantId, (IGetInt32Property) subject);
+			var proxy = _client.CreateProxy<IGetInt32Property>(servantId);
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				proxy.Value.Should().Be(42);
+			}
+
+			const int numCallsPerCaller = 10000;
+			foreach (var numCallers in new[] {1, 2, 4, 8, 16})
+			{
+				var sw = Stopwatch.StartNew();
+				var callers = Enumerable.Range(0, numCallers).Select(unused => Task.Factory.StartNew(() =>
+				{
+					for (int i = 0; i < numCallsPerCaller; ++i)
+						proxy.Value.Should().Be(42);
+				}, TaskCreationOptions.LongRunning)).ToArray();
+				Task.WaitAll(callers);
+				sw.Stop();
+
+				var numCalls = numCallers * numCallsPerCaller;
+				Console.WriteLine("{0} caller(s): {1:F0} calls/s",
+				                  numCallers,
+				                  numCalls / sw.Elapsed.TotalSeconds);
+			}
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[NUnit.Framework.Description("Verifies that the latest value of a coalesced event is delivered to the proxy")]
+		public void TestCoalescedEvent()
+		{
+			const ulong servantId = 46;
+			var subject = new Mock<ICoalescedEvents>();
+			_server.CreateServant(servantId, subject.Object);
+			var proxy = _client.CreateProxy<ICoalescedEvents>(servantId);
+
+			const int numRaises = 1000;
+			int numDeliveries = 0;
+			using (var lastValueDelivered = new ManualResetEventSlim())
+			{
+				proxy.Progress += value =>
+				{
+					Interlocked.Increment(ref numDeliveries);
+					if (value == numRaises)
+						lastValueDelivered.Set();
+				};
+
+				for (int i = 1; i <= numRaises; ++i)
+				{
+					subject.Raise(x => x.Progress += null, i);
+				}
+
+				lastValueDelivered.Wait(TimeSpan.FromSeconds(10))
+				                  .Should().BeTrue("because the latest value must always be delivered");
+				numDeliveries.Should().BeLessThan(numRaises);
+			}
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[PerformanceTest]
+		[NUnit.Framework.Description("Compares the cost of raising a coalesced event with an event which is delivered once per raise")]
+		public void TestCoalescedEventRate()
+		{
+			const ulong servantId = 47;
+			var subject = new Mock<ICoalescedEvents>();
+			_server.CreateServant(servantId, subject.Object);
+			var proxy = _client.CreateProxy<ICoalescedEvents>(servantId);
+
+			const int numRaises = 100000;
+			int numCoalescedDeliveries = 0;
+			int numUncoalescedDeliveries = 0;
+			proxy.Progress += unused => Interlocked.Increment(ref numCoalescedDeliveries);
+			proxy.UncoalescedProgress += unused => Interlocked.Increment(ref numUncoalescedDeliveries);
+
+			var process = Process.GetCurrentProcess();
+
+			process.Refresh();
+			var cpuTime = process.TotalProcessorTime;
+			var sw = Stopwatch.StartNew();
+			for (int i = 1; i <= numRaises; ++i)
+			{
+				subject.Raise(x => x.UncoalescedProgress += null, i);
+			}
+			SpinWait.SpinUntil(() => Volatile.Read(ref numUncoalescedDeliveries) == numRaises, TimeSpan.FromMinutes(1))
+			        .Should().BeTrue();
+			sw.Stop();
+			process.Refresh();
+			Console.WriteLine("Uncoalesced: {0} raises delivered {1} times in {2:F0}ms ({3:F0} deliveries/s), CPU time: {4:F0}ms",
+			                  numRaises,
+			                  numUncoalescedDeliveries,
+			                  sw.Elapsed.TotalMilliseconds,
+			                  numUncoalescedDeliveries / sw.Elapsed.TotalSeconds,
+			                  (process.TotalProcessorTime - cpuTime).TotalMilliseconds);
+
+			process.Refresh();
+			cpuTime = process.TotalProcessorTime;
+			sw.Restart();
+			for (int i = 1; i <= numRaises; ++i)
+			{
+				subject.Raise(x => x.Progress += null, i);
+			}
+			sw.Stop();
+			process.Refresh();
+			Console.WriteLine("Coalesced: {0} raises delivered {1} times in {2:F0}ms ({3:F0} deliveries/s), CPU time: {4:F0}ms",
+			                  numRaises,
+			                  numCoalescedDeliveries,
+			                  sw.Elapsed.TotalMilliseconds,
+			                  numCoalescedDeliveries / sw.Elapsed.TotalSeconds,
+			                  (process.TotalProcessorTime - cpuTime).TotalMilliseconds);
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[NUnit.Framework.Description("Verifies that the result of a [Streamed] method is transmitted completely and in order")]
+		public void TestStreamedResult()
+		{
+			const ulong servantId = 51;
+			var subject = new StreamedResults();
+			_server.CreateServant<IStreamedResults>(servantId, subject);
+			var proxy = _client.CreateProxy<IStreamedResults>(servantId);
+
+			proxy.Range(0).Should().BeEmpty();
+			proxy.Range(1).Should().Equal(0);
+			proxy.Range(10000).Should().Equal(Enumerable.Range(0, 10000));
+			proxy.Null().Should().BeNull();
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[NUnit.Framework.Description("Verifies that the servant only produces the items of a [Streamed] result when the caller asks for them")]
+		public void TestStreamedResultIsLazy()
+		{
+			const ulong servantId = 52;
+			var subject = new StreamedResults();
+			_server.CreateServant<IStreamedResults>(servantId, subject);
+			var proxy = _client.CreateProxy<IStreamedResults>(servantId);
+
+			var values = proxy.Range(1000000);
+			subject.NumProduced.Should().Be(0, "because nothing should be produced before the result is enumerated");
+
+			values.Take(10).Should().Equal(Enumerable.Range(0, 10));
+			SpinWait.SpinUntil(() => subject.NumEnumerationsDisposed == 1, TimeSpan.FromSeconds(10))
+			        .Should().BeTrue("because disposing of the enumerator early should end the enumeration on the servant");
+			subject.NumProduced.Should().BeLessOrEqualTo(10 + StreamedAttribute.DefaultChunkSize,
+			                                             "because the servant should never produce more than one chunk ahead of the caller");
+
+			new Action(() => values.GetEnumerator())
+				.Should().Throw<InvalidOperationException>()
+				.WithMessage("A streamed result can only be enumerated once");
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[NUnit.Framework.Description("Verifies that the servant ends a [Streamed] result which the caller abandoned without disposing of it")]
+		public void TestStreamedResultIdleTimeout()
+		{
+			const ulong servantId = 62;
+			var subject = new StreamedResults();
+			_server.CreateServant<IStreamedResults>(servantId, subject);
+			var proxy = _client.CreateProxy<IStreamedResults>(servantId);
+
+			var enumerator = proxy.RangeWithIdleTimeout(1000000).GetEnumerator();
+			enumerator.MoveNext().Should().BeTrue();
+			SpinWait.SpinUntil(() => subject.NumEnumerationsDisposed == 1, TimeSpan.FromSeconds(10))
+			        .Should().BeTrue("because the servant should end the enumeration once it has been idle for too long");
+
+			new Action(() =>
+				{
+					while (enumerator.MoveNext())
+					{}
+				})
+				.Should().Throw<InvalidOperationException>()
+				.WithMessage("The streamed result has been closed because no chunk has been requested for 100ms");
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[NUnit.Framework.Description("Verifies that an exception thrown while producing a [Streamed] result is rethrown while the result is enumerated")]
+		public void TestStreamedResultThrowException()
+		{
+			const ulong servantId = 53;
+			var subject = new StreamedResults();
+			_server.CreateServant<IStreamedResults>(servantId, subject);
+			var proxy = _client.CreateProxy<IStreamedResults>(servantId);
+
+			var actualValues = new List<int>();
+			new Action(() => actualValues.AddRange(proxy.ThrowAfter(100)))
+				.Should().Throw<ArgumentException>()
+				.WithMessage("The sequence has ended");
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[PerformanceTest]
+		[NUnit.Framework.Description("Compares the time until the first item arrives for a [Streamed] result with that of a materialized result")]
+		public void TestStreamedResultTimeToFirstItem()
+		{
+			const ulong servantId = 54;
+			var subject = new StreamedResults();
+			_server.CreateServant<IStreamedResults>(servantId, subject);
+			var proxy = _client.CreateProxy<IStreamedResults>(servantId);
+
+			const int numItems = 100;
+			const int delay = 10;
+
+			var sw = Stopwatch.StartNew();
+			proxy.Slow(numItems, delay).First();
+			var timeToFirstItem = sw.Elapsed;
+			sw.Restart();
+			proxy.Slow(numItems, delay).Count().Should().Be(numItems);
+			var timeToLastItem = sw.Elapsed;
+			Console.WriteLine("Streamed: First item after {0:F0}ms, all {1} items after {2:F0}ms",
+			                  timeToFirstItem.TotalMilliseconds,
+			                  numItems,
+			                  timeToLastItem.TotalMilliseconds);
+			Console.WriteLine("Materialized: First item after at least {0:F0}ms", numItems * delay);
+
+			timeToFirstItem.Should().BeLessThan(TimeSpan.FromMilliseconds(numItems * delay / 2.0));
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[PerformanceTest]
+		[NUnit.Framework.Description("Compares the throughput and the peak memory usage of a [Streamed] result with that of a materialized result")]
+		public void TestStreamedResultMemory()
+		{
+			const ulong servantId = 55;
+			var subject = new StreamedResults();
+			_server.CreateServant<IStreamedResults>(servantId, subject);
+			var proxy = _client.CreateProxy<IStreamedResults>(servantId);
+
+			const int numItems = 10000000;
+
+			GC.Collect(2, GCCollectionMode.Forced, true);
+			var memoryBefore = GC.GetTotalMemory(true);
+			long peakMemory = memoryBefore;
+			long sum = 0;
+			var sw = Stopwatch.StartNew();
+			int i = 0;
+			foreach (var value in proxy.MaterializedRange(numItems))
+			{
+				sum += value;
+				if (++i % 100000 == 0)
+					peakMemory = Math.Max(peakMemory, GC.GetTotalMemory(false));
+			}
+			sw.Stop();
+			Console.WriteLine("Materialized: {0} items in {1:F0}ms, peak memory: {2:F1}MB",
+			                  numItems,
+			                  sw.Elapsed.TotalMilliseconds,
+			                  (peakMemory - memoryBefore) / 1024.0 / 1024);
+
+			GC.Collect(2, GCCollectionMode.Forced, true);
+			memoryBefore = GC.GetTotalMemory(true);
+			peakMemory = memoryBefore;
+			sum = 0;
+			sw.Restart();
+			i = 0;
+			foreach (var value in proxy.Range(numItems))
+			{
+				sum += value;
+				if (++i % 100000 == 0)
+					peakMemory = Math.Max(peakMemory, GC.GetTotalMemory(false));
+			}
+			sw.Stop();
+			Console.WriteLine("Streamed: {0} items in {1:F0}ms, peak memory: {2:F1}MB",
+			                  numItems,
+			                  sw.Elapsed.TotalMilliseconds,
+			                  (peakMemory - memoryBefore) / 1024.0 / 1024);
+
+			sum.Should().Be((long) numItems * (numItems - 1) / 2);
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[NUnit.Framework.Description("Verifies that messages whose size is computed upfront roundtrip")]
+		public void TestLargeMessages()
+		{
+			const ulong servantId = 56;
+			var subject = new LargeMessages();
+			_server.CreateServant<ILargeMessages>(servantId, subject);
+			var proxy = _client.CreateProxy<ILargeMessages>(servantId);
+
+			proxy.GetVectors(0).Should().BeEmpty();
+			proxy.GetVectors(100000).Should().Equal(subject.GetVectors(100000));
+			proxy.SetVectors(subject.GetVectors(100000)).Should().Be(100000);
+			proxy.SetVectors(null).Should().Be(0);
+			proxy.GetString(0).Should().BeEmpty();
+			proxy.GetString(100001).Should().Be(subject.GetString(100001));
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[PerformanceTest]
+		[NUnit.Framework.Description("Measures how much memory is allocated (and retained afterwards) to send and receive large messages")]
+		public void TestLargeMessageAllocations()
+		{
+			const ulong servantId = 57;
+			var subject = new LargeMessages();
+			_server.CreateServant<ILargeMessages>(servantId, subject);
+			var proxy = _client.CreateProxy<ILargeMessages>(servantId);
+			AppDomain.MonitoringIsEnabled = true;
+
+			const int count = 1024 * 1024;
+			const long payloadSize = count * 24;
+			var values = subject.GetVectors(count);
+
+			foreach (var direction in new[] {"Result", "Argument"})
+			{
+				// Warmup, so that the proxy and servant methods are compiled already
+				for (int n = 0; n < 2; ++n)
+				{
+					GC.Collect(2, GCCollectionMode.Forced, true);
+					var memoryBefore = GC.GetTotalMemory(true);
+					var allocatedBefore = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize;
+					var sw = Stopwatch.StartNew();
+
+					if (direction == "Result")
+						proxy.GetVectors(count).Length.Should().Be(count);
+					else
+						proxy.SetVectors(values).Should().Be(count);
+
+					sw.Stop();
+					var allocated = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize - allocatedBefore;
+					GC.Collect(2, GCCollectionMode.Forced, true);
+					var retained = GC.GetTotalMemory(true) - memoryBefore;
+
+					if (n == 1)
+						Console.WriteLine("{0} of {1:F1}MB: {2:F1}MB allocated, {3:F1}MB retained, {4:F0}ms",
+						                  direction,
+						                  payloadSize / 1024.0 / 1024,
+						                  allocated / 1024.0 / 1024,
+						                  retained / 1024.0 / 1024,
+						                  sw.Elapsed.TotalMilliseconds);
+				}
+			}
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		public void TestByteSegments()
+		{
+			const ulong servantId = 58;
+			var subject = new ByteForwarder();
+			_server.CreateServant<IByteForwarder>(servantId, subject);
+			var proxy = _client.CreateProxy<IByteForwarder>(servantId);
+
+			var bytes = Enumerable.Range(0, 256).Select(x => (byte) x).ToArray();
+			proxy.Forward(new ArraySegment<byte>(bytes, 10, 20)).Should().Equal(bytes.Skip(11).Take(19));
+			proxy.Forward(new ArraySegment<byte>(bytes, 0, 0)).Should().BeEmpty();
+			proxy.Forward(new ArraySegment<byte>(bytes)).Should().Equal(bytes.Skip(1));
+			proxy.Forward(default(ArraySegment<byte>)).Array.Should().BeNull();
+
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[PerformanceTest]
+		[NUnit.Framework.Description("Compares how much memory is allocated to forward 1MB slices of a larger buffer as byte[] and as ArraySegment<byte>")]
+		public void TestByteSegmentAllocations()
+		{
+			const ulong servantId = 59;
+			var subject = new ByteForwarder();
+			_server.CreateServant<IByteForwarder>(servantId, subject);
+			var proxy = _client.CreateProxy<IByteForwarder>(servantId);
+			AppDomain.MonitoringIsEnabled = true;
+
+			const int sliceSize = 1024 * 1024;
+			const int numCalls = 8;
+			var buffer = new byte[4 * sliceSize];
+
+			foreach (var type in new[] {"byte[]", "ArraySegment<byte>"})
+			{
+				// Warmup, so that the proxy and servant methods are compiled already
+				for (int n = 0; n < 2; ++n)
+				{
+					GC.Collect(2, GCCollectionMode.Forced, true);
+					var allocatedBefore = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize;
+					var sw = Stopwatch.StartNew();
+
+					for (int i = 0; i < numCalls; ++i)
+					{
+						if (type == "byte[]")
+						{
+							var slice = new byte[sliceSize];
+							Buffer.BlockCopy(buffer, i % 4 * sliceSize, slice, 0, sliceSize);
+							proxy.ForwardArray(slice).Length.Should().Be(sliceSize - 1);
+						}
+						else
+						{
+							proxy.Forward(new ArraySegment<byte>(buffer, i % 4 * sliceSize, sliceSize)).Count.Should().Be(sliceSize - 1);
+						}
+					}
+
+					sw.Stop();
+					var allocated = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize - allocatedBefore;
+
+					if (n == 1)
+						Console.WriteLine("{0}: {1:F1}x the slice allocated per call, {2:F1}ms per call",
+						                  type,
+						                  (double) allocated / numCalls / sliceSize,
+						                  sw.Elapsed.TotalMilliseconds / numCalls);
+				}
+			}
+
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		public void TestPooledDataContract()
+		{
+			const ulong servantId = 60;
+			var subject = new PacketSink();
+			_server.CreateServant<IPacketSink>(servantId, subject);
+			var proxy = _client.CreateProxy<IPacketSink>(servantId);
+
+			for (int i = 0; i < 10; ++i)
+			{
+				proxy.ProcessPooled(new PooledDataPacket {SequenceNumber = i, Data = new byte[i % 3]}).Should().Be(i % 3);
+			}
+
+			GC.KeepAlive(subject);
+		}
+
+		[Test]
+		[PerformanceTest]
+		[NUnit.Framework.Description("Compares the number of garbage collections per million calls for a plain and a pooled data contract")]
+		public void TestPooledDataContractCollections()
+		{
+			const ulong servantId = 61;
+			var subject = new PacketSink();
+			_server.CreateServant<IPacketSink>(servantId, subject);
+			var proxy = _client.CreateProxy<IPacketSink>(servantId);
+
+			const int numCalls = 100000;
+			var data = new byte[16 * 1024];
+
+			foreach (var pooled in new[] {false, true})
+			{
+				// Warmup, so that the proxy and servant methods are compiled already
+				for (int n = 0; n < 2; ++n)
+				{
+					GC.Collect(2, GCCollectionMode.Forced, true);
+					var collectionsBefore = GC.CollectionCount(0);
+					var sw = Stopwatch.StartNew();
+
+					for (int i = 0; i < numCalls; ++i)
+					{
+						if (pooled)
+							proxy.ProcessPooled(new PooledDataPacket {SequenceNumber = i, Data = data});
+						else
+							proxy.Process(new DataPacket {SequenceNumber = i, Data = data});
+					}
+
+					sw.Stop();
+					var collections = GC.CollectionCount(0) - collectionsBefore;
+
+					if (n == 1)
+						Console.WriteLine("{0}: {1:F0} gen0 collections per million calls, {2:F1}us per call",
+						                  pooled ? "Pooled" : "Not pooled",
+						                  collections * 1000000.0 / numCalls,
+						                  sw.Elapsed.TotalMilliseconds * 1000 / numCalls);
+				}
+			}
+
+			GC.KeepAlive(subject);
+		}
+
 		[Test]
 		public void TestGetProperty()
 		{
@@ -357,6 +1185,38 @@ namespace SharpRemote.Test.Remoting
 			GC.KeepAlive(subject);
 		}
 
+		[Test]
+		[PerformanceTest]
+		[NUnit.Framework.Description("Measures the round trip time of a method call which throws an exception")]
+		public void TestGetPropertyThrowExceptionPerformance()
+		{
+			var subject = new Mock<IGetDoubleProperty>();
+			subject.Setup(x => x.Value).Returns(() => { throw new ArgumentException("Foobar"); });
+
+			const int servantId = 48;
+			_server.CreateServant(servantId, subject.Object);
+			var proxy = _client.CreateProxy<IGetDoubleProperty>(servantId);
+
+			const int numCalls = 10000;
+			var sw = Stopwatch.StartNew();
+			for (int i = 0; i < numCalls; ++i)
+			{
+				try
+				{
+					double unused = proxy.Value;
+				}
+				catch (ArgumentException)
+				{}
+			}
+			sw.Stop();
+			Console.WriteLine("{0} failing calls: {1:F3}ms per call", numCalls, sw.Elapsed.TotalMilliseconds / numCalls);
+
+			// This line exists to FORCE the GC to NOT collect the subject, which
+			// in turn would unregister the servant from the server, thus making the test
+			// fail sporadically.
+			GC.KeepAlive(subject);
+		}
+
 		[Test]
 		[NUnit.Framework.Description(
 			"Verifies that if an exception could not be serialized, but can be re-constructed due to a default ctor, then it is thrown again"
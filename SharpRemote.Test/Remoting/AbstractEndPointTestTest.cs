@@ -318,6 +318,49 @@ namespace SharpRemote.Test.Remoting
 			}
 		}
 
+		[Test]
+		[Description("Verifies that a method invocation is rejected with a ServerBusyException once too many invocations are pending")]
+		public void TestServerBusy()
+		{
+			var endPointSettings = new EndPointSettings {MaxConcurrentInvocations = 1};
+			using (var server = CreateServer(endPointSettings: endPointSettings))
+			using (var client = CreateClient())
+			using (var executing = new ManualResetEventSlim())
+			using (var release = new ManualResetEventSlim())
+			{
+				Bind(server);
+				Connect(client, server.LocalEndPoint);
+
+				var subject = new Mock<IGetInt32Property>();
+				subject.Setup(x => x.Value).Returns(() =>
+				{
+					executing.Set();
+					release.Wait();
+					return 42;
+				});
+
+				server.CreateServant(0, subject.Object);
+				var proxy = client.CreateProxy<IGetInt32Property>(0);
+
+				var blockedCall = Task.Factory.StartNew(() => proxy.Value, TaskCreationOptions.LongRunning);
+				executing.Wait(TimeSpan.FromSeconds(5)).Should().BeTrue();
+				server.NumExecutingMethodInvocations.Should().Be(1);
+
+				new Action(() => { int unused = proxy.Value; })
+					.Should().Throw<ServerBusyException>();
+				server.NumRejectedMethodInvocations.Should().Be(1);
+				client.IsConnected.Should().BeTrue("because rejecting an invocation shouldn't tear down the connection");
+
+				release.Set();
+				blockedCall.Wait(TimeSpan.FromSeconds(5)).Should().BeTrue();
+				blockedCall.Result.Should().Be(42);
+
+				server.Property(x => x.NumExecutingMethodInvocations).ShouldEventually().Be(0);
+				proxy.Value.Should().Be(42, "because the quota should've been released again");
+				server.NumRejectedMethodInvocations.Should().Be(1);
+			}
+		}
+
 		[Test]
 		[Description("Verifies that SharpRemote manages situations in which a proxy of a subject is passed back to the endpoint which holds the subject")]
 		public void TestByReference()
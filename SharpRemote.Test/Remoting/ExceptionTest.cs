@@ -1,9 +1,13 @@
 ﻿using System;
+using System.Diagnostics;
 using System.IO;
 using System.Reflection;
+using System.Runtime.Serialization.Formatters.Binary;
 using System.Text;
 using FluentAssertions;
 using NUnit.Framework;
+using SharpRemote.CodeGeneration.Serialization.Binary;
+using SharpRemote.Test.Types.Exceptions;
 
 namespace SharpRemote.Test.Remoting
 {
@@ -48,5 +52,227 @@ namespace SharpRemote.Test.Remoting
 				}
 			}
 		}
+
+		[Test]
+		[Description("Verifies that message, inner exceptions and the additional fields of an exception are preserved")]
+		public void TestRoundtripInnerException()
+		{
+			var exception = Roundtrip(new ArgumentException("Foo", "bar", new InvalidOperationException("Inner")));
+			exception.Should().BeOfType<ArgumentException>();
+			exception.Message.Should().StartWith("Foo");
+			((ArgumentException) exception).ParamName.Should().Be("bar");
+			exception.InnerException.Should().BeOfType<InvalidOperationException>();
+			exception.InnerException.Message.Should().Be("Inner");
+		}
+
+		[Test]
+		[Description("Verifies that values an exception adds in GetObjectData are preserved")]
+		public void TestRoundtripCustomFields()
+		{
+			var exception = Roundtrip(new CustomFieldsException("Foo", 42, "Details", new WellBehavedCustomException("Inner")));
+			exception.Should().BeOfType<CustomFieldsException>();
+			var actual = (CustomFieldsException) exception;
+			actual.Message.Should().Be("Foo");
+			actual.Id.Should().Be(42);
+			actual.Details.Should().Be("Details");
+			actual.InnerException.Should().BeOfType<WellBehavedCustomException>();
+			actual.InnerException.Message.Should().Be("Inner");
+		}
+
+		[Test]
+		[Description("Verifies that fields and properties of an exception which are attributed with [DataMember] are preserved")]
+		public void TestRoundtripDataMembers()
+		{
+			var exception = Roundtrip(new DataMemberException("Foo", 42, "Because"));
+			exception.Should().BeOfType<DataMemberException>();
+			var actual = (DataMemberException) exception;
+			actual.Message.Should().Be("Foo");
+			actual.ErrorCode.Should().Be(42);
+			actual.Reason.Should().Be("Because");
+		}
+
+		[Test]
+		[Description("Verifies that inner exceptions which are nested too deeply are omitted instead of overflowing the stack")]
+		public void TestRoundtripDeeplyNestedInnerExceptions()
+		{
+			Exception original = new InvalidOperationException("0");
+			for (int i = 1; i < 10000; ++i)
+				original = new InvalidOperationException(i.ToString(), original);
+
+			var exception = Roundtrip(original);
+			exception.Message.Should().Be("9999");
+
+			int depth = 0;
+			for (var inner = exception.InnerException; inner != null; inner = inner.InnerException)
+				++depth;
+			depth.Should().Be(BinaryExceptionSerializer.MaxDepth);
+		}
+
+		[Test]
+		[Description("Verifies that reading inner exceptions which are nested too deeply is rejected")]
+		public void TestReadDeeplyNestedInnerExceptions()
+		{
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = new BinaryWriter(stream, Encoding.UTF8, true))
+				{
+					for (int i = 0; i < 10000; ++i)
+					{
+						writer.Write((byte) 0);
+						writer.Write(typeof(InvalidOperationException).AssemblyQualifiedName);
+						writer.Write(1);
+						writer.Write("InnerException");
+						writer.Write((byte) 16);
+					}
+				}
+
+				stream.Position = 0;
+				using (var reader = new BinaryReader(stream))
+				{
+					new Action(() => AbstractEndPoint.ReadException(reader))
+						.Should().Throw<SerializationException>();
+				}
+			}
+		}
+
+		[Test]
+		[Description("Verifies that the Data dictionary of an exception is preserved")]
+		public void TestRoundtripData()
+		{
+			var original = new InvalidOperationException("Foo");
+			original.Data.Add("Answer", 42);
+			original.Data.Add("Question", null);
+
+			var exception = Roundtrip(original);
+			exception.Data["Answer"].Should().Be(42);
+			exception.Data.Contains("Question").Should().BeTrue();
+		}
+
+		[Test]
+		[Description("Verifies that an exception which isn't serializable is replaced by an UnserializableException")]
+		public void TestRoundtripNonSerializableException()
+		{
+			var exception = Roundtrip(Throw(new NonSerializableExceptionButDefaultCtor()));
+			exception.Should().BeOfType<UnserializableException>();
+			((UnserializableException) exception).OriginalTypename.Should().Be(typeof(NonSerializableExceptionButDefaultCtor).AssemblyQualifiedName);
+		}
+
+		[Test]
+		[Description("Verifies that an exception which throws during serialization is replaced by an UnserializableException")]
+		public void TestRoundtripThrowsDuringSerialization()
+		{
+			var exception = Roundtrip(Throw(new ThrowsDuringSerialization()));
+			exception.Should().BeOfType<UnserializableException>();
+		}
+
+		[Test]
+		[Description("Verifies that only the inner exception is replaced when it isn't serializable")]
+		public void TestRoundtripNonSerializableInnerException()
+		{
+			var exception = Roundtrip(new InvalidOperationException("Foo", Throw(new NonSerializableExceptionButDefaultCtor())));
+			exception.Should().BeOfType<InvalidOperationException>();
+			exception.Message.Should().Be("Foo");
+			exception.InnerException.Should().BeOfType<UnserializableException>();
+		}
+
+		[Test]
+		[Description("Verifies that an exception of an unknown type is replaced by an UnserializableException")]
+		public void TestReadUnknownExceptionType()
+		{
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = new BinaryWriter(stream, Encoding.UTF8, true))
+				{
+					writer.Write((byte) 0);
+					writer.Write("SharpRemote.DoesNotExistException, SharpRemote.DoesNotExist");
+					writer.Write(0);
+					writer.Write(0);
+				}
+
+				stream.Position = 0;
+				using (var reader = new BinaryReader(stream))
+				{
+					var exception = AbstractEndPoint.ReadException(reader);
+					exception.Should().BeOfType<UnserializableException>();
+					stream.Position.Should().Be(stream.Length);
+				}
+			}
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Compares the time it takes to roundtrip an exception between the BinaryFormatter and the compiled serializer")]
+		public void TestRoundtripPerformance()
+		{
+			var exception = Throw(new ArgumentException("Something went wrong", "value", Throw(new InvalidOperationException("Inner"))));
+			const int numRepetitions = 10000;
+
+			var formatter = new BinaryFormatter();
+			var sw = Stopwatch.StartNew();
+			long length;
+			using (var stream = new MemoryStream())
+			{
+				for (int i = 0; i < numRepetitions; ++i)
+				{
+					stream.SetLength(0);
+					formatter.Serialize(stream, exception);
+					stream.Position = 0;
+					formatter.Deserialize(stream);
+				}
+				length = stream.Length;
+			}
+			Console.WriteLine("BinaryFormatter: {0:F1}µs per roundtrip, {1} bytes",
+			                  sw.Elapsed.TotalMilliseconds * 1000 / numRepetitions,
+			                  length);
+
+			sw.Restart();
+			using (var stream = new MemoryStream())
+			using (var writer = new BinaryWriter(stream, Encoding.UTF8, true))
+			using (var reader = new BinaryReader(stream, Encoding.UTF8, true))
+			{
+				for (int i = 0; i < numRepetitions; ++i)
+				{
+					stream.SetLength(0);
+					AbstractEndPoint.WriteException(writer, exception);
+					stream.Position = 0;
+					AbstractEndPoint.ReadException(reader);
+				}
+				length = stream.Length;
+			}
+			Console.WriteLine("Compiled: {0:F1}µs per roundtrip, {1} bytes",
+			                  sw.Elapsed.TotalMilliseconds * 1000 / numRepetitions,
+			                  length);
+		}
+
+		private static Exception Roundtrip(Exception exception)
+		{
+			using (var stream = new MemoryStream())
+			{
+				using (var writer = new BinaryWriter(stream, Encoding.UTF8, true))
+				{
+					AbstractEndPoint.WriteException(writer, exception);
+				}
+
+				stream.Position = 0;
+				using (var reader = new BinaryReader(stream))
+				{
+					var actualException = AbstractEndPoint.ReadException(reader);
+					stream.Position.Should().Be(stream.Length, "because the entire exception should've been read");
+					return actualException;
+				}
+			}
+		}
+
+		private static Exception Throw(Exception exception)
+		{
+			try
+			{
+				throw exception;
+			}
+			catch (Exception e)
+			{
+				return e;
+			}
+		}
 	}
 }
\ No newline at end of file
@@ -21,14 +21,24 @@ namespace SharpRemote.Test.Remoting.NamePipe
 			return ((NamedPipeRemotingEndPointClient)client).Servants;
 		}
 
-		protected override IRemotingEndPoint CreateClient()
+		protected override IRemotingEndPoint CreateClient(HeartbeatSettings heartbeatSettings = null,
+		                                                  LatencySettings latencySettings = null,
+		                                                  EndPointSettings endPointSettings = null)
 		{
-			return new NamedPipeRemotingEndPointClient("Client");
+			return new NamedPipeRemotingEndPointClient("Client",
+			                                           heartbeatSettings: heartbeatSettings,
+			                                           latencySettings: latencySettings,
+			                                           endPointSettings: endPointSettings);
 		}
 
-		protected override IRemotingEndPoint CreateServer()
+		protected override IRemotingEndPoint CreateServer(HeartbeatSettings heartbeatSettings = null,
+		                                                  LatencySettings latencySettings = null,
+		                                                  EndPointSettings endPointSettings = null)
 		{
-			return new NamedPipeRemotingEndPointServer("Server");
+			return new NamedPipeRemotingEndPointServer("Server",
+			                                           heartbeatSettings: heartbeatSettings,
+			                                           latencySettings: latencySettings,
+			                                           endPointSettings: endPointSettings);
 		}
 
 		protected override void Bind(IRemotingEndPoint server)
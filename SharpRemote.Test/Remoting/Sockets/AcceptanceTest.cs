@@ -21,14 +21,24 @@ namespace SharpRemote.Test.Remoting.Sockets
 			return ((SocketEndPoint) client).Servants;
 		}
 
-		protected override IRemotingEndPoint CreateClient()
+		protected override IRemotingEndPoint CreateClient(HeartbeatSettings heartbeatSettings = null,
+		                                                  LatencySettings latencySettings = null,
+		                                                  EndPointSettings endPointSettings = null)
 		{
-			return new SocketEndPoint(EndPointType.Client, "Client");
+			return new SocketEndPoint(EndPointType.Client, "Client",
+			                          heartbeatSettings: heartbeatSettings,
+			                          latencySettings: latencySettings,
+			                          endPointSettings: endPointSettings);
 		}
 
-		protected override IRemotingEndPoint CreateServer()
+		protected override IRemotingEndPoint CreateServer(HeartbeatSettings heartbeatSettings = null,
+		                                                  LatencySettings latencySettings = null,
+		                                                  EndPointSettings endPointSettings = null)
 		{
-			return new SocketEndPoint(EndPointType.Server, "Server");
+			return new SocketEndPoint(EndPointType.Server, "Server",
+			                          heartbeatSettings: heartbeatSettings,
+			                          latencySettings: latencySettings,
+			                          endPointSettings: endPointSettings);
 		}
 
 		protected override void Bind(IRemotingEndPoint server)
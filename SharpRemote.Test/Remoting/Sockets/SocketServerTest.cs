@@ -1,9 +1,14 @@
-﻿using System.Collections.Concurrent;
+﻿using System;
+using System.Collections.Concurrent;
+using System.Diagnostics;
 using System.Linq;
 using System.Net;
+using System.Threading;
+using System.Threading.Tasks;
 using FluentAssertions;
 using Moq;
 using NUnit.Framework;
+using SharpRemote.Test.Types.Classes;
 using SharpRemote.Test.Types.Interfaces.PrimitiveTypes;
 
 namespace SharpRemote.Test.Remoting.Sockets
@@ -155,6 +160,100 @@ namespace SharpRemote.Test.Remoting.Sockets
 			}
 		}
 
+		[Test]
+		[Description("Verifies that the amount of method invocations is limited over all connections of the server")]
+		public void TestServerBusy()
+		{
+			var endPointSettings = new EndPointSettings {MaxConcurrentServerInvocations = 1};
+			using (var server = new SocketServer("Server", endPointSettings: endPointSettings))
+			using (var client1 = CreateClient())
+			using (var client2 = CreateClient())
+			using (var executing = new ManualResetEventSlim())
+			using (var release = new ManualResetEventSlim())
+			{
+				const ulong objectId = 42;
+
+				var subject = new Mock<IGetInt32Property>();
+				subject.Setup(x => x.Value).Returns(() =>
+				{
+					executing.Set();
+					release.Wait();
+					return 1337;
+				});
+				server.RegisterSubject(objectId, subject.Object);
+
+				server.Bind(IPAddress.Loopback);
+				client1.Connect(server.LocalEndPoint);
+				client2.Connect(server.LocalEndPoint);
+
+				var proxy1 = client1.CreateProxy<IGetInt32Property>(objectId);
+				var proxy2 = client2.CreateProxy<IGetInt32Property>(objectId);
+
+				var blockedCall = Task.Factory.StartNew(() => proxy1.Value, TaskCreationOptions.LongRunning);
+				executing.Wait(TimeSpan.FromSeconds(5)).Should().BeTrue();
+
+				new Action(() => { int unused = proxy2.Value; })
+					.Should().Throw<ServerBusyException>("because the server's quota has been exhausted by another connection");
+				server.NumRejectedMethodInvocations.Should().Be(1);
+
+				release.Set();
+				blockedCall.Wait(TimeSpan.FromSeconds(5)).Should().BeTrue();
+				blockedCall.Result.Should().Be(1337);
+
+				server.Property(x => x.NumExecutingMethodInvocations).ShouldEventually().Be(0);
+				proxy2.Value.Should().Be(1337, "because the server's quota should've been released again");
+			}
+		}
+
+		[Test]
+		[PerformanceTest]
+		[Description("Measures the throughput of inbound calls when they are made by an increasing number of concurrently connected clients")]
+		public void TestConcurrentInboundCallsFromManyClients()
+		{
+			const ulong objectId = 42;
+			const int numCallsPerClient = 10000;
+
+			using (var server = CreateServer())
+			{
+				server.RegisterSubject<IGetInt32Property>(objectId, new Returns42());
+				server.Bind(IPAddress.Loopback);
+
+				foreach (var numClients in new[] {1, 2, 4, 8, 16})
+				{
+					var clients = Enumerable.Range(0, numClients).Select(unused => CreateClient()).ToList();
+					try
+					{
+						var proxies = clients.Select(client =>
+						{
+							client.Connect(server.LocalEndPoint);
+							var proxy = client.CreateProxy<IGetInt32Property>(objectId);
+							proxy.Value.Should().Be(42);
+							return proxy;
+						}).ToList();
+
+						var sw = Stopwatch.StartNew();
+						var callers = proxies.Select(proxy => Task.Factory.StartNew(() =>
+						{
+							for (int i = 0; i < numCallsPerClient; ++i)
+								proxy.Value.Should().Be(42);
+						}, TaskCreationOptions.LongRunning)).ToArray();
+						Task.WaitAll(callers);
+						sw.Stop();
+
+						var numCalls = numClients * numCallsPerClient;
+						Console.WriteLine("{0} client(s): {1:F0} calls/s",
+						                  numClients,
+						                  numCalls / sw.Elapsed.TotalSeconds);
+					}
+					finally
+					{
+						foreach (var client in clients)
+							client.Dispose();
+					}
+				}
+			}
+		}
+
 		private ISocketEndPoint CreateClient()
 		{
 			return new SocketEndPoint(EndPointType.Client,
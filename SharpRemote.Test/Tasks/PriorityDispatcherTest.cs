@@ -0,0 +1,94 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading;
+using System.Threading.Tasks;
+using FluentAssertions;
+using NUnit.Framework;
+using SharpRemote.Tasks;
+
+namespace SharpRemote.Test.Tasks
+{
+	[TestFixture]
+	public sealed class PriorityDispatcherTest
+		: AbstractTest
+	{
+		[Test]
+		public void TestCtor()
+		{
+			new Action(() => new PriorityDispatcher(0))
+				.Should().Throw<ArgumentOutOfRangeException>();
+
+			var dispatcher = new PriorityDispatcher(1);
+			dispatcher.NumQueuedTasks.Should().Be(0);
+		}
+
+		[Test]
+		public void TestQueueManyTasks()
+		{
+			var dispatcher = new PriorityDispatcher(4);
+			const int taskCount = 1000;
+			int numExecuted = 0;
+			var tasks = new List<Task>(taskCount);
+			for (int i = 0; i < taskCount; ++i)
+			{
+				var completionSource = new TaskCompletionSource<int>();
+				dispatcher.QueueTask(() => Interlocked.Increment(ref numExecuted), completionSource, (Priority) (i % 3));
+				tasks.Add(completionSource.Task);
+			}
+
+			Task.WaitAll(tasks.ToArray(), TimeSpan.FromSeconds(10))
+			    .Should().BeTrue();
+			numExecuted.Should().Be(taskCount);
+			dispatcher.NumQueuedTasks.Should().Be(0);
+		}
+
+		[Test]
+		public void TestException()
+		{
+			var dispatcher = new PriorityDispatcher(1);
+			var completionSource = new TaskCompletionSource<int>();
+			dispatcher.QueueTask(() => { throw new ArgumentException("Foobar"); }, completionSource, Priority.Normal);
+
+			new Action(() => completionSource.Task.Wait(TimeSpan.FromSeconds(10)))
+				.Should().Throw<AggregateException>()
+				.WithInnerException<ArgumentException>()
+				.WithMessage("Foobar");
+		}
+
+		[Test]
+		[Description("Verifies that a high priority task overtakes queued bulk tasks")]
+		public void TestHighPriorityOvertakesBulk()
+		{
+			var dispatcher = new PriorityDispatcher(1);
+			using (var blocker = new ManualResetEventSlim())
+			{
+				var order = new List<Priority>();
+				var tasks = new List<Task>();
+
+				var first = new TaskCompletionSource<int>();
+				dispatcher.QueueTask(() => blocker.Wait(), first, Priority.Bulk);
+				tasks.Add(first.Task);
+
+				for (int i = 0; i < 10; ++i)
+				{
+					var completionSource = new TaskCompletionSource<int>();
+					dispatcher.QueueTask(() => order.Add(Priority.Bulk), completionSource, Priority.Bulk);
+					tasks.Add(completionSource.Task);
+				}
+
+				var high = new TaskCompletionSource<int>();
+				dispatcher.QueueTask(() => order.Add(Priority.High), high, Priority.High);
+				tasks.Add(high.Task);
+
+				dispatcher.NumQueuedTasks.Should().BeGreaterOrEqualTo(11);
+				blocker.Set();
+
+				Task.WaitAll(tasks.ToArray(), TimeSpan.FromSeconds(10))
+				    .Should().BeTrue();
+				order.Should().HaveCount(11);
+				order.First().Should().Be(Priority.High);
+			}
+		}
+	}
+}
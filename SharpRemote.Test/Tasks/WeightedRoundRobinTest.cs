@@ -0,0 +1,51 @@
+﻿using System.Linq;
+using FluentAssertions;
+using NUnit.Framework;
+using SharpRemote.Tasks;
+
+namespace SharpRemote.Test.Tasks
+{
+	[TestFixture]
+	public sealed class WeightedRoundRobinTest
+	{
+		[Test]
+		public void TestNoLaneReady()
+		{
+			var roundRobin = WeightedRoundRobin.ForPriorities();
+			roundRobin.Count.Should().Be(3);
+			roundRobin.Next(0).Should().Be(-1);
+		}
+
+		[Test]
+		public void TestOneLaneReady()
+		{
+			var roundRobin = WeightedRoundRobin.ForPriorities();
+			for (int i = 0; i < 10; ++i)
+			{
+				roundRobin.Next(1 << (int) Priority.Bulk).Should().Be((int) Priority.Bulk);
+			}
+		}
+
+		[Test]
+		[Description("Verifies that each lane is served proportionally to its weight")]
+		public void TestProportions()
+		{
+			var roundRobin = new WeightedRoundRobin(3, 1);
+			var lanes = Enumerable.Range(0, 400).Select(unused => roundRobin.Next(0x3)).ToList();
+			lanes.Count(x => x == 0).Should().Be(300);
+			lanes.Count(x => x == 1).Should().Be(100);
+		}
+
+		[Test]
+		[Description("Verifies that the lane with the smallest weight is served at least once per round")]
+		public void TestNoStarvation()
+		{
+			var roundRobin = WeightedRoundRobin.ForPriorities();
+			const int allLanes = 0x7;
+			var lanes = Enumerable.Range(0, 21).Select(unused => roundRobin.Next(allLanes)).ToList();
+			lanes.Count(x => x == (int) Priority.High).Should().Be(16);
+			lanes.Count(x => x == (int) Priority.Normal).Should().Be(4);
+			lanes.Count(x => x == (int) Priority.Bulk).Should().Be(1);
+		}
+	}
+}
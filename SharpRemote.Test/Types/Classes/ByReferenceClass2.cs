@@ -0,0 +1,20 @@
+﻿using SharpRemote.Test.Types.Interfaces;
+
+namespace SharpRemote.Test.Types.Classes
+{
+	public sealed class ByReferenceClass2
+		: IByReferenceType
+	{
+		private readonly int _value;
+
+		public ByReferenceClass2(int value)
+		{
+			_value = value;
+		}
+
+		public int Value
+		{
+			get { return _value; }
+		}
+	}
+}
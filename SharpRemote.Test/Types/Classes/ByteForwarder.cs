@@ -0,0 +1,30 @@
+﻿using System;
+using SharpRemote.Test.Types.Interfaces;
+
+namespace SharpRemote.Test.Types.Classes
+{
+	/// <summary>
+	///     Returns the received bytes without their first byte.
+	/// </summary>
+	public sealed class ByteForwarder
+		: IByteForwarder
+	{
+		public ArraySegment<byte> Forward(ArraySegment<byte> value)
+		{
+			if (value.Array == null || value.Count == 0)
+				return value;
+
+			return new ArraySegment<byte>(value.Array, value.Offset + 1, value.Count - 1);
+		}
+
+		public byte[] ForwardArray(byte[] value)
+		{
+			if (value == null || value.Length == 0)
+				return value;
+
+			var ret = new byte[value.Length - 1];
+			Buffer.BlockCopy(value, 1, ret, 0, ret.Length);
+			return ret;
+		}
+	}
+}
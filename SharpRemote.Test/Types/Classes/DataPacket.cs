@@ -0,0 +1,12 @@
+﻿using System.Runtime.Serialization;
+
+namespace SharpRemote.Test.Types.Classes
+{
+	[DataContract]
+	public sealed class DataPacket
+	{
+		[DataMember] public int SequenceNumber;
+
+		[DataMember] public byte[] Data;
+	}
+}
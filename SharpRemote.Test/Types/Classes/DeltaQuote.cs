@@ -0,0 +1,27 @@
+﻿using System;
+using System.Runtime.Serialization;
+
+namespace SharpRemote.Test.Types.Classes
+{
+	/// <summary>
+	///     Same shape as <see cref="Quote" />, but only those members which changed since the last
+	///     snapshot of the same <see cref="Symbol" /> are written.
+	/// </summary>
+	[DataContract]
+	[DeltaEncoded]
+	public sealed class DeltaQuote
+	{
+		[DataMember] [DeltaKey] public string Symbol;
+
+		[DataMember] public double Bid;
+
+		[DataMember] public double Ask;
+
+		[DataMember] public long Volume;
+
+		[DataMember] public DateTime Time;
+
+		[DataMember]
+		public string Exchange { get; set; }
+	}
+}
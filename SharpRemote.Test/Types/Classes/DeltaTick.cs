@@ -0,0 +1,16 @@
+﻿using System.Runtime.Serialization;
+
+namespace SharpRemote.Test.Types.Classes
+{
+	/// <summary>
+	///     Keeps at most two streams (i.e. symbols) per connection.
+	/// </summary>
+	[DataContract]
+	[DeltaEncoded(MaxStreams = 2)]
+	public sealed class DeltaTick
+	{
+		[DataMember] [DeltaKey] public string Symbol;
+
+		[DataMember] public double Price;
+	}
+}
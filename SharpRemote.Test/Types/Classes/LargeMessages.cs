@@ -0,0 +1,34 @@
+﻿using SharpRemote.Test.Types.Interfaces;
+using SharpRemote.Test.Types.Structs;
+
+namespace SharpRemote.Test.Types.Classes
+{
+	public sealed class LargeMessages
+		: ILargeMessages
+	{
+		public FieldVector3[] GetVectors(int count)
+		{
+			var values = new FieldVector3[count];
+			for (int i = 0; i < count; ++i)
+			{
+				values[i] = new FieldVector3 {X = i, Y = -i, Z = i * 0.5};
+			}
+			return values;
+		}
+
+		public int SetVectors(FieldVector3[] values)
+		{
+			return values != null ? values.Length : 0;
+		}
+
+		public string GetString(int length)
+		{
+			var characters = new char[length];
+			for (int i = 0; i < length; ++i)
+			{
+				characters[i] = i % 2 == 0 ? 'a' : 'ä';
+			}
+			return new string(characters);
+		}
+	}
+}
@@ -0,0 +1,23 @@
+﻿using SharpRemote.Test.Types.Interfaces;
+
+namespace SharpRemote.Test.Types.Classes
+{
+	/// <summary>
+	///     Returns every pooled packet to the <see cref="InstancePool" /> once it has been processed.
+	/// </summary>
+	public sealed class PacketSink
+		: IPacketSink
+	{
+		public int Process(DataPacket packet)
+		{
+			return packet.Data.Length;
+		}
+
+		public int ProcessPooled(PooledDataPacket packet)
+		{
+			var length = packet.Data.Length;
+			InstancePool.Return(packet);
+			return length;
+		}
+	}
+}
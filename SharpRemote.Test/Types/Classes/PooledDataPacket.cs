@@ -0,0 +1,17 @@
+﻿using System.Runtime.Serialization;
+
+namespace SharpRemote.Test.Types.Classes
+{
+	/// <summary>
+	///     Same shape as <see cref="DataPacket" />, but rented from the <see cref="InstancePool" />
+	///     upon deserialization.
+	/// </summary>
+	[DataContract]
+	[Pooled(ReuseArrays = true)]
+	public sealed class PooledDataPacket
+	{
+		[DataMember] public int SequenceNumber;
+
+		[DataMember] public byte[] Data;
+	}
+}
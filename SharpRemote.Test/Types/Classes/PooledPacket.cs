@@ -0,0 +1,20 @@
+﻿using System.Runtime.Serialization;
+
+namespace SharpRemote.Test.Types.Classes
+{
+	/// <summary>
+	///     Is rented from the <see cref="InstancePool" /> upon deserialization and reads its
+	///     <see cref="Data" /> into the array of the rented instance whenever possible.
+	/// </summary>
+	[DataContract]
+	[Pooled(ReuseArrays = true)]
+	public sealed class PooledPacket
+	{
+		[DataMember] public int SequenceNumber;
+
+		[DataMember] public byte[] Data;
+
+		[DataMember]
+		public byte[] Header { get; set; }
+	}
+}
@@ -0,0 +1,22 @@
+﻿using System;
+using System.Runtime.Serialization;
+
+namespace SharpRemote.Test.Types.Classes
+{
+	[DataContract]
+	public sealed class Quote
+	{
+		[DataMember] public string Symbol;
+
+		[DataMember] public double Bid;
+
+		[DataMember] public double Ask;
+
+		[DataMember] public long Volume;
+
+		[DataMember] public DateTime Time;
+
+		[DataMember]
+		public string Exchange { get; set; }
+	}
+}
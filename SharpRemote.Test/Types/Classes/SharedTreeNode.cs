@@ -0,0 +1,17 @@
+﻿using System.Runtime.Serialization;
+
+namespace SharpRemote.Test.Types.Classes
+{
+	/// <summary>
+	///     Same shape as <see cref="BinaryTreeNode" />, but opts into reference preservation:
+	///     Shared nodes (and cycles) survive a roundtrip.
+	/// </summary>
+	[DataContract(IsReference = true)]
+	public sealed class SharedTreeNode
+	{
+		[DataMember] public SharedTreeNode Left;
+
+		[DataMember] public SharedTreeNode Right;
+		[DataMember] public double Value;
+	}
+}
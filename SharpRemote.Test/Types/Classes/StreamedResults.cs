@@ -0,0 +1,67 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading;
+using SharpRemote.Test.Types.Interfaces;
+
+namespace SharpRemote.Test.Types.Classes
+{
+	public sealed class StreamedResults
+		: IStreamedResults
+	{
+		private int _numProduced;
+		private int _numEnumerationsDisposed;
+
+		public int NumProduced => Volatile.Read(ref _numProduced);
+
+		public int NumEnumerationsDisposed => Volatile.Read(ref _numEnumerationsDisposed);
+
+		public IEnumerable<int> Range(int count)
+		{
+			try
+			{
+				for (int i = 0; i < count; ++i)
+				{
+					Interlocked.Increment(ref _numProduced);
+					yield return i;
+				}
+			}
+			finally
+			{
+				Interlocked.Increment(ref _numEnumerationsDisposed);
+			}
+		}
+
+		public IEnumerable<string> Slow(int count, int delayInMilliseconds)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				Thread.Sleep(delayInMilliseconds);
+				yield return i.ToString();
+			}
+		}
+
+		public IEnumerable<int> ThrowAfter(int count)
+		{
+			for (int i = 0; i < count; ++i)
+				yield return i;
+
+			throw new ArgumentException("The sequence has ended");
+		}
+
+		public IEnumerable<int> Null()
+		{
+			return null;
+		}
+
+		public IEnumerable<int> RangeWithIdleTimeout(int count)
+		{
+			return Range(count);
+		}
+
+		public int[] MaterializedRange(int count)
+		{
+			return Enumerable.Range(0, count).ToArray();
+		}
+	}
+}
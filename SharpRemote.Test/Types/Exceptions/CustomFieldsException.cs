@@ -0,0 +1,42 @@
+﻿using System;
+using System.Runtime.Serialization;
+
+namespace SharpRemote.Test.Types.Exceptions
+{
+	/// <summary>
+	///     An exception which stores additional fields in <see cref="GetObjectData" />.
+	/// </summary>
+	[Serializable]
+	public sealed class CustomFieldsException
+		: Exception
+	{
+		private readonly int _id;
+		private readonly string _details;
+
+		public CustomFieldsException(string message, int id, string details, Exception innerException = null)
+			: base(message, innerException)
+		{
+			_id = id;
+			_details = details;
+		}
+
+		private CustomFieldsException(SerializationInfo info, StreamingContext context)
+			: base(info, context)
+		{
+			_id = info.GetInt32("Id");
+			_details = info.GetString("Details");
+		}
+
+		public int Id => _id;
+
+		public string Details => _details;
+
+		public override void GetObjectData(SerializationInfo info, StreamingContext context)
+		{
+			base.GetObjectData(info, context);
+
+			info.AddValue("Id", _id);
+			info.AddValue("Details", _details);
+		}
+	}
+}
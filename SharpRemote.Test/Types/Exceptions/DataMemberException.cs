@@ -0,0 +1,33 @@
+﻿using System;
+using System.Runtime.Serialization;
+
+namespace SharpRemote.Test.Types.Exceptions
+{
+	/// <summary>
+	///     An exception whose additional state is only described by <see cref="DataMemberAttribute" />s:
+	///     Neither <see cref="Exception.GetObjectData" /> nor its deserialization constructor know about it.
+	/// </summary>
+	[Serializable]
+	public sealed class DataMemberException
+		: Exception
+	{
+		[DataMember]
+		private int _errorCode;
+
+		public DataMemberException(string message, int errorCode, string reason)
+			: base(message)
+		{
+			_errorCode = errorCode;
+			Reason = reason;
+		}
+
+		private DataMemberException(SerializationInfo info, StreamingContext context)
+			: base(info, context)
+		{ }
+
+		public int ErrorCode => _errorCode;
+
+		[DataMember]
+		public string Reason { get; set; }
+	}
+}
@@ -0,0 +1,11 @@
+﻿using System;
+
+namespace SharpRemote.Test.Types.Interfaces
+{
+	public interface IByteForwarder
+	{
+		ArraySegment<byte> Forward(ArraySegment<byte> value);
+
+		byte[] ForwardArray(byte[] value);
+	}
+}
@@ -0,0 +1,10 @@
+﻿using System;
+
+namespace SharpRemote.Test.Types.Interfaces
+{
+	public interface ICoalescedEventReturnsValue
+	{
+		[Coalesce]
+		event Func<int> Foo;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+﻿using System;
+using SharpRemote.Attributes;
+
+namespace SharpRemote.Test.Types.Interfaces
+{
+	public interface ICoalescedEvents
+	{
+		[Coalesce(MaxRate = 20)]
+		event Action<int> Progress;
+
+		[Coalesce]
+		event Action Tick;
+
+		[AsyncRemote]
+		event Action<int> UncoalescedProgress;
+	}
+}
\ No newline at end of file
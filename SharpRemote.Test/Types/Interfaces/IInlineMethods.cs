@@ -0,0 +1,10 @@
+﻿namespace SharpRemote.Test.Types.Interfaces
+{
+	public interface IInlineMethods
+	{
+		[Invoke(Dispatch.Inline)]
+		int GetInline();
+
+		int GetDefault();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+﻿using System.Threading.Tasks;
+
+namespace SharpRemote.Test.Types.Interfaces
+{
+	public interface IInlineReturnsTask
+	{
+		[Invoke(Dispatch.Inline)]
+		Task DoStuff();
+	}
+}
\ No newline at end of file
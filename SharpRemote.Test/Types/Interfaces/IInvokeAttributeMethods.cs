@@ -21,5 +21,8 @@
 
 		[Invoke(Dispatch.SerializePerMethod)]
 		void SerializePerMethod2();
+
+		[Invoke(Dispatch.Inline)]
+		void Inline();
 	}
 }
\ No newline at end of file
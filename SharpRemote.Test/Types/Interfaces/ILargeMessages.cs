@@ -0,0 +1,13 @@
+﻿using SharpRemote.Test.Types.Structs;
+
+namespace SharpRemote.Test.Types.Interfaces
+{
+	public interface ILargeMessages
+	{
+		FieldVector3[] GetVectors(int count);
+
+		int SetVectors(FieldVector3[] values);
+
+		string GetString(int length);
+	}
+}
@@ -0,0 +1,11 @@
+﻿using SharpRemote.Test.Types.Classes;
+
+namespace SharpRemote.Test.Types.Interfaces
+{
+	public interface IPacketSink
+	{
+		int Process(DataPacket packet);
+
+		int ProcessPooled(PooledDataPacket packet);
+	}
+}
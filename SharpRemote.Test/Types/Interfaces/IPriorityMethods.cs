@@ -0,0 +1,13 @@
+﻿namespace SharpRemote.Test.Types.Interfaces
+{
+	public interface IPriorityMethods
+	{
+		[Priority(Priority.High)]
+		int GetStatus();
+
+		int GetValue();
+
+		[Priority(Priority.Bulk)]
+		void Upload(byte[] data);
+	}
+}
\ No newline at end of file
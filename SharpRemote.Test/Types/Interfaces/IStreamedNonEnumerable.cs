@@ -0,0 +1,8 @@
+﻿namespace SharpRemote.Test.Types.Interfaces
+{
+	public interface IStreamedNonEnumerable
+	{
+		[Streamed]
+		int[] Foo();
+	}
+}
@@ -0,0 +1,24 @@
+﻿using System.Collections.Generic;
+
+namespace SharpRemote.Test.Types.Interfaces
+{
+	public interface IStreamedResults
+	{
+		[Streamed]
+		IEnumerable<int> Range(int count);
+
+		[Streamed(ChunkSize = 16)]
+		IEnumerable<string> Slow(int count, int delayInMilliseconds);
+
+		[Streamed]
+		IEnumerable<int> ThrowAfter(int count);
+
+		[Streamed]
+		IEnumerable<int> Null();
+
+		[Streamed(IdleTimeoutMilliseconds = 100)]
+		IEnumerable<int> RangeWithIdleTimeout(int count);
+
+		int[] MaterializedRange(int count);
+	}
+}
@@ -0,0 +1,69 @@
+﻿using System;
+using System.Runtime.Serialization;
+using SharpRemote.Test.Types.Enums;
+
+namespace SharpRemote.Test.Types.Structs
+{
+	[DataContract]
+	[Columnar]
+	public struct ColumnarTick : IEquatable<ColumnarTick>
+	{
+		[DataMember] public long Timestamp;
+
+		[DataMember] public double Price;
+
+		[DataMember] public int Quantity;
+
+		[DataMember] public ByteEnum Side;
+
+		[DataMember] public bool IsTrade;
+
+		[DataMember] public float? Yield;
+
+		[DataMember] public string Venue;
+
+		[DataMember]
+		public Int32Enum Flags { get; set; }
+
+		public int NotSerialized;
+
+		public bool Equals(ColumnarTick other)
+		{
+			return Timestamp == other.Timestamp && Price.Equals(other.Price) && Quantity == other.Quantity &&
+			       Side == other.Side && IsTrade == other.IsTrade && Yield.Equals(other.Yield) &&
+			       string.Equals(Venue, other.Venue) && Flags == other.Flags &&
+			       NotSerialized == other.NotSerialized;
+		}
+
+		public override bool Equals(object obj)
+		{
+			if (ReferenceEquals(null, obj)) return false;
+			return obj is ColumnarTick && Equals((ColumnarTick) obj);
+		}
+
+		public override int GetHashCode()
+		{
+			unchecked
+			{
+// ReSharper disable NonReadonlyFieldInGetHashCode
+				var hashCode = Timestamp.GetHashCode();
+				hashCode = (hashCode*397) ^ Price.GetHashCode();
+				hashCode = (hashCode*397) ^ Quantity;
+				hashCode = (hashCode*397) ^ Yield.GetHashCode();
+				hashCode = (hashCode*397) ^ (Venue != null ? Venue.GetHashCode() : 0);
+				return hashCode;
+// ReSharper restore NonReadonlyFieldInGetHashCode
+			}
+		}
+
+		public static bool operator ==(ColumnarTick left, ColumnarTick right)
+		{
+			return left.Equals(right);
+		}
+
+		public static bool operator !=(ColumnarTick left, ColumnarTick right)
+		{
+			return !left.Equals(right);
+		}
+	}
+}
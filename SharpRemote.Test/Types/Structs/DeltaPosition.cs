@@ -0,0 +1,16 @@
+﻿using System.Runtime.Serialization;
+
+namespace SharpRemote.Test.Types.Structs
+{
+	[DataContract]
+	[DeltaEncoded(SnapshotInterval = 4)]
+	public struct DeltaPosition
+	{
+		[DataMember] public int X;
+
+		[DataMember] public int Y;
+
+		[DataMember]
+		public string Name { get; set; }
+	}
+}
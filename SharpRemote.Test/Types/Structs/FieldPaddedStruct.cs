@@ -0,0 +1,44 @@
+﻿using System;
+using System.Runtime.Serialization;
+
+namespace SharpRemote.Test.Types.Structs
+{
+	[DataContract]
+	public struct FieldPaddedStruct : IEquatable<FieldPaddedStruct>
+	{
+		[DataMember] public byte A;
+
+		[DataMember] public int B;
+
+		public bool Equals(FieldPaddedStruct other)
+		{
+			return A == other.A && B == other.B;
+		}
+
+		public override bool Equals(object obj)
+		{
+			if (ReferenceEquals(null, obj)) return false;
+			return obj is FieldPaddedStruct && Equals((FieldPaddedStruct) obj);
+		}
+
+		public override int GetHashCode()
+		{
+			unchecked
+			{
+// ReSharper disable NonReadonlyFieldInGetHashCode
+				return (A.GetHashCode()*397) ^ B;
+// ReSharper restore NonReadonlyFieldInGetHashCode
+			}
+		}
+
+		public static bool operator ==(FieldPaddedStruct left, FieldPaddedStruct right)
+		{
+			return left.Equals(right);
+		}
+
+		public static bool operator !=(FieldPaddedStruct left, FieldPaddedStruct right)
+		{
+			return !left.Equals(right);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+﻿using System;
+using System.Runtime.Serialization;
+
+namespace SharpRemote.Test.Types.Structs
+{
+	[DataContract]
+	public struct FieldVector3 : IEquatable<FieldVector3>
+	{
+		[DataMember] public double X;
+
+		[DataMember] public double Y;
+
+		[DataMember] public double Z;
+
+		public bool Equals(FieldVector3 other)
+		{
+			return X.Equals(other.X) && Y.Equals(other.Y) && Z.Equals(other.Z);
+		}
+
+		public override bool Equals(object obj)
+		{
+			if (ReferenceEquals(null, obj)) return false;
+			return obj is FieldVector3 && Equals((FieldVector3) obj);
+		}
+
+		public override int GetHashCode()
+		{
+			unchecked
+			{
+// ReSharper disable NonReadonlyFieldInGetHashCode
+				return (((X.GetHashCode()*397) ^ Y.GetHashCode())*397) ^ Z.GetHashCode();
+// ReSharper restore NonReadonlyFieldInGetHashCode
+			}
+		}
+
+		public static bool operator ==(FieldVector3 left, FieldVector3 right)
+		{
+			return left.Equals(right);
+		}
+
+		public static bool operator !=(FieldVector3 left, FieldVector3 right)
+		{
+			return !left.Equals(right);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+﻿using System.Runtime.Serialization;
+
+namespace SharpRemote.Test.Types.Structs
+{
+	[DataContract]
+	[Columnar]
+	public struct NonFlatColumnarStruct
+	{
+		[DataMember] public int Count;
+
+		[DataMember] public int[] Values;
+	}
+}
@@ -0,0 +1,29 @@
+﻿using System.Runtime.Serialization;
+using SharpRemote.Test.Types.Enums;
+
+namespace SharpRemote.Test.Types.Structs
+{
+	/// <summary>
+	///     Same members as <see cref="ColumnarTick" />, but serialized row by row.
+	/// </summary>
+	[DataContract]
+	public struct RowTick
+	{
+		[DataMember] public long Timestamp;
+
+		[DataMember] public double Price;
+
+		[DataMember] public int Quantity;
+
+		[DataMember] public ByteEnum Side;
+
+		[DataMember] public bool IsTrade;
+
+		[DataMember] public float? Yield;
+
+		[DataMember] public string Venue;
+
+		[DataMember]
+		public Int32Enum Flags { get; set; }
+	}
+}
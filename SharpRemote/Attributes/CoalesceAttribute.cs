@@ -0,0 +1,39 @@
+﻿using System;
+
+namespace SharpRemote
+{
+	/// <summary>
+	///     Can be applied to events which are raised at a high frequency, but whose subscribers
+	///     are only ever interested in the latest value (for example progress notifications):
+	///     Instead of sending one message per raise, the servant delivers the event at most
+	///     <see cref="MaxRate" /> times per second. When the event is raised more often than that,
+	///     only the arguments of the latest raise are delivered and all others are dropped.
+	/// </summary>
+	/// <remarks>
+	///     A coalesced event is always delivered asynchronously: Raising it never blocks and
+	///     any exception thrown by the subscriber is swallowed.
+	///     The delegate type of a coalesced event must not return a value.
+	/// </remarks>
+	[AttributeUsage(AttributeTargets.Event)]
+	public sealed class CoalesceAttribute
+		: Attribute
+	{
+		/// <summary>
+		///     The default amount of deliveries per second.
+		/// </summary>
+		public const int DefaultMaxRate = 10;
+
+		/// <summary>
+		///     Initializes this object.
+		/// </summary>
+		public CoalesceAttribute()
+		{
+			MaxRate = DefaultMaxRate;
+		}
+
+		/// <summary>
+		///     The maximum amount of times per second the attributed event is delivered to the proxy.
+		/// </summary>
+		public int MaxRate { get; set; }
+	}
+}
@@ -0,0 +1,25 @@
+﻿using System;
+
+// ReSharper disable CheckNamespace
+namespace SharpRemote
+// ReSharper restore CheckNamespace
+{
+	/// <summary>
+	///     Can be applied to [DataContract] structs in order to have arrays and lists of them serialized
+	///     column by column instead of element by element: The values of each data member of all elements
+	///     are written one after another before the next data member follows.
+	/// </summary>
+	/// <remarks>
+	///     Columns of numeric, enum and boolean members are written as one raw block of memory and
+	///     nullable numeric members as a bitmap of which elements have a value, followed by those values.
+	///     Such a layout is both faster to read and write and compresses much better than
+	///     the interleaved one.
+	///     The struct may not have any serialization callbacks: Columnar types are meant to be
+	///     flat records of values.
+	/// </remarks>
+	[AttributeUsage(AttributeTargets.Struct, Inherited = false)]
+	public sealed class ColumnarAttribute
+		: Attribute
+	{
+	}
+}
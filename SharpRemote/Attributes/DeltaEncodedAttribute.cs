@@ -0,0 +1,64 @@
+﻿using System;
+
+// ReSharper disable CheckNamespace
+namespace SharpRemote
+// ReSharper restore CheckNamespace
+{
+	/// <summary>
+	///     Can be applied to [DataContract] types which are sent repeatedly with only a few changes in between:
+	///     Instead of writing the entire value every time, serializers which support delta encoding only write
+	///     those data members which differ from the last full snapshot sent over the same connection.
+	/// </summary>
+	/// <remarks>
+	///     Every <see cref="SnapshotInterval" />th value is written in full (a snapshot) and all values in between
+	///     are written as the difference to that snapshot. Each value refers to the version of the snapshot it is
+	///     based on and the receiver keeps the current and the previous snapshot, hence a delta may be read after
+	///     a newer snapshot. A delta can however never be read before the snapshot it refers to:
+	///     Values which share the same <see cref="DeltaKeyAttribute" /> member must therefore be sent one after
+	///     the other (i.e. the next value must not be serialized before the previous one has been handed to
+	///     the connection), otherwise the receiver may fail with a <see cref="SerializationException" />.
+	///     Values which share the same <see cref="DeltaKeyAttribute" /> member form one stream of snapshots and
+	///     deltas: Types without such a member have exactly one stream per connection.
+	///     At most <see cref="MaxStreams" /> streams are kept per connection: The least recently used one
+	///     is discarded when another key is sent and the next value with the discarded key is a snapshot again.
+	///     Only data members of primitive types, enums, strings and <see cref="DateTime" /> can be omitted: Members
+	///     of any other type are always written.
+	/// </remarks>
+	[AttributeUsage(AttributeTargets.Class | AttributeTargets.Struct, Inherited = false)]
+	public sealed class DeltaEncodedAttribute
+		: Attribute
+	{
+		/// <summary>
+		///     The default number of values after which another snapshot is written.
+		/// </summary>
+		public const int DefaultSnapshotInterval = 32;
+
+		/// <summary>
+		///     The default number of streams (i.e. distinct <see cref="DeltaKeyAttribute" /> values) which are
+		///     kept per connection.
+		/// </summary>
+		public const int DefaultMaxStreams = 1024;
+
+		/// <summary>
+		///     Initializes this object.
+		/// </summary>
+		public DeltaEncodedAttribute()
+		{
+			SnapshotInterval = DefaultSnapshotInterval;
+			MaxStreams = DefaultMaxStreams;
+		}
+
+		/// <summary>
+		///     The number of values after which another snapshot is written (in full).
+		///     A value of 1 effectively disables delta encoding.
+		/// </summary>
+		public int SnapshotInterval { get; set; }
+
+		/// <summary>
+		///     The number of streams (i.e. distinct <see cref="DeltaKeyAttribute" /> values) which are kept
+		///     per connection before the least recently used one is discarded.
+		///     The receiver keeps twice as many so that it doesn't discard a stream the sender still uses.
+		/// </summary>
+		public int MaxStreams { get; set; }
+	}
+}
@@ -0,0 +1,17 @@
+﻿using System;
+
+// ReSharper disable CheckNamespace
+namespace SharpRemote
+// ReSharper restore CheckNamespace
+{
+	/// <summary>
+	///     Marks the data member of a <see cref="DeltaEncodedAttribute" /> type which identifies the stream
+	///     a value belongs to: Each distinct key is delta encoded against its own snapshot.
+	///     The member must be of a primitive type, an enum, a string or a <see cref="DateTime" />.
+	/// </summary>
+	[AttributeUsage(AttributeTargets.Field | AttributeTargets.Property)]
+	public sealed class DeltaKeyAttribute
+		: Attribute
+	{
+	}
+}
@@ -16,6 +16,10 @@ namespace SharpRemote
 	///     object with the same invokation-type are serialized and executed one after the other
 	///     - <see cref="Dispatch.SerializePerType" />: Concurrent invocations of this method AND any other method on the SAME
 	///     interface with the same invokation-type are serialized and executed one after the other
+	///     - <see cref="Dispatch.Inline" />: Invocations of this method (or property/event) are executed synchronously on the
+	///     thread reading from the connection, which avoids the cost of scheduling a task for very short methods.
+	///     Such a method must never call back into the remote endpoint synchronously because this deadlocks the thread
+	///     reading from the connection (see <see cref="Dispatch.Inline" />)
 	/// </summary>
 	[AttributeUsage(AttributeTargets.Event | AttributeTargets.Method | AttributeTargets.Property)]
 	public class InvokeAttribute
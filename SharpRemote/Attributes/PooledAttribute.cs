@@ -0,0 +1,50 @@
+﻿using System;
+
+// ReSharper disable CheckNamespace
+namespace SharpRemote
+// ReSharper restore CheckNamespace
+{
+	/// <summary>
+	///     Can be applied to [DataContract] classes in order to have the deserializer rent instances from
+	///     the <see cref="InstancePool" /> instead of allocating a new instance for every value read.
+	/// </summary>
+	/// <remarks>
+	///     Whoever receives a pooled object (for example a servant) decides when it isn't needed anymore
+	///     and hands it back via <see cref="InstancePool.Return" />. Objects which are never returned are
+	///     simply collected by the GC.
+	///     An object must NEVER be returned more than once: The pool would hand it out twice and two
+	///     deserialized values would silently share (and overwrite) the same object. Only debug builds detect this.
+	///     A rented object is not reset: Its data members are overwritten by the deserializer, any other
+	///     fields keep the values they had when the object was returned.
+	/// </remarks>
+	[AttributeUsage(AttributeTargets.Class, Inherited = false)]
+	public sealed class PooledAttribute
+		: Attribute
+	{
+		/// <summary>
+		///     The default maximum amount of instances kept per type.
+		/// </summary>
+		public const int DefaultMaximumSize = 1024;
+
+		/// <summary>
+		///     Initializes this object.
+		/// </summary>
+		public PooledAttribute()
+		{
+			MaximumSize = DefaultMaximumSize;
+		}
+
+		/// <summary>
+		///     The maximum amount of returned instances the pool keeps for later reuse.
+		///     Instances returned to a full pool are left to the GC.
+		/// </summary>
+		public int MaximumSize { get; set; }
+
+		/// <summary>
+		///     When set to true, byte[] data members of a rented instance are reused (and overwritten)
+		///     when the deserialized array has the same length, instead of allocating a new array.
+		///     This means that returning an instance to the pool also gives up ownership of these arrays.
+		/// </summary>
+		public bool ReuseArrays { get; set; }
+	}
+}
@@ -0,0 +1,54 @@
+﻿using System;
+
+// ReSharper disable CheckNamespace
+namespace SharpRemote
+// ReSharper restore CheckNamespace
+{
+	/// <summary>
+	///     Is attached to assemblies produced by <see cref="CodeGeneration.CodeGenerator.Pregenerate" />
+	///     and maps an interface to the proxy and servant which have been generated for it.
+	/// </summary>
+	/// <remarks>
+	///     This attribute is not supposed to be attached by hand.
+	/// </remarks>
+	[AttributeUsage(AttributeTargets.Assembly, AllowMultiple = true)]
+	public sealed class PregeneratedCodeAttribute
+		: Attribute
+	{
+		/// <summary>
+		///     Initializes this attribute.
+		/// </summary>
+		/// <param name="interfaceType"></param>
+		/// <param name="proxyType"></param>
+		/// <param name="servantType"></param>
+		/// <param name="key"></param>
+		public PregeneratedCodeAttribute(Type interfaceType, Type proxyType, Type servantType, string key)
+		{
+			InterfaceType = interfaceType;
+			ProxyType = proxyType;
+			ServantType = servantType;
+			Key = key;
+		}
+
+		/// <summary>
+		///     The interface the code has been generated for.
+		/// </summary>
+		public Type InterfaceType { get; }
+
+		/// <summary>
+		///     The proxy which has been generated for <see cref="InterfaceType" />.
+		/// </summary>
+		public Type ProxyType { get; }
+
+		/// <summary>
+		///     The servant which has been generated for <see cref="InterfaceType" />.
+		/// </summary>
+		public Type ServantType { get; }
+
+		/// <summary>
+		///     Identifies the exact builds of all types which took part in generating the code:
+		///     The code is not used when this key no longer matches.
+		/// </summary>
+		public string Key { get; }
+	}
+}
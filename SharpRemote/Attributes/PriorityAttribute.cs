@@ -0,0 +1,35 @@
+﻿using System;
+
+namespace SharpRemote
+{
+	/// <summary>
+	///     Can be used to specify the priority with which a certain event or method should be sent by the calling
+	///     endpoint and invoked by the called endpoint.
+	///     By default, all methods are invoked with <see cref="SharpRemote.Priority.Normal" />.
+	/// </summary>
+	/// <remarks>
+	///     The priority is only honoured for methods which are not serialized (<see cref="Dispatch.DoNotSerialize" />)
+	///     as serialized methods are executed in order of arrival by definition.
+	///     The called endpoint only starts invocations by their priority when
+	///     <see cref="EndPointSettings.MaxParallelInvocations" /> is set, otherwise every invocation is
+	///     started right away.
+	/// </remarks>
+	[AttributeUsage(AttributeTargets.Event | AttributeTargets.Method)]
+	public class PriorityAttribute
+		: Attribute
+	{
+		/// <summary>
+		///     Initializes this object.
+		/// </summary>
+		/// <param name="priority"></param>
+		public PriorityAttribute(Priority priority)
+		{
+			Priority = priority;
+		}
+
+		/// <summary>
+		///     The priority with which the attributed method shall be sent and invoked.
+		/// </summary>
+		public Priority Priority { get; set; }
+	}
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+﻿using System;
+using System.Collections.Generic;
+
+namespace SharpRemote
+{
+	/// <summary>
+	///     Can be applied to methods returning <see cref="IEnumerable{T}" /> in order to stream their result
+	///     to the caller instead of serializing it as a whole:
+	///     The caller immediately obtains a lazy enumerable which pulls the items from the servant in chunks
+	///     of at most <see cref="ChunkSize" /> items while it is being enumerated.
+	/// </summary>
+	/// <remarks>
+	///     The servant only produces the next chunk once the caller asked for it and the caller never requests more
+	///     than one chunk ahead of the item it is currently consuming: A slow consumer therefore automatically slows
+	///     the producer down and neither side buffers the entire sequence.
+	///     The first chunk only contains a single item so that the caller can start consuming as soon as possible,
+	///     subsequent chunks grow up to <see cref="ChunkSize" />.
+	///     A streamed result can only be enumerated once and the servant side enumeration lives until the
+	///     sequence has been fully enumerated, the enumerator has been disposed of, the connection is dropped or
+	///     the caller didn't ask for another chunk for <see cref="IdleTimeoutMilliseconds" />: The latter ends
+	///     enumerations which the caller abandoned without disposing of them (or never started).
+	///     Asking for another chunk after the enumeration timed out throws an <see cref="InvalidOperationException" />.
+	/// </remarks>
+	[AttributeUsage(AttributeTargets.Method)]
+	public sealed class StreamedAttribute
+		: Attribute
+	{
+		/// <summary>
+		///     The default maximum amount of items per chunk.
+		/// </summary>
+		public const int DefaultChunkSize = 1024;
+
+		/// <summary>
+		///     The default amount of time after which an enumeration the caller didn't ask for another chunk of
+		///     is ended by the servant.
+		/// </summary>
+		public const int DefaultIdleTimeoutMilliseconds = 60 * 1000;
+
+		/// <summary>
+		///     Initializes this object.
+		/// </summary>
+		public StreamedAttribute()
+		{
+			ChunkSize = DefaultChunkSize;
+			IdleTimeoutMilliseconds = DefaultIdleTimeoutMilliseconds;
+		}
+
+		/// <summary>
+		///     The maximum amount of items which are transmitted in one chunk.
+		/// </summary>
+		public int ChunkSize { get; set; }
+
+		/// <summary>
+		///     The amount of time after which the servant ends an enumeration the caller didn't ask for another
+		///     chunk of. A value of zero or less disables the timeout: Abandoned enumerations then live until
+		///     the connection is dropped.
+		/// </summary>
+		public int IdleTimeoutMilliseconds { get; set; }
+	}
+}
@@ -1,5 +1,7 @@
 using System;
+using System.Collections.Generic;
 using System.Threading;
+using SharpRemote.Tasks;
 
 namespace SharpRemote
 {
@@ -11,8 +13,12 @@ namespace SharpRemote
 		private readonly SemaphoreSlim _enqueueSemaphore;
 		private readonly object _syncRoot;
 		private readonly T[] _values;
+		private readonly Queue<T> _highPriorityValues;
+		private readonly Queue<T> _bulkValues;
+		private readonly WeightedRoundRobin _roundRobin;
 
 		private int _count;
+		private int _normalCount;
 		private int _dequeueIndex;
 		private int _enqueueIndex;
 
@@ -23,6 +29,9 @@ namespace SharpRemote
 
 			_syncRoot = new object();
 			_values = new T[maximumCapacity];
+			_highPriorityValues = new Queue<T>();
+			_bulkValues = new Queue<T>();
+			_roundRobin = WeightedRoundRobin.ForPriorities();
 			_dequeueIndex = 0;
 			_dequeueIndex = 0;
 			_count = 0;
@@ -56,13 +65,41 @@ namespace SharpRemote
 		/// <param name="value"></param>
 		/// <exception cref="OperationCanceledException">When this collection has been disposed of</exception>
 		public void Enqueue(T value)
+		{
+			Enqueue(value, Priority.Normal);
+		}
+
+		/// <summary>
+		///     Adds the given item, blocks if the maximum capacity has been reached until at least one
+		///     item has been retrieved.
+		///     Items of different priorities are retrieved in a weighted fair manner, see <see cref="WeightedRoundRobin" />.
+		/// </summary>
+		/// <param name="value"></param>
+		/// <param name="priority"></param>
+		/// <exception cref="OperationCanceledException">When this collection has been disposed of</exception>
+		public void Enqueue(T value, Priority priority)
 		{
 			_enqueueSemaphore.Wait(_cancellationRequested.Token);
 
 			lock (_syncRoot)
 			{
-				_values[_enqueueIndex] = value;
-				_enqueueIndex = (_enqueueIndex + 1)%_values.Length;
+				switch (priority)
+				{
+					case Priority.High:
+						_highPriorityValues.Enqueue(value);
+						break;
+
+					case Priority.Bulk:
+						_bulkValues.Enqueue(value);
+						break;
+
+					default:
+						_values[_enqueueIndex] = value;
+						_enqueueIndex = (_enqueueIndex + 1)%_values.Length;
+						++_normalCount;
+						break;
+				}
+
 				_dequeueSemaphore.Release();
 				++_count;
 			}
@@ -78,13 +115,46 @@ namespace SharpRemote
 
 			lock (_syncRoot)
 			{
-				T value = _values[_dequeueIndex];
-				_values[_dequeueIndex] = default(T);
-				_dequeueIndex = (_dequeueIndex + 1)%_values.Length;
+				T value;
+				switch (NextPriority())
+				{
+					case Priority.High:
+						value = _highPriorityValues.Dequeue();
+						break;
+
+					case Priority.Bulk:
+						value = _bulkValues.Dequeue();
+						break;
+
+					default:
+						value = _values[_dequeueIndex];
+						_values[_dequeueIndex] = default(T);
+						_dequeueIndex = (_dequeueIndex + 1)%_values.Length;
+						--_normalCount;
+						break;
+				}
+
 				_enqueueSemaphore.Release();
 				--_count;
 				return value;
 			}
 		}
+
+		private Priority NextPriority()
+		{
+			// Fast path: As long as only normal priority items are used, there's nothing to choose from
+			if (_normalCount == _count)
+				return Priority.Normal;
+
+			int readyLanes = 0;
+			if (_normalCount > 0)
+				readyLanes |= 1 << (int) Priority.Normal;
+			if (_highPriorityValues.Count > 0)
+				readyLanes |= 1 << (int) Priority.High;
+			if (_bulkValues.Count > 0)
+				readyLanes |= 1 << (int) Priority.Bulk;
+
+			return (Priority) _roundRobin.Next(readyLanes);
+		}
 	}
 }
\ No newline at end of file
@@ -1,6 +1,12 @@
 using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
 using System.Reflection;
 using System.Reflection.Emit;
+using System.Security.Cryptography;
+using System.Text;
+using log4net;
 using SharpRemote.CodeGeneration.Remoting;
 
 namespace SharpRemote.CodeGeneration
@@ -12,6 +18,8 @@ namespace SharpRemote.CodeGeneration
 	public sealed class CodeGenerator
 		: ICodeGenerator
 	{
+		private static readonly ILog Log = LogManager.GetLogger(MethodBase.GetCurrentMethod().DeclaringType);
+
 		private static ICodeGenerator _defaultGenerator;
 		private static readonly object DefaultGeneratorConstructionSyncRoot = new object();
 
@@ -57,9 +65,20 @@ namespace SharpRemote.CodeGeneration
 		///     <see cref="AppDomain.CurrentDomain" />. THIS ASSEMBLY CANNOT BE UNLOADED UNLESS THE APPDOMAIN IS.
 		///     Do not create new instances of this type if you can easily re-use an existing instance or
 		///     you will consume more and more memory.
+		///     Proxies and servants which have been generated at build time by <see cref="Pregenerate" />
+		///     are used instead of generating them again.
 		/// </remarks>
 		/// <param name="customTypeResolver">Type resolver that should be used instead of <see cref="TypeResolver" /></param>
 		public CodeGenerator(ITypeResolver customTypeResolver = null)
+			: this(customTypeResolver, new PregeneratedCode())
+		{}
+
+		/// <summary>
+		///     Initializes this object.
+		/// </summary>
+		/// <param name="customTypeResolver">Type resolver that should be used instead of <see cref="TypeResolver" /></param>
+		/// <param name="pregeneratedCode">The code generated at build time, if any</param>
+		internal CodeGenerator(ITypeResolver customTypeResolver, PregeneratedCode pregeneratedCode)
 		{
 			var assemblyName = new AssemblyName("SharpRemote.GeneratedCode");
 
@@ -74,8 +93,299 @@ namespace SharpRemote.CodeGeneration
 			var module = assembly.DefineDynamicModule(moduleName);
 
 			var serializer = new BinarySerializer(module, customTypeResolver);
-			_proxyCreator = new RemotingProxyCreator(module, serializer);
-			_servantCreator = new ServantCreator(module, serializer);
+			_proxyCreator = new RemotingProxyCreator(module, serializer, pregeneratedCode);
+			_servantCreator = new ServantCreator(module, serializer, pregeneratedCode);
+		}
+
+		/// <summary>
+		///     Initializes this object and provides the proxies and servants for the given interfaces
+		///     from an on-disk cache: If <paramref name="cacheDirectory" /> already contains an assembly which
+		///     has been generated for the very same types, then that assembly is loaded instead of generating the code again.
+		///     Otherwise the code is generated and saved to <paramref name="cacheDirectory" /> so that
+		///     subsequent processes can simply load it.
+		/// </summary>
+		/// <remarks>
+		///     The cached assembly is identified by a hash over the <see cref="TypeModel" /> of the given interfaces
+		///     (i.e. every type which takes part in their methods) as well as over the exact builds of SharpRemote
+		///     and of all assemblies declaring those types: Changing any of them causes the code to be generated again.
+		///     Proxies and servants for interfaces which haven't been specified are still generated on-demand.
+		///     .NET Core cannot save dynamic assemblies and therefore the code is always generated there.
+		/// </remarks>
+		/// <param name="interfaceTypes">The interfaces for which proxies and servants should be provided</param>
+		/// <param name="cacheDirectory">The directory where generated assemblies are stored</param>
+		/// <param name="customTypeResolver">Type resolver that should be used instead of <see cref="TypeResolver" /></param>
+		/// <exception cref="ArgumentNullException">When <paramref name="interfaceTypes" /> or <paramref name="cacheDirectory" /> is null</exception>
+		/// <exception cref="ArgumentException">When any of the given types is not an interface</exception>
+		public CodeGenerator(IEnumerable<Type> interfaceTypes, string cacheDirectory, ITypeResolver customTypeResolver = null)
+			: this(customTypeResolver)
+		{
+			if (interfaceTypes == null)
+				throw new ArgumentNullException(nameof(interfaceTypes));
+			if (cacheDirectory == null)
+				throw new ArgumentNullException(nameof(cacheDirectory));
+
+			var interfaces = GetInterfaces(interfaceTypes);
+
+#if DOTNETCORE
+			foreach (var interfaceType in interfaces)
+			{
+				_proxyCreator.GenerateProxy(interfaceType);
+				_servantCreator.GenerateServant(interfaceType);
+			}
+#else
+			var proxies = new Dictionary<Type, Type>();
+			var servants = new Dictionary<Type, Type>();
+			LoadOrGenerate(interfaces, cacheDirectory, customTypeResolver, proxies, servants);
+
+			foreach (var interfaceType in interfaces)
+			{
+				_proxyCreator.AddProxy(interfaceType, proxies[interfaceType]);
+				_servantCreator.AddServant(interfaceType, servants[interfaceType]);
+			}
+#endif
+		}
+
+		/// <summary>
+		///     Generates proxies and servants for the given interfaces and saves them to an assembly
+		///     in <paramref name="outputDirectory" />. This is supposed to be done at build time, for example
+		///     by a post-build step: When the resulting assembly is deployed next to the assembly which declares
+		///     the interfaces, then <see cref="CodeGenerator" /> uses its proxies and servants instead of
+		///     generating them at runtime.
+		/// </summary>
+		/// <remarks>
+		///     Pregenerated code is only used as long as the assemblies declaring the types which take part
+		///     in the interfaces' methods (as well as SharpRemote itself) are the very builds the code has
+		///     been generated for. Otherwise it is ignored and the code is generated at runtime.
+		///     Proxies and servants of interfaces for which no code has been pregenerated are
+		///     generated at runtime, too.
+		/// </remarks>
+		/// <param name="interfaceTypes">The interfaces for which proxies and servants should be generated, all of which must be declared in the same assembly</param>
+		/// <param name="outputDirectory">The directory the assembly should be saved to</param>
+		/// <param name="customTypeResolver">Type resolver that should be used instead of <see cref="TypeResolver" /></param>
+		/// <returns>The path of the saved assembly</returns>
+		/// <exception cref="ArgumentNullException">When <paramref name="interfaceTypes" /> or <paramref name="outputDirectory" /> is null</exception>
+		/// <exception cref="ArgumentException">When any of the given types is not an interface or when they are declared in different assemblies</exception>
+		/// <exception cref="NotSupportedException">On .NET Core which cannot save dynamic assemblies</exception>
+		public static string Pregenerate(IEnumerable<Type> interfaceTypes, string outputDirectory, ITypeResolver customTypeResolver = null)
+		{
+			if (interfaceTypes == null)
+				throw new ArgumentNullException(nameof(interfaceTypes));
+			if (outputDirectory == null)
+				throw new ArgumentNullException(nameof(outputDirectory));
+
+			var interfaces = GetInterfaces(interfaceTypes);
+			var assemblies = interfaces.Select(x => x.Assembly).Distinct().ToList();
+			if (assemblies.Count != 1)
+				throw new ArgumentException(string.Format("All interfaces must be declared in the same assembly, but they are declared in: {0}",
+				                                          string.Join(", ", assemblies.Select(x => x.GetName().Name))));
+
+#if DOTNETCORE
+			throw new NotSupportedException("Dynamic assemblies cannot be saved on .NET Core");
+#else
+			var assemblyName = PregeneratedCode.GetAssemblyName(assemblies[index: 0]);
+			Directory.CreateDirectory(outputDirectory);
+			GenerateAndSave(assemblyName, outputDirectory, interfaces, customTypeResolver,
+			                new Dictionary<Type, Type>(), new Dictionary<Type, Type>());
+			return Path.Combine(outputDirectory, assemblyName + ".dll");
+#endif
+		}
+
+		private static List<Type> GetInterfaces(IEnumerable<Type> interfaceTypes)
+		{
+			var interfaces = interfaceTypes.Distinct().ToList();
+			foreach (var interfaceType in interfaces)
+			{
+				if (!interfaceType.IsInterface)
+					throw new ArgumentException(string.Format("Proxies can only be created for interfaces: {0} is not an interface", interfaceType));
+			}
+			return interfaces;
+		}
+
+		/// <summary>
+		///     Computes the key under which the code generated for the given interfaces is cached.
+		/// </summary>
+		/// <param name="interfaceTypes"></param>
+		/// <returns></returns>
+		internal static string ComputeCacheKey(IEnumerable<Type> interfaceTypes)
+		{
+			var typeModel = new TypeModel();
+			foreach (var interfaceType in interfaceTypes)
+				typeModel.Add(interfaceType, assumeByReference: true);
+
+			// The generated code not only depends on the types' names, but on their
+			// exact layout as well as on the code generator itself: The module version id
+			// changes with every build of an assembly and thus covers all of that.
+			var builder = new StringBuilder();
+			builder.AppendLine(typeof(CodeGenerator).Module.ModuleVersionId.ToString());
+			foreach (var description in typeModel.Types.OrderBy(x => x.AssemblyQualifiedName, StringComparer.Ordinal))
+			{
+				builder.AppendFormat("{0}|{1}", description.AssemblyQualifiedName, description.Type.Module.ModuleVersionId);
+				builder.AppendLine();
+			}
+
+			using (var algorithm = SHA256.Create())
+			{
+				var hash = algorithm.ComputeHash(Encoding.UTF8.GetBytes(builder.ToString()));
+				return string.Concat(hash.Take(16).Select(x => x.ToString("x2")));
+			}
+		}
+
+#if !DOTNETCORE
+		private static void LoadOrGenerate(IReadOnlyList<Type> interfaces,
+		                                   string cacheDirectory,
+		                                   ITypeResolver customTypeResolver,
+		                                   Dictionary<Type, Type> proxies,
+		                                   Dictionary<Type, Type> servants)
+		{
+			var assemblyName = string.Format("SharpRemote.GeneratedCode.{0}", ComputeCacheKey(interfaces));
+			var fileName = assemblyName + ".dll";
+			var path = Path.Combine(cacheDirectory, fileName);
+
+			if (File.Exists(path))
+			{
+				try
+				{
+					var assembly = Assembly.LoadFrom(path);
+					foreach (var interfaceType in interfaces)
+					{
+						proxies.Add(interfaceType, assembly.GetType(RemotingProxyCreator.GetProxyTypeName(interfaceType), throwOnError: true));
+						servants.Add(interfaceType, assembly.GetType(ServantCreator.GetSubjectTypeName(interfaceType), throwOnError: true));
+					}
+
+					Log.DebugFormat("Loaded proxies and servants for {0} interface(s) from '{1}'", interfaces.Count, path);
+					return;
+				}
+				catch (Exception e)
+				{
+					Log.WarnFormat("Unable to load cached proxies and servants from '{0}', generating them again: {1}", path, e);
+					proxies.Clear();
+					servants.Clear();
+					TryDelete(path);
+				}
+			}
+
+			// The assembly is saved to a directory of its own and only then moved to its final location
+			// so that other processes never observe (and load) a partially written file.
+			var temporaryDirectory = Path.Combine(cacheDirectory, Guid.NewGuid().ToString("N"));
+			Directory.CreateDirectory(temporaryDirectory);
+			try
+			{
+				try
+				{
+					GenerateAndSave(assemblyName, temporaryDirectory, interfaces, customTypeResolver, proxies, servants);
+					File.Move(Path.Combine(temporaryDirectory, fileName), path);
+					Log.DebugFormat("Saved proxies and servants for {0} interface(s) to '{1}'", interfaces.Count, path);
+				}
+				catch (IOException e)
+				{
+					// Most likely another process has been faster than us...
+					Log.WarnFormat("Unable to save proxies and servants to '{0}': {1}", path, e);
+				}
+			}
+			finally
+			{
+				TryDelete(temporaryDirectory);
+			}
+		}
+
+		private static void GenerateAndSave(string assemblyName,
+		                                    string directory,
+		                                    IReadOnlyList<Type> interfaces,
+		                                    ITypeResolver customTypeResolver,
+		                                    Dictionary<Type, Type> proxies,
+		                                    Dictionary<Type, Type> servants)
+		{
+			var fileName = assemblyName + ".dll";
+			var assembly = AppDomain.CurrentDomain.DefineDynamicAssembly(new AssemblyName(assemblyName),
+			                                                             AssemblyBuilderAccess.RunAndSave,
+			                                                             directory);
+			var module = assembly.DefineDynamicModule(assemblyName, fileName);
+			var serializer = new BinarySerializer(module, customTypeResolver);
+			var proxyCreator = new RemotingProxyCreator(module, serializer);
+			var servantCreator = new ServantCreator(module, serializer);
+			var attributeCtor = typeof(PregeneratedCodeAttribute).GetConstructor(new[] {typeof(Type), typeof(Type), typeof(Type), typeof(string)});
+			foreach (var interfaceType in interfaces)
+			{
+				var proxyType = proxyCreator.GenerateProxy(interfaceType);
+				var servantType = servantCreator.GenerateServant(interfaceType);
+				proxies.Add(interfaceType, proxyType);
+				servants.Add(interfaceType, servantType);
+
+				var key = ComputeCacheKey(new[] {interfaceType});
+				assembly.SetCustomAttribute(new CustomAttributeBuilder(attributeCtor, new object[] {interfaceType, proxyType, servantType, key}));
+			}
+
+			assembly.Save(fileName);
+		}
+
+		private static void TryDelete(string path)
+		{
+			try
+			{
+				if (Directory.Exists(path))
+					Directory.Delete(path, recursive: true);
+				else
+					File.Delete(path);
+			}
+			catch (Exception e)
+			{
+				Log.WarnFormat("Unable to delete '{0}': {1}", path, e);
+			}
+		}
+#endif
+
+		/// <summary>
+		///     Generates the proxies and servants (as well as the serialization methods they require) for
+		///     the given interfaces upfront so that the first calls on them don't have to wait for any code
+		///     to be generated.
+		/// </summary>
+		/// <remarks>
+		///     The interfaces are prepared one after the other: Proxies, servants and serialization methods are all
+		///     emitted into the same dynamic module, one type at a time. Interfaces for which no proxy or servant
+		///     can be generated are reported through <see cref="PreparedType.Exception" /> instead of throwing.
+		/// </remarks>
+		/// <param name="interfaceTypes">The interfaces to prepare</param>
+		/// <returns>The outcome of preparing each interface, in the same order as <paramref name="interfaceTypes" /></returns>
+		/// <exception cref="ArgumentNullException">When <paramref name="interfaceTypes" /> is null</exception>
+		public IReadOnlyList<PreparedType> Prepare(IEnumerable<Type> interfaceTypes)
+		{
+			if (interfaceTypes == null)
+				throw new ArgumentNullException(nameof(interfaceTypes));
+
+			var preparedTypes = interfaceTypes.Select(x => PreparedType.Prepare(x, PrepareInterface)).ToList();
+
+			foreach (var preparedType in preparedTypes)
+				Log.DebugFormat("Prepared {0}", preparedType);
+
+			return preparedTypes;
+		}
+
+		/// <summary>
+		///     Generates the proxies and servants (as well as the serialization methods they require) for
+		///     all public interfaces of the given assemblies upfront so that the first calls on them don't
+		///     have to wait for any code to be generated.
+		/// </summary>
+		/// <remarks>
+		///     Interfaces for which no proxy or servant can be generated (for example because they aren't
+		///     supposed to be remoted in the first place) are reported through <see cref="PreparedType.Exception" />.
+		/// </remarks>
+		/// <param name="assemblies">The assemblies whose interfaces shall be prepared</param>
+		/// <returns>The outcome of preparing each interface</returns>
+		/// <exception cref="ArgumentNullException">When <paramref name="assemblies" /> is null</exception>
+		public IReadOnlyList<PreparedType> Prepare(params Assembly[] assemblies)
+		{
+			if (assemblies == null)
+				throw new ArgumentNullException(nameof(assemblies));
+
+			var interfaces = assemblies.SelectMany(x => x.GetExportedTypes())
+			                           .Where(x => x.IsInterface && !x.ContainsGenericParameters);
+			return Prepare(interfaces);
+		}
+
+		private void PrepareInterface(Type interfaceType)
+		{
+			_proxyCreator.GenerateProxy(interfaceType);
+			_servantCreator.GenerateServant(interfaceType);
 		}
 
 		/// <inheritdoc />
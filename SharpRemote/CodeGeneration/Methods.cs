@@ -5,6 +5,8 @@ using System.Linq;
 using System.Reflection;
 using System.Threading;
 using System.Threading.Tasks;
+using SharpRemote.CodeGeneration.Serialization;
+using SharpRemote.Streaming;
 using SharpRemote.Tasks;
 
 namespace SharpRemote.CodeGeneration
@@ -13,6 +15,8 @@ namespace SharpRemote.CodeGeneration
 	{
 		public static readonly MethodInfo ChannelCallRemoteMethod;
 		public static readonly MethodInfo ChannelCallRemoteAsyncMethod;
+		public static readonly MethodInfo ChannelCallRemoteMethodWithPriority;
+		public static readonly MethodInfo ChannelCallRemoteAsyncMethodWithPriority;
 		public static readonly MethodInfo ReadDouble;
 		public static readonly MethodInfo GrainGetObjectId;
 		public static readonly MethodInfo GrainGetSerializer;
@@ -43,6 +47,7 @@ namespace SharpRemote.CodeGeneration
 		public static readonly FieldInfo StringEmpty;
 		public static readonly MethodInfo GrainInvoke;
 		public static readonly MethodInfo GrainGetTaskScheduler;
+		public static readonly MethodInfo GrainGetDispatchingStrategy;
 		public static readonly MethodInfo GrainGetInterfaceType;
 		public static readonly MethodInfo StringEquality;
 		public static readonly MethodInfo ReadBytes;
@@ -93,6 +98,34 @@ namespace SharpRemote.CodeGeneration
 		public static readonly MethodInfo StringFormat3Objects;
 		public static readonly MethodInfo TypeGetTypeFromHandle;
 		public static readonly ConstructorInfo SerialTaskSchedulerCtor;
+		public static readonly ConstructorInfo EventCoalescerCtor;
+		public static readonly MethodInfo EventCoalescerPost;
+		public static readonly MethodInfo EventCoalescerDispose;
+		public static readonly ConstructorInfo FuncObjectArrayToMemoryStreamCtor;
+		public static readonly MethodInfo DisposableDispose;
+		public static readonly MethodInfo StreamedEnumerableWrite;
+		public static readonly MethodInfo StreamedEnumerableRead;
+		public static readonly MethodInfo BinarySerializerWriteBlittableArray;
+		public static readonly MethodInfo BinarySerializerReadBlittableArray;
+		public static readonly MethodInfo BinarySerializerWriteBlittableArrayCount;
+		public static readonly MethodInfo BinarySerializerGetColumn;
+		public static readonly MethodInfo BinarySerializerGetEmptyColumn;
+		public static readonly MethodInfo BinarySerializerCopyToColumn;
+		public static readonly MethodInfo BinarySerializerReadColumn;
+		public static readonly MethodInfo BinarySerializerWriteNullableColumn;
+		public static readonly MethodInfo BinarySerializerReadNullableColumn;
+		public static readonly MethodInfo BinarySerializerReturnColumn;
+		public static readonly MethodInfo BinarySerializerGetStringSize;
+		public static readonly MethodInfo BinarySerializerGetStringArraySize;
+		public static readonly MethodInfo BinarySerializerGetArraySize;
+		public static readonly MethodInfo BinarySerializerCreateStream;
+		public static readonly MethodInfo BinarySerializerReserve;
+		public static readonly MethodInfo BinarySerializerReadBytes;
+		public static readonly MethodInfo InstancePoolRent;
+		public static readonly MethodInfo DeltaEncodingGetOutgoingStream;
+		public static readonly MethodInfo DeltaEncodingGetIncomingStream;
+		public static readonly MethodInfo MonitorEnter;
+		public static readonly MethodInfo MonitorExit;
 		public static readonly MethodInfo DebuggerNotifyOfCrossThreadDependency;
 		public static readonly ConstructorInfo NullableUInt64Ctor;
 		public static readonly ConstructorInfo NoSuchServantExceptionCtor;
@@ -113,10 +146,13 @@ namespace SharpRemote.CodeGeneration
 			GrainInvoke = typeof (IGrain).GetMethod("Invoke");
 			GrainGetInterfaceType = typeof (IGrain).GetMethod("get_InterfaceType");
 			GrainGetTaskScheduler = typeof (IGrain).GetMethod("GetTaskScheduler");
+			GrainGetDispatchingStrategy = typeof (IGrain).GetMethod("GetDispatchingStrategy");
 
 			ObjectCtor = typeof(object).GetConstructor(new Type[0]);
-			ChannelCallRemoteMethod = typeof(IEndPointChannel).GetMethod("CallRemoteMethod");
-			ChannelCallRemoteAsyncMethod = typeof (IEndPointChannel).GetMethod("CallRemoteMethodAsync");
+			ChannelCallRemoteMethod = typeof(IEndPointChannel).GetMethod("CallRemoteMethod", new[] {typeof(ulong), typeof(string), typeof(string), typeof(MemoryStream)});
+			ChannelCallRemoteAsyncMethod = typeof (IEndPointChannel).GetMethod("CallRemoteMethodAsync", new[] {typeof(ulong), typeof(string), typeof(string), typeof(MemoryStream)});
+			ChannelCallRemoteMethodWithPriority = typeof(IEndPointChannel).GetMethod("CallRemoteMethod", new[] {typeof(ulong), typeof(string), typeof(string), typeof(MemoryStream), typeof(Priority)});
+			ChannelCallRemoteAsyncMethodWithPriority = typeof (IEndPointChannel).GetMethod("CallRemoteMethodAsync", new[] {typeof(ulong), typeof(string), typeof(string), typeof(MemoryStream), typeof(Priority)});
 
 			ObjectReferenceEquals = typeof(object).GetMethod(nameof(ReferenceEquals));
 
@@ -227,6 +263,46 @@ namespace SharpRemote.CodeGeneration
 					typeof (bool)
 				});
 
+			EventCoalescerCtor = typeof(EventCoalescer).GetConstructor(new[]
+				{
+					typeof(IEndPointChannel),
+					typeof(ulong),
+					typeof(string),
+					typeof(string),
+					typeof(Priority),
+					typeof(int),
+					typeof(Func<object[], MemoryStream>)
+				});
+			EventCoalescerPost = typeof(EventCoalescer).GetMethod(nameof(EventCoalescer.Post));
+			EventCoalescerDispose = typeof(EventCoalescer).GetMethod(nameof(EventCoalescer.Dispose));
+			FuncObjectArrayToMemoryStreamCtor = typeof(Func<object[], MemoryStream>).GetConstructor(new[] {typeof(object), typeof(IntPtr)});
+			DisposableDispose = typeof(IDisposable).GetMethod(nameof(IDisposable.Dispose));
+
+			StreamedEnumerableWrite = typeof(StreamedEnumerable).GetMethod(nameof(StreamedEnumerable.Write));
+			StreamedEnumerableRead = typeof(StreamedEnumerable).GetMethod(nameof(StreamedEnumerable.Read));
+
+			BinarySerializerWriteBlittableArray = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.WriteBlittableArray), new[] {typeof(BinaryWriter), typeof(Array), typeof(int)});
+			BinarySerializerReadBlittableArray = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.ReadBlittableArray), new[] {typeof(BinaryReader), typeof(Array), typeof(int)});
+			BinarySerializerWriteBlittableArrayCount = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.WriteBlittableArray), new[] {typeof(BinaryWriter), typeof(Array), typeof(int), typeof(int)});
+			BinarySerializerGetColumn = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.GetColumn));
+			BinarySerializerGetEmptyColumn = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.GetEmptyColumn));
+			BinarySerializerCopyToColumn = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.CopyToColumn));
+			BinarySerializerReadColumn = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.ReadColumn));
+			BinarySerializerWriteNullableColumn = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.WriteNullableColumn));
+			BinarySerializerReadNullableColumn = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.ReadNullableColumn));
+			BinarySerializerReturnColumn = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.ReturnColumn));
+			BinarySerializerGetStringSize = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.GetSerializedSize), new[] {typeof(string)});
+			BinarySerializerGetStringArraySize = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.GetSerializedSize), new[] {typeof(string[])});
+			BinarySerializerGetArraySize = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.GetSerializedSize), new[] {typeof(Array), typeof(int)});
+			BinarySerializerCreateStream = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.CreateStream));
+			BinarySerializerReserve = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.Reserve));
+			BinarySerializerReadBytes = typeof(BinarySerializer).GetMethod(nameof(BinarySerializer.ReadBytes), new[] {typeof(BinaryReader), typeof(byte[])});
+			InstancePoolRent = typeof(InstancePool).GetMethod(nameof(InstancePool.Rent));
+			DeltaEncodingGetOutgoingStream = typeof(DeltaEncoding).GetMethod(nameof(DeltaEncoding.GetOutgoingStream));
+			DeltaEncodingGetIncomingStream = typeof(DeltaEncoding).GetMethod(nameof(DeltaEncoding.GetIncomingStream));
+			MonitorEnter = typeof(Monitor).GetMethod(nameof(Monitor.Enter), new[] {typeof(object)});
+			MonitorExit = typeof(Monitor).GetMethod(nameof(Monitor.Exit), new[] {typeof(object)});
+
 			DebuggerNotifyOfCrossThreadDependency = typeof (Debugger).GetMethod("NotifyOfCrossThreadDependency");
 
 			NullableUInt64Ctor = typeof (ulong?).GetConstructors().First();
@@ -0,0 +1,123 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Reflection;
+using log4net;
+
+namespace SharpRemote.CodeGeneration
+{
+	/// <summary>
+	///     Provides access to proxies and servants which have been generated at build time
+	///     by <see cref="CodeGenerator.Pregenerate" />.
+	/// </summary>
+	/// <remarks>
+	///     Code generated for the interfaces of an assembly is looked for in an assembly named
+	///     "&lt;assembly name&gt;.SharpRemote.dll" which resides in the same directory.
+	/// </remarks>
+	internal sealed class PregeneratedCode
+	{
+		private static readonly ILog Log = LogManager.GetLogger(MethodBase.GetCurrentMethod().DeclaringType);
+
+		private readonly Func<Assembly, string> _getPath;
+		private readonly Dictionary<Assembly, Dictionary<Type, PregeneratedCodeAttribute>> _assemblies;
+
+		public PregeneratedCode()
+			: this(GetDefaultPath)
+		{}
+
+		/// <summary>
+		/// </summary>
+		/// <param name="getPath">Returns the path where the code for the interfaces of the given assembly resides in, if any</param>
+		public PregeneratedCode(Func<Assembly, string> getPath)
+		{
+			if (getPath == null)
+				throw new ArgumentNullException(nameof(getPath));
+
+			_getPath = getPath;
+			_assemblies = new Dictionary<Assembly, Dictionary<Type, PregeneratedCodeAttribute>>();
+		}
+
+		public static string GetAssemblyName(Assembly assembly)
+		{
+			return string.Format("{0}.SharpRemote", assembly.GetName().Name);
+		}
+
+		public bool TryGetProxy(Type interfaceType, out Type proxyType)
+		{
+			var code = TryGet(interfaceType);
+			proxyType = code?.ProxyType;
+			return proxyType != null;
+		}
+
+		public bool TryGetServant(Type interfaceType, out Type servantType)
+		{
+			var code = TryGet(interfaceType);
+			servantType = code?.ServantType;
+			return servantType != null;
+		}
+
+		private PregeneratedCodeAttribute TryGet(Type interfaceType)
+		{
+			Dictionary<Type, PregeneratedCodeAttribute> types;
+			lock (_assemblies)
+			{
+				var assembly = interfaceType.Assembly;
+				if (!_assemblies.TryGetValue(assembly, out types))
+				{
+					types = Load(assembly);
+					_assemblies.Add(assembly, types);
+				}
+			}
+
+			PregeneratedCodeAttribute code;
+			types.TryGetValue(interfaceType, out code);
+			return code;
+		}
+
+		private Dictionary<Type, PregeneratedCodeAttribute> Load(Assembly assembly)
+		{
+			var types = new Dictionary<Type, PregeneratedCodeAttribute>();
+			var path = _getPath(assembly);
+			if (path == null || !File.Exists(path))
+				return types;
+
+			try
+			{
+				var pregeneratedAssembly = Assembly.LoadFrom(path);
+				foreach (var code in pregeneratedAssembly.GetCustomAttributes<PregeneratedCodeAttribute>())
+				{
+					if (code.Key != CodeGenerator.ComputeCacheKey(new[] {code.InterfaceType}))
+					{
+						Log.WarnFormat("The code in '{0}' has been generated for a different build of '{1}' and won't be used",
+						               path,
+						               code.InterfaceType);
+						continue;
+					}
+
+					types.Add(code.InterfaceType, code);
+				}
+
+				Log.DebugFormat("Loaded pregenerated proxies and servants for {0} interface(s) from '{1}'", types.Count, path);
+			}
+			catch (Exception e)
+			{
+				Log.WarnFormat("Unable to load pregenerated proxies and servants from '{0}': {1}", path, e);
+				types.Clear();
+			}
+
+			return types;
+		}
+
+		private static string GetDefaultPath(Assembly assembly)
+		{
+			if (assembly.IsDynamic || string.IsNullOrEmpty(assembly.Location))
+				return null;
+
+			var directory = Path.GetDirectoryName(assembly.Location);
+			if (directory == null)
+				return null;
+
+			return Path.Combine(directory, GetAssemblyName(assembly) + ".dll");
+		}
+	}
+}
@@ -0,0 +1,78 @@
+﻿using System;
+using System.Diagnostics;
+
+// ReSharper disable once CheckNamespace
+namespace SharpRemote
+{
+	/// <summary>
+	///     Describes the outcome of preparing (i.e. compiling everything necessary for) a type upfront.
+	/// </summary>
+	public sealed class PreparedType
+	{
+		/// <summary>
+		///     Initializes this object.
+		/// </summary>
+		/// <param name="type"></param>
+		/// <param name="elapsed"></param>
+		/// <param name="exception"></param>
+		public PreparedType(Type type, TimeSpan elapsed, Exception exception = null)
+		{
+			if (type == null)
+				throw new ArgumentNullException(nameof(type));
+
+			Type = type;
+			Elapsed = elapsed;
+			Exception = exception;
+		}
+
+		/// <summary>
+		///     The type which has been prepared.
+		/// </summary>
+		public Type Type { get; }
+
+		/// <summary>
+		///     The amount of time it took to prepare <see cref="Type" />.
+		/// </summary>
+		public TimeSpan Elapsed { get; }
+
+		/// <summary>
+		///     The exception which was thrown while preparing <see cref="Type" />, if any.
+		/// </summary>
+		public Exception Exception { get; }
+
+		/// <summary>
+		///     Whether or not <see cref="Type" /> has been prepared successfully.
+		/// </summary>
+		public bool Succeeded => Exception == null;
+
+		/// <inheritdoc />
+		public override string ToString()
+		{
+			if (Exception != null)
+				return string.Format("{0}: failed after {1:F1}ms: {2}", Type, Elapsed.TotalMilliseconds, Exception.Message);
+
+			return string.Format("{0}: {1:F1}ms", Type, Elapsed.TotalMilliseconds);
+		}
+
+		/// <summary>
+		///     Invokes the given <paramref name="prepare" /> for the given type and measures how long it took.
+		///     Exceptions thrown by <paramref name="prepare" /> are reported instead of being rethrown.
+		/// </summary>
+		/// <param name="type"></param>
+		/// <param name="prepare"></param>
+		/// <returns></returns>
+		internal static PreparedType Prepare(Type type, Action<Type> prepare)
+		{
+			var sw = Stopwatch.StartNew();
+			try
+			{
+				prepare(type);
+				return new PreparedType(type, sw.Elapsed);
+			}
+			catch (Exception e)
+			{
+				return new PreparedType(type, sw.Elapsed, e);
+			}
+		}
+	}
+}
@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.Diagnostics;
 using System.IO;
 using System.Linq;
@@ -26,6 +27,78 @@ namespace SharpRemote.CodeGeneration.Remoting
 			InterfaceType = interfaceType;
 		}
 
+		protected static Dispatch GetDispatchingStrategy(MemberInfo member)
+		{
+			var attribute = member.GetCustomAttribute<InvokeAttribute>();
+			return attribute != null ? attribute.DispatchingStrategy : Dispatch.DoNotSerialize;
+		}
+
+		protected static Priority GetPriority(MemberInfo member)
+		{
+			var attribute = member.GetCustomAttribute<PriorityAttribute>();
+			return attribute != null ? attribute.Priority : Priority.Normal;
+		}
+
+		/// <summary>
+		///     Generates the implementation of <see cref="IGrain.GetDispatchingStrategy" /> which
+		///     returns the strategy of the <see cref="InvokeAttribute" /> of the given member.
+		/// </summary>
+		/// <param name="typeBuilder"></param>
+		/// <param name="members"></param>
+		/// <param name="notFoundMessage"></param>
+		protected static void GenerateGetDispatchingStrategy(TypeBuilder typeBuilder,
+		                                                     MemberInfo[] members,
+		                                                     string notFoundMessage)
+		{
+			MethodBuilder method = typeBuilder.DefineMethod("GetDispatchingStrategy",
+			                                                MethodAttributes.Public | MethodAttributes.Final | MethodAttributes.Virtual,
+			                                                typeof (Dispatch),
+			                                                new[] {typeof (string)});
+
+			ILGenerator gen = method.GetILGenerator();
+
+			LocalBuilder name = gen.DeclareLocal(typeof (string));
+			Label @throw = gen.DefineLabel();
+			Label @ret = gen.DefineLabel();
+
+			gen.Emit(OpCodes.Ldarg_1);
+			gen.Emit(OpCodes.Stloc, name);
+			gen.Emit(OpCodes.Ldloc, name);
+			gen.Emit(OpCodes.Brfalse, @throw);
+
+			var labels = new Label[members.Length];
+			for (int i = 0; i < members.Length; ++i)
+			{
+				gen.Emit(OpCodes.Ldloc, name);
+				gen.Emit(OpCodes.Ldstr, members[i].Name);
+				gen.Emit(OpCodes.Call, Methods.StringEquality);
+
+				labels[i] = gen.DefineLabel();
+				gen.Emit(OpCodes.Brtrue, labels[i]);
+			}
+
+			gen.Emit(OpCodes.Br, @throw);
+
+			for (int i = 0; i < members.Length; ++i)
+			{
+				gen.MarkLabel(labels[i]);
+				gen.Emit(OpCodes.Ldc_I4, (int) GetDispatchingStrategy(members[i]));
+				gen.Emit(OpCodes.Br, @ret);
+			}
+
+			gen.MarkLabel(@throw);
+			gen.Emit(OpCodes.Ldstr, notFoundMessage);
+			gen.Emit(OpCodes.Ldarg_1);
+			gen.Emit(OpCodes.Call, Methods.StringFormatOneObject);
+			gen.Emit(OpCodes.Newobj, Methods.ArgumentExceptionCtor);
+			gen.Emit(OpCodes.Throw);
+
+			gen.MarkLabel(@ret);
+			gen.Emit(OpCodes.Ret);
+
+			typeBuilder.DefineMethodOverride(method, Methods.GrainGetDispatchingStrategy);
+		}
+
 		protected void ExtractArgumentsAndCallMethod(ILGenerator gen,
 			MethodInfo methodInfo,
 			Action loadReader,
@@ -92,6 +165,7 @@ namespace SharpRemote.CodeGeneration.Remoting
 					gen.Emit(OpCodes.Call, getResult);
 					gen.Emit(OpCodes.Stloc, taskResult);
 
+					EmitReserveSerializedSize(gen, loadWriter, () => gen.Emit(OpCodes.Ldloc, taskResult), taskReturnType);
 					SerializerCompiler.EmitWriteValue(gen,
 						loadWriter,
 						() => gen.Emit(OpCodes.Ldloc, taskResult),
@@ -110,12 +184,28 @@ namespace SharpRemote.CodeGeneration.Remoting
 					gen.Emit(OpCodes.Call, Methods.TaskWait);
 				}
 			}
+			else if (methodInfo.GetCustomAttribute<StreamedAttribute>() != null)
+			{
+				Type elementType = VerifyStreamedConstraints(methodInfo);
+
+				LocalBuilder tmp = gen.DeclareLocal(returnType);
+				gen.Emit(OpCodes.Callvirt, methodInfo);
+				gen.Emit(OpCodes.Stloc, tmp);
+
+				// StreamedEnumerable.Write(writer, _endPoint, tmp, idleTimeout);
+				loadWriter();
+				loadRemotingEndPoint();
+				gen.Emit(OpCodes.Ldloc, tmp);
+				gen.Emit(OpCodes.Ldc_I4, methodInfo.GetCustomAttribute<StreamedAttribute>().IdleTimeoutMilliseconds);
+				gen.Emit(OpCodes.Call, Methods.StreamedEnumerableWrite.MakeGenericMethod(elementType));
+			}
 			else if (returnType != typeof (void))
 			{
 				LocalBuilder tmp = gen.DeclareLocal(returnType);
 				gen.Emit(OpCodes.Callvirt, methodInfo);
 				gen.Emit(OpCodes.Stloc, tmp);
 
+				EmitReserveSerializedSize(gen, loadWriter, () => gen.Emit(OpCodes.Ldloc, tmp), returnType);
 				SerializerCompiler.EmitWriteValue(gen,
 				                                  loadWriter,
 				                                  () => gen.Emit(OpCodes.Ldloc, tmp),
@@ -130,6 +220,28 @@ namespace SharpRemote.CodeGeneration.Remoting
 			}
 		}
 
+		/// <summary>
+		///     Emits code to grow the writer's stream to the serialized size of the given value
+		///     (if it can be computed cheaply) so that large values don't cause the stream to be
+		///     re-allocated and copied over and over again while they're written.
+		/// </summary>
+		/// <param name="gen"></param>
+		/// <param name="loadWriter"></param>
+		/// <param name="loadValue"></param>
+		/// <param name="valueType"></param>
+		private void EmitReserveSerializedSize(ILGenerator gen, Action loadWriter, Action loadValue, Type valueType)
+		{
+			if (!SerializerCompiler.EmitGetSerializedSize(gen, loadValue, valueType))
+				return;
+
+			// BinarySerializer.Reserve(writer, size)
+			LocalBuilder size = gen.DeclareLocal(typeof(long));
+			gen.Emit(OpCodes.Stloc, size);
+			loadWriter();
+			gen.Emit(OpCodes.Ldloc, size);
+			gen.Emit(OpCodes.Call, Methods.BinarySerializerReserve);
+		}
+
 		private void EmitVerifyTaskConstraints(MethodInfo method, ILGenerator gen, Action loadTask)
 		{
 			loadTask();
@@ -158,24 +270,54 @@ namespace SharpRemote.CodeGeneration.Remoting
 			gen.MarkLabel(taskStarted);
 		}
 
-		protected void GenerateMethodInvocation(MethodBuilder method,
-		                                        string interfaceType,
-		                                        string remoteMethodName,
-		                                        ParameterInfo[] parameters,
-		                                        MethodInfo remoteMethod,
-		                                        AsyncRemoteAttribute async = null)
+		/// <summary>
+		///     Emits code to serialize all arguments of the current method into a new <see cref="MemoryStream" />
+		///     which is stored in the given local (or null if there are no arguments).
+		/// </summary>
+		/// <param name="gen"></param>
+		/// <param name="parameters"></param>
+		/// <param name="stream"></param>
+		protected void EmitWriteArguments(ILGenerator gen, ParameterInfo[] parameters, LocalBuilder stream)
 		{
-			ILGenerator gen = method.GetILGenerator();
+			EmitWriteArguments(gen,
+			                   parameters,
+			                   stream,
+			                   i => gen.Emit(OpCodes.Ldarg, i + 1),
+			                   i => gen.Emit(OpCodes.Ldarga, i + 1));
+		}
 
-			LocalBuilder stream = gen.DeclareLocal(typeof (MemoryStream));
+		/// <summary>
+		///     Emits code which serializes the given parameters into a new <see cref="MemoryStream"/>
+		///     (or null if there are none) and stores it in the given local.
+		/// </summary>
+		/// <param name="gen"></param>
+		/// <param name="parameters"></param>
+		/// <param name="stream"></param>
+		/// <param name="loadArgument">Emits code which loads the value of the i-th parameter onto the stack</param>
+		/// <param name="loadArgumentAddress">Emits code which loads the address of the i-th parameter onto the stack</param>
+		protected void EmitWriteArguments(ILGenerator gen,
+		                                  ParameterInfo[] parameters,
+		                                  LocalBuilder stream,
+		                                  Action<int> loadArgument,
+		                                  Action<int> loadArgumentAddress)
+		{
 			LocalBuilder binaryWriter = gen.DeclareLocal(typeof (StreamWriter));
 
-			gen.Emit(OpCodes.Call, Methods.DebuggerNotifyOfCrossThreadDependency);
-
 			if (parameters.Length > 0)
 			{
-				// var stream = new MemoryStream();
-				gen.Emit(OpCodes.Newobj, Methods.MemoryStreamCtor);
+				// var stream = BinarySerializer.CreateStream(<serialized size of all arguments, as far as it is known>);
+				gen.Emit(OpCodes.Ldc_I8, (long) 0);
+				for (int i = 0; i < parameters.Length; ++i)
+				{
+					int currentIndex = i;
+					if (SerializerCompiler.EmitGetSerializedSize(gen,
+					                                             () => loadArgument(currentIndex),
+					                                             parameters[i].ParameterType))
+					{
+						gen.Emit(OpCodes.Add);
+					}
+				}
+				gen.Emit(OpCodes.Call, Methods.BinarySerializerCreateStream);
 				gen.Emit(OpCodes.Stloc, stream);
 
 				// var binaryWriter = new BinaryWriter(stream);
@@ -201,10 +343,10 @@ namespace SharpRemote.CodeGeneration.Remoting
 				{
 					ParameterInfo parameter = parameters[i];
 					Type parameterType = parameter.ParameterType;
-					int currentIndex = i + 1;
+					int currentIndex = i;
 
-					Action loadValue = () => gen.Emit(OpCodes.Ldarg, currentIndex);
-					Action loadValueAddress = () => gen.Emit(OpCodes.Ldarga, currentIndex);
+					Action loadValue = () => loadArgument(currentIndex);
+					Action loadValueAddress = () => loadArgumentAddress(currentIndex);
 
 					//WriteXXX(_serializer, arg[y], binaryWriter);
 					SerializerCompiler.EmitWriteValue(
@@ -231,9 +373,29 @@ namespace SharpRemote.CodeGeneration.Remoting
 				gen.Emit(OpCodes.Ldnull);
 				gen.Emit(OpCodes.Stloc, stream);
 			}
+		}
+
+		protected void GenerateMethodInvocation(MethodBuilder method,
+		                                        string interfaceType,
+		                                        string remoteMethodName,
+		                                        ParameterInfo[] parameters,
+		                                        MethodInfo remoteMethod,
+		                                        Priority priority,
+		                                        AsyncRemoteAttribute async = null)
+		{
+			ILGenerator gen = method.GetILGenerator();
+
+			LocalBuilder stream = gen.DeclareLocal(typeof (MemoryStream));
+
+			gen.Emit(OpCodes.Call, Methods.DebuggerNotifyOfCrossThreadDependency);
+
+			EmitWriteArguments(gen, parameters, stream);
 
 			Type returnType = method.ReturnType;
 			ICustomAttributeProvider returnAttributes = remoteMethod.ReturnTypeCustomAttributes;
+			StreamedAttribute streamed = remoteMethod.GetCustomAttribute<StreamedAttribute>();
+			if (streamed != null)
+				VerifyStreamedConstraints(remoteMethod);
 			bool hasAsyncAttribute = (async ?? remoteMethod.GetCustomAttribute<AsyncRemoteAttribute>()) != null;
 			bool isAsync = returnType == typeof (Task) ||
 			               (returnType.IsGenericType && returnType.GetGenericTypeDefinition() == typeof (Task<>)) ||
@@ -277,7 +439,7 @@ namespace SharpRemote.CodeGeneration.Remoting
 				gen.Emit(OpCodes.Ldstr, interfaceType);
 				gen.Emit(OpCodes.Ldstr, remoteMethodName);
 				gen.Emit(OpCodes.Ldloc, stream);
-				gen.Emit(OpCodes.Callvirt, Methods.ChannelCallRemoteAsyncMethod);
+				EmitCallRemoteMethod(gen, priority, Methods.ChannelCallRemoteAsyncMethod, Methods.ChannelCallRemoteAsyncMethodWithPriority);
 
 				// return .ContinueWith(On_XXX_Finished);
 				if (taskReturnType == typeof (void))
@@ -356,7 +518,7 @@ namespace SharpRemote.CodeGeneration.Remoting
 				gen.Emit(OpCodes.Ldstr, interfaceType);
 				gen.Emit(OpCodes.Ldstr, remoteMethodName);
 				gen.Emit(OpCodes.Ldloc, stream);
-				gen.Emit(OpCodes.Callvirt, Methods.ChannelCallRemoteMethod);
+				EmitCallRemoteMethod(gen, priority, Methods.ChannelCallRemoteMethod, Methods.ChannelCallRemoteMethodWithPriority);
 
 				if (returnType == typeof (void))
 				{
@@ -365,13 +527,41 @@ namespace SharpRemote.CodeGeneration.Remoting
 				else
 				{
 					LocalBuilder binaryReader = gen.DeclareLocal(typeof (StreamReader));
-					ReadValueFromStream(method, gen, binaryReader, returnAttributes, returnType);
+					if (streamed != null)
+						ReadStreamedValueFromStream(gen, binaryReader, returnType, streamed);
+					else
+						ReadValueFromStream(method, gen, binaryReader, returnAttributes, returnType);
 				}
 
 				gen.Emit(OpCodes.Ret);
 			}
 		}
 
+		/// <summary>
+		///     Emits the call to the given channel method, expects the channel and all of its arguments
+		///     except the priority to be on the stack.
+		///     Only methods with a priority other than <see cref="Priority.Normal" /> pass their priority.
+		/// </summary>
+		/// <param name="gen"></param>
+		/// <param name="priority"></param>
+		/// <param name="callRemoteMethod"></param>
+		/// <param name="callRemoteMethodWithPriority"></param>
+		private static void EmitCallRemoteMethod(ILGenerator gen,
+		                                         Priority priority,
+		                                         MethodInfo callRemoteMethod,
+		                                         MethodInfo callRemoteMethodWithPriority)
+		{
+			if (priority == Priority.Normal)
+			{
+				gen.Emit(OpCodes.Callvirt, callRemoteMethod);
+			}
+			else
+			{
+				gen.Emit(OpCodes.Ldc_I4, (int) priority);
+				gen.Emit(OpCodes.Callvirt, callRemoteMethodWithPriority);
+			}
+		}
+
 		private void ReadValueFromStream(MethodBuilder method,
 			ILGenerator gen,
 			LocalBuilder binaryReader,
@@ -418,6 +608,51 @@ namespace SharpRemote.CodeGeneration.Remoting
 			}
 		}
 
+		private void ReadStreamedValueFromStream(ILGenerator gen,
+			LocalBuilder binaryReader,
+			Type returnType,
+			StreamedAttribute streamed)
+		{
+			// reader = new BinaryReader(...)
+			gen.Emit(OpCodes.Newobj, Methods.BinaryReaderCtor);
+			gen.Emit(OpCodes.Stloc, binaryReader);
+
+			// return StreamedEnumerable.Read(reader, _endPoint, chunkSize);
+			gen.Emit(OpCodes.Ldloc, binaryReader);
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Ldfld, EndPoint);
+			gen.Emit(OpCodes.Ldc_I4, streamed.ChunkSize);
+			gen.Emit(OpCodes.Call, Methods.StreamedEnumerableRead.MakeGenericMethod(returnType.GetGenericArguments()[0]));
+		}
+
+		private Type VerifyStreamedConstraints(MethodInfo method)
+		{
+			Type returnType = method.ReturnType;
+			if (!returnType.IsGenericType || returnType.GetGenericTypeDefinition() != typeof(IEnumerable<>))
+				throw new ArgumentException(
+					string.Format(
+						"Method {0}.{1} has the Streamed attribute applied, but its return type is not IEnumerable<T> - this is not supported",
+						InterfaceType.Name,
+						method.Name));
+
+			if (method.GetCustomAttribute<AsyncRemoteAttribute>() != null)
+				throw new ArgumentException(
+					string.Format(
+						"Method {0}.{1} has both the Streamed and the AsyncRemote attribute applied - this is not supported",
+						InterfaceType.Name,
+						method.Name));
+
+			var streamed = method.GetCustomAttribute<StreamedAttribute>();
+			if (streamed.ChunkSize <= 0)
+				throw new ArgumentException(
+					string.Format(
+						"Method {0}.{1} has the Streamed attribute applied, but its chunk size is not greater than zero",
+						InterfaceType.Name,
+						method.Name));
+
+			return returnType.GetGenericArguments()[0];
+		}
+
 		private void VerifyParameterConstraints(ParameterInfo parameter)
 		{
 			if (parameter.ParameterType.IsValueType)
@@ -55,6 +55,7 @@ namespace SharpRemote.CodeGeneration.Remoting
 			GenerateMethods();
 			GenerateInvokeEvent();
 			GenerateGetTaskScheduler();
+			GenerateGetDispatchingStrategy(_typeBuilder, AllEvents, "Event '{0}' not found");
 			GenerateInterfaceType();
 
 			var proxyType = _typeBuilder.CreateType();
@@ -462,6 +463,10 @@ namespace SharpRemote.CodeGeneration.Remoting
 						gen.Emit(OpCodes.Ldsfld, _perTypeScheduler);
 						break;
 
+					case Dispatch.Inline:
+						gen.Emit(OpCodes.Ldnull);
+						break;
+
 					default:
 						throw new InvalidEnumArgumentException("InvokeAttribute.DispatchingStrategy", (int)strategy, typeof(Dispatch));
 				}
@@ -603,7 +608,7 @@ namespace SharpRemote.CodeGeneration.Remoting
 
 		/// <summary>
 		/// Generates the method responsible for invoking the given interface method via
-		/// <see cref="IEndPointChannel.CallRemoteMethod"/>.
+		/// <see cref="IEndPointChannel.CallRemoteMethod(ulong, string, string, System.IO.MemoryStream)"/>.
 		/// </summary>
 		/// <param name="remoteMethod"></param>
 		private void GenerateMethodInvocation(MethodInfo remoteMethod)
@@ -616,7 +621,7 @@ namespace SharpRemote.CodeGeneration.Remoting
 													remoteMethod.ReturnType,
 													parameters.Select(x => x.ParameterType).ToArray());
 
-			GenerateMethodInvocation(method, InterfaceType.FullName, methodName, parameters, remoteMethod);
+			GenerateMethodInvocation(method, InterfaceType.FullName, methodName, parameters, remoteMethod, GetPriority(remoteMethod));
 
 			_typeBuilder.DefineMethodOverride(method, remoteMethod);
 		}
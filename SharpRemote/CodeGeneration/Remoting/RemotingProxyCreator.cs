@@ -14,14 +14,16 @@ namespace SharpRemote.CodeGeneration.Remoting
 		private readonly ISerializerCompiler _serializer;
 		private readonly Dictionary<Type, Type> _interfaceToProxy;
 		private readonly ModuleBuilder _module;
+		private readonly PregeneratedCode _pregeneratedCode;
 
-		public RemotingProxyCreator(ModuleBuilder module, ISerializerCompiler serializer)
+		public RemotingProxyCreator(ModuleBuilder module, ISerializerCompiler serializer, PregeneratedCode pregeneratedCode = null)
 		{
 			if (module == null) throw new ArgumentNullException(nameof(module));
 			if (serializer == null) throw new ArgumentNullException(nameof(serializer));
 
 			_module = module;
 			_serializer = serializer;
+			_pregeneratedCode = pregeneratedCode;
 
 			_interfaceToProxy = new Dictionary<Type, Type>();
 		}
@@ -59,7 +61,16 @@ namespace SharpRemote.CodeGeneration.Remoting
 		/// <returns></returns>
 		public Type GenerateProxy<T>()
 		{
-			var interfaceType = typeof (T);
+			return GenerateProxy(typeof(T));
+		}
+
+		/// <summary>
+		/// Generates the class for a proxy of the given type <paramref name="interfaceType"/>.
+		/// </summary>
+		/// <param name="interfaceType"></param>
+		/// <returns></returns>
+		public Type GenerateProxy(Type interfaceType)
+		{
 			if (!interfaceType.IsInterface)
 				throw new ArgumentException(string.Format("Proxies can only be created for interfaces: {0} is not an interface", interfaceType));
 
@@ -68,19 +79,22 @@ namespace SharpRemote.CodeGeneration.Remoting
 				Type proxyType;
 				if (!_interfaceToProxy.TryGetValue(interfaceType, out proxyType))
 				{
-					try
-					{
-						var proxyTypeName = GetProxyTypeName(interfaceType);
-
-						var generator = new ProxyCompiler(_serializer, _module, proxyTypeName, interfaceType);
-						proxyType = generator.Generate();
-					}
-					catch (Exception e)
+					if (_pregeneratedCode == null || !_pregeneratedCode.TryGetProxy(interfaceType, out proxyType))
 					{
-						var message = string.Format("Unable to create proxy for type '{0}': {1}",
-						                            interfaceType.Name,
-						                            e.Message);
-						throw new ArgumentException(message, e);
+						try
+						{
+							var proxyTypeName = GetProxyTypeName(interfaceType);
+
+							var generator = new ProxyCompiler(_serializer, _module, proxyTypeName, interfaceType);
+							proxyType = generator.Generate();
+						}
+						catch (Exception e)
+						{
+							var message = string.Format("Unable to create proxy for type '{0}': {1}",
+							                            interfaceType.Name,
+							                            e.Message);
+							throw new ArgumentException(message, e);
+						}
 					}
 					_interfaceToProxy.Add(interfaceType, proxyType);
 				}
@@ -120,9 +134,23 @@ namespace SharpRemote.CodeGeneration.Remoting
 				});
 		}
 
-		private string GetProxyTypeName(Type interfaceType)
+		/// <summary>
+		/// Uses the given, already generated, proxy type for the given interface
+		/// instead of generating one.
+		/// </summary>
+		/// <param name="interfaceType"></param>
+		/// <param name="proxyType"></param>
+		public void AddProxy(Type interfaceType, Type proxyType)
+		{
+			lock (_interfaceToProxy)
+			{
+				_interfaceToProxy.Add(interfaceType, proxyType);
+			}
+		}
+
+		public static string GetProxyTypeName(Type interfaceType)
 		{
-			return string.Format("{0}.{1}.Proxy", interfaceType.Namespace, interfaceType.Name);
+			return string.Format("{0}.{1}.Proxy", interfaceType.Namespace, interfaceType.GetGeneratedTypeName());
 		}
 	}
 }
\ No newline at end of file
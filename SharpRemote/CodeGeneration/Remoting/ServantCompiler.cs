@@ -5,6 +5,7 @@ using System.IO;
 using System.Linq;
 using System.Reflection;
 using System.Reflection.Emit;
+using System.Threading.Tasks;
 using SharpRemote.Attributes;
 using SharpRemote.Tasks;
 
@@ -14,6 +15,8 @@ namespace SharpRemote.CodeGeneration.Remoting
 		: Compiler
 	{
 		private readonly List<KeyValuePair<EventInfo, MethodInfo>> _eventInvocationMethods;
+		private readonly List<KeyValuePair<EventInfo, FieldBuilder>> _eventCoalescers;
+		private readonly Dictionary<EventInfo, MethodInfo> _eventArgumentWriters;
 		private readonly Dictionary<MethodInfo, FieldBuilder> _perMethodSchedulers;
 		private readonly ModuleBuilder _module;
 		private readonly FieldBuilder _subject;
@@ -41,6 +44,8 @@ namespace SharpRemote.CodeGeneration.Remoting
 			_perMethodSchedulers = new Dictionary<MethodInfo, FieldBuilder>();
 
 			_eventInvocationMethods = new List<KeyValuePair<EventInfo, MethodInfo>>();
+			_eventCoalescers = new List<KeyValuePair<EventInfo, FieldBuilder>>();
+			_eventArgumentWriters = new Dictionary<EventInfo, MethodInfo>();
 
 			_subjectType = typeof(WeakReference<>).MakeGenericType(interfaceType);
 			_subjectTryGetTarget = _subjectType.GetMethod("TryGetTarget");
@@ -134,6 +139,7 @@ namespace SharpRemote.CodeGeneration.Remoting
 
 		public Type Generate()
 		{
+			VerifyInlineMethods();
 			GenerateCctor();
 			GenerateEvents();
 			GenerateCtor();
@@ -143,12 +149,30 @@ namespace SharpRemote.CodeGeneration.Remoting
 			GenerateGetSubject();
 			GenerateInvoke();
 			GenerateGetTaskScheduler();
+			GenerateGetDispatchingStrategy(_typeBuilder, AllMethods, "Method '{0}' not found");
 			GenerateInterfaceType();
+			GenerateDispose();
 
 			Type proxyType = _typeBuilder.CreateType();
 			return proxyType;
 		}
 
+		private void VerifyInlineMethods()
+		{
+			foreach (var method in AllMethods)
+			{
+				if (GetDispatchingStrategy(method) != Dispatch.Inline)
+					continue;
+
+				var returnType = method.ReturnType;
+				if (typeof(Task).IsAssignableFrom(returnType))
+					throw new ArgumentException(
+						string.Format("Method {0}.{1} is dispatched inline, but returns a task - this is not supported",
+						              InterfaceType.Name,
+						              method.Name));
+			}
+		}
+
 		private void GenerateInterfaceType()
 		{
 			MethodBuilder getInterfaceType = _typeBuilder.DefineMethod("get_InterfaceType",
@@ -177,7 +201,7 @@ namespace SharpRemote.CodeGeneration.Remoting
 		/// <summary>
 		///     Responsible for generating a method to remote-invoke an event on this servant's proxy.
 		///     The generated method serializes the event's parameters and then either calls
-		///     <see cref="IEndPointChannel.CallRemoteMethod" /> or <see cref="IEndPointChannel.CallRemoteMethodAsync" />
+		///     <see cref="IEndPointChannel.CallRemoteMethod(ulong, string, string, System.IO.MemoryStream)" /> or <see cref="IEndPointChannel.CallRemoteMethodAsync(ulong, string, string, System.IO.MemoryStream)" />
 		///     depending on whether or not the <see cref="AsyncRemoteAttribute" /> was applied to
 		///     the event.
 		/// </summary>
@@ -195,17 +219,154 @@ namespace SharpRemote.CodeGeneration.Remoting
 			                                                 returnType,
 			                                                 parameters.Select(x => x.ParameterType).ToArray());
 
-			var async = @event.GetCustomAttribute<AsyncRemoteAttribute>();
-			GenerateMethodInvocation(method,
-			                         InterfaceType.FullName,
-			                         @event.Name,
-			                         parameters,
-			                         methodInfo,
-			                         async);
+			if (@event.GetCustomAttribute<CoalesceAttribute>() != null)
+			{
+				GenerateCoalescedEventInvocation(@event, method, methodInfo, parameters);
+			}
+			else
+			{
+				var async = @event.GetCustomAttribute<AsyncRemoteAttribute>();
+				GenerateMethodInvocation(method,
+				                         InterfaceType.FullName,
+				                         @event.Name,
+				                         parameters,
+				                         methodInfo,
+				                         GetPriority(@event),
+				                         async);
+			}
 
 			_eventInvocationMethods.Add(new KeyValuePair<EventInfo, MethodInfo>(@event, method));
 		}
 
+		/// <summary>
+		///     Generates a method which hands the event's parameters to an <see cref="EventCoalescer" />
+		///     (which then decides if and when they're sent) as well as a method which serializes them,
+		///     which the coalescer only invokes for the raises it actually delivers.
+		/// </summary>
+		/// <param name="event"></param>
+		/// <param name="method"></param>
+		/// <param name="methodInfo"></param>
+		/// <param name="parameters"></param>
+		private void GenerateCoalescedEventInvocation(EventInfo @event,
+		                                              MethodBuilder method,
+		                                              MethodInfo methodInfo,
+		                                              ParameterInfo[] parameters)
+		{
+			if (methodInfo.ReturnType != typeof(void))
+				throw new ArgumentException(
+					string.Format("Event {0}.{1} is coalesced, but its delegate returns a value - this is not supported",
+					              InterfaceType.Name,
+					              @event.Name));
+			if (@event.GetCustomAttribute<CoalesceAttribute>().MaxRate <= 0)
+				throw new ArgumentException(
+					string.Format("Event {0}.{1} is coalesced, but its maximum rate is not greater than zero - this is not supported",
+					              InterfaceType.Name,
+					              @event.Name));
+
+			var coalescer = _typeBuilder.DefineField(string.Format("_{0}Coalescer", @event.Name),
+			                                         typeof(EventCoalescer),
+			                                         FieldAttributes.Private | FieldAttributes.InitOnly);
+
+			ILGenerator gen = method.GetILGenerator();
+			LocalBuilder arguments = gen.DeclareLocal(typeof(object[]));
+			if (parameters.Length > 0)
+			{
+				// var arguments = new object[] { arg1, arg2, ... };
+				gen.Emit(OpCodes.Ldc_I4, parameters.Length);
+				gen.Emit(OpCodes.Newarr, typeof(object));
+				gen.Emit(OpCodes.Stloc, arguments);
+				for (int i = 0; i < parameters.Length; ++i)
+				{
+					var parameterType = parameters[i].ParameterType;
+					gen.Emit(OpCodes.Ldloc, arguments);
+					gen.Emit(OpCodes.Ldc_I4, i);
+					gen.Emit(OpCodes.Ldarg, i + 1);
+					if (parameterType.IsValueType)
+						gen.Emit(OpCodes.Box, parameterType);
+					gen.Emit(OpCodes.Stelem_Ref);
+				}
+			}
+
+			// _XXXCoalescer.Post(arguments);
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Ldfld, coalescer);
+			gen.Emit(OpCodes.Ldloc, arguments);
+			gen.Emit(OpCodes.Callvirt, Methods.EventCoalescerPost);
+			gen.Emit(OpCodes.Ret);
+
+			_eventCoalescers.Add(new KeyValuePair<EventInfo, FieldBuilder>(@event, coalescer));
+			_eventArgumentWriters.Add(@event, GenerateWriteEventArguments(@event, parameters));
+		}
+
+		/// <summary>
+		///     Generates a method which serializes the given (boxed) arguments of the given event.
+		/// </summary>
+		/// <param name="event"></param>
+		/// <param name="parameters"></param>
+		/// <returns></returns>
+		private MethodInfo GenerateWriteEventArguments(EventInfo @event, ParameterInfo[] parameters)
+		{
+			var method = _typeBuilder.DefineMethod(string.Format("Write{0}Arguments", @event.Name),
+			                                       MethodAttributes.Private,
+			                                       typeof(MemoryStream),
+			                                       new[] {typeof(object[])});
+
+			ILGenerator gen = method.GetILGenerator();
+			var values = new LocalBuilder[parameters.Length];
+			for (int i = 0; i < parameters.Length; ++i)
+			{
+				// var valueX = (T)arguments[X];
+				var parameterType = parameters[i].ParameterType;
+				values[i] = gen.DeclareLocal(parameterType);
+				gen.Emit(OpCodes.Ldarg_1);
+				gen.Emit(OpCodes.Ldc_I4, i);
+				gen.Emit(OpCodes.Ldelem_Ref);
+				gen.Emit(OpCodes.Unbox_Any, parameterType);
+				gen.Emit(OpCodes.Stloc, values[i]);
+			}
+
+			LocalBuilder stream = gen.DeclareLocal(typeof(MemoryStream));
+			EmitWriteArguments(gen,
+			                   parameters,
+			                   stream,
+			                   i => gen.Emit(OpCodes.Ldloc, values[i]),
+			                   i => gen.Emit(OpCodes.Ldloca, values[i]));
+
+			gen.Emit(OpCodes.Ldloc, stream);
+			gen.Emit(OpCodes.Ret);
+
+			return method;
+		}
+
+		/// <summary>
+		///     Generates <see cref="IDisposable.Dispose" /> (which disposes of the servant's
+		///     <see cref="EventCoalescer" />s), if the servant has any.
+		/// </summary>
+		private void GenerateDispose()
+		{
+			if (_eventCoalescers.Count == 0)
+				return;
+
+			_typeBuilder.AddInterfaceImplementation(typeof(IDisposable));
+
+			var method = _typeBuilder.DefineMethod("Dispose",
+			                                       MethodAttributes.Public | MethodAttributes.Virtual |
+			                                       MethodAttributes.Final,
+			                                       typeof(void),
+			                                       null);
+			ILGenerator gen = method.GetILGenerator();
+			foreach (var pair in _eventCoalescers)
+			{
+				// _XXXCoalescer.Dispose();
+				gen.Emit(OpCodes.Ldarg_0);
+				gen.Emit(OpCodes.Ldfld, pair.Value);
+				gen.Emit(OpCodes.Callvirt, Methods.EventCoalescerDispose);
+			}
+			gen.Emit(OpCodes.Ret);
+
+			_typeBuilder.DefineMethodOverride(method, Methods.DisposableDispose);
+		}
+
 		private void GenerateGetSubject()
 		{
 			MethodBuilder method = _typeBuilder.DefineMethod("get_Subject",
@@ -294,6 +455,10 @@ namespace SharpRemote.CodeGeneration.Remoting
 						gen.Emit(OpCodes.Ldsfld, _perTypeScheduler);
 						break;
 
+					case Dispatch.Inline:
+						gen.Emit(OpCodes.Ldnull);
+						break;
+
 					default:
 						throw new InvalidEnumArgumentException("InvokeAttribute.DispatchingStrategy", (int)strategy, typeof(Dispatch));
 				}
@@ -492,6 +657,27 @@ namespace SharpRemote.CodeGeneration.Remoting
 			gen.Emit(OpCodes.Newobj, ctor);
 			gen.Emit(OpCodes.Stfld, _subject);
 
+			// Coalescers must exist before we subscribe to the subject's events
+			foreach (var pair in _eventCoalescers)
+			{
+				var @event = pair.Key;
+				var attribute = @event.GetCustomAttribute<CoalesceAttribute>();
+
+				// _XXXCoalescer = new EventCoalescer(_channel, _objectId, "IFoo", "XXX", priority, maxRate, WriteXXXArguments);
+				gen.Emit(OpCodes.Ldarg_0);
+				gen.Emit(OpCodes.Ldarg_3);
+				gen.Emit(OpCodes.Ldarg_1);
+				gen.Emit(OpCodes.Ldstr, InterfaceType.FullName);
+				gen.Emit(OpCodes.Ldstr, @event.Name);
+				gen.Emit(OpCodes.Ldc_I4, (int) GetPriority(@event));
+				gen.Emit(OpCodes.Ldc_I4, attribute.MaxRate);
+				gen.Emit(OpCodes.Ldarg_0);
+				gen.Emit(OpCodes.Ldftn, _eventArgumentWriters[@event]);
+				gen.Emit(OpCodes.Newobj, Methods.FuncObjectArrayToMemoryStreamCtor);
+				gen.Emit(OpCodes.Newobj, Methods.EventCoalescerCtor);
+				gen.Emit(OpCodes.Stfld, pair.Value);
+			}
+
 			foreach (var pair in _eventInvocationMethods)
 			{
 				MethodInfo eventAddMethod = pair.Key.AddMethod;
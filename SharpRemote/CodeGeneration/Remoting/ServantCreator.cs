@@ -14,14 +14,16 @@ namespace SharpRemote.CodeGeneration.Remoting
 		private readonly BinarySerializer _serializer;
 		private readonly Dictionary<Type, Type> _interfaceToSubject;
 		private readonly ModuleBuilder _module;
+		private readonly PregeneratedCode _pregeneratedCode;
 
-		public ServantCreator(ModuleBuilder module, BinarySerializer binarySerializer)
+		public ServantCreator(ModuleBuilder module, BinarySerializer binarySerializer, PregeneratedCode pregeneratedCode = null)
 		{
 			if (module == null) throw new ArgumentNullException(nameof(module));
 			if (binarySerializer == null) throw new ArgumentNullException(nameof(binarySerializer));
 			
 			_module = module;
 			_serializer = binarySerializer;
+			_pregeneratedCode = pregeneratedCode;
 			_interfaceToSubject= new Dictionary<Type, Type>();
 		}
 
@@ -67,22 +69,24 @@ namespace SharpRemote.CodeGeneration.Remoting
 				Type proxyType;
 				if (!_interfaceToSubject.TryGetValue(interfaceType, out proxyType))
 				{
-					try
+					if (_pregeneratedCode == null || !_pregeneratedCode.TryGetServant(interfaceType, out proxyType))
 					{
-						var proxyTypeName = GetSubjectTypeName(interfaceType);
-
-						var generator = new ServantCompiler(_serializer, _module, proxyTypeName, interfaceType);
-						proxyType = generator.Generate();
-
-						_interfaceToSubject.Add(interfaceType, proxyType);
-					}
-					catch (Exception e)
-					{
-						var message = string.Format("Unable to create servant for type '{0}': {1}",
-						                            interfaceType.Name,
-						                            e.Message);
-						throw new ArgumentException(message, e);
+						try
+						{
+							var proxyTypeName = GetSubjectTypeName(interfaceType);
+
+							var generator = new ServantCompiler(_serializer, _module, proxyTypeName, interfaceType);
+							proxyType = generator.Generate();
+						}
+						catch (Exception e)
+						{
+							var message = string.Format("Unable to create servant for type '{0}': {1}",
+							                            interfaceType.Name,
+							                            e.Message);
+							throw new ArgumentException(message, e);
+						}
 					}
+					_interfaceToSubject.Add(interfaceType, proxyType);
 				}
 				return proxyType;
 			}
@@ -114,9 +118,23 @@ namespace SharpRemote.CodeGeneration.Remoting
 				});
 		}
 
-		private string GetSubjectTypeName(Type interfaceType)
+		/// <summary>
+		/// Uses the given, already generated, servant type for the given interface
+		/// instead of generating one.
+		/// </summary>
+		/// <param name="interfaceType"></param>
+		/// <param name="servantType"></param>
+		public void AddServant(Type interfaceType, Type servantType)
+		{
+			lock (_interfaceToSubject)
+			{
+				_interfaceToSubject.Add(interfaceType, servantType);
+			}
+		}
+
+		public static string GetSubjectTypeName(Type interfaceType)
 		{
-			return string.Format("{0}.{1}.Servant", interfaceType.Namespace, interfaceType.Name);
+			return string.Format("{0}.{1}.Servant", interfaceType.Namespace, interfaceType.GetGeneratedTypeName());
 		}
 	}
 }
\ No newline at end of file
@@ -3,6 +3,7 @@ using System.Collections.Generic;
 using System.Globalization;
 using System.Reflection;
 using System.Reflection.Emit;
+using System.Runtime.Serialization;
 using log4net.Core;
 
 namespace SharpRemote.CodeGeneration.Serialization
@@ -141,6 +142,23 @@ namespace SharpRemote.CodeGeneration.Serialization
 			};
 		}
 
+		/// <summary>
+		///     Whether or not instances of the given type opted into reference preservation
+		///     (via <see cref="DataContractAttribute.IsReference" />): Such an instance is written
+		///     at most once per message and every further occurrence is written as a back-reference
+		///     to the first one, which is what allows shared and cyclic object graphs to survive a round-trip.
+		/// </summary>
+		/// <param name="type"></param>
+		/// <returns></returns>
+		protected static bool PreservesReferences(Type type)
+		{
+			if (type.IsValueType)
+				return false;
+
+			var dataContract = type.GetCustomAttribute<DataContractAttribute>();
+			return dataContract != null && dataContract.IsReference;
+		}
+
 		/// <inheritdoc />
 		public abstract MethodBuilder Method { get; }
 
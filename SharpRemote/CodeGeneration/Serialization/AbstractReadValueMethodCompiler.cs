@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.ComponentModel;
 using System.Linq;
 using System.Reflection;
@@ -78,6 +79,33 @@ namespace SharpRemote.CodeGeneration.Serialization
 		/// <param name="gen"></param>
 		protected abstract void EmitDynamicDispatchReadObject(ILGenerator gen);
 
+		/// <summary>
+		///     Emits code which reads the counterpart of <see cref="AbstractWriteValueMethodCompiler.EmitWriteObjectReference" />
+		///     and returns the referenced object in case it has already been read as part of the current message.
+		///     Is only called for types which preserve references.
+		/// </summary>
+		/// <remarks>
+		///     Does nothing by default.
+		/// </remarks>
+		/// <param name="gen">The code generator to use to emit new code</param>
+		protected virtual void EmitReadObjectReference(ILGenerator gen)
+		{
+		}
+
+		/// <summary>
+		///     Emits code which remembers the freshly created object stored in <paramref name="value" /> so that
+		///     subsequent back-references can be resolved to it.
+		///     Is only called for types which preserve references.
+		/// </summary>
+		/// <remarks>
+		///     Does nothing by default.
+		/// </remarks>
+		/// <param name="gen">The code generator to use to emit new code</param>
+		/// <param name="value"></param>
+		protected virtual void EmitAddObjectReference(ILGenerator gen, LocalBuilder value)
+		{
+		}
+
 		private void EmitReadBuiltInType(ISerializationMethodStorage<AbstractMethodsCompiler> methodStorage)
 		{
 			var gen = Method.GetILGenerator();
@@ -97,6 +125,11 @@ namespace SharpRemote.CodeGeneration.Serialization
 		{
 			var gen = Method.GetILGenerator();
 			var tmp = gen.DeclareLocal(_context.Type);
+			var preservesReferences = PreservesReferences(_context.Type);
+
+			// Objects which have already been read as part of this message are simply returned again
+			if (preservesReferences)
+				EmitReadObjectReference(gen);
 
 			if (_context.Type.IsValueType)
 			{
@@ -109,17 +142,45 @@ namespace SharpRemote.CodeGeneration.Serialization
 				if (ctor == null)
 					throw new ArgumentException(string.Format("Type '{0}' is missing a parameterless constructor", _context.Type));
 
-				gen.Emit(OpCodes.Newobj, ctor);
+				if (_context.Type.GetCustomAttribute<PooledAttribute>(false) != null)
+				{
+					// tmp = InstancePool.Rent<T>()
+					gen.Emit(OpCodes.Call, Methods.InstancePoolRent.MakeGenericMethod(_context.Type));
+				}
+				else
+				{
+					gen.Emit(OpCodes.Newobj, ctor);
+				}
 				gen.Emit(OpCodes.Stloc, tmp);
 			}
 
+			// The object must be known before its members are read, otherwise cycles couldn't be resolved
+			if (preservesReferences)
+				EmitAddObjectReference(gen, tmp);
+
 			EmitBeginRead(gen);
 
 			// tmp.BeforeDeserializationCallback();
 			EmitCallBeforeDeserialization(gen, tmp);
 
-			EmitReadFields(gen, tmp, methodStorage);
-			EmitReadProperties(gen, tmp, methodStorage);
+			// Members which are missing from a delta are taken from the snapshot it refers to
+			IReadOnlyList<DeltaMember> deltaMembers = null;
+			DeltaMember deltaKey = null;
+			LocalBuilder header = null;
+			LocalBuilder bitmap = null;
+			if (SupportsDeltaEncoding && DeltaEncoding.GetAttribute(_context.Type) != null)
+			{
+				deltaMembers = DeltaMember.GetMembers(_context.TypeDescription, out deltaKey);
+				header = gen.DeclareLocal(typeof(uint));
+				bitmap = gen.DeclareLocal(typeof(ulong));
+				EmitBeginReadDelta(gen, header, bitmap);
+			}
+
+			EmitReadFields(gen, tmp, methodStorage, deltaMembers, bitmap);
+			EmitReadProperties(gen, tmp, methodStorage, deltaMembers, bitmap);
+
+			if (deltaMembers != null)
+				EmitEndReadDelta(gen, tmp, header, bitmap, deltaMembers, deltaKey);
 
 			// tmp.AfterDeserializationCallback();
 			EmitCallAfterSerialization(gen, tmp);
@@ -131,13 +192,114 @@ namespace SharpRemote.CodeGeneration.Serialization
 			gen.Emit(OpCodes.Ret);
 		}
 
+		private void EmitBeginReadDelta(ILGenerator gen, LocalBuilder header, LocalBuilder bitmap)
+		{
+			var isSnapshot = gen.DefineLabel();
+
+			// header = ReadDeltaHeader()
+			EmitReadDeltaHeader(gen);
+			gen.Emit(OpCodes.Stloc, header);
+
+			// bitmap = (header & 1) != 0 ? ReadDeltaBitmap() : ulong.MaxValue
+			gen.Emit(OpCodes.Ldc_I4_M1);
+			gen.Emit(OpCodes.Conv_I8);
+			gen.Emit(OpCodes.Stloc, bitmap);
+			gen.Emit(OpCodes.Ldloc, header);
+			gen.Emit(OpCodes.Ldc_I4_1);
+			gen.Emit(OpCodes.And);
+			gen.Emit(OpCodes.Brfalse, isSnapshot);
+			EmitReadDeltaBitmap(gen);
+			gen.Emit(OpCodes.Stloc, bitmap);
+			gen.MarkLabel(isSnapshot);
+		}
+
+		private void EmitEndReadDelta(ILGenerator gen,
+		                              LocalBuilder value,
+		                              LocalBuilder header,
+		                              LocalBuilder bitmap,
+		                              IReadOnlyList<DeltaMember> members,
+		                              DeltaMember key)
+		{
+			var streamType = typeof(DeltaStream<>).MakeGenericType(_context.Type);
+			var stream = gen.DeclareLocal(streamType);
+			var snapshot = gen.DeclareLocal(_context.Type);
+			var isSnapshot = gen.DefineLabel();
+			var end = gen.DefineLabel();
+
+			Action loadValue = () => gen.Emit(_context.Type.IsValueType ? OpCodes.Ldloca : OpCodes.Ldloc, value);
+			Action loadSnapshot = () => gen.Emit(_context.Type.IsValueType ? OpCodes.Ldloca : OpCodes.Ldloc, snapshot);
+
+			// stream = DeltaEncoding.GetIncomingStream<T>(serializer, endPoint, key)
+			gen.Emit(OpCodes.Ldarg_1);
+			gen.Emit(OpCodes.Ldarg_2);
+			if (key != null)
+				key.EmitLoadBoxed(gen, loadValue);
+			else
+				gen.Emit(OpCodes.Ldnull);
+			gen.Emit(OpCodes.Call, Methods.DeltaEncodingGetIncomingStream.MakeGenericMethod(_context.Type));
+			gen.Emit(OpCodes.Stloc, stream);
+
+			gen.Emit(OpCodes.Ldloc, header);
+			gen.Emit(OpCodes.Ldc_I4_1);
+			gen.Emit(OpCodes.And);
+			gen.Emit(OpCodes.Brfalse, isSnapshot);
+
+			// snapshot = stream.GetSnapshot(header >> 1)
+			gen.Emit(OpCodes.Ldloc, stream);
+			gen.Emit(OpCodes.Ldloc, header);
+			gen.Emit(OpCodes.Ldc_I4_1);
+			gen.Emit(OpCodes.Shr_Un);
+			gen.Emit(OpCodes.Call, streamType.GetMethod(nameof(DeltaStream<object>.GetSnapshot)));
+			gen.Emit(OpCodes.Stloc, snapshot);
+			// if ((bitmap & mask) == 0) value.Member = snapshot.Member
+			foreach (var member in members)
+			{
+				var written = gen.DefineLabel();
+				gen.Emit(OpCodes.Ldloc, bitmap);
+				gen.Emit(OpCodes.Ldc_I8, (long) member.Mask);
+				gen.Emit(OpCodes.And);
+				gen.Emit(OpCodes.Brtrue, written);
+				member.EmitCopy(gen, loadValue, loadSnapshot);
+				gen.MarkLabel(written);
+			}
+			gen.Emit(OpCodes.Br, end);
+
+			// The snapshot is kept separately from the value so the caller may do with the latter whatever it pleases
+			gen.MarkLabel(isSnapshot);
+			if (_context.Type.IsValueType)
+			{
+				gen.Emit(OpCodes.Ldloca, snapshot);
+				gen.Emit(OpCodes.Initobj, _context.Type);
+			}
+			else
+			{
+				gen.Emit(OpCodes.Newobj, _context.Type.GetConstructor(new Type[0]));
+				gen.Emit(OpCodes.Stloc, snapshot);
+			}
+			foreach (var member in members)
+				member.EmitCopy(gen, loadSnapshot, loadValue);
+			// stream.AddSnapshot(header >> 1, snapshot)
+			gen.Emit(OpCodes.Ldloc, stream);
+			gen.Emit(OpCodes.Ldloc, header);
+			gen.Emit(OpCodes.Ldc_I4_1);
+			gen.Emit(OpCodes.Shr_Un);
+			gen.Emit(OpCodes.Ldloc, snapshot);
+			gen.Emit(OpCodes.Call, streamType.GetMethod(nameof(DeltaStream<object>.AddSnapshot)));
+
+			gen.MarkLabel(end);
+		}
+
 		private void EmitReadFields(ILGenerator gen,
 		                            LocalBuilder local,
-		                            ISerializationMethodStorage<AbstractMethodsCompiler> methodStorage)
+		                            ISerializationMethodStorage<AbstractMethodsCompiler> methodStorage,
+		                            IReadOnlyList<DeltaMember> deltaMembers,
+		                            LocalBuilder bitmap)
 		{
 			foreach (var fieldDescription in _context.TypeDescription.Fields)
 				try
 				{
+					var unchanged = gen.DefineLabel();
+					DeltaMember.EmitSkipUnchanged(gen, fieldDescription, deltaMembers, bitmap, unchanged);
 					EmitBeginReadField(gen, fieldDescription);
 					if (_context.TypeDescription.IsValueType)
 					{
@@ -150,6 +312,7 @@ namespace SharpRemote.CodeGeneration.Serialization
 					EmitReadValue(gen, fieldDescription.FieldType, methodStorage);
 					gen.Emit(OpCodes.Stfld, fieldDescription.Field);
 					EmitEndReadField(gen, fieldDescription);
+					gen.MarkLabel(unchanged);
 				}
 				catch (SerializationException)
 				{
@@ -168,11 +331,15 @@ namespace SharpRemote.CodeGeneration.Serialization
 
 		private void EmitReadProperties(ILGenerator gen,
 		                                LocalBuilder local,
-		                                ISerializationMethodStorage<AbstractMethodsCompiler> methodStorage)
+		                                ISerializationMethodStorage<AbstractMethodsCompiler> methodStorage,
+		                                IReadOnlyList<DeltaMember> deltaMembers,
+		                                LocalBuilder bitmap)
 		{
 			foreach (var propertyDescription in _context.TypeDescription.Properties)
 				try
 				{
+					var unchanged = gen.DefineLabel();
+					DeltaMember.EmitSkipUnchanged(gen, propertyDescription, deltaMembers, bitmap, unchanged);
 					EmitBeginReadProperty(gen, propertyDescription);
 					if (_context.TypeDescription.IsValueType)
 					{
@@ -185,6 +352,7 @@ namespace SharpRemote.CodeGeneration.Serialization
 					EmitReadValue(gen, propertyDescription.PropertyType, methodStorage);
 					gen.Emit(OpCodes.Call, propertyDescription.SetMethod.Method);
 					EmitEndReadProperty(gen, propertyDescription);
+					gen.MarkLabel(unchanged);
 				}
 				catch (SerializationException)
 				{
@@ -259,9 +427,39 @@ namespace SharpRemote.CodeGeneration.Serialization
 			else
 			{
 				EmitDynamicDispatchReadObject(gen);
+				gen.Emit(OpCodes.Castclass, typeDescription.Type);
 			}
 		}
 
+		/// <summary>
+		///     Whether or not this serializer honours the <see cref="DeltaEncodedAttribute" />.
+		///     When it does, it must override <see cref="EmitReadDeltaHeader" /> and <see cref="EmitReadDeltaBitmap" />.
+		/// </summary>
+		/// <remarks>
+		///     False by default.
+		/// </remarks>
+		protected virtual bool SupportsDeltaEncoding => false;
+
+		/// <summary>
+		///     Emits code which reads the counterpart of <see cref="AbstractWriteValueMethodCompiler.EmitWriteDeltaHeader" />
+		///     and pushes it onto the evaluation stack.
+		/// </summary>
+		/// <param name="gen">The code generator to use to emit new code</param>
+		protected virtual void EmitReadDeltaHeader(ILGenerator gen)
+		{
+			throw new NotSupportedException();
+		}
+
+		/// <summary>
+		///     Emits code which reads the counterpart of <see cref="AbstractWriteValueMethodCompiler.EmitWriteDeltaBitmap" />
+		///     and pushes it onto the evaluation stack.
+		/// </summary>
+		/// <param name="gen">The code generator to use to emit new code</param>
+		protected virtual void EmitReadDeltaBitmap(ILGenerator gen)
+		{
+			throw new NotSupportedException();
+		}
+
 		/// <summary>
 		/// 
 		/// </summary>
@@ -444,7 +642,7 @@ namespace SharpRemote.CodeGeneration.Serialization
 
 			// result = _remotingEndPoint.RetrieveSubject(id)
 			var retrieveSubject = typeof(IRemotingEndPoint).GetMethod("RetrieveSubject").MakeGenericMethod(_context.TypeDescription.ByReferenceInterfaceType);
-			gen.Emit(OpCodes.Ldarg_1);
+			gen.Emit(OpCodes.Ldarg_2);
 			gen.Emit(OpCodes.Ldloc, id);
 			gen.Emit(OpCodes.Callvirt, retrieveSubject);
 			gen.Emit(OpCodes.Br, objectRetrieved);
@@ -453,7 +651,7 @@ namespace SharpRemote.CodeGeneration.Serialization
 			// result = _remotingEndPoint.GetExistingOrCreateNewProxy<T>(serializer.ReadLong());
 			var getOrCreateNewProxy = typeof(IRemotingEndPoint)
 				.GetMethod("GetExistingOrCreateNewProxy").MakeGenericMethod(_context.TypeDescription.ByReferenceInterfaceType);
-			gen.Emit(OpCodes.Ldarg_1);
+			gen.Emit(OpCodes.Ldarg_2);
 			gen.Emit(OpCodes.Ldloc, id);
 			gen.Emit(OpCodes.Callvirt, getOrCreateNewProxy);
 
@@ -37,5 +37,15 @@ namespace SharpRemote.CodeGeneration.Serialization
 		/// 
 		/// </summary>
 		public Type ReaderType { get; set; }
+
+		/// <summary>
+		///     The encoding of integers (only honoured by the binary serializer).
+		/// </summary>
+		public IntegerEncoding IntegerEncoding { get; set; }
+
+		/// <summary>
+		///     The encoding of strings (only honoured by the binary serializer).
+		/// </summary>
+		public StringEncoding StringEncoding { get; set; }
 	}
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.ComponentModel;
 using System.Linq;
 using System.Reflection;
@@ -111,6 +112,13 @@ namespace SharpRemote.CodeGeneration.Serialization
 		private void EmitWriteByValue(ISerializationMethodStorage<AbstractMethodsCompiler> methodStorage)
 		{
 			var gen = Method.GetILGenerator();
+			var end = gen.DefineLabel();
+
+			// Objects which have already been written as part of this message are only referred to
+			if (PreservesReferences(_context.Type))
+				EmitWriteObjectReference(gen, end);
+
+			EmitBeginWrite(gen);
 
 			// The very first thing we want to do is to call the PreDeserializationCallback, if available.
 			EmitCallBeforeSerialization(gen);
@@ -123,17 +131,118 @@ namespace SharpRemote.CodeGeneration.Serialization
 					gen.Emit(OpCodes.Ldarg_1);
 			};
 
+			// Delta encoded types are preceded by a header and, if the value is a delta, a bitmap
+			// of the members which differ from the last snapshot: All others are omitted.
+			IReadOnlyList<DeltaMember> deltaMembers = null;
+			LocalBuilder bitmap = null;
+			if (SupportsDeltaEncoding && DeltaEncoding.GetAttribute(_context.Type) != null)
+			{
+				DeltaMember key;
+				deltaMembers = DeltaMember.GetMembers(_context.TypeDescription, out key);
+				bitmap = EmitBeginWriteDelta(gen, loadValue, deltaMembers, key);
+			}
+
 			//Followed by the list of serializable fields
-			EmitWriteFields(gen, loadValue, methodStorage);
+			EmitWriteFields(gen, loadValue, methodStorage, deltaMembers, bitmap);
 			// Then the serializable properties
-			EmitWriteProperties(gen, loadValue, methodStorage);
+			EmitWriteProperties(gen, loadValue, methodStorage, deltaMembers, bitmap);
 
 			// And finally call the PostDeserializationCallback, if available.
 			EmitCallAfterSerialization(gen);
 
+			EmitEndWrite(gen);
+
+			gen.MarkLabel(end);
 			gen.Emit(OpCodes.Ret);
 		}
 
+		private LocalBuilder EmitBeginWriteDelta(ILGenerator gen,
+		                                         Action loadValue,
+		                                         IReadOnlyList<DeltaMember> members,
+		                                         DeltaMember key)
+		{
+			var streamType = typeof(DeltaStream<>).MakeGenericType(_context.Type);
+			var snapshotField = streamType.GetField(nameof(DeltaStream<object>.Snapshot));
+			var stream = gen.DeclareLocal(streamType);
+			var header = gen.DeclareLocal(typeof(uint));
+			var bitmap = gen.DeclareLocal(typeof(ulong));
+			var isDelta = gen.DefineLabel();
+			var bitmapComputed = gen.DefineLabel();
+			var headerWritten = gen.DefineLabel();
+
+			Action loadSnapshot = () =>
+			{
+				gen.Emit(OpCodes.Ldloc, stream);
+				gen.Emit(_context.TypeDescription.IsValueType ? OpCodes.Ldflda : OpCodes.Ldfld, snapshotField);
+			};
+
+			// stream = DeltaEncoding.GetOutgoingStream<T>(serializer, endPoint, key)
+			gen.Emit(OpCodes.Ldarg_2);
+			gen.Emit(OpCodes.Ldarg_3);
+			if (key != null)
+				key.EmitLoadBoxed(gen, loadValue);
+			else
+				gen.Emit(OpCodes.Ldnull);
+			gen.Emit(OpCodes.Call, Methods.DeltaEncodingGetOutgoingStream.MakeGenericMethod(_context.Type));
+			gen.Emit(OpCodes.Stloc, stream);
+
+			// lock (stream) {
+			gen.Emit(OpCodes.Ldloc, stream);
+			gen.Emit(OpCodes.Call, Methods.MonitorEnter);
+			gen.BeginExceptionBlock();
+
+			// header = stream.BeginWrite()
+			gen.Emit(OpCodes.Ldloc, stream);
+			gen.Emit(OpCodes.Call, streamType.GetMethod(nameof(DeltaStream<object>.BeginWrite)));
+			gen.Emit(OpCodes.Stloc, header);
+			gen.Emit(OpCodes.Ldloc, header);
+			gen.Emit(OpCodes.Ldc_I4_1);
+			gen.Emit(OpCodes.And);
+			gen.Emit(OpCodes.Brtrue, isDelta);
+
+			// A snapshot is written in full and replaces the previous one
+			foreach (var member in members)
+				member.EmitCopy(gen, loadSnapshot, loadValue);
+			gen.Emit(OpCodes.Ldc_I4_M1);
+			gen.Emit(OpCodes.Conv_I8);
+			gen.Emit(OpCodes.Stloc, bitmap);
+			gen.Emit(OpCodes.Br, bitmapComputed);
+
+			// A delta only contains those members which differ from the snapshot
+			gen.MarkLabel(isDelta);
+			gen.Emit(OpCodes.Ldc_I4_0);
+			gen.Emit(OpCodes.Conv_I8);
+			gen.Emit(OpCodes.Stloc, bitmap);
+			foreach (var member in members)
+			{
+				var unchanged = gen.DefineLabel();
+				member.EmitEquals(gen, loadSnapshot, loadValue);
+				gen.Emit(OpCodes.Brtrue, unchanged);
+				gen.Emit(OpCodes.Ldloc, bitmap);
+				gen.Emit(OpCodes.Ldc_I8, (long) member.Mask);
+				gen.Emit(OpCodes.Or);
+				gen.Emit(OpCodes.Stloc, bitmap);
+				gen.MarkLabel(unchanged);
+			}
+			gen.MarkLabel(bitmapComputed);
+
+			// } // lock (stream)
+			gen.BeginFinallyBlock();
+			gen.Emit(OpCodes.Ldloc, stream);
+			gen.Emit(OpCodes.Call, Methods.MonitorExit);
+			gen.EndExceptionBlock();
+
+			EmitWriteDeltaHeader(gen, header);
+			gen.Emit(OpCodes.Ldloc, header);
+			gen.Emit(OpCodes.Ldc_I4_1);
+			gen.Emit(OpCodes.And);
+			gen.Emit(OpCodes.Brfalse, headerWritten);
+			EmitWriteDeltaBitmap(gen, bitmap);
+			gen.MarkLabel(headerWritten);
+
+			return bitmap;
+		}
+
 		private void EmitCallBeforeSerialization(ILGenerator gen)
 		{
 			var method = _context.Type.GetMethods()
@@ -147,11 +256,15 @@ namespace SharpRemote.CodeGeneration.Serialization
 
 		private void EmitWriteFields(ILGenerator gen,
 		                             Action loadValue,
-		                             ISerializationMethodStorage<AbstractMethodsCompiler> methodStorage)
+		                             ISerializationMethodStorage<AbstractMethodsCompiler> methodStorage,
+		                             IReadOnlyList<DeltaMember> deltaMembers,
+		                             LocalBuilder bitmap)
 		{
 			foreach (var field in _context.TypeDescription.Fields)
 				try
 				{
+					var unchanged = gen.DefineLabel();
+					DeltaMember.EmitSkipUnchanged(gen, field, deltaMembers, bitmap, unchanged);
 					EmitBeginWriteField(gen, field);
 					EmitWriteValue(gen, field.TypeDescription, () =>
 					{
@@ -163,6 +276,7 @@ namespace SharpRemote.CodeGeneration.Serialization
 						gen.Emit(OpCodes.Ldflda, field.Field);
 					}, methodStorage);
 					EmitEndWriteField(gen, field);
+					gen.MarkLabel(unchanged);
 				}
 				catch (SerializationException)
 				{
@@ -180,11 +294,15 @@ namespace SharpRemote.CodeGeneration.Serialization
 
 		private void EmitWriteProperties(ILGenerator gen,
 		                                 Action loadValue,
-		                                 ISerializationMethodStorage<AbstractMethodsCompiler> methodStorage)
+		                                 ISerializationMethodStorage<AbstractMethodsCompiler> methodStorage,
+		                                 IReadOnlyList<DeltaMember> deltaMembers,
+		                                 LocalBuilder bitmap)
 		{
 			foreach (var propertyDescription in _context.TypeDescription.Properties)
 				try
 				{
+					var unchanged = gen.DefineLabel();
+					DeltaMember.EmitSkipUnchanged(gen, propertyDescription, deltaMembers, bitmap, unchanged);
 					EmitBeginWriteProperty(gen, propertyDescription);
 					EmitWriteValue(gen, propertyDescription.TypeDescription, () =>
 					               {
@@ -199,6 +317,7 @@ namespace SharpRemote.CodeGeneration.Serialization
 					               },
 					               methodStorage);
 					EmitEndWriteProperty(gen, propertyDescription);
+					gen.MarkLabel(unchanged);
 				}
 				catch (SerializationException)
 				{
@@ -277,7 +396,7 @@ namespace SharpRemote.CodeGeneration.Serialization
 			}
 			else
 			{
-				EmitDynamicDispatchWriteObject(gen);
+				EmitDynamicDispatchWriteObject(gen, loadMember);
 			}
 		}
 
@@ -285,7 +404,74 @@ namespace SharpRemote.CodeGeneration.Serialization
 		/// 
 		/// </summary>
 		/// <param name="gen"></param>
-		protected abstract void EmitDynamicDispatchWriteObject(ILGenerator gen);
+		/// <param name="loadMember">Emits code which loads the member to be written onto the evaluation stack</param>
+		protected abstract void EmitDynamicDispatchWriteObject(ILGenerator gen, Action loadMember);
+
+		/// <summary>
+		///     Emits code which writes a back-reference to the value (argument 1) and then jumps to
+		///     <paramref name="alreadyWritten" /> in case the value has already been written as part of the current
+		///     message. Is only called for types which preserve references.
+		/// </summary>
+		/// <remarks>
+		///     Does nothing by default: Serializers which don't support reference preservation simply
+		///     write every occurrence in full.
+		/// </remarks>
+		/// <param name="gen">The code generator to use to emit new code</param>
+		/// <param name="alreadyWritten"></param>
+		protected virtual void EmitWriteObjectReference(ILGenerator gen, Label alreadyWritten)
+		{
+		}
+
+		/// <summary>
+		///     Emits code which is executed before the members of a by-value type are written.
+		/// </summary>
+		/// <remarks>
+		///     Does nothing by default.
+		/// </remarks>
+		/// <param name="gen">The code generator to use to emit new code</param>
+		protected virtual void EmitBeginWrite(ILGenerator gen)
+		{
+		}
+
+		/// <summary>
+		///     Emits code which is executed after the members of a by-value type have been written.
+		/// </summary>
+		/// <remarks>
+		///     Does nothing by default.
+		/// </remarks>
+		/// <param name="gen">The code generator to use to emit new code</param>
+		protected virtual void EmitEndWrite(ILGenerator gen)
+		{
+		}
+
+		/// <summary>
+		///     Whether or not this serializer honours the <see cref="DeltaEncodedAttribute" />.
+		///     When it does, it must override <see cref="EmitWriteDeltaHeader" /> and <see cref="EmitWriteDeltaBitmap" />.
+		/// </summary>
+		/// <remarks>
+		///     False by default: Such a serializer writes delta encoded types in full.
+		/// </remarks>
+		protected virtual bool SupportsDeltaEncoding => false;
+
+		/// <summary>
+		///     Emits code which writes the header (a <see cref="uint" />) of a delta encoded value.
+		/// </summary>
+		/// <param name="gen">The code generator to use to emit new code</param>
+		/// <param name="header"></param>
+		protected virtual void EmitWriteDeltaHeader(ILGenerator gen, LocalBuilder header)
+		{
+			throw new NotSupportedException();
+		}
+
+		/// <summary>
+		///     Emits code which writes the bitmap (a <see cref="ulong" />) of the members which are part of a delta.
+		/// </summary>
+		/// <param name="gen">The code generator to use to emit new code</param>
+		/// <param name="bitmap"></param>
+		protected virtual void EmitWriteDeltaBitmap(ILGenerator gen, LocalBuilder bitmap)
+		{
+			throw new NotSupportedException();
+		}
 
 		/// <summary>
 		/// 
@@ -473,7 +659,7 @@ namespace SharpRemote.CodeGeneration.Serialization
 			// if proxy.EndPoint != _endPoint, goto writeServant
 			gen.Emit(OpCodes.Ldloc, grain);
 			gen.Emit(OpCodes.Callvirt, Methods.GrainGetEndPoint);
-			gen.Emit(OpCodes.Ldarg_2);
+			gen.Emit(OpCodes.Ldarg_3);
 			gen.Emit(OpCodes.Ceq);
 			gen.Emit(OpCodes.Brfalse_S, writeServant);
 
@@ -503,6 +689,7 @@ namespace SharpRemote.CodeGeneration.Serialization
 			EmitWriteObjectId(gen, grain);
 
 			gen.MarkLabel(grainWritten);
+			gen.Emit(OpCodes.Ret);
 		}
 
 		/// <summary>
@@ -1,6 +1,12 @@
 ﻿using System;
 using System.ComponentModel;
+using System.IO;
+using System.Linq;
+using System.Reflection;
 using System.Reflection.Emit;
+using System.Runtime.InteropServices;
+using System.Runtime.Serialization;
+using SharpRemote.Attributes;
 using SharpRemote.CodeGeneration;
 
 // ReSharper disable CheckNamespace
@@ -15,6 +21,207 @@ namespace SharpRemote
 			Reverse,
 		}
 
+		/// <summary>
+		///     The size of the chunks in which blittable arrays are copied from / to the stream.
+		/// </summary>
+		private const int BlittableArrayChunkSize = 64 * 1024;
+
+		[ThreadStatic]
+		private static byte[] _blittableArrayChunk;
+
+		/// <summary>
+		///     Writes the contents of the given array as one raw block of memory.
+		///     This is only called for arrays of blittable types whose in-memory representation is identical
+		///     to the representation the per-element serialization would produce.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="writer"></param>
+		/// <param name="values"></param>
+		/// <param name="elementSize"></param>
+		public static void WriteBlittableArray(BinaryWriter writer, Array values, int elementSize)
+		{
+			WriteBlittableArray(writer, values, elementSize, values.Length);
+		}
+
+		/// <summary>
+		///     Writes the first <paramref name="count" /> values of the given array as one raw block of memory.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="writer"></param>
+		/// <param name="values"></param>
+		/// <param name="elementSize"></param>
+		/// <param name="count"></param>
+		public static void WriteBlittableArray(BinaryWriter writer, Array values, int elementSize, int count)
+		{
+			var byteCount = (long) count * elementSize;
+			if (byteCount == 0)
+				return;
+
+			var chunk = GetBlittableArrayChunk();
+			var handle = GCHandle.Alloc(values, GCHandleType.Pinned);
+			try
+			{
+				var source = handle.AddrOfPinnedObject().ToInt64();
+				for (long offset = 0; offset < byteCount; offset += chunk.Length)
+				{
+					var chunkLength = (int) Math.Min(chunk.Length, byteCount - offset);
+					Marshal.Copy(new IntPtr(source + offset), chunk, 0, chunkLength);
+					writer.Write(chunk, 0, chunkLength);
+				}
+			}
+			finally
+			{
+				handle.Free();
+			}
+		}
+
+		/// <summary>
+		///     Reads the contents of the given array as one raw block of memory, the counterpart
+		///     of <see cref="WriteBlittableArray" />.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="reader"></param>
+		/// <param name="values"></param>
+		/// <param name="elementSize"></param>
+		/// <exception cref="EndOfStreamException">When the stream ends before the array has been read completely</exception>
+		public static void ReadBlittableArray(BinaryReader reader, Array values, int elementSize)
+		{
+			ReadBlittableArray(reader, values, elementSize, values.Length);
+		}
+
+		/// <summary>
+		///     Reads the first <paramref name="count" /> values of the given array as one raw block of memory.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="reader"></param>
+		/// <param name="values"></param>
+		/// <param name="elementSize"></param>
+		/// <param name="count"></param>
+		/// <exception cref="EndOfStreamException">When the stream ends before the values have been read completely</exception>
+		public static void ReadBlittableArray(BinaryReader reader, Array values, int elementSize, int count)
+		{
+			var byteCount = (long) count * elementSize;
+			if (byteCount == 0)
+				return;
+
+			var chunk = GetBlittableArrayChunk();
+			var handle = GCHandle.Alloc(values, GCHandleType.Pinned);
+			try
+			{
+				var destination = handle.AddrOfPinnedObject().ToInt64();
+				long offset = 0;
+				while (offset < byteCount)
+				{
+					var chunkLength = reader.Read(chunk, 0, (int) Math.Min(chunk.Length, byteCount - offset));
+					if (chunkLength == 0)
+						throw new EndOfStreamException();
+
+					Marshal.Copy(chunk, 0, new IntPtr(destination + offset), chunkLength);
+					offset += chunkLength;
+				}
+			}
+			finally
+			{
+				handle.Free();
+			}
+		}
+
+		private static byte[] GetBlittableArrayChunk()
+		{
+			return _blittableArrayChunk ?? (_blittableArrayChunk = new byte[BlittableArrayChunkSize]);
+		}
+
+		/// <summary>
+		///     Tests if arrays of the given type can be written / read as one raw block of memory.
+		///     This is the case when a value's in-memory representation is byte-for-byte identical to
+		///     what <see cref="EmitWriteValue" /> would write for it, so both paths produce the same stream
+		///     and endpoints using either of them remain compatible:
+		///     <see cref="BinaryWriter" /> always writes little endian values, so this is never true
+		///     on big endian machines. Structs qualify when they only consist of public [DataMember] fields
+		///     of such types, without any padding in between, and don't require any custom serialization.
+		/// </summary>
+		/// <param name="type"></param>
+		/// <param name="size">The size of one value of the given type, in bytes</param>
+		/// <returns></returns>
+		private bool IsBlittable(Type type, out int size)
+		{
+			size = 0;
+			if (!BitConverter.IsLittleEndian)
+				return false;
+
+			if (type == typeof(byte) || type == typeof(sbyte))
+			{
+				size = 1;
+				return true;
+			}
+			if (type == typeof(short) || type == typeof(ushort))
+			{
+				size = 2;
+				return true;
+			}
+			if (type == typeof(int) || type == typeof(uint) || type == typeof(float))
+			{
+				size = 4;
+				return true;
+			}
+			if (type == typeof(long) || type == typeof(ulong) || type == typeof(double))
+			{
+				size = 8;
+				return true;
+			}
+
+			if (!type.IsValueType || type.IsPrimitive || type.IsEnum || type.IsGenericType || !type.IsLayoutSequential)
+				return false;
+			if (type.GetCustomAttribute<DataContractAttribute>() == null)
+				return false;
+			if (_customSerializers.Any(x => x.Supports(type)))
+				return false;
+			MethodInfo unused;
+			if (IsSingleton(type, out unused))
+				return false;
+			if (type.GetMethods().Any(HasSerializationCallback))
+				return false;
+			if (type.GetProperties(BindingFlags.Public | BindingFlags.Instance)
+			        .Any(x => x.GetCustomAttribute<DataMemberAttribute>() != null))
+				return false;
+
+			var fields = type.GetFields(BindingFlags.Public | BindingFlags.Instance);
+			if (fields.Length != type.GetFields(BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance).Length)
+				return false;
+
+			foreach (var field in fields)
+			{
+				if (field.GetCustomAttribute<DataMemberAttribute>() == null || field.IsInitOnly)
+					return false;
+
+				int fieldSize;
+				if (!IsBlittable(field.FieldType, out fieldSize))
+					return false;
+				if (Marshal.OffsetOf(type, field.Name).ToInt64() != size)
+					return false;
+
+				size += fieldSize;
+			}
+
+			return size > 0 && Marshal.SizeOf(type) == size;
+		}
+
+		private static bool HasSerializationCallback(MethodInfo method)
+		{
+			return method.GetCustomAttribute<BeforeSerializeAttribute>() != null ||
+			       method.GetCustomAttribute<AfterSerializeAttribute>() != null ||
+			       method.GetCustomAttribute<BeforeDeserializeAttribute>() != null ||
+			       method.GetCustomAttribute<AfterDeserializeAttribute>() != null;
+		}
+
 		private void EmitWriteArray(ILGenerator gen,
 			TypeInformation typeInformation,
 			Action loadWriter,
@@ -38,6 +245,23 @@ namespace SharpRemote
 			gen.Emit(OpCodes.Ldloc, length);
 			gen.Emit(OpCodes.Call, Methods.WriteInt32);
 
+			if (order == ArrayOrder.Forward && IsColumnar(elementType))
+			{
+				EmitWriteColumns(gen, elementType, loadWriter, loadValue, length, loadSerializer, loadRemotingEndPoint);
+				return;
+			}
+
+			int elementSize;
+			if (order == ArrayOrder.Forward && IsBlittable(elementType, out elementSize))
+			{
+				// BinarySerializer.WriteBlittableArray(writer, value, elementSize)
+				loadWriter();
+				loadValue();
+				gen.Emit(OpCodes.Ldc_I4, elementSize);
+				gen.Emit(OpCodes.Call, Methods.BinarySerializerWriteBlittableArray);
+				return;
+			}
+
 			// i = 0
 			// OR
 			// i = length-1
@@ -130,7 +354,8 @@ namespace SharpRemote
 			Action loadReader,
 			Action loadSerializer,
 			Action loadRemotingEndPoint,
-			TypeInformation typeInformation)
+			TypeInformation typeInformation,
+			ArrayOrder order = ArrayOrder.Forward)
 		{
 			var elementType = typeInformation.ElementType;
 
@@ -148,6 +373,25 @@ namespace SharpRemote
 			gen.Emit(OpCodes.Newarr, elementType);
 			gen.Emit(OpCodes.Stloc, value);
 
+			if (order == ArrayOrder.Forward && IsColumnar(elementType))
+			{
+				EmitReadColumns(gen, elementType, loadReader, value, count, loadSerializer, loadRemotingEndPoint);
+				gen.Emit(OpCodes.Ldloc, value);
+				return;
+			}
+
+			int elementSize;
+			if (IsBlittable(elementType, out elementSize))
+			{
+				// BinarySerializer.ReadBlittableArray(reader, value, elementSize)
+				loadReader();
+				gen.Emit(OpCodes.Ldloc, value);
+				gen.Emit(OpCodes.Ldc_I4, elementSize);
+				gen.Emit(OpCodes.Call, Methods.BinarySerializerReadBlittableArray);
+				gen.Emit(OpCodes.Ldloc, value);
+				return;
+			}
+
 			var loop = gen.DefineLabel();
 			var end = gen.DefineLabel();
 
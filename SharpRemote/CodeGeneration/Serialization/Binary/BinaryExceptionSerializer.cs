@@ -0,0 +1,496 @@
+using System;
+using System.Collections;
+using System.Collections.Specialized;
+using System.IO;
+using System.Reflection;
+using System.Runtime.Serialization;
+using log4net;
+
+// GetObjectData and the deserialization constructor are the only public means to capture the state
+// of framework exceptions (such as ArgumentException.ParamName) and of custom exceptions which implement
+// ISerializable. No formatter is involved, the values are written by this class, hence the obsoletion
+// warnings of the formatter infrastructure don't apply here.
+#pragma warning disable SYSLIB0050, SYSLIB0051
+
+namespace SharpRemote.CodeGeneration.Serialization.Binary
+{
+	/// <summary>
+	///     Writes exceptions to / reads them from a binary stream without relying on a BinaryFormatter:
+	///     An exception is written as its type, followed by every value it adds to a
+	///     <see cref="SerializationInfo" /> in <see cref="Exception.GetObjectData" /> (message, stack trace,
+	///     inner exception, custom fields, etc...) and restored by passing those values to its
+	///     deserialization constructor (see <see cref="ExceptionCompiler" />).
+	///     Those values are followed by the fields and properties of the exception which are attributed
+	///     with <see cref="DataMemberAttribute" />: They are assigned after the exception has been constructed.
+	/// </summary>
+	/// <remarks>
+	///     Inner exceptions are written recursively, up to a depth of <see cref="MaxDepth" />:
+	///     Deeper inner exceptions are omitted when writing and rejected when reading.
+	///     Exceptions which can't be written like this (because they're not serializable, lack
+	///     a deserialization constructor or add values of unsupported types) are replaced by an
+	///     <see cref="UnserializableException" /> which preserves as much information about the original
+	///     exception as possible.
+	/// </remarks>
+	internal static class BinaryExceptionSerializer
+	{
+		private static readonly ILog Log = LogManager.GetLogger(MethodBase.GetCurrentMethod().DeclaringType);
+
+		// I will never understand why the remote stacktrace is ONLY ever preserved for
+		// exceptions which cross app domains. Wouldn't it also be useful when traversing machines?!
+		// Anyways, this feature is super important when working with distributed software so we'll
+		// have to lie here in order to get what we want...
+		// (Proof: https://referencesource.microsoft.com/#mscorlib/system/exception.cs)
+		private static readonly StreamingContext Context = new StreamingContext(StreamingContextStates.CrossMachine |
+		                                                                        StreamingContextStates.CrossProcess |
+		                                                                        StreamingContextStates.CrossAppDomain);
+
+		private static readonly Func<string, Type> ResolveType = name => TypeResolver.GetType(name, false);
+
+		/// <summary>
+		///     The maximum number of exceptions and dictionaries which may be nested in one another.
+		/// </summary>
+		public const int MaxDepth = 32;
+
+		private enum ValueKind : byte
+		{
+			Null = 0,
+			String,
+			Boolean,
+			Byte,
+			SByte,
+			Int16,
+			UInt16,
+			Int32,
+			UInt32,
+			Int64,
+			UInt64,
+			Single,
+			Double,
+			Decimal,
+			DateTime,
+			ByteArray,
+			Exception,
+			Dictionary
+		}
+
+		/// <summary>
+		///     Writes the given exception to the given writer.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="exception"></param>
+		public static void Write(BinaryWriter writer, Exception exception)
+		{
+			if (writer == null)
+				throw new ArgumentNullException(nameof(writer));
+			if (exception == null)
+				throw new ArgumentNullException(nameof(exception));
+
+			Write(writer, exception, 0);
+		}
+
+		private static void Write(BinaryWriter writer, Exception exception, int depth)
+		{
+			var info = GetSerializableObjectData(ref exception);
+			BinarySerializer2.WriteTypeInformation(writer, exception.GetType());
+			writer.Write(info.MemberCount);
+			var it = info.GetEnumerator();
+			while (it.MoveNext())
+			{
+				var entry = it.Current;
+				writer.Write(entry.Name);
+				WriteValue(writer, entry.Value, depth);
+			}
+
+			var members = ExceptionCompiler.GetDataMembers(exception.GetType());
+			writer.Write(members.Length);
+			foreach (var member in members)
+			{
+				writer.Write(member.Name);
+				WriteValue(writer, member.GetValue(exception), depth);
+			}
+		}
+
+		/// <summary>
+		///     Reads an exception which has been written by <see cref="Write" />.
+		///     If the exception can't be restored (because its type can't be found, for example), then
+		///     an <see cref="UnserializableException" /> is returned instead.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static Exception Read(BinaryReader reader)
+		{
+			if (reader == null)
+				throw new ArgumentNullException(nameof(reader));
+
+			return Read(reader, 0);
+		}
+
+		private static Exception Read(BinaryReader reader, int depth)
+		{
+			var type = BinarySerializer2.ReadTypeInformation(reader, ResolveType);
+			var count = reader.ReadInt32();
+			var info = new SerializationInfo(type ?? typeof(Exception), new FormatterConverter());
+			for (int i = 0; i < count; ++i)
+			{
+				var name = reader.ReadString();
+				var value = ReadValue(reader, depth);
+				info.AddValue(name, value, value?.GetType() ?? typeof(object));
+			}
+
+			var exception = CreateException(type, info);
+			var members = exception.GetType() == type
+				? ExceptionCompiler.GetDataMembers(type)
+				: null;
+			var memberCount = reader.ReadInt32();
+			for (int i = 0; i < memberCount; ++i)
+			{
+				var name = reader.ReadString();
+				var value = ReadValue(reader, depth);
+				if (members != null)
+					SetDataMember(exception, members, name, value);
+			}
+
+			return exception;
+		}
+
+		private static void SetDataMember(Exception exception, ExceptionMember[] members, string name, object value)
+		{
+			foreach (var member in members)
+			{
+				if (member.Name != name)
+					continue;
+
+				try
+				{
+					member.SetValue(exception, value);
+				}
+				catch (Exception e)
+				{
+					Log.WarnFormat("Unable to restore member '{0}' of exception '{1}': {2}",
+					               name,
+					               exception.GetType(),
+					               e);
+				}
+				return;
+			}
+		}
+
+		/// <summary>
+		///     Retrieves the data of the given exception which is to be serialized.
+		///     Exceptions which cannot be serialized are replaced with an <see cref="UnserializableException" />.
+		/// </summary>
+		/// <param name="exception"></param>
+		/// <returns></returns>
+		private static SerializationInfo GetSerializableObjectData(ref Exception exception)
+		{
+			SerializationInfo info;
+			if (!TryGetObjectData(exception, out info))
+			{
+				exception = new UnserializableException(exception);
+				info = GetObjectData(exception);
+			}
+			return info;
+		}
+
+		/// <summary>
+		///     Creates an exception of the given type from the data previously retrieved via
+		///     <see cref="GetSerializableObjectData" />.
+		///     Returns an <see cref="UnserializableException" /> if that is not possible.
+		/// </summary>
+		/// <param name="type">The type of the exception or null if it couldn't be resolved</param>
+		/// <param name="info"></param>
+		/// <returns></returns>
+		private static Exception CreateException(Type type, SerializationInfo info)
+		{
+			if (type == null)
+				return new UnserializableException(string.Format("Unable to find the type of the exception thrown by the remote method: {0}",
+				                                                 TryGetString(info, "Message")));
+
+			var factory = ExceptionCompiler.GetFactory(type);
+			if (factory == null)
+				return new UnserializableException(string.Format("The type '{0}' is missing a deserialization constructor", type));
+
+			try
+			{
+				return factory(info, Context);
+			}
+			catch (Exception e)
+			{
+				Log.ErrorFormat("Caught unexpected exception while trying to deserialize an exception of type '{0}': {1}", type, e);
+				return new UnserializableException(string.Format("Unable to deserialize an exception of type '{0}'", type), e);
+			}
+		}
+
+		private static bool TryGetObjectData(Exception exception, out SerializationInfo info)
+		{
+			var type = exception.GetType();
+			if (!type.IsSerializable || ExceptionCompiler.GetFactory(type) == null)
+			{
+				Log.WarnFormat("Unable to serialize exception '{0}': It's either not serializable or missing a deserialization constructor", type);
+				info = null;
+				return false;
+			}
+
+			try
+			{
+				info = GetObjectData(exception);
+			}
+			catch (Exception e)
+			{
+				Log.WarnFormat("Unable to serialize exception: {0}", e);
+				info = null;
+				return false;
+			}
+
+			var it = info.GetEnumerator();
+			while (it.MoveNext())
+			{
+				if (!IsSupported(it.Current.Value))
+				{
+					Log.WarnFormat("Unable to serialize exception '{0}': The value '{1}' is of unsupported type '{2}'",
+					               type,
+					               it.Current.Name,
+					               it.Current.ObjectType);
+					info = null;
+					return false;
+				}
+			}
+
+			foreach (var member in ExceptionCompiler.GetDataMembers(type))
+			{
+				object value;
+				try
+				{
+					value = member.GetValue(exception);
+				}
+				catch (Exception e)
+				{
+					Log.WarnFormat("Unable to serialize exception '{0}': Member '{1}' threw: {2}", type, member.Name, e);
+					info = null;
+					return false;
+				}
+
+				if (!IsSupported(value))
+				{
+					Log.WarnFormat("Unable to serialize exception '{0}': The member '{1}' is of unsupported type '{2}'",
+					               type,
+					               member.Name,
+					               value.GetType());
+					info = null;
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		private static SerializationInfo GetObjectData(Exception exception)
+		{
+			var info = new SerializationInfo(exception.GetType(), new FormatterConverter());
+			exception.GetObjectData(info, Context);
+			return info;
+		}
+
+		private static bool IsSupported(object value)
+		{
+			if (value == null || value is Exception)
+				return true;
+
+			var dictionary = value as IDictionary;
+			if (dictionary != null)
+			{
+				foreach (DictionaryEntry entry in dictionary)
+				{
+					if (!IsSupported(entry.Key) || !IsSupported(entry.Value))
+						return false;
+				}
+				return true;
+			}
+
+			return GetValueType(value) != ValueKind.Null;
+		}
+
+		private static ValueKind GetValueType(object value)
+		{
+			if (value is string)
+				return ValueKind.String;
+			if (value is bool)
+				return ValueKind.Boolean;
+			if (value is byte)
+				return ValueKind.Byte;
+			if (value is sbyte)
+				return ValueKind.SByte;
+			if (value is short)
+				return ValueKind.Int16;
+			if (value is ushort)
+				return ValueKind.UInt16;
+			if (value is int)
+				return ValueKind.Int32;
+			if (value is uint)
+				return ValueKind.UInt32;
+			if (value is long)
+				return ValueKind.Int64;
+			if (value is ulong)
+				return ValueKind.UInt64;
+			if (value is float)
+				return ValueKind.Single;
+			if (value is double)
+				return ValueKind.Double;
+			if (value is decimal)
+				return ValueKind.Decimal;
+			if (value is DateTime)
+				return ValueKind.DateTime;
+			if (value is byte[])
+				return ValueKind.ByteArray;
+			if (value is Exception)
+				return ValueKind.Exception;
+			if (value is IDictionary)
+				return ValueKind.Dictionary;
+			return ValueKind.Null;
+		}
+
+		private static void WriteValue(BinaryWriter writer, object value, int depth)
+		{
+			var type = value == null ? ValueKind.Null : GetValueType(value);
+			if (depth >= MaxDepth && (type == ValueKind.Exception || type == ValueKind.Dictionary))
+			{
+				Log.WarnFormat("Omitting a value of type '{0}': It's nested deeper than {1} levels", value.GetType(), MaxDepth);
+				type = ValueKind.Null;
+			}
+
+			writer.Write((byte) type);
+			switch (type)
+			{
+				case ValueKind.Null:
+					break;
+				case ValueKind.String:
+					writer.Write((string) value);
+					break;
+				case ValueKind.Boolean:
+					writer.Write((bool) value);
+					break;
+				case ValueKind.Byte:
+					writer.Write((byte) value);
+					break;
+				case ValueKind.SByte:
+					writer.Write((sbyte) value);
+					break;
+				case ValueKind.Int16:
+					writer.Write((short) value);
+					break;
+				case ValueKind.UInt16:
+					writer.Write((ushort) value);
+					break;
+				case ValueKind.Int32:
+					writer.Write((int) value);
+					break;
+				case ValueKind.UInt32:
+					writer.Write((uint) value);
+					break;
+				case ValueKind.Int64:
+					writer.Write((long) value);
+					break;
+				case ValueKind.UInt64:
+					writer.Write((ulong) value);
+					break;
+				case ValueKind.Single:
+					writer.Write((float) value);
+					break;
+				case ValueKind.Double:
+					writer.Write((double) value);
+					break;
+				case ValueKind.Decimal:
+					writer.Write((decimal) value);
+					break;
+				case ValueKind.DateTime:
+					writer.Write(((DateTime) value).ToBinary());
+					break;
+				case ValueKind.ByteArray:
+					var bytes = (byte[]) value;
+					writer.Write(bytes.Length);
+					writer.Write(bytes);
+					break;
+				case ValueKind.Exception:
+					Write(writer, (Exception) value, depth + 1);
+					break;
+				case ValueKind.Dictionary:
+					var dictionary = (IDictionary) value;
+					writer.Write(dictionary.Count);
+					foreach (DictionaryEntry entry in dictionary)
+					{
+						WriteValue(writer, entry.Key, depth + 1);
+						WriteValue(writer, entry.Value, depth + 1);
+					}
+					break;
+			}
+		}
+
+		private static object ReadValue(BinaryReader reader, int depth)
+		{
+			var type = (ValueKind) reader.ReadByte();
+			if (depth >= MaxDepth && (type == ValueKind.Exception || type == ValueKind.Dictionary))
+				throw new SerializationException(string.Format("Values may not be nested deeper than {0} levels", MaxDepth));
+
+			switch (type)
+			{
+				case ValueKind.Null:
+					return null;
+				case ValueKind.String:
+					return reader.ReadString();
+				case ValueKind.Boolean:
+					return reader.ReadBoolean();
+				case ValueKind.Byte:
+					return reader.ReadByte();
+				case ValueKind.SByte:
+					return reader.ReadSByte();
+				case ValueKind.Int16:
+					return reader.ReadInt16();
+				case ValueKind.UInt16:
+					return reader.ReadUInt16();
+				case ValueKind.Int32:
+					return reader.ReadInt32();
+				case ValueKind.UInt32:
+					return reader.ReadUInt32();
+				case ValueKind.Int64:
+					return reader.ReadInt64();
+				case ValueKind.UInt64:
+					return reader.ReadUInt64();
+				case ValueKind.Single:
+					return reader.ReadSingle();
+				case ValueKind.Double:
+					return reader.ReadDouble();
+				case ValueKind.Decimal:
+					return reader.ReadDecimal();
+				case ValueKind.DateTime:
+					return DateTime.FromBinary(reader.ReadInt64());
+				case ValueKind.ByteArray:
+					return reader.ReadBytes(reader.ReadInt32());
+				case ValueKind.Exception:
+					return Read(reader, depth + 1);
+				case ValueKind.Dictionary:
+					var count = reader.ReadInt32();
+					var dictionary = new ListDictionary();
+					for (int i = 0; i < count; ++i)
+					{
+						var key = ReadValue(reader, depth + 1);
+						var value = ReadValue(reader, depth + 1);
+						dictionary.Add(key, value);
+					}
+					return dictionary;
+				default:
+					throw new SerializationException(string.Format("Unknown value type: {0}", (byte) type));
+			}
+		}
+
+		private static string TryGetString(SerializationInfo info, string name)
+		{
+			var it = info.GetEnumerator();
+			while (it.MoveNext())
+			{
+				if (it.Current.Name == name)
+					return it.Current.Value as string;
+			}
+			return null;
+		}
+	}
+}
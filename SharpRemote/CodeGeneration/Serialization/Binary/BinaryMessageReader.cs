@@ -0,0 +1,239 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Runtime.Serialization;
+using System.Text;
+
+namespace SharpRemote.CodeGeneration.Serialization.Binary
+{
+	/// <summary>
+	///     The counterpart to <see cref="BinaryMessageWriter" />: Remembers the types which have
+	///     already been read as part of the current message so that subsequent occurrences
+	///     can be resolved from their id.
+	/// </summary>
+	internal class BinaryMessageReader
+		: BinaryReader
+	{
+		private readonly List<Type> _types;
+		private List<object> _objects;
+		private List<string> _strings;
+
+		public BinaryMessageReader(Stream stream)
+			: base(stream, Encoding.UTF8, true)
+		{
+			_types = new List<Type>();
+		}
+
+		/// <summary>
+		///     Whether or not the entire message has been read.
+		/// </summary>
+		public virtual bool EndOfMessage => BaseStream.Position >= BaseStream.Length;
+
+		/// <summary>
+		///     Reads a type id which has been written by <see cref="BinaryMessageWriter.WriteTypeId" />.
+		/// </summary>
+		/// <returns></returns>
+		public int ReadTypeId()
+		{
+			return Read7BitEncodedInt();
+		}
+
+		/// <summary>
+		///     Returns the type which has previously been assigned the given id.
+		/// </summary>
+		/// <param name="id"></param>
+		/// <returns></returns>
+		/// <exception cref="SerializationException">When no type has been assigned the given id</exception>
+		public Type GetTypeById(int id)
+		{
+			int index = id - 1;
+			if (index < 0 || index >= _types.Count)
+				throw new SerializationException(
+					string.Format("The message refers to type #{0}, but only {1} type(s) have been read so far",
+					              id,
+					              _types.Count));
+
+			return _types[index];
+		}
+
+		/// <summary>
+		///     Assigns the next id to the given type.
+		/// </summary>
+		/// <param name="type"></param>
+		public void AddType(Type type)
+		{
+			_types.Add(type);
+		}
+
+		/// <summary>
+		///     Reads an object id which has been written by <see cref="BinaryMessageWriter.WriteObjectId" />.
+		/// </summary>
+		/// <returns></returns>
+		public int ReadObjectId()
+		{
+			return Read7BitEncodedInt();
+		}
+
+		/// <summary>
+		///     Returns the object which has previously been assigned the given id.
+		/// </summary>
+		/// <param name="id"></param>
+		/// <returns></returns>
+		/// <exception cref="SerializationException">When no object has been assigned the given id</exception>
+		public object GetObjectById(int id)
+		{
+			int index = id - 1;
+			var count = _objects?.Count ?? 0;
+			if (index < 0 || index >= count)
+				throw new SerializationException(
+					string.Format("The message refers to object #{0}, but only {1} object(s) have been read so far",
+					              id,
+					              count));
+
+			return _objects[index];
+		}
+
+		/// <summary>
+		///     Assigns the next id to the given object.
+		/// </summary>
+		/// <param name="value"></param>
+		public void AddObject(object value)
+		{
+			if (_objects == null)
+				_objects = new List<object>();
+
+			_objects.Add(value);
+		}
+
+		/// <summary>
+		///     Reads a string id which has been written by <see cref="BinaryMessageWriter.WriteStringId" />.
+		/// </summary>
+		/// <returns></returns>
+		public int ReadStringId()
+		{
+			return Read7BitEncodedInt();
+		}
+
+		/// <summary>
+		///     Returns the string which has previously been assigned the given id.
+		/// </summary>
+		/// <param name="id"></param>
+		/// <returns></returns>
+		/// <exception cref="SerializationException">When no string has been assigned the given id</exception>
+		public string GetStringById(int id)
+		{
+			int index = id - 2;
+			var count = _strings?.Count ?? 0;
+			if (index < 0 || index >= count)
+				throw new SerializationException(
+					string.Format("The message refers to string #{0}, but only {1} string(s) have been read so far",
+					              id,
+					              count));
+
+			return _strings[index];
+		}
+
+		/// <summary>
+		///     Assigns the next id to the given string, unless the table is full
+		///     (see <see cref="BinaryMessageWriter.MaxStringTableSize" />).
+		/// </summary>
+		/// <param name="value"></param>
+		public void AddString(string value)
+		{
+			if (_strings == null)
+				_strings = new List<string>();
+
+			if (_strings.Count < BinaryMessageWriter.MaxStringTableSize)
+				_strings.Add(value);
+		}
+
+		/// <summary>
+		///     Reads the given amount of bytes as a slice of the message's buffer if that buffer is
+		///     accessible and only copies them otherwise.
+		/// </summary>
+		/// <remarks>
+		///     The returned segment may refer to the buffer of the message: It remains valid for as long as
+		///     that buffer isn't reused (see <see cref="BufferedBinaryMessageReader.ReadByteSegment" />).
+		/// </remarks>
+		/// <param name="count"></param>
+		/// <returns></returns>
+		/// <exception cref="EndOfStreamException">When the message doesn't contain the given amount of bytes anymore</exception>
+		public virtual ArraySegment<byte> ReadByteSegment(int count)
+		{
+			return SliceOrReadBytes(this, count);
+		}
+
+		/// <summary>
+		///     Reads the given amount of bytes from the given reader, without copying them if possible.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <param name="count"></param>
+		/// <returns></returns>
+		/// <exception cref="EndOfStreamException">When the message doesn't contain the given amount of bytes anymore</exception>
+		public static ArraySegment<byte> ReadByteSegment(BinaryReader reader, int count)
+		{
+			if (count < 0)
+				throw new IOException(string.Format("Invalid byte count: {0}", count));
+
+			var messageReader = reader as BinaryMessageReader;
+			if (messageReader != null)
+				return messageReader.ReadByteSegment(count);
+
+			return SliceOrReadBytes(reader, count);
+		}
+
+		private static ArraySegment<byte> SliceOrReadBytes(BinaryReader reader, int count)
+		{
+			var stream = reader.BaseStream as MemoryStream;
+			byte[] buffer;
+			int origin;
+			if (stream != null && TryGetBuffer(stream, out buffer, out origin))
+			{
+				var position = stream.Position;
+				if (stream.Length - position < count)
+					throw new EndOfStreamException();
+
+				stream.Position = position + count;
+				return new ArraySegment<byte>(buffer, origin + (int) position, count);
+			}
+
+			var bytes = reader.ReadBytes(count);
+			if (bytes.Length != count)
+				throw new EndOfStreamException();
+
+			return new ArraySegment<byte>(bytes);
+		}
+
+		private static bool TryGetBuffer(MemoryStream stream, out byte[] buffer, out int origin)
+		{
+#if DOTNETCORE
+			ArraySegment<byte> segment;
+			if (stream.TryGetBuffer(out segment))
+			{
+				buffer = segment.Array;
+				origin = segment.Offset;
+				return true;
+			}
+
+			buffer = null;
+			origin = 0;
+			return false;
+#else
+			// .NET 4.5 neither offers MemoryStream.TryGetBuffer nor does it expose where a stream
+			// starts in its buffer: Only streams which span their entire buffer can be sliced.
+			origin = 0;
+			try
+			{
+				buffer = stream.GetBuffer();
+			}
+			catch (UnauthorizedAccessException)
+			{
+				buffer = null;
+				return false;
+			}
+
+			return buffer.Length == stream.Length;
+#endif
+		}
+	}
+}
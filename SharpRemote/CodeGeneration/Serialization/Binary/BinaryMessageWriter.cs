@@ -0,0 +1,167 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Runtime.CompilerServices;
+using System.Text;
+
+namespace SharpRemote.CodeGeneration.Serialization.Binary
+{
+	/// <summary>
+	///     A <see cref="BinaryWriter" /> which is used to write exactly one message and which
+	///     remembers the types which have already been written as part of that message:
+	///     Only the first occurrence of a type is written by name, every other occurrence
+	///     is written as a small id.
+	///     The same applies to instances of types which opted into reference preservation
+	///     via <see cref="System.Runtime.Serialization.DataContractAttribute.IsReference" />
+	///     and to strings, if <see cref="StringEncoding.Table" /> is used.
+	/// </summary>
+	internal class BinaryMessageWriter
+		: BinaryWriter
+	{
+		private readonly Dictionary<Type, int> _typeIds;
+		private Dictionary<object, int> _objectIds;
+		private Dictionary<string, int> _stringIds;
+
+		/// <summary>
+		///     The maximum number of strings remembered per message: Once the table is full,
+		///     strings which aren't part of it yet are always written in full.
+		/// </summary>
+		public const int MaxStringTableSize = 4096;
+
+		public BinaryMessageWriter(Stream stream)
+			: base(stream, Encoding.UTF8, true)
+		{
+			_typeIds = new Dictionary<Type, int>();
+		}
+
+		/// <summary>
+		///     Writes the given type id using as few bytes as possible.
+		/// </summary>
+		/// <param name="id"></param>
+		public void WriteTypeId(int id)
+		{
+			Write7BitEncodedInt(id);
+		}
+
+		/// <summary>
+		///     Looks up the id of the given type, if it has already been written as part of this message.
+		/// </summary>
+		/// <param name="type"></param>
+		/// <param name="id"></param>
+		/// <returns></returns>
+		public bool TryGetTypeId(Type type, out int id)
+		{
+			return _typeIds.TryGetValue(type, out id);
+		}
+
+		/// <summary>
+		///     Assigns the next id to the given type.
+		/// </summary>
+		/// <param name="type"></param>
+		public void AddType(Type type)
+		{
+			// Ids start at 1 because 0 marks a type which is written by name
+			_typeIds.Add(type, _typeIds.Count + 1);
+		}
+
+		/// <summary>
+		///     Writes the given object id using as few bytes as possible.
+		/// </summary>
+		/// <param name="id"></param>
+		public void WriteObjectId(int id)
+		{
+			Write7BitEncodedInt(id);
+		}
+
+		/// <summary>
+		///     Looks up the id of the given object, if it has already been written as part of this message.
+		/// </summary>
+		/// <param name="value"></param>
+		/// <param name="id"></param>
+		/// <returns></returns>
+		public bool TryGetObjectId(object value, out int id)
+		{
+			if (_objectIds == null)
+			{
+				id = 0;
+				return false;
+			}
+
+			return _objectIds.TryGetValue(value, out id);
+		}
+
+		/// <summary>
+		///     Assigns the next id to the given object.
+		/// </summary>
+		/// <param name="value"></param>
+		public void AddObject(object value)
+		{
+			// Most messages never contain a single reference-preserved object,
+			// hence the table is only created when it's actually needed.
+			if (_objectIds == null)
+				_objectIds = new Dictionary<object, int>(ReferenceComparer.Instance);
+
+			// Ids start at 1 because 0 marks an object which is written in full
+			_objectIds.Add(value, _objectIds.Count + 1);
+		}
+
+		/// <summary>
+		///     Writes the given string id using as few bytes as possible.
+		/// </summary>
+		/// <param name="id"></param>
+		public void WriteStringId(int id)
+		{
+			Write7BitEncodedInt(id);
+		}
+
+		/// <summary>
+		///     Looks up the id of the given string, if it has already been written as part of this message.
+		/// </summary>
+		/// <param name="value"></param>
+		/// <param name="id"></param>
+		/// <returns></returns>
+		public bool TryGetStringId(string value, out int id)
+		{
+			if (_stringIds == null)
+			{
+				id = 0;
+				return false;
+			}
+
+			return _stringIds.TryGetValue(value, out id);
+		}
+
+		/// <summary>
+		///     Assigns the next id to the given string, unless the table is full.
+		/// </summary>
+		/// <param name="value"></param>
+		public void AddString(string value)
+		{
+			if (_stringIds == null)
+				_stringIds = new Dictionary<string, int>(StringComparer.Ordinal);
+
+			// Ids start at 2 because 0 marks null and 1 marks a string which is written in full
+			if (_stringIds.Count < MaxStringTableSize)
+				_stringIds.Add(value, _stringIds.Count + 2);
+		}
+
+		/// <summary>
+		///     Compares objects by identity, ignoring any Equals/GetHashCode override.
+		/// </summary>
+		private sealed class ReferenceComparer
+			: IEqualityComparer<object>
+		{
+			public static readonly ReferenceComparer Instance = new ReferenceComparer();
+
+			public new bool Equals(object x, object y)
+			{
+				return ReferenceEquals(x, y);
+			}
+
+			public int GetHashCode(object obj)
+			{
+				return RuntimeHelpers.GetHashCode(obj);
+			}
+		}
+	}
+}
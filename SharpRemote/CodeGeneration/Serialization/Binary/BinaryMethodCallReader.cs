@@ -6,27 +6,25 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 	internal sealed class BinaryMethodCallReader
 		: IMethodCallReader
 	{
-		private readonly Stream _stream;
 		private readonly BinarySerializer2 _serializer;
-		private readonly BinaryReader _reader;
+		private readonly BinaryMessageReader _reader;
 		private readonly ulong _grainId;
 		private readonly string _methodName;
 		private readonly ulong _rpcId;
 
-		public BinaryMethodCallReader(BinarySerializer2 serializer, BinaryReader reader)
+		public BinaryMethodCallReader(BinarySerializer2 serializer, BinaryMessageReader reader)
 		{
 			if (reader == null)
 				throw new ArgumentNullException(nameof(reader));
 
 			_serializer = serializer;
 			_reader = reader;
-			_stream = reader.BaseStream;
 			_grainId = _reader.ReadUInt64();
 			_methodName = _reader.ReadString();
 			_rpcId = _reader.ReadUInt64();
 		}
 
-		private bool EndOfStream => _stream.Position >= _stream.Length;
+		private bool EndOfStream => _reader.EndOfMessage;
 
 		public void Dispose()
 		{
@@ -53,7 +51,14 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 
 		public bool ReadNextArgumentAsStruct<T>(out T value) where T : struct
 		{
-			throw new NotImplementedException();
+			if (EndOfStream)
+			{
+				value = default(T);
+				return false;
+			}
+
+			value = _serializer.ReadValue<T>(_reader, null);
+			return true;
 		}
 
 		public bool ReadNextArgumentAsSByte(out sbyte value)
@@ -112,7 +117,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 				return false;
 			}
 
-			value = BinarySerializer2.ReadValueAsUInt32(_reader);
+			value = _serializer.ReadEncodedUInt32(_reader);
 			return true;
 		}
 
@@ -124,7 +129,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 				return false;
 			}
 
-			value = BinarySerializer2.ReadValueAsInt32(_reader);
+			value = _serializer.ReadEncodedInt32(_reader);
 			return true;
 		}
 
@@ -136,7 +141,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 				return false;
 			}
 
-			value = BinarySerializer2.ReadValueAsUInt64(_reader);
+			value = _serializer.ReadEncodedUInt64(_reader);
 			return true;
 		}
 
@@ -148,7 +153,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 				return false;
 			}
 
-			value = BinarySerializer2.ReadValueAsInt64(_reader);
+			value = _serializer.ReadEncodedInt64(_reader);
 			return true;
 		}
 
@@ -208,7 +213,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 				return false;
 			}
 
-			value = BinarySerializer2.ReadValueAsString(_reader);
+			value = _serializer.ReadEncodedString(_reader);
 			return true;
 		}
 
@@ -232,5 +237,17 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 
 			return true;
 		}
+
+		public bool ReadNextArgumentAsByteSegment(out ArraySegment<byte> value)
+		{
+			if (EndOfStream)
+			{
+				value = default(ArraySegment<byte>);
+				return false;
+			}
+
+			value = BinarySerializer2.ReadByteSegment(_reader);
+			return true;
+		}
 	}
 }
\ No newline at end of file
@@ -1,6 +1,5 @@
 using System;
 using System.IO;
-using System.Text;
 
 namespace SharpRemote.CodeGeneration.Serialization.Binary
 {
@@ -12,10 +11,14 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 		private readonly BinaryWriter _writer;
 
 		public BinaryMethodCallWriter(BinarySerializer2 serializer, Stream stream, ulong grainId, string methodName, ulong rpcId, IRemotingEndPoint endPoint = null)
+			: this(serializer, new BinaryMessageWriter(stream), grainId, methodName, rpcId, endPoint)
+		{}
+
+		public BinaryMethodCallWriter(BinarySerializer2 serializer, BinaryMessageWriter writer, ulong grainId, string methodName, ulong rpcId, IRemotingEndPoint endPoint = null)
 		{
 			_serializer = serializer;
 			_endPoint = endPoint;
-			_writer = new BinaryWriter(stream, Encoding.UTF8, true);
+			_writer = writer;
 			_writer.Write((byte)MessageType2.Call);
 			_writer.Write(grainId);
 			_writer.Write(methodName);
@@ -32,6 +35,11 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 			_serializer.WriteObject(_writer, value, _endPoint);
 		}
 
+		public void WriteArgument<T>(T value) where T : struct
+		{
+			_serializer.WriteValue(_writer, value, _endPoint);
+		}
+
 		public void WriteArgument(sbyte value)
 		{
 			BinarySerializer2.WriteValue(_writer, value);
@@ -54,22 +62,22 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 
 		public void WriteArgument(uint value)
 		{
-			BinarySerializer2.WriteValue(_writer, value);
+			_serializer.WriteEncoded(_writer, value);
 		}
 
 		public void WriteArgument(int value)
 		{
-			BinarySerializer2.WriteValue(_writer, value);
+			_serializer.WriteEncoded(_writer, value);
 		}
 
 		public void WriteArgument(ulong value)
 		{
-			BinarySerializer2.WriteValue(_writer, value);
+			_serializer.WriteEncoded(_writer, value);
 		}
 
 		public void WriteArgument(long value)
 		{
-			BinarySerializer2.WriteValue(_writer, value);
+			_serializer.WriteEncoded(_writer, value);
 		}
 
 		public void WriteArgument(float value)
@@ -94,12 +102,17 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 
 		public void WriteArgument(string value)
 		{
-			BinarySerializer2.WriteValue(_writer, value);
+			_serializer.WriteEncoded(_writer, value);
 		}
 
 		public void WriteArgument(byte[] value)
 		{
 			BinarySerializer2.WriteValue(_writer, value);
 		}
+
+		public void WriteArgument(ArraySegment<byte> value)
+		{
+			BinarySerializer2.WriteValue(_writer, value);
+		}
 	}
 }
\ No newline at end of file
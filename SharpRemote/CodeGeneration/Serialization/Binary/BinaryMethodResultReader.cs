@@ -7,22 +7,20 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 		: IMethodResultReader
 	{
 		private readonly BinarySerializer2 _serializer;
-		private readonly BinaryReader _reader;
+		private readonly BinaryMessageReader _reader;
 		private readonly ulong _rpcId;
-		private readonly Stream _stream;
 
-		public BinaryMethodResultReader(BinarySerializer2 serializer, BinaryReader reader)
+		public BinaryMethodResultReader(BinarySerializer2 serializer, BinaryMessageReader reader)
 		{
 			if (reader == null)
 				throw new ArgumentNullException(nameof(reader));
 
 			_serializer = serializer;
 			_reader = reader;
-			_stream = reader.BaseStream;
 			_rpcId = _reader.ReadUInt64();
 		}
 		
-		private bool EndOfStream => _stream.Position >= _stream.Length;
+		private bool EndOfStream => _reader.EndOfMessage;
 
 		public void Dispose()
 		{
@@ -55,6 +53,18 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 			return true;
 		}
 
+		public bool ReadResultStruct<T>(out T value) where T : struct
+		{
+			if (EndOfStream)
+			{
+				value = default(T);
+				return false;
+			}
+
+			value = _serializer.ReadValue<T>(_reader, null);
+			return true;
+		}
+
 		public bool ReadResultSByte(out sbyte value)
 		{
 			if (EndOfStream)
@@ -111,7 +121,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 				return false;
 			}
 
-			value = BinarySerializer2.ReadValueAsUInt32(_reader);
+			value = _serializer.ReadEncodedUInt32(_reader);
 			return true;
 		}
 
@@ -123,7 +133,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 				return false;
 			}
 
-			value = BinarySerializer2.ReadValueAsInt32(_reader);
+			value = _serializer.ReadEncodedInt32(_reader);
 			return true;
 		}
 
@@ -135,7 +145,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 				return false;
 			}
 
-			value = BinarySerializer2.ReadValueAsUInt64(_reader);
+			value = _serializer.ReadEncodedUInt64(_reader);
 			return true;
 		}
 
@@ -147,7 +157,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 				return false;
 			}
 
-			value = BinarySerializer2.ReadValueAsInt64(_reader);
+			value = _serializer.ReadEncodedInt64(_reader);
 			return true;
 		}
 
@@ -183,7 +193,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 				return false;
 			}
 
-			value = BinarySerializer2.ReadValueAsString(_reader);
+			value = _serializer.ReadEncodedString(_reader);
 			return true;
 		}
 
@@ -207,5 +217,17 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 
 			return true;
 		}
+
+		public bool ReadResultByteSegment(out ArraySegment<byte> value)
+		{
+			if (EndOfStream)
+			{
+				value = default(ArraySegment<byte>);
+				return false;
+			}
+
+			value = BinarySerializer2.ReadByteSegment(_reader);
+			return true;
+		}
 	}
 }
\ No newline at end of file
@@ -1,6 +1,5 @@
 using System;
 using System.IO;
-using System.Text;
 
 namespace SharpRemote.CodeGeneration.Serialization.Binary
 {
@@ -18,11 +17,18 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 		                                Stream stream,
 		                                ulong rpcId,
 		                                IRemotingEndPoint endPoint = null)
+			: this(serializer, new BinaryMessageWriter(stream), rpcId, endPoint)
+		{}
+
+		public BinaryMethodResultWriter(BinarySerializer2 serializer,
+		                                BinaryMessageWriter writer,
+		                                ulong rpcId,
+		                                IRemotingEndPoint endPoint = null)
 		{
 			_serializer = serializer;
 			_endPoint = endPoint;
-			_stream = stream;
-			_writer = new BinaryWriter(stream, Encoding.UTF8, true);
+			_stream = writer.BaseStream;
+			_writer = writer;
 			_writer.Write((byte)MessageType2.Result);
 			_writer.Write(rpcId);
 		}
@@ -39,7 +45,12 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 
 		public void WriteResult(object value)
 		{
-			throw new NotImplementedException();
+			_serializer.WriteObject(_writer, value, _endPoint);
+		}
+
+		public void WriteResult<T>(T value) where T : struct
+		{
+			_serializer.WriteValue(_writer, value, _endPoint);
 		}
 
 		public void WriteResult(sbyte value)
@@ -64,22 +75,22 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 
 		public void WriteResult(uint value)
 		{
-			BinarySerializer2.WriteValue(_writer, value);
+			_serializer.WriteEncoded(_writer, value);
 		}
 
 		public void WriteResult(int value)
 		{
-			BinarySerializer2.WriteValue(_writer, value);
+			_serializer.WriteEncoded(_writer, value);
 		}
 
 		public void WriteResult(ulong value)
 		{
-			BinarySerializer2.WriteValue(_writer, value);
+			_serializer.WriteEncoded(_writer, value);
 		}
 
 		public void WriteResult(long value)
 		{
-			BinarySerializer2.WriteValue(_writer, value);
+			_serializer.WriteEncoded(_writer, value);
 		}
 
 		public void WriteResult(float value)
@@ -94,7 +105,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 
 		public void WriteResult(string value)
 		{
-			BinarySerializer2.WriteValue(_writer, value);
+			_serializer.WriteEncoded(_writer, value);
 		}
 
 		public void WriteResult(byte[] value)
@@ -102,6 +113,11 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 			BinarySerializer2.WriteValue(_writer, value);
 		}
 
+		public void WriteResult(ArraySegment<byte> value)
+		{
+			BinarySerializer2.WriteValue(_writer, value);
+		}
+
 		public void WriteException(Exception e)
 		{
 			_writer.Flush();
@@ -34,7 +34,22 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 
 		public Func<BinaryReader, BinarySerializer2, IRemotingEndPoint, object> ReadObjectDelegate { get; private set; }
 
-		public static BinaryMethodsCompiler Create(TypeBuilder typeBuilder, ITypeDescription typeDescription)
+		/// <summary>
+		///     An Action{BinaryWriter, T, BinarySerializer2, IRemotingEndPoint} which writes a value of type T
+		///     without boxing it or null when T is not a value type.
+		/// </summary>
+		public Delegate WriteValueDelegate { get; private set; }
+
+		/// <summary>
+		///     A Func{BinaryReader, BinarySerializer2, IRemotingEndPoint, T} which reads a value of type T
+		///     without boxing it or null when T is not a value type.
+		/// </summary>
+		public Delegate ReadValueDelegate { get; private set; }
+
+		public static BinaryMethodsCompiler Create(TypeBuilder typeBuilder,
+		                                          ITypeDescription typeDescription,
+		                                          IntegerEncoding integerEncoding,
+		                                          StringEncoding stringEncoding)
 		{
 			var context = new CompilationContext
 			{
@@ -42,7 +57,9 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 				SerializerType = typeof(BinarySerializer2),
 				ReaderType = typeof(BinaryReader),
 				WriterType = typeof(BinaryWriter),
-				TypeBuilder = typeBuilder
+				TypeBuilder = typeBuilder,
+				IntegerEncoding = integerEncoding,
+				StringEncoding = stringEncoding
 			};
 
 			return new BinaryMethodsCompiler(typeBuilder,
@@ -67,6 +84,18 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 				(Func<BinaryReader, BinarySerializer2, IRemotingEndPoint, object>)
 				_context.TypeBuilder.GetMethod("ReadObjectNotNull")
 				        .CreateDelegate(typeof(Func<BinaryReader, BinarySerializer2, IRemotingEndPoint, object>));
+
+			var type = _context.Type;
+			if (type.IsValueType)
+			{
+				WriteValueDelegate =
+					_context.TypeBuilder.GetMethod("WriteValueNotNull")
+					        .CreateDelegate(typeof(Action<,,,>).MakeGenericType(typeof(BinaryWriter), type, typeof(BinarySerializer2), typeof(IRemotingEndPoint)));
+
+				ReadValueDelegate =
+					_context.TypeBuilder.GetMethod("ReadValueNotNull")
+					        .CreateDelegate(typeof(Func<,,,>).MakeGenericType(typeof(BinaryReader), typeof(BinarySerializer2), typeof(IRemotingEndPoint), type));
+			}
 		}
 	}
 }
\ No newline at end of file
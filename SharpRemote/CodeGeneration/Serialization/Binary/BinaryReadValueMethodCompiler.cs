@@ -17,11 +17,24 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 		private static readonly MethodInfo BinarySerializer2ReadInt64;
 		private static readonly MethodInfo BinarySerializer2ReadUInt64;
 		private static readonly MethodInfo BinarySerializer2ReadString;
+		private static readonly MethodInfo BinarySerializer2ReadInternedString;
 		private static readonly MethodInfo BinarySerializer2ReadDateTime;
 		private static readonly MethodInfo BinarySerializer2ReadFloat;
 		private static readonly MethodInfo BinarySerializer2ReadDouble;
 		private static readonly MethodInfo BinarySerializer2ReadException;
 		private static readonly MethodInfo BinarySerializer2ReadObject;
+		private static readonly MethodInfo BinarySerializer2ReadVarintInt32;
+		private static readonly MethodInfo BinarySerializer2ReadVarintUInt32;
+		private static readonly MethodInfo BinarySerializer2ReadVarintInt64;
+		private static readonly MethodInfo BinarySerializer2ReadVarintUInt64;
+		private static readonly MethodInfo BinarySerializer2ReadObjectReference;
+		private static readonly MethodInfo BinarySerializer2AddObjectReference;
+
+		private readonly MethodInfo _readInt32;
+		private readonly MethodInfo _readUInt32;
+		private readonly MethodInfo _readInt64;
+		private readonly MethodInfo _readUInt64;
+		private readonly MethodInfo _readString;
 
 		static BinaryReadValueMethodCompiler()
 		{
@@ -35,16 +48,32 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 			BinarySerializer2ReadInt64 = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.ReadValueAsInt64));
 			BinarySerializer2ReadUInt64 = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.ReadValueAsUInt64));
 			BinarySerializer2ReadString = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.ReadValueAsString));
+			BinarySerializer2ReadInternedString = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.ReadValueAsInternedString));
 			BinarySerializer2ReadDateTime = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.ReadValueAsDateTime));
 			BinarySerializer2ReadFloat = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.ReadValueAsSingle));
 			BinarySerializer2ReadDouble = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.ReadValueAsDouble));
 			BinarySerializer2ReadDecimal = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.ReadValueAsDecimal));
 			BinarySerializer2ReadException = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.ReadValueAsException));
+			BinarySerializer2ReadVarintInt32 = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.ReadVarintAsInt32));
+			BinarySerializer2ReadVarintUInt32 = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.ReadVarintAsUInt32));
+			BinarySerializer2ReadVarintInt64 = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.ReadVarintAsInt64));
+			BinarySerializer2ReadVarintUInt64 = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.ReadVarintAsUInt64));
+			BinarySerializer2ReadObjectReference = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.ReadObjectReference));
+			BinarySerializer2AddObjectReference = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.AddObjectReference));
 		}
 
 		public BinaryReadValueMethodCompiler(CompilationContext context)
 			: base(context)
-		{}
+		{
+			var varint = context.IntegerEncoding == IntegerEncoding.Varint;
+			_readInt32 = varint ? BinarySerializer2ReadVarintInt32 : BinarySerializer2ReadInt32;
+			_readUInt32 = varint ? BinarySerializer2ReadVarintUInt32 : BinarySerializer2ReadUInt32;
+			_readInt64 = varint ? BinarySerializer2ReadVarintInt64 : BinarySerializer2ReadInt64;
+			_readUInt64 = varint ? BinarySerializer2ReadVarintUInt64 : BinarySerializer2ReadUInt64;
+			_readString = context.StringEncoding == StringEncoding.Table
+				? BinarySerializer2ReadInternedString
+				: BinarySerializer2ReadString;
+		}
 
 		protected override void EmitBeginRead(ILGenerator gen)
 		{
@@ -57,6 +86,45 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 			gen.Emit(OpCodes.Call, BinarySerializer2ReadObject);
 		}
 
+		protected override void EmitReadObjectReference(ILGenerator gen)
+		{
+			// var existing = BinarySerializer2.ReadObjectReference(reader);
+			// if (existing != null) return (T)existing;
+			var readInFull = gen.DefineLabel();
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, BinarySerializer2ReadObjectReference);
+			gen.Emit(OpCodes.Dup);
+			gen.Emit(OpCodes.Brfalse, readInFull);
+			gen.Emit(OpCodes.Castclass, Method.ReturnType);
+			gen.Emit(OpCodes.Ret);
+			gen.MarkLabel(readInFull);
+			gen.Emit(OpCodes.Pop);
+		}
+
+		protected override void EmitAddObjectReference(ILGenerator gen, LocalBuilder value)
+		{
+			// BinarySerializer2.AddObjectReference(reader, value);
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Ldloc, value);
+			gen.Emit(OpCodes.Call, BinarySerializer2AddObjectReference);
+		}
+
+		protected override bool SupportsDeltaEncoding => true;
+
+		protected override void EmitReadDeltaHeader(ILGenerator gen)
+		{
+			// BinarySerializer2.ReadVarintAsUInt32(reader)
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, BinarySerializer2ReadVarintUInt32);
+		}
+
+		protected override void EmitReadDeltaBitmap(ILGenerator gen)
+		{
+			// BinarySerializer2.ReadVarintAsUInt64(reader)
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, BinarySerializer2ReadVarintUInt64);
+		}
+
 		protected override void EmitBeginReadField(ILGenerator gen, IFieldDescription field)
 		{
 		}
@@ -100,19 +168,19 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 			}
 			else if (storageType == typeof(int))
 			{
-				gen.Emit(OpCodes.Call, BinarySerializer2ReadInt32);
+				gen.Emit(OpCodes.Call, _readInt32);
 			}
 			else if (storageType == typeof(uint))
 			{
-				gen.Emit(OpCodes.Call, BinarySerializer2ReadUInt32);
+				gen.Emit(OpCodes.Call, _readUInt32);
 			}
 			else if (storageType == typeof(long))
 			{
-				gen.Emit(OpCodes.Call, BinarySerializer2ReadInt64);
+				gen.Emit(OpCodes.Call, _readInt64);
 			}
 			else if (storageType == typeof(ulong))
 			{
-				gen.Emit(OpCodes.Call, BinarySerializer2ReadUInt64);
+				gen.Emit(OpCodes.Call, _readUInt64);
 			}
 			else
 			{
@@ -147,25 +215,25 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 		protected override void EmitReadUInt32(ILGenerator gen)
 		{
 			gen.Emit(OpCodes.Ldarg_0);
-			gen.Emit(OpCodes.Call, BinarySerializer2ReadUInt32);
+			gen.Emit(OpCodes.Call, _readUInt32);
 		}
 
 		protected override void EmitReadInt32(ILGenerator gen)
 		{
 			gen.Emit(OpCodes.Ldarg_0);
-			gen.Emit(OpCodes.Call, BinarySerializer2ReadInt32);
+			gen.Emit(OpCodes.Call, _readInt32);
 		}
 
 		protected override void EmitReadUInt64(ILGenerator gen)
 		{
 			gen.Emit(OpCodes.Ldarg_0);
-			gen.Emit(OpCodes.Call, BinarySerializer2ReadUInt64);
+			gen.Emit(OpCodes.Call, _readUInt64);
 		}
 
 		protected override void EmitReadInt64(ILGenerator gen)
 		{
 			gen.Emit(OpCodes.Ldarg_0);
-			gen.Emit(OpCodes.Call, BinarySerializer2ReadInt64);
+			gen.Emit(OpCodes.Call, _readInt64);
 		}
 
 		protected override void EmitReadDecimal(ILGenerator gen)
@@ -189,7 +257,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 		protected override void EmitReadString(ILGenerator gen)
 		{
 			gen.Emit(OpCodes.Ldarg_0);
-			gen.Emit(OpCodes.Call, BinarySerializer2ReadString);
+			gen.Emit(OpCodes.Call, _readString);
 		}
 
 		protected override void EmitReadDateTime(ILGenerator gen)
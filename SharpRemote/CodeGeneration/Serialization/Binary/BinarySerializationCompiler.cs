@@ -7,16 +7,22 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 		: ISerializationMethodCompiler<BinaryMethodsCompiler>
 	{
 		private readonly ModuleBuilder _module;
+		private readonly IntegerEncoding _integerEncoding;
+		private readonly StringEncoding _stringEncoding;
 
-		public BinarySerializationCompiler(ModuleBuilder moduleBuilder)
+		public BinarySerializationCompiler(ModuleBuilder moduleBuilder,
+		                                   IntegerEncoding integerEncoding,
+		                                   StringEncoding stringEncoding)
 		{
 			_module = moduleBuilder;
+			_integerEncoding = integerEncoding;
+			_stringEncoding = stringEncoding;
 		}
 
 		public BinaryMethodsCompiler Prepare(string typeName, ITypeDescription typeDescription)
 		{
 			TypeBuilder typeBuilder = _module.DefineType(typeName, TypeAttributes.Public | TypeAttributes.Class);
-			return BinaryMethodsCompiler.Create(typeBuilder, typeDescription);
+			return BinaryMethodsCompiler.Create(typeBuilder, typeDescription, _integerEncoding, _stringEncoding);
 		}
 
 		public void Compile(BinaryMethodsCompiler methods, ISerializationMethodStorage<BinaryMethodsCompiler> storage)
@@ -55,6 +55,7 @@ namespace SharpRemote
 				new BuiltInTypeSerializer(),
 				new StringSerializer(),
 				new ByteArraySerializer(),
+				new ByteSegmentSerializer(),
 				new TimeSpanSerializer(),
 				new DateTimeSerializer(),
 				new DateTimeOffsetSerializer(),
@@ -1,9 +1,12 @@
 ﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
 using System.ComponentModel;
 using System.IO;
+using System.Linq;
 using System.Reflection;
 using System.Reflection.Emit;
-using System.Runtime.Serialization.Formatters.Binary;
+using System.Runtime.Serialization;
 using System.Text;
 using log4net;
 using SharpRemote.CodeGeneration.Serialization;
@@ -27,6 +30,10 @@ namespace SharpRemote
 		private readonly SerializationMethodStorage<BinaryMethodsCompiler> _methodStorage;
 		private readonly BinarySerializationCompiler _methodCompiler;
 		private readonly ITypeResolver _typeResolver;
+		private readonly IntegerEncoding _integerEncoding;
+		private readonly StringEncoding _stringEncoding;
+		private readonly ConcurrentDictionary<string, Type> _typesByName;
+		private readonly Func<string, Type> _resolveType;
 
 		/// <summary>
 		/// </summary>
@@ -41,11 +48,107 @@ namespace SharpRemote
 		/// <param name="moduleBuilder"></param>
 		/// <param name="typeResolver"></param>
 		public BinarySerializer2(ModuleBuilder moduleBuilder, ITypeResolver typeResolver = null)
+			: this(moduleBuilder, typeResolver, IntegerEncoding.Fixed)
 		{
-			_methodCompiler = new BinarySerializationCompiler(moduleBuilder);
-			_methodStorage = new SerializationMethodStorage<BinaryMethodsCompiler>("BinarySerializer",
-			                                                                       _methodCompiler);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="moduleBuilder"></param>
+		/// <param name="typeResolver"></param>
+		/// <param name="integerEncoding">The encoding of integers, as negotiated during the handshake</param>
+		/// <exception cref="ArgumentException">When <paramref name="integerEncoding" /> isn't exactly one encoding</exception>
+		public BinarySerializer2(ModuleBuilder moduleBuilder, ITypeResolver typeResolver, IntegerEncoding integerEncoding)
+			: this(moduleBuilder, typeResolver, integerEncoding, StringEncoding.Inline)
+		{
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="moduleBuilder"></param>
+		/// <param name="typeResolver"></param>
+		/// <param name="integerEncoding">The encoding of integers, as negotiated during the handshake</param>
+		/// <param name="stringEncoding">The encoding of strings, as negotiated during the handshake</param>
+		/// <exception cref="ArgumentException">When <paramref name="integerEncoding" /> or <paramref name="stringEncoding" /> isn't exactly one encoding</exception>
+		public BinarySerializer2(ModuleBuilder moduleBuilder,
+		                         ITypeResolver typeResolver,
+		                         IntegerEncoding integerEncoding,
+		                         StringEncoding stringEncoding)
+		{
+			if (integerEncoding != IntegerEncoding.Fixed && integerEncoding != IntegerEncoding.Varint)
+				throw new ArgumentException(string.Format("Expected exactly one integer encoding but got: {0}", integerEncoding),
+				                            nameof(integerEncoding));
+			if (stringEncoding != StringEncoding.Inline && stringEncoding != StringEncoding.Table)
+				throw new ArgumentException(string.Format("Expected exactly one string encoding but got: {0}", stringEncoding),
+				                            nameof(stringEncoding));
+
+			_integerEncoding = integerEncoding;
+			_stringEncoding = stringEncoding;
+			_methodCompiler = new BinarySerializationCompiler(moduleBuilder, integerEncoding, stringEncoding);
+			_methodStorage = new SerializationMethodStorage<BinaryMethodsCompiler>(
+				(integerEncoding == IntegerEncoding.Varint ? "Varint" : "") +
+				(stringEncoding == StringEncoding.Table ? "StringTable" : "") +
+				"BinarySerializer",
+				_methodCompiler);
 			_typeResolver = typeResolver;
+			_typesByName = new ConcurrentDictionary<string, Type>();
+			_resolveType = ResolveType;
+		}
+
+		/// <summary>
+		///     The encoding of integers used by this serializer.
+		/// </summary>
+		public IntegerEncoding IntegerEncoding => _integerEncoding;
+
+		/// <summary>
+		///     The integer encodings supported by this serializer.
+		/// </summary>
+		public const IntegerEncoding SupportedIntegerEncodings = IntegerEncoding.Fixed | IntegerEncoding.Varint;
+
+		/// <summary>
+		///     Chooses the integer encoding for a connection during the handshake:
+		///     <see cref="SharpRemote.IntegerEncoding.Varint" /> is chosen if both sides support it,
+		///     otherwise <see cref="SharpRemote.IntegerEncoding.Fixed" /> is chosen because it's understood
+		///     by every endpoint, including those which don't announce any encoding at all.
+		/// </summary>
+		/// <param name="supportedByClient"></param>
+		/// <param name="supportedByServer"></param>
+		/// <returns></returns>
+		public static IntegerEncoding ChooseIntegerEncoding(IntegerEncoding supportedByClient, IntegerEncoding supportedByServer)
+		{
+			var common = supportedByClient & supportedByServer;
+			if ((common & IntegerEncoding.Varint) != 0)
+				return IntegerEncoding.Varint;
+			return IntegerEncoding.Fixed;
+		}
+
+		/// <summary>
+		///     The encoding of strings used by this serializer.
+		/// </summary>
+		public StringEncoding StringEncoding => _stringEncoding;
+
+		/// <summary>
+		///     The string encodings supported by this serializer.
+		/// </summary>
+		public const StringEncoding SupportedStringEncodings = StringEncoding.Inline | StringEncoding.Table;
+
+		/// <summary>
+		///     Chooses the string encoding for a connection during the handshake:
+		///     <see cref="SharpRemote.StringEncoding.Table" /> is chosen if both sides support it,
+		///     otherwise <see cref="SharpRemote.StringEncoding.Inline" /> is chosen because it's understood
+		///     by every endpoint, including those which don't announce any encoding at all.
+		/// </summary>
+		/// <param name="supportedByClient"></param>
+		/// <param name="supportedByServer"></param>
+		/// <returns></returns>
+		public static StringEncoding ChooseStringEncoding(StringEncoding supportedByClient, StringEncoding supportedByServer)
+		{
+			var common = supportedByClient & supportedByServer;
+			if ((common & StringEncoding.Table) != 0)
+				return StringEncoding.Table;
+			return StringEncoding.Inline;
 		}
 
 		/// <inheritdoc />
@@ -62,6 +165,15 @@ namespace SharpRemote
 			Log.DebugFormat("Type '{0}' successfully registered", type);
 		}
 
+		/// <inheritdoc />
+		public IReadOnlyList<PreparedType> RegisterTypes(IEnumerable<Type> types)
+		{
+			if (types == null)
+				throw new ArgumentNullException(nameof(types));
+
+			return types.Select(x => PreparedType.Prepare(x, RegisterType)).ToList();
+		}
+
 		/// <inheritdoc />
 		public bool IsTypeRegistered<T>()
 		{
@@ -92,7 +204,13 @@ namespace SharpRemote
 		                               out IMethodResultReader resultReader,
 		                               IRemotingEndPoint endPoint = null)
 		{
-			var reader = new BinaryReader(stream, Encoding.UTF8, true);
+			CreateMethodReader(new BinaryMessageReader(stream), out callReader, out resultReader);
+		}
+
+		internal void CreateMethodReader(BinaryMessageReader reader,
+		                                 out IMethodCallReader callReader,
+		                                 out IMethodResultReader resultReader)
+		{
 			var type = (MessageType2)reader.ReadByte();
 			if (type == MessageType2.Call)
 			{
@@ -121,7 +239,7 @@ namespace SharpRemote
 			var methods = _methodStorage.GetOrAdd(message.GetType());
 
 			using (var stream = new MemoryStream())
-			using (var writer = new BinaryWriter(stream))
+			using (var writer = new BinaryMessageWriter(stream))
 			{
 				methods.WriteDelegate(writer, message, this, null);
 				writer.Flush();
@@ -140,7 +258,7 @@ namespace SharpRemote
 			var methods = _methodStorage.GetOrAdd(typeof(T));
 
 			using (var stream = new MemoryStream(serializedMessage))
-			using (var reader = new BinaryReader(stream))
+			using (var reader = new BinaryMessageReader(stream))
 			{
 				var value = methods.ReadObjectDelegate(reader, this, null);
 				return (T) value;
@@ -182,6 +300,29 @@ namespace SharpRemote
 			methods.WriteDelegate(writer, value, this, endPoint);
 		}
 
+		/// <summary>
+		///     Writes the given value exactly like <see cref="WriteObject" /> would, but without boxing it:
+		///     The value can be read again with either <see cref="ReadValue{T}" /> or <see cref="ReadObject" />.
+		/// </summary>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		/// <param name="endPoint"></param>
+		public void WriteValue<T>(BinaryWriter writer, T value, IRemotingEndPoint endPoint) where T : struct
+		{
+			var methods = _methodStorage.GetOrAdd(typeof(T));
+			var writeValue = methods.WriteValueDelegate as Action<BinaryWriter, T, BinarySerializer2, IRemotingEndPoint>;
+			if (writeValue == null)
+			{
+				WriteObject(writer, value, endPoint);
+				return;
+			}
+
+			WriteValue(writer, true);
+			WriteTypeInformation(writer, typeof(T));
+			writeValue(writer, value, this, endPoint);
+		}
+
 		/// <summary>
 		/// 
 		/// </summary>
@@ -309,6 +450,49 @@ namespace SharpRemote
 				writer.Write(false);
 			}
 		}
+
+		/// <summary>
+		///     Writes either the id of the given string (if it has already been written as part of the current message),
+		///     or 1 followed by the string itself, or 0 if the string is null.
+		/// </summary>
+		/// <remarks>
+		///     Used instead of <see cref="WriteValue(BinaryWriter, string)" /> when <see cref="SharpRemote.StringEncoding.Table" /> is used.
+		/// </remarks>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteInternedString(BinaryWriter writer, string value)
+		{
+			if (value == null)
+			{
+				writer.Write((byte) 0);
+				return;
+			}
+
+			var messageWriter = writer as BinaryMessageWriter;
+			int id;
+			if (messageWriter != null && messageWriter.TryGetStringId(value, out id))
+			{
+				messageWriter.WriteStringId(id);
+				return;
+			}
+
+			writer.Write((byte) 1);
+			writer.Write(value);
+			messageWriter?.AddString(value);
+		}
+
+		/// <summary>
+		///     Writes the given value using this serializer's <see cref="StringEncoding" />.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		internal void WriteEncoded(BinaryWriter writer, string value)
+		{
+			if (_stringEncoding == StringEncoding.Table)
+				WriteInternedString(writer, value);
+			else
+				WriteValue(writer, value);
+		}
 		
 		/// <summary>
 		/// 
@@ -339,6 +523,193 @@ namespace SharpRemote
 			}
 		}
 
+		/// <summary>
+		///     Writes the given slice straight from its array, in the same format as a byte[]:
+		///     A segment without an array is written as null.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, ArraySegment<byte> value)
+		{
+			if (value.Array != null)
+			{
+				writer.Write(true);
+				writer.Write(value.Count);
+				writer.Write(value.Array, value.Offset, value.Count);
+			}
+			else
+			{
+				writer.Write(false);
+			}
+		}
+
+		/// <summary>
+		///     Reads a value which has been written by <see cref="WriteValue(BinaryWriter, byte[])" />
+		///     or <see cref="WriteValue(BinaryWriter, ArraySegment{byte})" />.
+		/// </summary>
+		/// <remarks>
+		///     Whenever possible, the returned segment is a slice of the message's buffer instead of a copy:
+		///     It shall not be used anymore once the message's reader has been disposed of.
+		/// </remarks>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static ArraySegment<byte> ReadByteSegment(BinaryReader reader)
+		{
+			if (!reader.ReadBoolean())
+				return default(ArraySegment<byte>);
+
+			var count = reader.ReadInt32();
+			return BinaryMessageReader.ReadByteSegment(reader, count);
+		}
+
+#if DOTNETCORE
+		/// <summary>
+		///     Writes the given memory straight to the writer, in the same format as a byte[].
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, ReadOnlyMemory<byte> value)
+		{
+			writer.Write(true);
+			writer.Write(value.Length);
+			writer.Write(value.Span);
+		}
+
+		/// <summary>
+		///     Writes the given memory straight to the writer, in the same format as a byte[].
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, Memory<byte> value)
+		{
+			WriteValue(writer, (ReadOnlyMemory<byte>) value);
+		}
+
+		/// <summary>
+		///     Reads a value which has been written by <see cref="WriteValue(BinaryWriter, ReadOnlyMemory{byte})" />,
+		///     see <see cref="ReadByteSegment" /> for the lifetime of the returned memory.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static ReadOnlyMemory<byte> ReadReadOnlyByteMemory(BinaryReader reader)
+		{
+			return ReadByteSegment(reader);
+		}
+
+		/// <summary>
+		///     Reads a value which has been written by <see cref="WriteValue(BinaryWriter, Memory{byte})" />,
+		///     see <see cref="ReadByteSegment" /> for the lifetime of the returned memory.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static Memory<byte> ReadByteMemory(BinaryReader reader)
+		{
+			return ReadByteSegment(reader);
+		}
+#endif
+
+		/// <summary>
+		///     Writes the given value as a zigzag encoded LEB128 variable length integer.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteVarint(BinaryWriter writer, int value)
+		{
+			WriteVarint(writer, (uint) ((value << 1) ^ (value >> 31)));
+		}
+
+		/// <summary>
+		///     Writes the given value as a LEB128 variable length integer.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteVarint(BinaryWriter writer, uint value)
+		{
+			while (value >= 0x80)
+			{
+				writer.Write((byte) (value | 0x80));
+				value >>= 7;
+			}
+			writer.Write((byte) value);
+		}
+
+		/// <summary>
+		///     Writes the given value as a zigzag encoded LEB128 variable length integer.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteVarint(BinaryWriter writer, long value)
+		{
+			WriteVarint(writer, (ulong) ((value << 1) ^ (value >> 63)));
+		}
+
+		/// <summary>
+		///     Writes the given value as a LEB128 variable length integer.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteVarint(BinaryWriter writer, ulong value)
+		{
+			while (value >= 0x80)
+			{
+				writer.Write((byte) (value | 0x80));
+				value >>= 7;
+			}
+			writer.Write((byte) value);
+		}
+
+		/// <summary>
+		///     Writes the given value using this serializer's <see cref="IntegerEncoding" />.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		internal void WriteEncoded(BinaryWriter writer, int value)
+		{
+			if (_integerEncoding == IntegerEncoding.Varint)
+				WriteVarint(writer, value);
+			else
+				writer.Write(value);
+		}
+
+		/// <summary>
+		///     Writes the given value using this serializer's <see cref="IntegerEncoding" />.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		internal void WriteEncoded(BinaryWriter writer, uint value)
+		{
+			if (_integerEncoding == IntegerEncoding.Varint)
+				WriteVarint(writer, value);
+			else
+				writer.Write(value);
+		}
+
+		/// <summary>
+		///     Writes the given value using this serializer's <see cref="IntegerEncoding" />.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		internal void WriteEncoded(BinaryWriter writer, long value)
+		{
+			if (_integerEncoding == IntegerEncoding.Varint)
+				WriteVarint(writer, value);
+			else
+				writer.Write(value);
+		}
+
+		/// <summary>
+		///     Writes the given value using this serializer's <see cref="IntegerEncoding" />.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		internal void WriteEncoded(BinaryWriter writer, ulong value)
+		{
+			if (_integerEncoding == IntegerEncoding.Varint)
+				WriteVarint(writer, value);
+			else
+				writer.Write(value);
+		}
+
 		/// <summary>
 		/// 
 		/// </summary>
@@ -350,21 +721,14 @@ namespace SharpRemote
 		}
 
 		/// <summary>
-		/// 
+		///     Writes the given exception, see <see cref="BinaryExceptionSerializer" />.
 		/// </summary>
 		/// <param name="writer"></param>
 		/// <param name="exception"></param>
 		/// <exception cref="ArgumentNullException"></exception>
 		public static void WriteValue(BinaryWriter writer, Exception exception)
 		{
-			if (writer == null)
-				throw new ArgumentNullException(nameof(writer));
-			if (exception == null)
-				throw new ArgumentNullException(nameof(exception));
-
-			var formatter = new BinaryFormatter();
-			writer.Flush();
-			formatter.Serialize(writer.BaseStream, exception);
+			BinaryExceptionSerializer.Write(writer, exception);
 		}
 
 		#endregion
@@ -461,6 +825,120 @@ namespace SharpRemote
 			return reader.ReadUInt64();
 		}
 		
+		/// <summary>
+		///     Reads a zigzag encoded LEB128 variable length integer.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static int ReadVarintAsInt32(BinaryReader reader)
+		{
+			var value = ReadVarintAsUInt32(reader);
+			return (int) (value >> 1) ^ -(int) (value & 1);
+		}
+
+		/// <summary>
+		///     Reads a LEB128 variable length integer.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		/// <exception cref="SerializationException">When the value doesn't fit into 32 bits</exception>
+		public static uint ReadVarintAsUInt32(BinaryReader reader)
+		{
+			uint value = 0;
+			for (int shift = 0;; shift += 7)
+			{
+				var b = reader.ReadByte();
+				// The 5th byte may only contribute the 4 most significant bits and must be the last one
+				if (shift == 28 && b > 0x0F)
+					throw new SerializationException("Malformed variable length integer: It doesn't fit into 32 bits");
+
+				value |= (uint) (b & 0x7F) << shift;
+				if ((b & 0x80) == 0)
+					return value;
+			}
+		}
+
+		/// <summary>
+		///     Reads a zigzag encoded LEB128 variable length integer.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static long ReadVarintAsInt64(BinaryReader reader)
+		{
+			var value = ReadVarintAsUInt64(reader);
+			return (long) (value >> 1) ^ -(long) (value & 1);
+		}
+
+		/// <summary>
+		///     Reads a LEB128 variable length integer.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		/// <exception cref="SerializationException">When the value doesn't fit into 64 bits</exception>
+		public static ulong ReadVarintAsUInt64(BinaryReader reader)
+		{
+			ulong value = 0;
+			for (int shift = 0;; shift += 7)
+			{
+				var b = reader.ReadByte();
+				// The 10th byte may only contribute the most significant bit and must be the last one
+				if (shift == 63 && b > 0x01)
+					throw new SerializationException("Malformed variable length integer: It doesn't fit into 64 bits");
+
+				value |= (ulong) (b & 0x7F) << shift;
+				if ((b & 0x80) == 0)
+					return value;
+			}
+		}
+
+		/// <summary>
+		///     Reads a value which has been written using this serializer's <see cref="IntegerEncoding" />.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		internal int ReadEncodedInt32(BinaryReader reader)
+		{
+			return _integerEncoding == IntegerEncoding.Varint
+				? ReadVarintAsInt32(reader)
+				: reader.ReadInt32();
+		}
+
+		/// <summary>
+		///     Reads a value which has been written using this serializer's <see cref="IntegerEncoding" />.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		internal uint ReadEncodedUInt32(BinaryReader reader)
+		{
+			return _integerEncoding == IntegerEncoding.Varint
+				? ReadVarintAsUInt32(reader)
+				: reader.ReadUInt32();
+		}
+
+		/// <summary>
+		///     Reads a value which has been written using this serializer's <see cref="IntegerEncoding" />.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		internal long ReadEncodedInt64(BinaryReader reader)
+		{
+			return _integerEncoding == IntegerEncoding.Varint
+				? ReadVarintAsInt64(reader)
+				: reader.ReadInt64();
+		}
+
+		/// <summary>
+		///     Reads a value which has been written using this serializer's <see cref="IntegerEncoding" />.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		internal ulong ReadEncodedUInt64(BinaryReader reader)
+		{
+			return _integerEncoding == IntegerEncoding.Varint
+				? ReadVarintAsUInt64(reader)
+				: reader.ReadUInt64();
+		}
+
 		/// <summary>
 		/// 
 		/// </summary>
@@ -516,15 +994,56 @@ namespace SharpRemote
 		}
 
 		/// <summary>
-		/// 
+		///     Reads a string which has been written by <see cref="WriteInternedString" />:
+		///     Every occurrence of the same string within a message is deserialized into the same instance.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static string ReadValueAsInternedString(BinaryReader reader)
+		{
+			var messageReader = reader as BinaryMessageReader;
+			var id = messageReader?.ReadStringId() ?? reader.ReadByte();
+			switch (id)
+			{
+				case 0:
+					return null;
+
+				case 1:
+					var value = reader.ReadString();
+					messageReader?.AddString(value);
+					return value;
+
+				default:
+					if (messageReader == null)
+						throw new SerializationException(
+							string.Format("The message refers to string #{0}, but string ids can only be resolved by a {1}",
+							              id,
+							              typeof(BinaryMessageReader).Name));
+
+					return messageReader.GetStringById(id);
+			}
+		}
+
+		/// <summary>
+		///     Reads a value which has been written using this serializer's <see cref="StringEncoding" />.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		internal string ReadEncodedString(BinaryReader reader)
+		{
+			return _stringEncoding == StringEncoding.Table
+				? ReadValueAsInternedString(reader)
+				: ReadValueAsString(reader);
+		}
+
+		/// <summary>
+		///     Reads an exception, see <see cref="BinaryExceptionSerializer" />.
 		/// </summary>
 		/// <param name="reader"></param>
 		/// <returns></returns>
 		public static Exception ReadValueAsException(BinaryReader reader)
 		{
-			var formatter = new BinaryFormatter();
-			var exception = formatter.Deserialize(reader.BaseStream);
-			return (Exception)exception;
+			return BinaryExceptionSerializer.Read(reader);
 		}
 
 		/// <summary>
@@ -544,6 +1063,28 @@ namespace SharpRemote
 			return methods.ReadObjectDelegate(reader, this, null);
 		}
 
+		/// <summary>
+		///     Reads a value which has previously been written by either <see cref="WriteValue{T}" /> or
+		///     <see cref="WriteObject" /> without boxing it.
+		/// </summary>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="reader"></param>
+		/// <param name="endPoint"></param>
+		/// <returns></returns>
+		public T ReadValue<T>(BinaryReader reader, IRemotingEndPoint endPoint) where T : struct
+		{
+			if (!ReadValueAsBoolean(reader))
+				throw new SerializationException(string.Format("Expected a value of type '{0}' but found null", typeof(T)));
+
+			var type = ReadTypeInformation(reader);
+			var methods = _methodStorage.GetOrAdd(type);
+			var readValue = methods.ReadValueDelegate as Func<BinaryReader, BinarySerializer2, IRemotingEndPoint, T>;
+			if (readValue == null)
+				return (T) methods.ReadObjectDelegate(reader, this, endPoint);
+
+			return readValue(reader, this, endPoint);
+		}
+
 		#endregion
 
 		private static ModuleBuilder CreateModule()
@@ -562,15 +1103,141 @@ namespace SharpRemote
 			return module;
 		}
 
-		private static void WriteTypeInformation(BinaryWriter writer, Type type)
+		/// <summary>
+		///     Writes either the id of the given type (if it has already been written as part of the current message)
+		///     or 0, followed by the type's name.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="type"></param>
+		internal static void WriteTypeInformation(BinaryWriter writer, Type type)
 		{
-			WriteValue(writer, type.AssemblyQualifiedName);
+			var messageWriter = writer as BinaryMessageWriter;
+			if (messageWriter == null)
+			{
+				writer.Write((byte) 0);
+				writer.Write(type.AssemblyQualifiedName);
+				return;
+			}
+
+			int id;
+			if (messageWriter.TryGetTypeId(type, out id))
+			{
+				messageWriter.WriteTypeId(id);
+			}
+			else
+			{
+				messageWriter.WriteTypeId(0);
+				messageWriter.Write(type.AssemblyQualifiedName);
+				messageWriter.AddType(type);
+			}
+		}
+
+		/// <summary>
+		///     Writes either the id of the given object (if it has already been written as part of the current message)
+		///     or 0, in which case the caller is expected to write the object in full.
+		/// </summary>
+		/// <remarks>
+		///     Only used for types which opted into reference preservation via
+		///     <see cref="System.Runtime.Serialization.DataContractAttribute.IsReference" />.
+		/// </remarks>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		/// <returns>True when the object has already been written and only its id was written now</returns>
+		public static bool WriteObjectReference(BinaryWriter writer, object value)
+		{
+			var messageWriter = writer as BinaryMessageWriter;
+			if (messageWriter == null)
+			{
+				writer.Write((byte) 0);
+				return false;
+			}
+
+			int id;
+			if (messageWriter.TryGetObjectId(value, out id))
+			{
+				messageWriter.WriteObjectId(id);
+				return true;
+			}
+
+			messageWriter.WriteObjectId(0);
+			messageWriter.AddObject(value);
+			return false;
+		}
+
+		/// <summary>
+		///     Reads an object reference which has been written by <see cref="WriteObjectReference" />.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns>The previously read object or null, if the object follows in full</returns>
+		public static object ReadObjectReference(BinaryReader reader)
+		{
+			var messageReader = reader as BinaryMessageReader;
+			var id = messageReader?.ReadObjectId() ?? reader.ReadByte();
+			if (id == 0)
+				return null;
+
+			if (messageReader == null)
+				throw new SerializationException(
+					string.Format("The message refers to object #{0}, but object ids can only be resolved by a {1}",
+					              id,
+					              typeof(BinaryMessageReader).Name));
+
+			return messageReader.GetObjectById(id);
+		}
+
+		/// <summary>
+		///     Remembers the given object, which is about to be read in full, so that subsequent
+		///     references to it (see <see cref="ReadObjectReference" />) can be resolved.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <param name="value"></param>
+		public static void AddObjectReference(BinaryReader reader, object value)
+		{
+			var messageReader = reader as BinaryMessageReader;
+			messageReader?.AddObject(value);
 		}
 
 		private Type ReadTypeInformation(BinaryReader reader)
 		{
-			var typeName = ReadValueAsString(reader);
-			var type = _typeResolver?.GetType(typeName) ?? Type.GetType(typeName);
+			return ReadTypeInformation(reader, _resolveType);
+		}
+
+		/// <summary>
+		///     Reads type information which has been written by <see cref="WriteTypeInformation" />.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <param name="resolveType">Resolves a type by its name, may return null</param>
+		/// <returns></returns>
+		internal static Type ReadTypeInformation(BinaryReader reader, Func<string, Type> resolveType)
+		{
+			var messageReader = reader as BinaryMessageReader;
+			var id = messageReader?.ReadTypeId() ?? reader.ReadByte();
+			if (id != 0)
+			{
+				if (messageReader == null)
+					throw new SerializationException(
+						string.Format("The message refers to type #{0}, but type ids can only be resolved by a {1}",
+						              id,
+						              typeof(BinaryMessageReader).Name));
+
+				return messageReader.GetTypeById(id);
+			}
+
+			var typeName = reader.ReadString();
+			var type = resolveType(typeName);
+			messageReader?.AddType(type);
+			return type;
+		}
+
+		private Type ResolveType(string typeName)
+		{
+			Type type;
+			if (_typesByName.TryGetValue(typeName, out type))
+				return type;
+
+			type = _typeResolver?.GetType(typeName) ?? Type.GetType(typeName);
+			if (type != null)
+				_typesByName.TryAdd(typeName, type);
 			return type;
 		}
 	}
@@ -24,8 +24,20 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 		private static readonly MethodInfo BinarySerializer2WriteSingle;
 		private static readonly MethodInfo BinarySerializer2WriteDouble;
 		private static readonly MethodInfo BinarySerializer2WriteString;
+		private static readonly MethodInfo BinarySerializer2WriteInternedString;
 		private static readonly MethodInfo BinarySerializer2WriteDateTime;
 		private static readonly MethodInfo BinarySerializer2WriteException;
+		private static readonly MethodInfo BinarySerializer2WriteVarintInt32;
+		private static readonly MethodInfo BinarySerializer2WriteVarintUInt32;
+		private static readonly MethodInfo BinarySerializer2WriteVarintInt64;
+		private static readonly MethodInfo BinarySerializer2WriteVarintUInt64;
+		private static readonly MethodInfo BinarySerializer2WriteObjectReference;
+
+		private readonly MethodInfo _writeInt32;
+		private readonly MethodInfo _writeUInt32;
+		private readonly MethodInfo _writeInt64;
+		private readonly MethodInfo _writeUInt64;
+		private readonly MethodInfo _writeString;
 
 		static BinaryWriteValueMethodCompiler()
 		{
@@ -42,14 +54,27 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 			BinarySerializer2WriteSingle = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.WriteValue), new []{typeof(BinaryWriter), typeof(Single)});
 			BinarySerializer2WriteDouble = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.WriteValue), new []{typeof(BinaryWriter), typeof(Double)});
 			BinarySerializer2WriteString = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.WriteValue), new []{typeof(BinaryWriter), typeof(string)});
+			BinarySerializer2WriteInternedString = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.WriteInternedString));
 			BinarySerializer2WriteDateTime = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.WriteValue), new []{typeof(BinaryWriter), typeof(DateTime)});
 			BinarySerializer2WriteException = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.WriteValue), new []{typeof(BinaryWriter), typeof(Exception)});
+			BinarySerializer2WriteVarintInt32 = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.WriteVarint), new []{typeof(BinaryWriter), typeof(Int32)});
+			BinarySerializer2WriteVarintUInt32 = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.WriteVarint), new []{typeof(BinaryWriter), typeof(UInt32)});
+			BinarySerializer2WriteVarintInt64 = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.WriteVarint), new []{typeof(BinaryWriter), typeof(Int64)});
+			BinarySerializer2WriteVarintUInt64 = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.WriteVarint), new []{typeof(BinaryWriter), typeof(UInt64)});
+			BinarySerializer2WriteObjectReference = typeof(BinarySerializer2).GetMethod(nameof(BinarySerializer2.WriteObjectReference));
 		}
 
 		public BinaryWriteValueMethodCompiler(CompilationContext context)
 			: base(context)
 		{
-			
+			var varint = context.IntegerEncoding == IntegerEncoding.Varint;
+			_writeInt32 = varint ? BinarySerializer2WriteVarintInt32 : BinarySerializer2WriteInt32;
+			_writeUInt32 = varint ? BinarySerializer2WriteVarintUInt32 : BinarySerializer2WriteUInt32;
+			_writeInt64 = varint ? BinarySerializer2WriteVarintInt64 : BinarySerializer2WriteInt64;
+			_writeUInt64 = varint ? BinarySerializer2WriteVarintUInt64 : BinarySerializer2WriteUInt64;
+			_writeString = context.StringEncoding == StringEncoding.Table
+				? BinarySerializer2WriteInternedString
+				: BinarySerializer2WriteString;
 		}
 
 		protected override void EmitWriteHint(ILGenerator generator, ByReferenceHint hint)
@@ -59,15 +84,42 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 			generator.Emit(OpCodes.Callvirt, Methods.WriteByte);
 		}
 
-		protected override void EmitDynamicDispatchWriteObject(ILGenerator gen)
+		protected override void EmitDynamicDispatchWriteObject(ILGenerator gen, Action loadMember)
 		{
 			gen.Emit(OpCodes.Ldarg_2);
 			gen.Emit(OpCodes.Ldarg_0);
-			gen.Emit(OpCodes.Ldarg_1);
+			loadMember();
 			gen.Emit(OpCodes.Ldarg_3);
 			gen.Emit(OpCodes.Call, BinarySerializer2WriteObject);
 		}
 
+		protected override void EmitWriteObjectReference(ILGenerator gen, Label alreadyWritten)
+		{
+			// if (BinarySerializer2.WriteObjectReference(writer, value)) return;
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Ldarg_1);
+			gen.Emit(OpCodes.Call, BinarySerializer2WriteObjectReference);
+			gen.Emit(OpCodes.Brtrue, alreadyWritten);
+		}
+
+		protected override bool SupportsDeltaEncoding => true;
+
+		protected override void EmitWriteDeltaHeader(ILGenerator gen, LocalBuilder header)
+		{
+			// BinarySerializer2.WriteVarint(writer, header);
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Ldloc, header);
+			gen.Emit(OpCodes.Call, BinarySerializer2WriteVarintUInt32);
+		}
+
+		protected override void EmitWriteDeltaBitmap(ILGenerator gen, LocalBuilder bitmap)
+		{
+			// BinarySerializer2.WriteVarint(writer, bitmap);
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Ldloc, bitmap);
+			gen.Emit(OpCodes.Call, BinarySerializer2WriteVarintUInt64);
+		}
+
 		protected override void EmitBeginWriteField(ILGenerator gen, IFieldDescription field)
 		{
 			
@@ -107,19 +159,19 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 			}
 			else if (storageType == typeof(int))
 			{
-				gen.Emit(OpCodes.Call, BinarySerializer2WriteInt32);
+				gen.Emit(OpCodes.Call, _writeInt32);
 			}
 			else if (storageType == typeof(uint))
 			{
-				gen.Emit(OpCodes.Call, BinarySerializer2WriteUInt32);
+				gen.Emit(OpCodes.Call, _writeUInt32);
 			}
 			else if (storageType == typeof(long))
 			{
-				gen.Emit(OpCodes.Call, BinarySerializer2WriteInt64);
+				gen.Emit(OpCodes.Call, _writeInt64);
 			}
 			else if (storageType == typeof(ulong))
 			{
-				gen.Emit(OpCodes.Call, BinarySerializer2WriteUInt64);
+				gen.Emit(OpCodes.Call, _writeUInt64);
 			}
 			else
 			{
@@ -164,28 +216,28 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 		{
 			gen.Emit(OpCodes.Ldarg_0);
 			loadMember();
-			gen.Emit(OpCodes.Call, BinarySerializer2WriteUInt32);
+			gen.Emit(OpCodes.Call, _writeUInt32);
 		}
 
 		protected override void EmitWriteInt32(ILGenerator gen, Action loadMember, Action loadMemberAddress)
 		{
 			gen.Emit(OpCodes.Ldarg_0);
 			loadMember();
-			gen.Emit(OpCodes.Call, BinarySerializer2WriteInt32);
+			gen.Emit(OpCodes.Call, _writeInt32);
 		}
 
 		protected override void EmitWriteUInt64(ILGenerator gen, Action loadMember, Action loadMemberAddress)
 		{
 			gen.Emit(OpCodes.Ldarg_0);
 			loadMember();
-			gen.Emit(OpCodes.Call, BinarySerializer2WriteUInt64);
+			gen.Emit(OpCodes.Call, _writeUInt64);
 		}
 
 		protected override void EmitWriteInt64(ILGenerator gen, Action loadMember, Action loadMemberAddress)
 		{
 			gen.Emit(OpCodes.Ldarg_0);
 			loadMember();
-			gen.Emit(OpCodes.Call, BinarySerializer2WriteInt64);
+			gen.Emit(OpCodes.Call, _writeInt64);
 		}
 
 		protected override void EmitWriteDecimal(ILGenerator gen, Action loadMember, Action loadMemberAddress)
@@ -213,7 +265,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Binary
 		{
 			gen.Emit(OpCodes.Ldarg_0);
 			loadMember();
-			gen.Emit(OpCodes.Call, BinarySerializer2WriteString);
+			gen.Emit(OpCodes.Call, _writeString);
 		}
 
 		protected override void EmitWriteDateTime(ILGenerator gen, Action loadMember, Action loadMemberAddress)
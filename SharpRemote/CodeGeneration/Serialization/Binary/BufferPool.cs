@@ -0,0 +1,119 @@
+using System;
+using System.Collections.Concurrent;
+using System.Threading;
+
+namespace SharpRemote.CodeGeneration.Serialization.Binary
+{
+	/// <summary>
+	///     A process-wide pool of byte arrays which is used by <see cref="BufferedBinaryMessageWriter" />
+	///     and <see cref="BufferedBinaryMessageReader" /> so that serializing a message doesn't allocate
+	///     a new buffer every time.
+	/// </summary>
+	/// <remarks>
+	///     Buffers are pooled in buckets of power-of-two sizes, from <see cref="MinimumSize" />
+	///     to <see cref="MaximumSize" />. Larger buffers are allocated on demand and
+	///     never pooled, so a single huge message doesn't keep its memory alive forever.
+	/// </remarks>
+	internal static class BufferPool
+	{
+		public const int MinimumSize = 256;
+		public const int MaximumSize = 4 * 1024 * 1024;
+
+		/// <summary>
+		///     The maximum number of buffers kept per bucket.
+		/// </summary>
+		private const int MaximumBuffersPerBucket = 32;
+
+		private static readonly Bucket[] Buckets;
+
+		static BufferPool()
+		{
+			var numBuckets = GetBucketIndex(MaximumSize) + 1;
+			Buckets = new Bucket[numBuckets];
+			for (int i = 0; i < numBuckets; ++i)
+				Buckets[i] = new Bucket(MinimumSize << i);
+		}
+
+		/// <summary>
+		///     Returns a buffer which is at least as big as the given size.
+		/// </summary>
+		/// <param name="minimumSize"></param>
+		/// <returns></returns>
+		public static byte[] Rent(int minimumSize)
+		{
+			if (minimumSize > MaximumSize)
+				return new byte[minimumSize];
+
+			return Buckets[GetBucketIndex(minimumSize)].Rent();
+		}
+
+		/// <summary>
+		///     Returns the given buffer to the pool. The buffer may not be used by the caller anymore.
+		/// </summary>
+		/// <param name="buffer"></param>
+		public static void Return(byte[] buffer)
+		{
+			if (buffer == null)
+				throw new ArgumentNullException(nameof(buffer));
+
+			var length = buffer.Length;
+			if (length < MinimumSize || length > MaximumSize)
+				return;
+
+			var index = GetBucketIndex(length);
+			var bucket = Buckets[index];
+			if (bucket.Size != length)
+				return;
+
+			bucket.Return(buffer);
+		}
+
+		private static int GetBucketIndex(int size)
+		{
+			int index = 0;
+			int bucketSize = MinimumSize;
+			while (bucketSize < size)
+			{
+				bucketSize <<= 1;
+				++index;
+			}
+			return index;
+		}
+
+		private sealed class Bucket
+		{
+			public readonly int Size;
+			private readonly ConcurrentBag<byte[]> _buffers;
+			private int _count;
+
+			public Bucket(int size)
+			{
+				Size = size;
+				_buffers = new ConcurrentBag<byte[]>();
+			}
+
+			public byte[] Rent()
+			{
+				byte[] buffer;
+				if (_buffers.TryTake(out buffer))
+				{
+					Interlocked.Decrement(ref _count);
+					return buffer;
+				}
+
+				return new byte[Size];
+			}
+
+			public void Return(byte[] buffer)
+			{
+				if (Interlocked.Increment(ref _count) > MaximumBuffersPerBucket)
+				{
+					Interlocked.Decrement(ref _count);
+					return;
+				}
+
+				_buffers.Add(buffer);
+			}
+		}
+	}
+}
@@ -0,0 +1,300 @@
+using System;
+using System.IO;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace SharpRemote.CodeGeneration.Serialization.Binary
+{
+	/// <summary>
+	///     The counterpart to <see cref="BufferedBinaryMessageWriter" />: Copies the entire message into
+	///     a pooled buffer once and then parses every value directly from that buffer instead of
+	///     reading it from the underlying stream.
+	/// </summary>
+	internal sealed class BufferedBinaryMessageReader
+		: BinaryMessageReader
+	{
+		private readonly MemoryStream _stream;
+		private readonly int _length;
+		private byte[] _buffer;
+		private int _position;
+
+		/// <summary>
+		///     True when <see cref="BaseStream" /> has been handed out and <see cref="_position" />
+		///     must be re-synchronized with it before the next value is read.
+		/// </summary>
+		private bool _streamInUse;
+
+		public BufferedBinaryMessageReader(Stream stream)
+			: this(ReadMessage(stream))
+		{}
+
+		private BufferedBinaryMessageReader(MemoryStream message)
+			: base(message)
+		{
+			_stream = message;
+			_buffer = message.GetBuffer();
+			_length = (int) message.Length;
+		}
+
+		public override Stream BaseStream
+		{
+			get
+			{
+				HandOverToStream();
+				return _stream;
+			}
+		}
+
+		public override bool EndOfMessage
+		{
+			get
+			{
+				SyncPosition();
+				return _position >= _length;
+			}
+		}
+
+		public override bool ReadBoolean()
+		{
+			return _buffer[Advance(1)] != 0;
+		}
+
+		public override byte ReadByte()
+		{
+			return _buffer[Advance(1)];
+		}
+
+		public override sbyte ReadSByte()
+		{
+			return (sbyte) _buffer[Advance(1)];
+		}
+
+		public override short ReadInt16()
+		{
+			return (short) ReadUInt16();
+		}
+
+		public override ushort ReadUInt16()
+		{
+			var position = Advance(2);
+			var buffer = _buffer;
+			return (ushort) (buffer[position] | buffer[position + 1] << 8);
+		}
+
+		public override int ReadInt32()
+		{
+			var position = Advance(4);
+			var buffer = _buffer;
+			return buffer[position] |
+			       buffer[position + 1] << 8 |
+			       buffer[position + 2] << 16 |
+			       buffer[position + 3] << 24;
+		}
+
+		public override uint ReadUInt32()
+		{
+			return (uint) ReadInt32();
+		}
+
+		public override long ReadInt64()
+		{
+			var position = Advance(8);
+			var buffer = _buffer;
+			var lo = (uint) (buffer[position] |
+			                 buffer[position + 1] << 8 |
+			                 buffer[position + 2] << 16 |
+			                 buffer[position + 3] << 24);
+			var hi = (uint) (buffer[position + 4] |
+			                 buffer[position + 5] << 8 |
+			                 buffer[position + 6] << 16 |
+			                 buffer[position + 7] << 24);
+			return (long) ((ulong) hi << 32 | lo);
+		}
+
+		public override ulong ReadUInt64()
+		{
+			return (ulong) ReadInt64();
+		}
+
+		public override float ReadSingle()
+		{
+			return new SingleBits {UInt32 = ReadUInt32()}.Single;
+		}
+
+		public override double ReadDouble()
+		{
+			return BitConverter.Int64BitsToDouble(ReadInt64());
+		}
+
+		public override decimal ReadDecimal()
+		{
+			var bits = new[] {ReadInt32(), ReadInt32(), ReadInt32(), ReadInt32()};
+			try
+			{
+				return new decimal(bits);
+			}
+			catch (ArgumentException e)
+			{
+				throw new IOException("The stream contains an invalid decimal", e);
+			}
+		}
+
+		public override string ReadString()
+		{
+			var byteCount = Read7BitEncodedInt();
+			if (byteCount < 0)
+				throw new IOException(string.Format("Invalid string length: {0}", byteCount));
+
+			var position = Advance(byteCount);
+			return Encoding.UTF8.GetString(_buffer, position, byteCount);
+		}
+
+		public override byte[] ReadBytes(int count)
+		{
+			if (count < 0)
+				throw new ArgumentOutOfRangeException(nameof(count));
+
+			SyncPosition();
+			count = Math.Min(count, _length - _position);
+			var bytes = new byte[count];
+			Buffer.BlockCopy(_buffer, Advance(count), bytes, 0, count);
+			return bytes;
+		}
+
+		/// <summary>
+		///     Returns a slice of the pooled buffer this reader has copied the message into.
+		///     The slice is only valid until this reader is disposed of, after which the buffer
+		///     is handed to the next message: Callers which need the bytes for longer must copy them.
+		/// </summary>
+		/// <param name="count"></param>
+		/// <returns></returns>
+		public override ArraySegment<byte> ReadByteSegment(int count)
+		{
+			if (count < 0)
+				throw new ArgumentOutOfRangeException(nameof(count));
+
+			var buffer = _buffer;
+			return new ArraySegment<byte>(buffer, Advance(count), count);
+		}
+
+		public override int Read(byte[] buffer, int index, int count)
+		{
+			if (buffer == null)
+				throw new ArgumentNullException(nameof(buffer));
+
+			SyncPosition();
+			count = Math.Min(count, _length - _position);
+			Buffer.BlockCopy(_buffer, Advance(count), buffer, index, count);
+			return count;
+		}
+
+		public override int PeekChar()
+		{
+			HandOverToStream();
+			return base.PeekChar();
+		}
+
+		public override int Read()
+		{
+			HandOverToStream();
+			return base.Read();
+		}
+
+		public override int Read(char[] buffer, int index, int count)
+		{
+			HandOverToStream();
+			return base.Read(buffer, index, count);
+		}
+
+		public override char ReadChar()
+		{
+			HandOverToStream();
+			return base.ReadChar();
+		}
+
+		public override char[] ReadChars(int count)
+		{
+			HandOverToStream();
+			return base.ReadChars(count);
+		}
+
+		protected override void Dispose(bool disposing)
+		{
+			if (disposing && _buffer != null)
+			{
+				BufferPool.Return(_buffer);
+				_buffer = null;
+			}
+
+			base.Dispose(disposing);
+		}
+
+		/// <summary>
+		///     Advances the current position by the given amount of bytes.
+		/// </summary>
+		/// <param name="count"></param>
+		/// <returns>The position before advancing</returns>
+		/// <exception cref="EndOfStreamException">When the message doesn't contain the given amount of bytes anymore</exception>
+		private int Advance(int count)
+		{
+			SyncPosition();
+
+			var position = _position;
+			if (_length - position < count)
+				throw new EndOfStreamException();
+
+			_position = position + count;
+			return position;
+		}
+
+		/// <summary>
+		///     Positions the underlying stream at the current position so that it can be used
+		///     by methods which read from it directly.
+		/// </summary>
+		private void HandOverToStream()
+		{
+			SyncPosition();
+			_stream.Position = _position;
+			_streamInUse = true;
+		}
+
+		private void SyncPosition()
+		{
+			if (_streamInUse)
+			{
+				_position = (int) _stream.Position;
+				_streamInUse = false;
+			}
+		}
+
+		private static MemoryStream ReadMessage(Stream stream)
+		{
+			if (stream == null)
+				throw new ArgumentNullException(nameof(stream));
+
+			var length = stream.Length - stream.Position;
+			if (length > int.MaxValue)
+				throw new IOException("The message is too large to be buffered");
+
+			var buffer = BufferPool.Rent((int) length);
+			int offset = 0;
+			while (offset < length)
+			{
+				var read = stream.Read(buffer, offset, (int) length - offset);
+				if (read == 0)
+					throw new EndOfStreamException();
+
+				offset += read;
+			}
+
+			return new MemoryStream(buffer, 0, (int) length, false, true);
+		}
+
+		[StructLayout(LayoutKind.Explicit)]
+		private struct SingleBits
+		{
+			[FieldOffset(0)] public float Single;
+			[FieldOffset(0)] public uint UInt32;
+		}
+	}
+}
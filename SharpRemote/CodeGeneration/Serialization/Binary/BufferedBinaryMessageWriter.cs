@@ -0,0 +1,237 @@
+using System;
+using System.IO;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace SharpRemote.CodeGeneration.Serialization.Binary
+{
+	/// <summary>
+	///     A <see cref="BinaryMessageWriter" /> which writes the entire message into a pooled, growable
+	///     buffer instead of forwarding every single value to the underlying stream:
+	///     Primitive values are encoded directly into the buffer and the stream is only written to
+	///     once the message is flushed or disposed of.
+	/// </summary>
+	/// <remarks>
+	///     The encoding of every value is identical to the one of <see cref="BinaryWriter" />, hence
+	///     messages written by this writer can be read by <see cref="BinaryMessageReader" /> and vice versa.
+	/// </remarks>
+	internal sealed class BufferedBinaryMessageWriter
+		: BinaryMessageWriter
+	{
+		private byte[] _buffer;
+		private int _position;
+
+		public BufferedBinaryMessageWriter(Stream stream)
+			: base(stream)
+		{
+			_buffer = BufferPool.Rent(BufferPool.MinimumSize);
+		}
+
+		public override void Write(bool value)
+		{
+			Write(value ? (byte) 1 : (byte) 0);
+		}
+
+		public override void Write(byte value)
+		{
+			if (_position == _buffer.Length)
+				Grow(1);
+
+			_buffer[_position++] = value;
+		}
+
+		public override void Write(sbyte value)
+		{
+			Write((byte) value);
+		}
+
+		public override void Write(short value)
+		{
+			Write((ushort) value);
+		}
+
+		public override void Write(ushort value)
+		{
+			EnsureCapacity(2);
+			var buffer = _buffer;
+			var position = _position;
+			buffer[position] = (byte) value;
+			buffer[position + 1] = (byte) (value >> 8);
+			_position = position + 2;
+		}
+
+		public override void Write(int value)
+		{
+			Write((uint) value);
+		}
+
+		public override void Write(uint value)
+		{
+			EnsureCapacity(4);
+			var buffer = _buffer;
+			var position = _position;
+			buffer[position] = (byte) value;
+			buffer[position + 1] = (byte) (value >> 8);
+			buffer[position + 2] = (byte) (value >> 16);
+			buffer[position + 3] = (byte) (value >> 24);
+			_position = position + 4;
+		}
+
+		public override void Write(long value)
+		{
+			Write((ulong) value);
+		}
+
+		public override void Write(ulong value)
+		{
+			EnsureCapacity(8);
+			var buffer = _buffer;
+			var position = _position;
+			buffer[position] = (byte) value;
+			buffer[position + 1] = (byte) (value >> 8);
+			buffer[position + 2] = (byte) (value >> 16);
+			buffer[position + 3] = (byte) (value >> 24);
+			buffer[position + 4] = (byte) (value >> 32);
+			buffer[position + 5] = (byte) (value >> 40);
+			buffer[position + 6] = (byte) (value >> 48);
+			buffer[position + 7] = (byte) (value >> 56);
+			_position = position + 8;
+		}
+
+		public override void Write(float value)
+		{
+			Write(new SingleBits {Single = value}.UInt32);
+		}
+
+		public override void Write(double value)
+		{
+			Write((ulong) BitConverter.DoubleToInt64Bits(value));
+		}
+
+		public override void Write(decimal value)
+		{
+			var bits = decimal.GetBits(value);
+			Write(bits[0]);
+			Write(bits[1]);
+			Write(bits[2]);
+			Write(bits[3]);
+		}
+
+		public override void Write(char value)
+		{
+			EnsureCapacity(4);
+			_position += Encoding.UTF8.GetBytes(new[] {value}, 0, 1, _buffer, _position);
+		}
+
+		public override void Write(char[] chars)
+		{
+			if (chars == null)
+				throw new ArgumentNullException(nameof(chars));
+
+			Write(chars, 0, chars.Length);
+		}
+
+		public override void Write(char[] chars, int index, int count)
+		{
+			EnsureCapacity(Encoding.UTF8.GetMaxByteCount(count));
+			_position += Encoding.UTF8.GetBytes(chars, index, count, _buffer, _position);
+		}
+
+		public override void Write(string value)
+		{
+			if (value == null)
+				throw new ArgumentNullException(nameof(value));
+
+			var byteCount = Encoding.UTF8.GetByteCount(value);
+			Write7BitEncodedInt(byteCount);
+			EnsureCapacity(byteCount);
+			Encoding.UTF8.GetBytes(value, 0, value.Length, _buffer, _position);
+			_position += byteCount;
+		}
+
+		public override void Write(byte[] buffer)
+		{
+			if (buffer == null)
+				throw new ArgumentNullException(nameof(buffer));
+
+			Write(buffer, 0, buffer.Length);
+		}
+
+		public override void Write(byte[] buffer, int index, int count)
+		{
+			if (buffer == null)
+				throw new ArgumentNullException(nameof(buffer));
+
+			EnsureCapacity(count);
+			Buffer.BlockCopy(buffer, index, _buffer, _position, count);
+			_position += count;
+		}
+
+#if DOTNETCORE
+		public override void Write(ReadOnlySpan<byte> buffer)
+		{
+			// BinaryWriter's implementation would first copy the span into a temporary array
+			EnsureCapacity(buffer.Length);
+			buffer.CopyTo(new Span<byte>(_buffer, _position, buffer.Length));
+			_position += buffer.Length;
+		}
+#endif
+
+		public override long Seek(int offset, SeekOrigin origin)
+		{
+			Flush();
+			return base.Seek(offset, origin);
+		}
+
+		/// <summary>
+		///     Writes all buffered bytes to the underlying stream.
+		/// </summary>
+		public override void Flush()
+		{
+			if (_position > 0)
+			{
+				OutStream.Write(_buffer, 0, _position);
+				_position = 0;
+			}
+
+			OutStream.Flush();
+		}
+
+		protected override void Dispose(bool disposing)
+		{
+			if (disposing && _buffer != null)
+			{
+				Flush();
+				BufferPool.Return(_buffer);
+				_buffer = null;
+			}
+
+			base.Dispose(disposing);
+		}
+
+		private void EnsureCapacity(int count)
+		{
+			if (_buffer.Length - _position < count)
+				Grow(count);
+		}
+
+		private void Grow(int count)
+		{
+			var required = (long) _position + count;
+			if (required > int.MaxValue)
+				throw new IOException("The message is too large to be buffered");
+
+			var newBuffer = BufferPool.Rent((int) Math.Max(required, Math.Min(2L * _buffer.Length, int.MaxValue)));
+			Buffer.BlockCopy(_buffer, 0, newBuffer, 0, _position);
+			BufferPool.Return(_buffer);
+			_buffer = newBuffer;
+		}
+
+		[StructLayout(LayoutKind.Explicit)]
+		private struct SingleBits
+		{
+			[FieldOffset(0)] public float Single;
+			[FieldOffset(0)] public uint UInt32;
+		}
+	}
+}
@@ -0,0 +1,138 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Reflection.Emit;
+using SharpRemote.CodeGeneration.Serialization.Binary;
+
+// ReSharper disable once CheckNamespace
+namespace SharpRemote
+{
+	/// <summary>
+	///     An alternative to <see cref="BinarySerializer2" /> which produces the exact same messages,
+	///     but encodes them differently: Every message is written into a pooled, growable buffer
+	///     which is copied to the stream in one go once the writer is disposed of and every message
+	///     is copied into a pooled buffer in one go before it is parsed.
+	///     This avoids one (virtual) stream call per value and should be preferred when messages are
+	///     written to / read from streams which aren't <see cref="MemoryStream" />s.
+	/// </summary>
+	/// <remarks>
+	///     Since the entire message is buffered, the stream passed to <see cref="CreateMethodReader" />
+	///     must support <see cref="Stream.Length" /> and should only contain the message itself.
+	/// </remarks>
+	public sealed class BufferedBinarySerializer2
+		: ISerializer2
+	{
+		private readonly BinarySerializer2 _serializer;
+
+		/// <summary>
+		/// </summary>
+		public BufferedBinarySerializer2(ITypeResolver typeResolver = null)
+			: this(new BinarySerializer2(typeResolver))
+		{
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="moduleBuilder"></param>
+		/// <param name="typeResolver"></param>
+		public BufferedBinarySerializer2(ModuleBuilder moduleBuilder, ITypeResolver typeResolver = null)
+			: this(new BinarySerializer2(moduleBuilder, typeResolver))
+		{
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="moduleBuilder"></param>
+		/// <param name="typeResolver"></param>
+		/// <param name="integerEncoding">The encoding of integers, as negotiated during the handshake</param>
+		/// <exception cref="ArgumentException">When <paramref name="integerEncoding" /> isn't exactly one encoding</exception>
+		public BufferedBinarySerializer2(ModuleBuilder moduleBuilder, ITypeResolver typeResolver, IntegerEncoding integerEncoding)
+			: this(new BinarySerializer2(moduleBuilder, typeResolver, integerEncoding))
+		{
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="moduleBuilder"></param>
+		/// <param name="typeResolver"></param>
+		/// <param name="integerEncoding">The encoding of integers, as negotiated during the handshake</param>
+		/// <param name="stringEncoding">The encoding of strings, as negotiated during the handshake</param>
+		/// <exception cref="ArgumentException">When <paramref name="integerEncoding" /> or <paramref name="stringEncoding" /> isn't exactly one encoding</exception>
+		public BufferedBinarySerializer2(ModuleBuilder moduleBuilder,
+		                                 ITypeResolver typeResolver,
+		                                 IntegerEncoding integerEncoding,
+		                                 StringEncoding stringEncoding)
+			: this(new BinarySerializer2(moduleBuilder, typeResolver, integerEncoding, stringEncoding))
+		{
+		}
+
+		private BufferedBinarySerializer2(BinarySerializer2 serializer)
+		{
+			_serializer = serializer;
+		}
+
+		/// <summary>
+		///     The encoding of integers used by this serializer.
+		/// </summary>
+		public IntegerEncoding IntegerEncoding => _serializer.IntegerEncoding;
+
+		/// <summary>
+		///     The encoding of strings used by this serializer.
+		/// </summary>
+		public StringEncoding StringEncoding => _serializer.StringEncoding;
+
+		/// <inheritdoc />
+		public void RegisterType<T>()
+		{
+			_serializer.RegisterType<T>();
+		}
+
+		/// <inheritdoc />
+		public void RegisterType(Type type)
+		{
+			_serializer.RegisterType(type);
+		}
+
+		/// <inheritdoc />
+		public IReadOnlyList<PreparedType> RegisterTypes(IEnumerable<Type> types)
+		{
+			return _serializer.RegisterTypes(types);
+		}
+
+		/// <inheritdoc />
+		public bool IsTypeRegistered<T>()
+		{
+			return _serializer.IsTypeRegistered<T>();
+		}
+
+		/// <inheritdoc />
+		public bool IsTypeRegistered(Type type)
+		{
+			return _serializer.IsTypeRegistered(type);
+		}
+
+		/// <inheritdoc />
+		public IMethodCallWriter CreateMethodCallWriter(Stream stream, ulong rpcId, ulong grainId, string methodName, IRemotingEndPoint endPoint = null)
+		{
+			return new BinaryMethodCallWriter(_serializer, new BufferedBinaryMessageWriter(stream), grainId, methodName, rpcId, endPoint);
+		}
+
+		/// <inheritdoc />
+		public IMethodResultWriter CreateMethodResultWriter(Stream stream, ulong rpcId, IRemotingEndPoint endPoint = null)
+		{
+			return new BinaryMethodResultWriter(_serializer, new BufferedBinaryMessageWriter(stream), rpcId, endPoint);
+		}
+
+		/// <inheritdoc />
+		public void CreateMethodReader(Stream stream,
+		                               out IMethodCallReader callReader,
+		                               out IMethodResultReader resultReader,
+		                               IRemotingEndPoint endPoint = null)
+		{
+			_serializer.CreateMethodReader(new BufferedBinaryMessageReader(stream), out callReader, out resultReader);
+		}
+	}
+}
@@ -24,6 +24,31 @@ namespace SharpRemote
 			gen.Emit(OpCodes.Callvirt, getCount);
 			gen.Emit(OpCodes.Call, Methods.WriteInt32);
 
+			var elementType = typeInformation.ElementType;
+			if (IsColumnar(elementType))
+			{
+				var count = gen.DeclareLocal(typeof(int));
+				var values = gen.DeclareLocal(elementType.MakeArrayType());
+
+				// values = BinarySerializer.CopyToColumn(value)
+				loadValue();
+				gen.Emit(OpCodes.Callvirt, getCount);
+				gen.Emit(OpCodes.Stloc, count);
+				loadValue();
+				gen.Emit(OpCodes.Call, Methods.BinarySerializerCopyToColumn.MakeGenericMethod(elementType));
+				gen.Emit(OpCodes.Stloc, values);
+
+				EmitWriteColumns(gen,
+					elementType,
+					loadWriter,
+					() => gen.Emit(OpCodes.Ldloc, values),
+					count,
+					loadSerializer,
+					loadRemotingEndPoint);
+				EmitReturnColumn(gen, elementType, values, count);
+				return;
+			}
+
 			EmitWriteEnumeration(gen,
 				typeInformation,
 				loadWriter,
@@ -55,6 +80,18 @@ namespace SharpRemote
 			gen.Emit(OpCodes.Call, Methods.ReadInt32);
 			gen.Emit(OpCodes.Stloc, count);
 
+			var values = gen.DeclareLocal(elementType.MakeArrayType());
+			var columnar = IsColumnar(elementType);
+			if (columnar)
+			{
+				// values = BinarySerializer.GetEmptyColumn<T>(count)
+				gen.Emit(OpCodes.Ldloc, count);
+				gen.Emit(OpCodes.Call, Methods.BinarySerializerGetEmptyColumn.MakeGenericMethod(elementType));
+				gen.Emit(OpCodes.Stloc, values);
+
+				EmitReadColumns(gen, elementType, loadReader, values, count, loadSerializer, loadRemotingEndPoint);
+			}
+
 			gen.Emit(OpCodes.Ldc_I4_0);
 			gen.Emit(OpCodes.Stloc, i);
 
@@ -67,11 +104,20 @@ namespace SharpRemote
 			gen.Emit(OpCodes.Brtrue, end);
 
 			gen.Emit(OpCodes.Ldloc, result);
-			EmitReadValue(gen,
-				loadReader,
-				loadSerializer,
-				loadRemotingEndPoint,
-				elementType);
+			if (columnar)
+			{
+				gen.Emit(OpCodes.Ldloc, values);
+				gen.Emit(OpCodes.Ldloc, i);
+				gen.Emit(OpCodes.Ldelem, elementType);
+			}
+			else
+			{
+				EmitReadValue(gen,
+					loadReader,
+					loadSerializer,
+					loadRemotingEndPoint,
+					elementType);
+			}
 			gen.Emit(OpCodes.Callvirt, add);
 
 			// ++i
@@ -84,6 +130,8 @@ namespace SharpRemote
 
 			// end:
 			gen.MarkLabel(end);
+			if (columnar)
+				EmitReturnColumn(gen, elementType, values, count);
 			gen.Emit(OpCodes.Ldloc, result);
 		}
 	}
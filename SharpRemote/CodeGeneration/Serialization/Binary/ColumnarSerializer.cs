@@ -0,0 +1,575 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Reflection.Emit;
+using System.Runtime.Serialization;
+using SharpRemote.CodeGeneration;
+
+// ReSharper disable CheckNamespace
+namespace SharpRemote
+// ReSharper restore CheckNamespace
+{
+	public partial class BinarySerializer
+	{
+		/// <summary>
+		///     The maximum length of a column buffer which is kept by a thread after it has been returned:
+		///     Larger buffers are dropped so that a single huge column doesn't keep its memory alive for as long
+		///     as the thread lives.
+		/// </summary>
+		private const int MaximumRetainedColumnLength = 64 * 1024;
+
+		/// <summary>
+		///     Returns a buffer which is large enough to hold the given number of values of one column.
+		///     The buffer is owned by the calling thread and reused by the next column of the same type.
+		///     It must be handed back to <see cref="ReturnColumn{T}" /> once the column has been written / read.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="count"></param>
+		/// <returns></returns>
+		public static T[] GetColumn<T>(int count)
+		{
+			return ColumnBuffer<T>.Get(count);
+		}
+
+		/// <summary>
+		///     Is called once the given buffer, obtained from <see cref="GetColumn{T}" /> or one of its siblings,
+		///     isn't used anymore: Clears the values it holds (if they may refer to other objects) and drops it
+		///     if it has grown beyond <see cref="MaximumRetainedColumnLength" />.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="column"></param>
+		/// <param name="count">The number of values which have been stored in the buffer</param>
+		public static void ReturnColumn<T>(T[] column, int count)
+		{
+			ColumnBuffer<T>.Return(column, count);
+		}
+
+		/// <summary>
+		///     Returns a buffer owned by the calling thread whose first <paramref name="count" /> elements
+		///     are set to their default value, see <see cref="GetColumn{T}" />.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="count"></param>
+		/// <returns></returns>
+		public static T[] GetEmptyColumn<T>(int count)
+		{
+			var column = ColumnBuffer<T>.Get(count);
+			Array.Clear(column, 0, count);
+			return column;
+		}
+
+		/// <summary>
+		///     Copies the given values into a buffer owned by the calling thread, see <see cref="GetColumn{T}" />.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="values"></param>
+		/// <returns></returns>
+		public static T[] CopyToColumn<T>(ICollection<T> values)
+		{
+			var column = ColumnBuffer<T>.Get(values.Count);
+			values.CopyTo(column, 0);
+			return column;
+		}
+
+		/// <summary>
+		///     Reads the given number of values of a column which has been written by
+		///     <see cref="WriteBlittableArray(BinaryWriter, Array, int, int)" />.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="reader"></param>
+		/// <param name="count"></param>
+		/// <param name="elementSize"></param>
+		/// <returns>A buffer owned by the calling thread, see <see cref="GetColumn{T}" /></returns>
+		public static T[] ReadColumn<T>(BinaryReader reader, int count, int elementSize)
+		{
+			var column = ColumnBuffer<T>.Get(count);
+			ReadBlittableArray(reader, column, elementSize, count);
+			return column;
+		}
+
+		/// <summary>
+		///     Writes a bitmap of which of the first <paramref name="count" /> values have a value,
+		///     followed by those values as one raw block of memory.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="writer"></param>
+		/// <param name="column"></param>
+		/// <param name="count"></param>
+		/// <param name="elementSize"></param>
+		public static void WriteNullableColumn<T>(BinaryWriter writer, T?[] column, int count, int elementSize) where T : struct
+		{
+			var bitmap = ColumnBitmap.Get((count + 7) / 8);
+			var values = ColumnBuffer<T>.Get(count);
+			var valueCount = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				if (i % 8 == 0)
+					bitmap[i / 8] = 0;
+
+				var value = column[i];
+				if (value.HasValue)
+				{
+					bitmap[i / 8] |= (byte) (1 << (i % 8));
+					values[valueCount++] = value.GetValueOrDefault();
+				}
+			}
+
+			writer.Write(bitmap, 0, (count + 7) / 8);
+			WriteBlittableArray(writer, values, elementSize, valueCount);
+
+			ColumnBuffer<T>.Return(values, valueCount);
+			ColumnBitmap.Return(bitmap);
+		}
+
+		/// <summary>
+		///     Reads the given number of values of a column which has been written by <see cref="WriteNullableColumn{T}" />.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="reader"></param>
+		/// <param name="count"></param>
+		/// <param name="elementSize"></param>
+		/// <returns>A buffer owned by the calling thread, see <see cref="GetColumn{T}" /></returns>
+		public static T?[] ReadNullableColumn<T>(BinaryReader reader, int count, int elementSize) where T : struct
+		{
+			var bitmap = ColumnBitmap.Get((count + 7) / 8);
+			ReadBlittableArray(reader, bitmap, 1, (count + 7) / 8);
+			var valueCount = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				if ((bitmap[i / 8] & (1 << (i % 8))) != 0)
+					++valueCount;
+			}
+
+			var values = ReadColumn<T>(reader, valueCount, elementSize);
+			var column = ColumnBuffer<T?>.Get(count);
+			var valueIndex = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				if ((bitmap[i / 8] & (1 << (i % 8))) != 0)
+					column[i] = values[valueIndex++];
+				else
+					column[i] = null;
+			}
+
+			ColumnBuffer<T>.Return(values, valueCount);
+			ColumnBitmap.Return(bitmap);
+			return column;
+		}
+
+		/// <summary>
+		///     Tests if arrays and lists of the given type are serialized column by column.
+		/// </summary>
+		/// <param name="type"></param>
+		/// <returns></returns>
+		/// <exception cref="ArgumentException">When the type is marked with the <see cref="ColumnarAttribute" />, but doesn't qualify</exception>
+		private static bool IsColumnar(Type type)
+		{
+			if (!type.IsValueType || type.GetCustomAttribute<ColumnarAttribute>(false) == null)
+				return false;
+
+			if (type.GetCustomAttribute<DataContractAttribute>() == null)
+				throw new ArgumentException(string.Format("The [Columnar] type '{0}' must be marked with the [DataContract] attribute", type));
+			if (type.GetMethods(BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance | BindingFlags.Static).Any(HasSerializationCallback))
+				throw new ArgumentException(string.Format("The [Columnar] type '{0}' may not have any serialization callbacks", type));
+
+			var member = GetColumns(type).FirstOrDefault(x => !IsFlat(GetColumnType(x)));
+			if (member != null)
+				throw new ArgumentException(string.Format("The data member '{0}' of the [Columnar] type '{1}' must be of a primitive type, an enum, a string, a DateTime, a TimeSpan, a decimal, a Guid or a nullable thereof",
+				                                          member.Name,
+				                                          type));
+
+			return true;
+		}
+
+		private static bool IsFlat(Type type)
+		{
+			type = Nullable.GetUnderlyingType(type) ?? type;
+			return type.IsPrimitive ||
+			       type.IsEnum ||
+			       type == typeof(string) ||
+			       type == typeof(DateTime) ||
+			       type == typeof(TimeSpan) ||
+			       type == typeof(decimal) ||
+			       type == typeof(Guid);
+		}
+
+		/// <summary>
+		///     Tests if a column of values of the given type can be written as one raw block of memory
+		///     and if so, which type the elements of that block are of.
+		/// </summary>
+		/// <param name="memberType"></param>
+		/// <param name="columnType"></param>
+		/// <param name="elementSize"></param>
+		/// <returns></returns>
+		private static bool IsBlittableColumn(Type memberType, out Type columnType, out int elementSize)
+		{
+			if (memberType == typeof(bool))
+			{
+				// bool[] can't be pinned, but bools are written as a single byte of value 0 or 1 anyway
+				columnType = typeof(byte);
+				elementSize = 1;
+				return BitConverter.IsLittleEndian;
+			}
+
+			// Enums are always written as Int32, no matter their underlying type
+			columnType = memberType.IsEnum ? typeof(int) : memberType;
+			return IsBlittablePrimitive(columnType, out elementSize);
+		}
+
+		private static bool Is64BitEnum(Type type)
+		{
+			if (!type.IsEnum)
+				return false;
+
+			var underlyingType = Enum.GetUnderlyingType(type);
+			return underlyingType == typeof(long) || underlyingType == typeof(ulong);
+		}
+
+		private static bool IsBlittablePrimitive(Type type, out int size)
+		{
+			if (type == typeof(byte) || type == typeof(sbyte))
+				size = 1;
+			else if (type == typeof(short) || type == typeof(ushort))
+				size = 2;
+			else if (type == typeof(int) || type == typeof(uint) || type == typeof(float))
+				size = 4;
+			else if (type == typeof(long) || type == typeof(ulong) || type == typeof(double))
+				size = 8;
+			else
+				size = 0;
+
+			return size > 0 && BitConverter.IsLittleEndian;
+		}
+
+		private static IEnumerable<MemberInfo> GetColumns(Type type)
+		{
+			return type.GetFields(BindingFlags.Public | BindingFlags.Instance)
+			           .Where(x => x.GetCustomAttribute<DataMemberAttribute>() != null)
+			           .Cast<MemberInfo>()
+			           .Concat(type.GetProperties(BindingFlags.Public | BindingFlags.Instance)
+			                       .Where(x => x.GetCustomAttribute<DataMemberAttribute>() != null));
+		}
+
+		private static Type GetColumnType(MemberInfo member)
+		{
+			var field = member as FieldInfo;
+			return field != null ? field.FieldType : ((PropertyInfo) member).PropertyType;
+		}
+
+		private static void EmitLoadColumnValue(ILGenerator gen, MemberInfo member)
+		{
+			var field = member as FieldInfo;
+			if (field != null)
+				gen.Emit(OpCodes.Ldfld, field);
+			else
+				gen.Emit(OpCodes.Call, ((PropertyInfo) member).GetMethod);
+		}
+
+		private static void EmitStoreColumnValue(ILGenerator gen, MemberInfo member)
+		{
+			var field = member as FieldInfo;
+			if (field != null)
+				gen.Emit(OpCodes.Stfld, field);
+			else
+				gen.Emit(OpCodes.Call, ((PropertyInfo) member).SetMethod);
+		}
+
+		/// <summary>
+		///     Emits a loop which executes the code emitted by <paramref name="emitBody" /> once for every
+		///     index in [0, count).
+		/// </summary>
+		private static void EmitForEachIndex(ILGenerator gen, LocalBuilder count, Action<LocalBuilder> emitBody)
+		{
+			var i = gen.DeclareLocal(typeof(int));
+			var loop = gen.DefineLabel();
+			var end = gen.DefineLabel();
+
+			// i = 0
+			gen.Emit(OpCodes.Ldc_I4_0);
+			gen.Emit(OpCodes.Stloc, i);
+
+			// loop: if (i >= count) goto end
+			gen.MarkLabel(loop);
+			gen.Emit(OpCodes.Ldloc, i);
+			gen.Emit(OpCodes.Ldloc, count);
+			gen.Emit(OpCodes.Bge, end);
+
+			emitBody(i);
+
+			// ++i
+			gen.Emit(OpCodes.Ldloc, i);
+			gen.Emit(OpCodes.Ldc_I4_1);
+			gen.Emit(OpCodes.Add);
+			gen.Emit(OpCodes.Stloc, i);
+			gen.Emit(OpCodes.Br, loop);
+
+			gen.MarkLabel(end);
+		}
+
+		/// <summary>
+		///     Emits code which writes the first <paramref name="count" /> elements of an array of a
+		///     <see cref="ColumnarAttribute" /> type, one data member after the other.
+		/// </summary>
+		private void EmitWriteColumns(ILGenerator gen,
+			Type elementType,
+			Action loadWriter,
+			Action loadValues,
+			LocalBuilder count,
+			Action loadSerializer,
+			Action loadRemotingEndPoint)
+		{
+			foreach (var member in GetColumns(elementType))
+			{
+				var memberType = GetColumnType(member);
+				Action<LocalBuilder> loadElementAddress = i =>
+				{
+					loadValues();
+					gen.Emit(OpCodes.Ldloc, i);
+					gen.Emit(OpCodes.Ldelema, elementType);
+				};
+
+				Type columnType;
+				int elementSize;
+				var nullableType = Nullable.GetUnderlyingType(memberType);
+				if (IsBlittableColumn(memberType, out columnType, out elementSize) ||
+				    nullableType != null && IsBlittablePrimitive(nullableType, out elementSize))
+				{
+					if (nullableType != null)
+						columnType = memberType;
+
+					// column = BinarySerializer.GetColumn<T>(count)
+					var column = gen.DeclareLocal(columnType.MakeArrayType());
+					gen.Emit(OpCodes.Ldloc, count);
+					gen.Emit(OpCodes.Call, Methods.BinarySerializerGetColumn.MakeGenericMethod(columnType));
+					gen.Emit(OpCodes.Stloc, column);
+
+					// column[i] = values[i].<Member>
+					EmitForEachIndex(gen, count, i =>
+					{
+						gen.Emit(OpCodes.Ldloc, column);
+						gen.Emit(OpCodes.Ldloc, i);
+						loadElementAddress(i);
+						EmitLoadColumnValue(gen, member);
+						if (Is64BitEnum(memberType))
+							gen.Emit(OpCodes.Conv_I4);
+						gen.Emit(OpCodes.Stelem, columnType);
+					});
+
+					loadWriter();
+					gen.Emit(OpCodes.Ldloc, column);
+					if (nullableType != null)
+					{
+						// BinarySerializer.WriteNullableColumn<T>(writer, column, count, elementSize)
+						gen.Emit(OpCodes.Ldloc, count);
+						gen.Emit(OpCodes.Ldc_I4, elementSize);
+						gen.Emit(OpCodes.Call, Methods.BinarySerializerWriteNullableColumn.MakeGenericMethod(nullableType));
+					}
+					else
+					{
+						// BinarySerializer.WriteBlittableArray(writer, column, elementSize, count)
+						gen.Emit(OpCodes.Ldc_I4, elementSize);
+						gen.Emit(OpCodes.Ldloc, count);
+						gen.Emit(OpCodes.Call, Methods.BinarySerializerWriteBlittableArrayCount);
+					}
+
+					EmitReturnColumn(gen, columnType, column, count);
+				}
+				else
+				{
+					// Any other column is written value by value
+					EmitForEachIndex(gen, count, i =>
+					{
+						Action loadValue = () =>
+						{
+							loadElementAddress(i);
+							EmitLoadColumnValue(gen, member);
+						};
+						Action loadValueAddress = () =>
+						{
+							var tmp = gen.DeclareLocal(memberType);
+							loadValue();
+							gen.Emit(OpCodes.Stloc, tmp);
+							gen.Emit(OpCodes.Ldloca, tmp);
+						};
+
+						EmitWriteValue(gen,
+							loadWriter,
+							loadValue,
+							memberType.IsValueType ? loadValueAddress : null,
+							loadSerializer,
+							loadRemotingEndPoint,
+							memberType);
+					});
+				}
+			}
+		}
+
+		/// <summary>
+		///     Emits code which reads the first <paramref name="count" /> elements of an array of a
+		///     <see cref="ColumnarAttribute" /> type, the counterpart of <see cref="EmitWriteColumns" />.
+		/// </summary>
+		private void EmitReadColumns(ILGenerator gen,
+			Type elementType,
+			Action loadReader,
+			LocalBuilder values,
+			LocalBuilder count,
+			Action loadSerializer,
+			Action loadRemotingEndPoint)
+		{
+			foreach (var member in GetColumns(elementType))
+			{
+				var memberType = GetColumnType(member);
+				Action<LocalBuilder> loadElementAddress = i =>
+				{
+					gen.Emit(OpCodes.Ldloc, values);
+					gen.Emit(OpCodes.Ldloc, i);
+					gen.Emit(OpCodes.Ldelema, elementType);
+				};
+
+				Type columnType;
+				int elementSize;
+				var nullableType = Nullable.GetUnderlyingType(memberType);
+				if (IsBlittableColumn(memberType, out columnType, out elementSize) ||
+				    nullableType != null && IsBlittablePrimitive(nullableType, out elementSize))
+				{
+					var column = gen.DeclareLocal(nullableType != null ? memberType.MakeArrayType() : columnType.MakeArrayType());
+					loadReader();
+					gen.Emit(OpCodes.Ldloc, count);
+					gen.Emit(OpCodes.Ldc_I4, elementSize);
+					if (nullableType != null)
+					{
+						// column = BinarySerializer.ReadNullableColumn<T>(reader, count, elementSize)
+						columnType = memberType;
+						gen.Emit(OpCodes.Call, Methods.BinarySerializerReadNullableColumn.MakeGenericMethod(nullableType));
+					}
+					else
+					{
+						// column = BinarySerializer.ReadColumn<T>(reader, count, elementSize)
+						gen.Emit(OpCodes.Call, Methods.BinarySerializerReadColumn.MakeGenericMethod(columnType));
+					}
+					gen.Emit(OpCodes.Stloc, column);
+
+					// values[i].<Member> = column[i]
+					EmitForEachIndex(gen, count, i =>
+					{
+						loadElementAddress(i);
+						gen.Emit(OpCodes.Ldloc, column);
+						gen.Emit(OpCodes.Ldloc, i);
+						gen.Emit(OpCodes.Ldelem, columnType);
+						if (Is64BitEnum(memberType))
+							gen.Emit(OpCodes.Conv_I8);
+						EmitStoreColumnValue(gen, member);
+					});
+
+					EmitReturnColumn(gen, columnType, column, count);
+				}
+				else
+				{
+					// values[i].<Member> = <ReadValue>
+					EmitForEachIndex(gen, count, i =>
+					{
+						loadElementAddress(i);
+						EmitReadValue(gen,
+							loadReader,
+							loadSerializer,
+							loadRemotingEndPoint,
+							memberType);
+						EmitStoreColumnValue(gen, member);
+					});
+				}
+			}
+		}
+
+		/// <summary>
+		///     Emits a call to <see cref="ReturnColumn{T}" /> for the given buffer.
+		/// </summary>
+		private static void EmitReturnColumn(ILGenerator gen, Type columnType, LocalBuilder column, LocalBuilder count)
+		{
+			// BinarySerializer.ReturnColumn<T>(column, count)
+			gen.Emit(OpCodes.Ldloc, column);
+			gen.Emit(OpCodes.Ldloc, count);
+			gen.Emit(OpCodes.Call, Methods.BinarySerializerReturnColumn.MakeGenericMethod(columnType));
+		}
+
+		private static class ColumnBuffer<T>
+		{
+			/// <summary>
+			///     Buffers of [Columnar] types may hold strings which must not be kept alive by the buffer.
+			/// </summary>
+			private static readonly bool ClearOnReturn = !typeof(T).IsPrimitive &&
+			                                             !typeof(T).IsEnum &&
+			                                             Nullable.GetUnderlyingType(typeof(T)) == null;
+
+			[ThreadStatic]
+			private static T[] _buffer;
+
+			public static T[] Get(int count)
+			{
+				var buffer = _buffer;
+				if (buffer == null || buffer.Length < count)
+					_buffer = buffer = new T[Math.Max(count, buffer?.Length * 2 ?? 0)];
+				return buffer;
+			}
+
+			public static void Return(T[] buffer, int count)
+			{
+				if (buffer.Length > MaximumRetainedColumnLength)
+				{
+					if (ReferenceEquals(buffer, _buffer))
+						_buffer = null;
+				}
+				else if (ClearOnReturn)
+				{
+					Array.Clear(buffer, 0, count);
+				}
+			}
+		}
+
+		/// <summary>
+		///     Kept apart from <see cref="ColumnBuffer{T}" /> because a nullable column of bytes needs both
+		///     a bitmap and a buffer of values at the same time.
+		/// </summary>
+		private static class ColumnBitmap
+		{
+			[ThreadStatic]
+			private static byte[] _buffer;
+
+			public static byte[] Get(int count)
+			{
+				var buffer = _buffer;
+				if (buffer == null || buffer.Length < count)
+					_buffer = buffer = new byte[Math.Max(count, buffer?.Length * 2 ?? 0)];
+				return buffer;
+			}
+
+			public static void Return(byte[] buffer)
+			{
+				if (buffer.Length > MaximumRetainedColumnLength && ReferenceEquals(buffer, _buffer))
+					_buffer = null;
+			}
+		}
+	}
+}
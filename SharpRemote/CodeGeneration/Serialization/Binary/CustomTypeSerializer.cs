@@ -512,11 +512,67 @@ namespace SharpRemote
 				if (ctor == null)
 					throw new ArgumentException(string.Format("Type '{0}' is missing a parameterless constructor", typeInformation.Type));
 
-				gen.Emit(OpCodes.Newobj, ctor);
+				if (typeInformation.Type.GetCustomAttribute<PooledAttribute>(false) != null)
+				{
+					// tmp = InstancePool.Rent<T>()
+					gen.Emit(OpCodes.Call, Methods.InstancePoolRent.MakeGenericMethod(typeInformation.Type));
+				}
+				else
+				{
+					gen.Emit(OpCodes.Newobj, ctor);
+				}
 				gen.Emit(OpCodes.Stloc, tmp);
 			}
 		}
 
+		/// <summary>
+		///     Tests if the byte[] members of the given type shall be read into the arrays
+		///     the (rented) instance already references.
+		/// </summary>
+		/// <param name="type"></param>
+		/// <param name="memberType"></param>
+		/// <returns></returns>
+		private static bool ReusesArray(TypeInformation type, Type memberType)
+		{
+			if (memberType != typeof(byte[]))
+				return false;
+
+			var pooled = type.Type.GetCustomAttribute<PooledAttribute>(false);
+			return pooled != null && pooled.ReuseArrays;
+		}
+
+		/// <summary>
+		///     Reads a byte array which has been written by the generated code, re-using the given
+		///     array if it has the same length as the serialized one.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="reader"></param>
+		/// <param name="existing"></param>
+		/// <returns></returns>
+		/// <exception cref="EndOfStreamException">When the stream ends before the array has been read completely</exception>
+		public static byte[] ReadBytes(BinaryReader reader, byte[] existing)
+		{
+			if (!reader.ReadBoolean())
+				return null;
+
+			var length = reader.ReadInt32();
+			if (existing == null || existing.Length != length)
+				return reader.ReadBytes(length);
+
+			int offset = 0;
+			while (offset < length)
+			{
+				var read = reader.Read(existing, offset, length - offset);
+				if (read == 0)
+					throw new EndOfStreamException();
+
+				offset += read;
+			}
+			return existing;
+		}
+
 		private void EmitReadAllProperties(ILGenerator gen,
 			Action loadReader,
 			Action loadSerializer,
@@ -535,11 +591,22 @@ namespace SharpRemote
 
 				try
 				{
-					EmitReadValue(gen,
-					              loadReader,
-					              loadSerializer,
-					              loadRemotingEndPoint,
-					              propertyType);
+					if (ReusesArray(type, propertyType) && property.GetMethod != null)
+					{
+						// BinarySerializer.ReadBytes(reader, tmp.<Property>)
+						loadReader();
+						gen.Emit(OpCodes.Ldloc, target);
+						gen.Emit(OpCodes.Callvirt, property.GetMethod);
+						gen.Emit(OpCodes.Call, Methods.BinarySerializerReadBytes);
+					}
+					else
+					{
+						EmitReadValue(gen,
+						              loadReader,
+						              loadSerializer,
+						              loadRemotingEndPoint,
+						              propertyType);
+					}
 				}
 				catch (SerializationException)
 				{
@@ -578,11 +645,22 @@ namespace SharpRemote
 
 				try
 				{
-					EmitReadValue(gen,
-					              loadReader,
-					              loadSerializer,
-					              loadRemotingEndPoint,
-					              fieldType);
+					if (ReusesArray(type, fieldType))
+					{
+						// BinarySerializer.ReadBytes(reader, tmp.<Field>)
+						loadReader();
+						gen.Emit(OpCodes.Ldloc, target);
+						gen.Emit(OpCodes.Ldfld, field);
+						gen.Emit(OpCodes.Call, Methods.BinarySerializerReadBytes);
+					}
+					else
+					{
+						EmitReadValue(gen,
+						              loadReader,
+						              loadSerializer,
+						              loadRemotingEndPoint,
+						              fieldType);
+					}
 				}
 				catch (SerializationException)
 				{
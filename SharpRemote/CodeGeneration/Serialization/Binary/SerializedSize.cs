@@ -0,0 +1,308 @@
+﻿using System;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Reflection.Emit;
+using System.Runtime.Serialization;
+using System.Text;
+using SharpRemote.CodeGeneration;
+
+// ReSharper disable CheckNamespace
+namespace SharpRemote
+// ReSharper restore CheckNamespace
+{
+	public partial class BinarySerializer
+	{
+		private static readonly Encoding Utf8 = new UTF8Encoding(false);
+
+		/// <inheritdoc />
+		public bool EmitGetSerializedSize(ILGenerator gen, Action loadValue, Type valueType)
+		{
+			int size;
+			if (TryGetFixedSize(valueType, out size))
+			{
+				// The size is known at compile time, no need to even look at the value
+				gen.Emit(OpCodes.Ldc_I8, (long) size);
+				return true;
+			}
+
+			if (valueType == typeof(string))
+			{
+				// BinarySerializer.GetSerializedSize(value)
+				loadValue();
+				gen.Emit(OpCodes.Call, Methods.BinarySerializerGetStringSize);
+				return true;
+			}
+
+			if (valueType == typeof(string[]))
+			{
+				// BinarySerializer.GetSerializedSize(values)
+				loadValue();
+				gen.Emit(OpCodes.Call, Methods.BinarySerializerGetStringArraySize);
+				return true;
+			}
+
+			if (valueType.IsArray && valueType.GetArrayRank() == 1 && TryGetFixedSize(valueType.GetElementType(), out size))
+			{
+				// BinarySerializer.GetSerializedSize(values, elementSize)
+				loadValue();
+				gen.Emit(OpCodes.Ldc_I4, size);
+				gen.Emit(OpCodes.Call, Methods.BinarySerializerGetArraySize);
+				return true;
+			}
+
+			if (IsByteSegment(valueType))
+			{
+				// BinarySerializer.GetSerializedSize(segment)
+				loadValue();
+				gen.Emit(OpCodes.Call, typeof(BinarySerializer).GetMethod(nameof(GetSerializedSize), new[] {valueType}));
+				return true;
+			}
+
+			return false;
+		}
+
+		private static bool IsByteSegment(Type type)
+		{
+			if (type == typeof(ArraySegment<byte>))
+				return true;
+#if DOTNETCORE
+			if (type == typeof(ReadOnlyMemory<byte>) || type == typeof(Memory<byte>))
+				return true;
+#endif
+			return false;
+		}
+
+		/// <summary>
+		///     Tests if every value of the given type occupies the same amount of bytes in the stream,
+		///     and if so, how many.
+		/// </summary>
+		/// <param name="type"></param>
+		/// <param name="size"></param>
+		/// <returns></returns>
+		private bool TryGetFixedSize(Type type, out int size)
+		{
+			if (type == typeof(bool) || type == typeof(byte) || type == typeof(sbyte))
+				size = 1;
+			else if (type == typeof(short) || type == typeof(ushort))
+				size = 2;
+			else if (type == typeof(int) || type == typeof(uint) || type == typeof(float) || type.IsEnum)
+				size = 4;
+			else if (type == typeof(long) || type == typeof(ulong) || type == typeof(double) || type == typeof(TimeSpan))
+				size = 8;
+			else if (type == typeof(DateTime))
+				size = 9;
+			else if (type == typeof(decimal) || type == typeof(Guid))
+				size = 16;
+			else if (!IsFixedSizeDataContract(type, out size))
+				return false;
+
+			return true;
+		}
+
+		/// <summary>
+		///     Tests if the given type is a [DataContract] struct which only consists of
+		///     fixed-size members. Unlike <see cref="IsBlittable" />, the struct's layout in
+		///     memory is irrelevant here.
+		/// </summary>
+		/// <param name="type"></param>
+		/// <param name="size"></param>
+		/// <returns></returns>
+		private bool IsFixedSizeDataContract(Type type, out int size)
+		{
+			size = 0;
+			if (!type.IsValueType || type.IsPrimitive || type.IsEnum)
+				return false;
+			if (type.GetCustomAttribute<DataContractAttribute>() == null)
+				return false;
+			if (_customSerializers.Any(x => x.Supports(type)))
+				return false;
+			MethodInfo unused;
+			if (IsSingleton(type, out unused))
+				return false;
+
+			var memberTypes = type.GetFields(BindingFlags.Public | BindingFlags.Instance)
+			                      .Where(x => x.GetCustomAttribute<DataMemberAttribute>() != null)
+			                      .Select(x => x.FieldType)
+			                      .Concat(type.GetProperties(BindingFlags.Public | BindingFlags.Instance)
+			                                  .Where(x => x.GetCustomAttribute<DataMemberAttribute>() != null)
+			                                  .Select(x => x.PropertyType));
+			foreach (var memberType in memberTypes)
+			{
+				int memberSize;
+				if (!TryGetFixedSize(memberType, out memberSize))
+					return false;
+
+				size += memberSize;
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		///     Returns the number of bytes the generated code writes for the given string.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="value"></param>
+		/// <returns></returns>
+		public static long GetSerializedSize(string value)
+		{
+			// Strings are preceded by a null flag and their 7-bit encoded byte count
+			if (value == null)
+				return 1;
+
+			var byteCount = Utf8.GetByteCount(value);
+			return 1 + Get7BitEncodedSize(byteCount) + byteCount;
+		}
+
+		/// <summary>
+		///     Returns the number of bytes the generated code writes for the given array of strings.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="values"></param>
+		/// <returns></returns>
+		public static long GetSerializedSize(string[] values)
+		{
+			if (values == null)
+				return 1;
+
+			long size = 1 + 4;
+			foreach (var value in values)
+			{
+				size += GetSerializedSize(value);
+			}
+			return size;
+		}
+
+		/// <summary>
+		///     Returns the number of bytes the generated code writes for the given array of
+		///     fixed-size values.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="values"></param>
+		/// <param name="elementSize"></param>
+		/// <returns></returns>
+		public static long GetSerializedSize(Array values, int elementSize)
+		{
+			// Arrays are preceded by a null flag and their length
+			if (values == null)
+				return 1;
+
+			return 1 + 4 + (long) values.Length * elementSize;
+		}
+
+		/// <summary>
+		///     Returns the number of bytes the generated code writes for the given slice.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="value"></param>
+		/// <returns></returns>
+		public static long GetSerializedSize(ArraySegment<byte> value)
+		{
+			if (value.Array == null)
+				return 1;
+
+			return 1 + 4 + value.Count;
+		}
+
+#if DOTNETCORE
+		/// <summary>
+		///     Returns the number of bytes the generated code writes for the given memory.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="value"></param>
+		/// <returns></returns>
+		public static long GetSerializedSize(ReadOnlyMemory<byte> value)
+		{
+			return 1 + 4 + value.Length;
+		}
+
+		/// <summary>
+		///     Returns the number of bytes the generated code writes for the given memory.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="value"></param>
+		/// <returns></returns>
+		public static long GetSerializedSize(Memory<byte> value)
+		{
+			return 1 + 4 + value.Length;
+		}
+#endif
+
+		/// <summary>
+		///     Creates a new stream which is able to hold the given amount of bytes
+		///     without having to grow.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="capacity"></param>
+		/// <returns></returns>
+		public static MemoryStream CreateStream(long capacity)
+		{
+			if (capacity <= 0 || capacity > int.MaxValue)
+				return new MemoryStream();
+
+			return new MemoryStream((int) capacity);
+		}
+
+		/// <summary>
+		///     Ensures that the stream of the given writer is able to hold the given amount of
+		///     additional bytes without having to grow (and thus copy its contents) several times.
+		///     Does nothing when the writer doesn't write to a <see cref="MemoryStream" />.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="writer"></param>
+		/// <param name="count"></param>
+		public static void Reserve(BinaryWriter writer, long count)
+		{
+			var stream = writer.BaseStream as MemoryStream;
+			if (stream == null)
+				return;
+
+			var capacity = stream.Capacity;
+			var requiredCapacity = stream.Position + count;
+			if (requiredCapacity <= capacity || requiredCapacity > int.MaxValue)
+				return;
+
+			// Small reservations still grow the stream geometrically (like writing to it would),
+			// large ones allocate the final buffer right away instead of doubling their way up to it.
+			var newCapacity = Math.Min(int.MaxValue, Math.Max(requiredCapacity, 2L * capacity));
+			try
+			{
+				stream.Capacity = (int) newCapacity;
+			}
+			catch (NotSupportedException)
+			{
+				// The stream was created over a fixed buffer and cannot grow: Writing
+				// to it is going to tell the caller as much.
+			}
+		}
+
+		private static int Get7BitEncodedSize(int value)
+		{
+			var size = 1;
+			var remainder = (uint) value;
+			while (remainder >= 0x80)
+			{
+				remainder >>= 7;
+				++size;
+			}
+			return size;
+		}
+	}
+}
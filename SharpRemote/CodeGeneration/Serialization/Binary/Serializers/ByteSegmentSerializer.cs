@@ -0,0 +1,69 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Reflection;
+using System.Reflection.Emit;
+
+namespace SharpRemote.CodeGeneration.Serialization.Binary.Serializers
+{
+	/// <summary>
+	///     Serializes slices of byte arrays (and, on .NET Core, byte memory) without copying them
+	///     into a temporary byte[] first: The wire format is identical to the one of a byte[].
+	/// </summary>
+	internal sealed class ByteSegmentSerializer
+		: AbstractTypeSerializer
+	{
+		private readonly Dictionary<Type, MethodInfo> _writeMethods;
+		private readonly Dictionary<Type, MethodInfo> _readMethods;
+
+		public ByteSegmentSerializer()
+		{
+			_writeMethods = new Dictionary<Type, MethodInfo>();
+			_readMethods = new Dictionary<Type, MethodInfo>();
+
+			Add(typeof(ArraySegment<byte>), "ReadByteSegment");
+#if DOTNETCORE
+			Add(typeof(ReadOnlyMemory<byte>), "ReadReadOnlyByteMemory");
+			Add(typeof(Memory<byte>), "ReadByteMemory");
+#endif
+		}
+
+		private void Add(Type type, string readMethodName)
+		{
+			_writeMethods.Add(type, typeof(BinarySerializer2).GetMethod("WriteValue", new[] {typeof(BinaryWriter), type}));
+			_readMethods.Add(type, typeof(BinarySerializer2).GetMethod(readMethodName, new[] {typeof(BinaryReader)}));
+		}
+
+		public override bool Supports(Type type)
+		{
+			return _writeMethods.ContainsKey(type);
+		}
+
+		public override void EmitWriteValue(ILGenerator gen,
+		                                    ISerializerCompiler serializerCompiler,
+		                                    Action loadWriter,
+		                                    Action loadValue,
+		                                    Action loadValueAddress,
+		                                    Action loadSerializer,
+		                                    Action loadRemotingEndPoint,
+		                                    Type type,
+		                                    bool valueCanBeNull = true)
+		{
+			loadWriter();
+			loadValue();
+			gen.Emit(OpCodes.Call, _writeMethods[type]);
+		}
+
+		public override void EmitReadValue(ILGenerator gen,
+		                                   ISerializerCompiler serializerCompiler,
+		                                   Action loadReader,
+		                                   Action loadSerializer,
+		                                   Action loadRemotingEndPoint,
+		                                   Type type,
+		                                   bool valueCanBeNull = true)
+		{
+			loadReader();
+			gen.Emit(OpCodes.Call, _readMethods[type]);
+		}
+	}
+}
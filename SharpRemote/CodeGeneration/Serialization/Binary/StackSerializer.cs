@@ -21,7 +21,8 @@ namespace SharpRemote
 			              loadReader,
 			              loadSerializer,
 			              loadRemotingEndPoint,
-			              typeInformation);
+			              typeInformation,
+			              ArrayOrder.Reverse);
 
 			gen.Emit(OpCodes.Newobj, ctor);
 		}
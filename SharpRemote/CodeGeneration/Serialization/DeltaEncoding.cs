@@ -0,0 +1,222 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Runtime.CompilerServices;
+
+namespace SharpRemote.CodeGeneration.Serialization
+{
+	/// <summary>
+	///     Keeps track of the snapshots of all <see cref="DeltaEncodedAttribute" /> types which have been
+	///     written and read over a particular connection.
+	/// </summary>
+	/// <remarks>
+	///     Streams are owned by the <see cref="IRemotingEndPoint" /> which is passed to the serializer, or by the
+	///     serializer itself when no endpoint is involved, and are discarded as soon as the endpoint
+	///     reconnects: The counterpart on the new connection hasn't seen any of the old snapshots.
+	///     The number of streams per type is bounded by <see cref="DeltaEncodedAttribute.MaxStreams" />:
+	///     The least recently used stream is discarded first.
+	/// </remarks>
+	public static class DeltaEncoding
+	{
+		private static readonly ConditionalWeakTable<object, Streams> StreamsByOwner;
+		private static readonly object NullKey;
+
+		static DeltaEncoding()
+		{
+			StreamsByOwner = new ConditionalWeakTable<object, Streams>();
+			NullKey = new object();
+		}
+
+		/// <summary>
+		///     Returns the stream the given value is written to.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="serializer"></param>
+		/// <param name="endPoint"></param>
+		/// <param name="key">The value of the <see cref="DeltaKeyAttribute" /> member, if there is one</param>
+		/// <returns></returns>
+		public static DeltaStream<T> GetOutgoingStream<T>(ISerializer2 serializer, IRemotingEndPoint endPoint, object key)
+		{
+			return GetStream<T>(serializer, endPoint, key, incoming: false);
+		}
+
+		/// <summary>
+		///     Returns the stream the given value is read from.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="serializer"></param>
+		/// <param name="endPoint"></param>
+		/// <param name="key">The value of the <see cref="DeltaKeyAttribute" /> member, if there is one</param>
+		/// <returns></returns>
+		public static DeltaStream<T> GetIncomingStream<T>(ISerializer2 serializer, IRemotingEndPoint endPoint, object key)
+		{
+			return GetStream<T>(serializer, endPoint, key, incoming: true);
+		}
+
+		/// <summary>
+		///     Compares the two given values bitwise so that NaNs are equal to themselves and 0 differs from -0.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <returns></returns>
+		public static bool Equals(double x, double y)
+		{
+			return BitConverter.DoubleToInt64Bits(x) == BitConverter.DoubleToInt64Bits(y);
+		}
+
+		/// <summary>
+		///     Compares the two given values, including their <see cref="DateTime.Kind" />.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <returns></returns>
+		public static bool Equals(DateTime x, DateTime y)
+		{
+			return x.Ticks == y.Ticks && x.Kind == y.Kind;
+		}
+
+		/// <summary>
+		///     Tests if members of the given type can be omitted from a delta.
+		/// </summary>
+		/// <param name="type"></param>
+		/// <returns></returns>
+		public static bool IsComparable(Type type)
+		{
+			return type.IsPrimitive && type != typeof(IntPtr) && type != typeof(UIntPtr) ||
+			       type.IsEnum ||
+			       type == typeof(string) ||
+			       type == typeof(DateTime);
+		}
+
+		/// <summary>
+		///     Returns the <see cref="DeltaEncodedAttribute" /> of the given type, if it has one.
+		/// </summary>
+		/// <param name="type"></param>
+		/// <returns></returns>
+		public static DeltaEncodedAttribute GetAttribute(Type type)
+		{
+			return type.GetCustomAttribute<DeltaEncodedAttribute>(false);
+		}
+
+		private static DeltaStream<T> GetStream<T>(ISerializer2 serializer, IRemotingEndPoint endPoint, object key, bool incoming)
+		{
+			var streams = StreamsByOwner.GetValue((object) endPoint ?? serializer, unused => new Streams());
+			var id = new StreamGroupId(typeof(T), incoming);
+			key = key ?? NullKey;
+			lock (streams)
+			{
+				var connectionId = endPoint?.CurrentConnectionId ?? ConnectionId.None;
+				if (connectionId != streams.ConnectionId)
+				{
+					streams.Clear();
+					streams.ConnectionId = connectionId;
+				}
+
+				StreamGroup group;
+				if (!streams.TryGetValue(id, out group))
+				{
+					group = new StreamGroup();
+					streams.Add(id, group);
+				}
+
+				LinkedListNode<KeyValuePair<object, object>> node;
+				if (group.StreamsByKey.TryGetValue(key, out node))
+				{
+					group.StreamsByUse.Remove(node);
+					group.StreamsByUse.AddFirst(node);
+					return (DeltaStream<T>) node.Value.Value;
+				}
+
+				// The receiver keeps more streams than the sender so that it doesn't discard
+				// a stream the sender still writes to, just because both use them in a slightly different order.
+				var attribute = GetAttribute(typeof(T));
+				var maxStreams = Math.Max(attribute.MaxStreams, 1) * (incoming ? 2 : 1);
+				if (group.StreamsByKey.Count >= maxStreams)
+				{
+					var leastRecentlyUsed = group.StreamsByUse.Last;
+					group.StreamsByUse.RemoveLast();
+					group.StreamsByKey.Remove(leastRecentlyUsed.Value.Key);
+
+					// Should the key be used again, then its new stream must continue where the discarded
+					// one left off or else the receiver would ignore the new snapshots as being outdated.
+					var version = ((DeltaStream<T>) leastRecentlyUsed.Value.Value).Version;
+					group.Version = Math.Max(group.Version, version);
+				}
+
+				var stream = new DeltaStream<T>(attribute.SnapshotInterval, group.Version);
+				node = group.StreamsByUse.AddFirst(new KeyValuePair<object, object>(key, stream));
+				group.StreamsByKey.Add(key, node);
+				return stream;
+			}
+		}
+
+		private struct StreamGroupId
+			: IEquatable<StreamGroupId>
+		{
+			private readonly Type _type;
+			private readonly bool _incoming;
+
+			public StreamGroupId(Type type, bool incoming)
+			{
+				_type = type;
+				_incoming = incoming;
+			}
+
+			public bool Equals(StreamGroupId other)
+			{
+				return _type == other._type && _incoming == other._incoming;
+			}
+
+			public override bool Equals(object obj)
+			{
+				return obj is StreamGroupId && Equals((StreamGroupId) obj);
+			}
+
+			public override int GetHashCode()
+			{
+				unchecked
+				{
+					return (_type.GetHashCode() * 397) ^ _incoming.GetHashCode();
+				}
+			}
+		}
+
+		/// <summary>
+		///     The streams of one type in one direction, by key and in the order of their last use.
+		/// </summary>
+		private sealed class StreamGroup
+		{
+			public readonly Dictionary<object, LinkedListNode<KeyValuePair<object, object>>> StreamsByKey;
+			public readonly LinkedList<KeyValuePair<object, object>> StreamsByUse;
+
+			/// <summary>
+			///     The highest version any discarded stream of this group has reached.
+			/// </summary>
+			public uint Version;
+
+			public StreamGroup()
+			{
+				StreamsByKey = new Dictionary<object, LinkedListNode<KeyValuePair<object, object>>>();
+				StreamsByUse = new LinkedList<KeyValuePair<object, object>>();
+			}
+		}
+
+		private sealed class Streams
+			: Dictionary<StreamGroupId, StreamGroup>
+		{
+			public ConnectionId ConnectionId;
+		}
+	}
+}
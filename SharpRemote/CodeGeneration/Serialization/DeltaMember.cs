@@ -0,0 +1,200 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Reflection;
+using System.Reflection.Emit;
+
+namespace SharpRemote.CodeGeneration.Serialization
+{
+	/// <summary>
+	///     A data member of a <see cref="DeltaEncodedAttribute" /> type which is compared against the last snapshot
+	///     and only written when it differs from it.
+	/// </summary>
+	internal sealed class DeltaMember
+	{
+		/// <summary>
+		///     The maximum number of members which can be omitted from a delta: The bitmap of members which have
+		///     been written is a single <see cref="ulong" />.
+		/// </summary>
+		public const int MaximumCount = 64;
+
+		private static readonly MethodInfo StringEquals;
+		private static readonly MethodInfo DoubleEquals;
+		private static readonly MethodInfo DateTimeEquals;
+
+		private readonly IMemberDescription _description;
+		private readonly Type _memberType;
+		private readonly ulong _mask;
+
+		static DeltaMember()
+		{
+			StringEquals = typeof(string).GetMethod(nameof(string.Equals), new[] {typeof(string), typeof(string)});
+			DoubleEquals = typeof(DeltaEncoding).GetMethod(nameof(DeltaEncoding.Equals), new[] {typeof(double), typeof(double)});
+			DateTimeEquals = typeof(DeltaEncoding).GetMethod(nameof(DeltaEncoding.Equals), new[] {typeof(DateTime), typeof(DateTime)});
+		}
+
+		private DeltaMember(IMemberDescription description, int index)
+		{
+			_description = description;
+			_memberType = description.TypeDescription.Type;
+			_mask = index >= 0 ? 1UL << index : 0;
+		}
+
+		/// <summary>
+		///     The member's bit in the bitmap of members which have been written.
+		/// </summary>
+		public ulong Mask => _mask;
+
+		/// <summary>
+		///     Tests if this member describes the given field or property.
+		/// </summary>
+		/// <param name="member"></param>
+		/// <returns></returns>
+		public bool Describes(IMemberDescription member)
+		{
+			return _description.MemberInfo == member.MemberInfo;
+		}
+
+		/// <summary>
+		///     Emits code which pushes the value of this member onto the evaluation stack.
+		/// </summary>
+		/// <param name="gen"></param>
+		/// <param name="loadInstance">Emits code which pushes the instance (or its address, for value types) onto the evaluation stack</param>
+		public void EmitLoad(ILGenerator gen, Action loadInstance)
+		{
+			loadInstance();
+			var field = _description as IFieldDescription;
+			if (field != null)
+				gen.Emit(OpCodes.Ldfld, field.Field);
+			else
+				gen.Emit(OpCodes.Call, ((IPropertyDescription) _description).GetMethod.Method);
+		}
+
+		/// <summary>
+		///     Emits code which pushes the value of this member onto the evaluation stack as an object.
+		/// </summary>
+		/// <param name="gen"></param>
+		/// <param name="loadInstance"></param>
+		public void EmitLoadBoxed(ILGenerator gen, Action loadInstance)
+		{
+			EmitLoad(gen, loadInstance);
+			if (_memberType.IsValueType)
+				gen.Emit(OpCodes.Box, _memberType);
+		}
+
+		/// <summary>
+		///     Emits code which copies the value of this member from one instance to another.
+		/// </summary>
+		/// <param name="gen"></param>
+		/// <param name="loadTarget">Emits code which pushes the target instance (or its address) onto the evaluation stack</param>
+		/// <param name="loadSource">Emits code which pushes the source instance (or its address) onto the evaluation stack</param>
+		public void EmitCopy(ILGenerator gen, Action loadTarget, Action loadSource)
+		{
+			loadTarget();
+			EmitLoad(gen, loadSource);
+			var field = _description as IFieldDescription;
+			if (field != null)
+				gen.Emit(OpCodes.Stfld, field.Field);
+			else
+				gen.Emit(OpCodes.Call, ((IPropertyDescription) _description).SetMethod.Method);
+		}
+
+		/// <summary>
+		///     Emits code which pushes true onto the evaluation stack when this member has the same value
+		///     in both instances and false otherwise.
+		/// </summary>
+		/// <param name="gen"></param>
+		/// <param name="loadX"></param>
+		/// <param name="loadY"></param>
+		public void EmitEquals(ILGenerator gen, Action loadX, Action loadY)
+		{
+			EmitLoad(gen, loadX);
+			if (_memberType == typeof(float))
+				gen.Emit(OpCodes.Conv_R8);
+			EmitLoad(gen, loadY);
+			if (_memberType == typeof(float))
+				gen.Emit(OpCodes.Conv_R8);
+
+			if (_memberType == typeof(string))
+				gen.Emit(OpCodes.Call, StringEquals);
+			else if (_memberType == typeof(float) || _memberType == typeof(double))
+				gen.Emit(OpCodes.Call, DoubleEquals);
+			else if (_memberType == typeof(DateTime))
+				gen.Emit(OpCodes.Call, DateTimeEquals);
+			else
+				gen.Emit(OpCodes.Ceq);
+		}
+
+		/// <summary>
+		///     Emits code which jumps to <paramref name="unchanged" /> in case the given member is not part of the
+		///     current delta. Emits nothing for members which are always written.
+		/// </summary>
+		/// <param name="gen"></param>
+		/// <param name="member"></param>
+		/// <param name="deltaMembers">The members which can be omitted from a delta or null if the type isn't delta encoded</param>
+		/// <param name="bitmap">The bitmap of members which are part of the current delta</param>
+		/// <param name="unchanged"></param>
+		public static void EmitSkipUnchanged(ILGenerator gen,
+		                                     IMemberDescription member,
+		                                     IReadOnlyList<DeltaMember> deltaMembers,
+		                                     LocalBuilder bitmap,
+		                                     Label unchanged)
+		{
+			var deltaMember = deltaMembers?.FirstOrDefault(x => x.Describes(member));
+			if (deltaMember == null)
+				return;
+
+			gen.Emit(OpCodes.Ldloc, bitmap);
+			gen.Emit(OpCodes.Ldc_I8, (long) deltaMember.Mask);
+			gen.Emit(OpCodes.And);
+			gen.Emit(OpCodes.Brfalse, unchanged);
+		}
+
+		/// <summary>
+		///     Finds the <see cref="DeltaKeyAttribute" /> member of the given type as well as all members which can be
+		///     omitted from a delta, in the order in which they are serialized (fields first, then properties).
+		/// </summary>
+		/// <param name="typeDescription"></param>
+		/// <param name="key">The key member or null if the type doesn't have one</param>
+		/// <returns></returns>
+		/// <exception cref="ArgumentException">When the type has more than one key or its key is of an unsupported type</exception>
+		public static IReadOnlyList<DeltaMember> GetMembers(ITypeDescription typeDescription, out DeltaMember key)
+		{
+			var members = typeDescription.Fields.Cast<IMemberDescription>()
+			                             .Concat(typeDescription.Properties)
+			                             .ToList();
+
+			var keys = members.Where(x => x.MemberInfo.GetCustomAttribute<DeltaKeyAttribute>() != null).ToList();
+			if (keys.Count > 1)
+				throw new ArgumentException(string.Format("The type '{0}' has more than one member marked with the [DeltaKey] attribute: {1}",
+				                                          typeDescription.Type,
+				                                          string.Join(", ", keys.Select(x => x.Name))));
+
+			key = null;
+			if (keys.Count == 1)
+			{
+				if (!DeltaEncoding.IsComparable(keys[0].TypeDescription.Type))
+					throw new ArgumentException(string.Format("The [DeltaKey] member '{0}' of type '{1}' must be of a primitive type, an enum, a string or a DateTime",
+					                                          keys[0].Name,
+					                                          typeDescription.Type));
+
+				key = new DeltaMember(keys[0], -1);
+			}
+
+			var compared = new List<DeltaMember>();
+			foreach (var member in members)
+			{
+				if (compared.Count == MaximumCount)
+					break;
+
+				if (keys.Contains(member))
+					continue;
+
+				if (DeltaEncoding.IsComparable(member.TypeDescription.Type))
+					compared.Add(new DeltaMember(member, compared.Count));
+			}
+
+			return compared;
+		}
+	}
+}
@@ -0,0 +1,144 @@
+﻿using System;
+
+namespace SharpRemote.CodeGeneration.Serialization
+{
+	/// <summary>
+	///     The snapshots of one stream of <see cref="DeltaEncodedAttribute" /> values.
+	/// </summary>
+	/// <remarks>
+	///     Every value is preceded by a header which holds the version of the snapshot the value refers to in its upper bits
+	///     and whether or not the value is a delta (as opposed to a snapshot) in its lowest bit.
+	/// </remarks>
+	/// <typeparam name="T"></typeparam>
+	public sealed class DeltaStream<T>
+	{
+		private readonly int _snapshotInterval;
+		private uint _version;
+		private int _count;
+
+		private uint _previousVersion;
+		private T _previousSnapshot;
+		private bool _hasSnapshot;
+
+		/// <summary>
+		///     The last snapshot which has been written to, or read from, this stream.
+		///     Must only be accessed while holding a lock on this stream.
+		/// </summary>
+		/// <remarks>
+		///     Accessed by the generated code, shouldn't be accessed directly.
+		/// </remarks>
+		public T Snapshot;
+
+		/// <summary>
+		///     Initializes this object.
+		/// </summary>
+		/// <param name="snapshotInterval"></param>
+		public DeltaStream(int snapshotInterval)
+			: this(snapshotInterval, 0)
+		{}
+
+		/// <summary>
+		///     Initializes this object.
+		/// </summary>
+		/// <param name="snapshotInterval"></param>
+		/// <param name="version">The version after which this stream starts numbering its snapshots</param>
+		public DeltaStream(int snapshotInterval, uint version)
+		{
+			_snapshotInterval = Math.Max(snapshotInterval, 1);
+			_version = version;
+			if (!typeof(T).IsValueType)
+				Snapshot = Activator.CreateInstance<T>();
+		}
+
+		/// <summary>
+		///     The version of the last snapshot which has been written to, or read from, this stream.
+		/// </summary>
+		internal uint Version
+		{
+			get
+			{
+				lock (this)
+				{
+					return _version;
+				}
+			}
+		}
+
+		/// <summary>
+		///     Decides whether or not the next value is written as a snapshot and returns its header.
+		///     The caller must write the value in full and copy it into <see cref="Snapshot" /> when the lowest bit
+		///     of the header is not set.
+		///     Must only be called while holding a lock on this stream.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		///     The lock only orders the serialization of values, not their delivery: When two threads write
+		///     to the same stream concurrently, the delta written by one of them may be delivered before the
+		///     snapshot it refers to, which has been written by the other. The receiver then can't deserialize
+		///     the delta. See <see cref="DeltaEncodedAttribute" />.
+		/// </remarks>
+		/// <returns></returns>
+		public uint BeginWrite()
+		{
+			if (_count++ % _snapshotInterval == 0)
+			{
+				++_version;
+				return _version << 1;
+			}
+
+			return (_version << 1) | 1;
+		}
+
+		/// <summary>
+		///     Returns the snapshot with the given version.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="version"></param>
+		/// <returns></returns>
+		/// <exception cref="SerializationException">When the snapshot isn't known (anymore)</exception>
+		public T GetSnapshot(uint version)
+		{
+			lock (this)
+			{
+				if (_hasSnapshot)
+				{
+					if (version == _version)
+						return Snapshot;
+					if (version == _previousVersion)
+						return _previousSnapshot;
+				}
+			}
+
+			throw new SerializationException(string.Format("Unable to deserialize a delta of '{0}': Snapshot #{1} has not been received",
+			                                               typeof(T),
+			                                               version));
+		}
+
+		/// <summary>
+		///     Adds a snapshot which has just been read.
+		///     Both this and the previous snapshot are kept so that deltas which have been written
+		///     shortly before the newer snapshot can still be read afterwards.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <param name="version"></param>
+		/// <param name="snapshot"></param>
+		public void AddSnapshot(uint version, T snapshot)
+		{
+			lock (this)
+			{
+				if (_hasSnapshot && version < _version)
+					return;
+
+				_previousVersion = _version;
+				_previousSnapshot = Snapshot;
+				_version = version;
+				Snapshot = snapshot;
+				_hasSnapshot = true;
+			}
+		}
+	}
+}
@@ -1,13 +1,280 @@
 ﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Reflection.Emit;
+using System.Runtime.Serialization;
 
 namespace SharpRemote.CodeGeneration.Serialization
 {
 	/// <summary>
-	///     Responsible for creating custom exceptions which inherit from <see cref="Exception" />,
-	///     provides a publicly accessible deserialization constructor so that nearly identical
-	///     custom exceptions may be shipped using XML.
+	///     Responsible for compiling a factory method for every exception type which invokes
+	///     its deserialization constructor (SerializationInfo, StreamingContext), so that exceptions
+	///     can be restored from the values written by <see cref="Exception.GetObjectData" />
+	///     without having to go through <see cref="ConstructorInfo.Invoke(object[])" /> or
+	///     a BinaryFormatter.
+	///     Additionally compiles accessors for the fields and properties of an exception type
+	///     which are attributed with <see cref="DataMemberAttribute" /> as well as factories which
+	///     restore an exception from nothing but its message, inner exception and stack trace.
 	/// </summary>
-	internal sealed class ExceptionCompiler
+	internal static class ExceptionCompiler
 	{
+		private static readonly ConcurrentDictionary<Type, Func<SerializationInfo, StreamingContext, Exception>> Factories;
+		private static readonly ConcurrentDictionary<Type, ExceptionMember[]> Members;
+		private static readonly ConcurrentDictionary<Type, Func<string, Exception, string, Exception>> PlainFactories;
+
+		private static readonly FieldInfo MessageField;
+		private static readonly FieldInfo InnerExceptionField;
+		private static readonly FieldInfo RemoteStackTraceField;
+
+		static ExceptionCompiler()
+		{
+			Factories = new ConcurrentDictionary<Type, Func<SerializationInfo, StreamingContext, Exception>>();
+			Members = new ConcurrentDictionary<Type, ExceptionMember[]>();
+			PlainFactories = new ConcurrentDictionary<Type, Func<string, Exception, string, Exception>>();
+
+			// These fields have the same names in both the .NET Framework and .NET Core.
+			// Should they ever be missing, then the respective value is simply not restored.
+			const BindingFlags flags = BindingFlags.NonPublic | BindingFlags.Instance;
+			MessageField = typeof(Exception).GetField("_message", flags);
+			InnerExceptionField = typeof(Exception).GetField("_innerException", flags);
+			RemoteStackTraceField = typeof(Exception).GetField("_remoteStackTraceString", flags);
+		}
+
+		/// <summary>
+		///     Returns a method which creates a new exception of the given type from the given
+		///     <see cref="SerializationInfo" /> by invoking the type's deserialization constructor.
+		/// </summary>
+		/// <param name="exceptionType"></param>
+		/// <returns>The factory or null in case the type doesn't have a deserialization constructor</returns>
+		public static Func<SerializationInfo, StreamingContext, Exception> GetFactory(Type exceptionType)
+		{
+			if (exceptionType == null)
+				throw new ArgumentNullException(nameof(exceptionType));
+
+			return Factories.GetOrAdd(exceptionType, CreateFactory);
+		}
+
+		/// <summary>
+		///     Returns a method which creates a new exception of the given type from its message, inner exception
+		///     and the stack trace it had on the remote side: The latter becomes the start of the exception's
+		///     <see cref="Exception.StackTrace" />, once it is thrown.
+		/// </summary>
+		/// <remarks>
+		///     The exception is created through its (string, Exception), (string) or parameterless constructor,
+		///     whichever is found first. Values which aren't passed to the constructor are assigned directly.
+		/// </remarks>
+		/// <param name="exceptionType"></param>
+		/// <returns>The factory or null in case the type doesn't have any of those constructors</returns>
+		public static Func<string, Exception, string, Exception> GetPlainFactory(Type exceptionType)
+		{
+			if (exceptionType == null)
+				throw new ArgumentNullException(nameof(exceptionType));
+
+			return PlainFactories.GetOrAdd(exceptionType, CreatePlainFactory);
+		}
+
+		private static Func<string, Exception, string, Exception> CreatePlainFactory(Type exceptionType)
+		{
+			if (!typeof(Exception).IsAssignableFrom(exceptionType) || exceptionType.IsAbstract)
+				return null;
+
+			const BindingFlags flags = BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance;
+			var method = new DynamicMethod(string.Format("CreatePlain{0}", exceptionType.Name),
+			                               typeof(Exception),
+			                               new[] {typeof(string), typeof(Exception), typeof(string)},
+			                               exceptionType.Module,
+			                               true);
+			var gen = method.GetILGenerator();
+
+			ConstructorInfo ctor;
+			if ((ctor = exceptionType.GetConstructor(flags, null, new[] {typeof(string), typeof(Exception)}, null)) != null)
+			{
+				gen.Emit(OpCodes.Ldarg_0);
+				gen.Emit(OpCodes.Ldarg_1);
+				gen.Emit(OpCodes.Newobj, ctor);
+			}
+			else if ((ctor = exceptionType.GetConstructor(flags, null, new[] {typeof(string)}, null)) != null)
+			{
+				gen.Emit(OpCodes.Ldarg_0);
+				gen.Emit(OpCodes.Newobj, ctor);
+				EmitStoreField(gen, InnerExceptionField, OpCodes.Ldarg_1);
+			}
+			else if ((ctor = exceptionType.GetConstructor(flags, null, Type.EmptyTypes, null)) != null)
+			{
+				gen.Emit(OpCodes.Newobj, ctor);
+				EmitStoreField(gen, MessageField, OpCodes.Ldarg_0);
+				EmitStoreField(gen, InnerExceptionField, OpCodes.Ldarg_1);
+			}
+			else
+			{
+				return null;
+			}
+
+			EmitStoreField(gen, RemoteStackTraceField, OpCodes.Ldarg_2);
+			gen.Emit(OpCodes.Ret);
+
+			return (Func<string, Exception, string, Exception>) method.CreateDelegate(
+				typeof(Func<string, Exception, string, Exception>));
+		}
+
+		/// <summary>
+		///     Stores the given argument in the given field of the exception on top of the stack,
+		///     leaving the exception on the stack.
+		/// </summary>
+		private static void EmitStoreField(ILGenerator gen, FieldInfo field, OpCode loadArgument)
+		{
+			if (field == null)
+				return;
+
+			gen.Emit(OpCodes.Dup);
+			gen.Emit(loadArgument);
+			gen.Emit(OpCodes.Stfld, field);
+		}
+
+		/// <summary>
+		///     Returns the fields and properties of the given exception type (and its base types, up to
+		///     but excluding <see cref="Exception" />) which are attributed with <see cref="DataMemberAttribute" />.
+		///     Properties are only returned when they have both a getter and a setter.
+		/// </summary>
+		/// <param name="exceptionType"></param>
+		/// <returns></returns>
+		public static ExceptionMember[] GetDataMembers(Type exceptionType)
+		{
+			if (exceptionType == null)
+				throw new ArgumentNullException(nameof(exceptionType));
+
+			return Members.GetOrAdd(exceptionType, CreateDataMembers);
+		}
+
+		private static ExceptionMember[] CreateDataMembers(Type exceptionType)
+		{
+			const BindingFlags flags = BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance | BindingFlags.DeclaredOnly;
+
+			var members = new List<ExceptionMember>();
+			for (var type = exceptionType; type != null && type != typeof(Exception); type = type.BaseType)
+			{
+				foreach (var field in type.GetFields(flags))
+				{
+					var attribute = field.GetCustomAttribute<DataMemberAttribute>();
+					if (attribute != null)
+						members.Add(new ExceptionMember(attribute.Name ?? field.Name,
+						                                CompileGetter(exceptionType, field),
+						                                CompileSetter(exceptionType, field)));
+				}
+
+				foreach (var property in type.GetProperties(flags))
+				{
+					var attribute = property.GetCustomAttribute<DataMemberAttribute>();
+					if (attribute == null || property.GetMethod == null || property.SetMethod == null)
+						continue;
+
+					members.Add(new ExceptionMember(attribute.Name ?? property.Name,
+					                                CompileGetter(exceptionType, property),
+					                                CompileSetter(exceptionType, property)));
+				}
+			}
+
+			return members.ToArray();
+		}
+
+		private static Func<Exception, object> CompileGetter(Type exceptionType, FieldInfo field)
+		{
+			var method = new DynamicMethod(string.Format("Get{0}", field.Name),
+			                               typeof(object),
+			                               new[] {typeof(Exception)},
+			                               exceptionType.Module,
+			                               true);
+			var gen = method.GetILGenerator();
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Castclass, field.DeclaringType);
+			gen.Emit(OpCodes.Ldfld, field);
+			if (field.FieldType.IsValueType)
+				gen.Emit(OpCodes.Box, field.FieldType);
+			gen.Emit(OpCodes.Ret);
+
+			return (Func<Exception, object>) method.CreateDelegate(typeof(Func<Exception, object>));
+		}
+
+		private static Action<Exception, object> CompileSetter(Type exceptionType, FieldInfo field)
+		{
+			var method = new DynamicMethod(string.Format("Set{0}", field.Name),
+			                               typeof(void),
+			                               new[] {typeof(Exception), typeof(object)},
+			                               exceptionType.Module,
+			                               true);
+			var gen = method.GetILGenerator();
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Castclass, field.DeclaringType);
+			gen.Emit(OpCodes.Ldarg_1);
+			gen.Emit(OpCodes.Unbox_Any, field.FieldType);
+			gen.Emit(OpCodes.Stfld, field);
+			gen.Emit(OpCodes.Ret);
+
+			return (Action<Exception, object>) method.CreateDelegate(typeof(Action<Exception, object>));
+		}
+
+		private static Func<Exception, object> CompileGetter(Type exceptionType, PropertyInfo property)
+		{
+			var method = new DynamicMethod(string.Format("Get{0}", property.Name),
+			                               typeof(object),
+			                               new[] {typeof(Exception)},
+			                               exceptionType.Module,
+			                               true);
+			var gen = method.GetILGenerator();
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Castclass, property.DeclaringType);
+			gen.Emit(OpCodes.Callvirt, property.GetMethod);
+			if (property.PropertyType.IsValueType)
+				gen.Emit(OpCodes.Box, property.PropertyType);
+			gen.Emit(OpCodes.Ret);
+
+			return (Func<Exception, object>) method.CreateDelegate(typeof(Func<Exception, object>));
+		}
+
+		private static Action<Exception, object> CompileSetter(Type exceptionType, PropertyInfo property)
+		{
+			var method = new DynamicMethod(string.Format("Set{0}", property.Name),
+			                               typeof(void),
+			                               new[] {typeof(Exception), typeof(object)},
+			                               exceptionType.Module,
+			                               true);
+			var gen = method.GetILGenerator();
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Castclass, property.DeclaringType);
+			gen.Emit(OpCodes.Ldarg_1);
+			gen.Emit(OpCodes.Unbox_Any, property.PropertyType);
+			gen.Emit(OpCodes.Callvirt, property.SetMethod);
+			gen.Emit(OpCodes.Ret);
+
+			return (Action<Exception, object>) method.CreateDelegate(typeof(Action<Exception, object>));
+		}
+
+		private static Func<SerializationInfo, StreamingContext, Exception> CreateFactory(Type exceptionType)
+		{
+			if (!typeof(Exception).IsAssignableFrom(exceptionType) || exceptionType.IsAbstract)
+				return null;
+
+			var ctor = exceptionType.GetConstructor(BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance,
+			                                        null,
+			                                        new[] {typeof(SerializationInfo), typeof(StreamingContext)},
+			                                        null);
+			if (ctor == null)
+				return null;
+
+			var method = new DynamicMethod(string.Format("Create{0}", exceptionType.Name),
+			                               typeof(Exception),
+			                               new[] {typeof(SerializationInfo), typeof(StreamingContext)},
+			                               exceptionType.Module,
+			                               true);
+			var gen = method.GetILGenerator();
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Ldarg_1);
+			gen.Emit(OpCodes.Newobj, ctor);
+			gen.Emit(OpCodes.Ret);
+
+			return (Func<SerializationInfo, StreamingContext, Exception>) method.CreateDelegate(
+				typeof(Func<SerializationInfo, StreamingContext, Exception>));
+		}
 	}
-}
\ No newline at end of file
+}
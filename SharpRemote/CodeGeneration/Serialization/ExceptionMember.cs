@@ -0,0 +1,22 @@
+﻿using System;
+
+namespace SharpRemote.CodeGeneration.Serialization
+{
+	/// <summary>
+	///     Provides compiled access to a field or property of an exception which is attributed with
+	///     <see cref="System.Runtime.Serialization.DataMemberAttribute" />.
+	/// </summary>
+	internal sealed class ExceptionMember
+	{
+		public readonly string Name;
+		public readonly Func<Exception, object> GetValue;
+		public readonly Action<Exception, object> SetValue;
+
+		public ExceptionMember(string name, Func<Exception, object> getValue, Action<Exception, object> setValue)
+		{
+			Name = name;
+			GetValue = getValue;
+			SetValue = setValue;
+		}
+	}
+}
@@ -33,6 +33,14 @@ namespace SharpRemote
 		/// <returns>True if the next argument could be read, false when the end of arguments has been reached.</returns>
 		bool ReadNextArgument(out object value);
 
+		/// <summary>
+		///     Reads the value of the next argument from the method call message without boxing it.
+		/// </summary>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="value">The value of the next argument</param>
+		/// <returns>True if the next argument could be read, false when the end of arguments has been reached.</returns>
+		bool ReadNextArgumentAsStruct<T>(out T value) where T : struct;
+
 		/// <summary>
 		///     Reads the value of the next argument from the method call message.
 		/// </summary>
@@ -130,5 +138,16 @@ namespace SharpRemote
 		/// <param name="value">The value of the next argument</param>
 		/// <returns>True if the next argument could be read, false when the end of arguments has been reached.</returns>
 		bool ReadNextArgumentAsBytes(out byte[] value);
+
+		/// <summary>
+		///     Reads the value of the next argument from the method call message.
+		/// </summary>
+		/// <remarks>
+		///     The returned segment may point into the message's buffer instead of being a copy:
+		///     It must not be used anymore once this reader has been disposed of.
+		/// </remarks>
+		/// <param name="value">The value of the next argument</param>
+		/// <returns>True if the next argument could be read, false when the end of arguments has been reached.</returns>
+		bool ReadNextArgumentAsByteSegment(out ArraySegment<byte> value);
 	}
 }
\ No newline at end of file
@@ -15,6 +15,15 @@ namespace SharpRemote
 		/// <param name="value"></param>
 		void WriteArgument(object value);
 
+		/// <summary>
+		///     Adds an argument of the given value type to this method call without boxing it.
+		///     The argument can be read with either <see cref="IMethodCallReader.ReadNextArgument(out object)" />
+		///     or <see cref="IMethodCallReader.ReadNextArgumentAsStruct{T}" />.
+		/// </summary>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="value"></param>
+		void WriteArgument<T>(T value) where T : struct;
+
 		/// <summary>
 		///     Adds an argument of the given name and value to this method call.
 		/// </summary>
@@ -98,5 +107,12 @@ namespace SharpRemote
 		/// </summary>
 		/// <param name="value"></param>
 		void WriteArgument(byte[] value);
+
+		/// <summary>
+		///     Adds an argument of the given name and value to this method call.
+		///     The bytes are written straight from the segment's array, in the same format as a byte[].
+		/// </summary>
+		/// <param name="value"></param>
+		void WriteArgument(ArraySegment<byte> value);
 	}
 }
\ No newline at end of file
@@ -38,6 +38,14 @@ namespace SharpRemote
 		/// <returns>True if a value was written to- and thus read from, false if no result is present</returns>
 		bool ReadResult(out object value);
 
+		/// <summary>
+		///     Returns the result of the method call without boxing it.
+		/// </summary>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="value"></param>
+		/// <returns>True if a value was written to- and thus read from, false if no result is present</returns>
+		bool ReadResultStruct<T>(out T value) where T : struct;
+
 		/// <summary>
 		///     Returns the result of the method as an <see cref="sbyte" />.
 		///     May throw an exception if the method didn't return a value of that type, but doesn't need to.
@@ -181,5 +189,17 @@ namespace SharpRemote
 		/// <param name="value"></param>
 		/// <returns>True if a value was written to- and thus read from, false if no result is present</returns>
 		bool ReadResultBytes(out byte[] value);
+
+		/// <summary>
+		///     Returns the result of the method as an <see cref="ArraySegment{T}" />.
+		///     May throw an exception if the method didn't return a value of that type, but doesn't need to.
+		/// </summary>
+		/// <remarks>
+		///     The returned segment may point into the message's buffer instead of being a copy:
+		///     It must not be used anymore once this reader has been disposed of.
+		/// </remarks>
+		/// <param name="value"></param>
+		/// <returns>True if a value was written to- and thus read from, false if no result is present</returns>
+		bool ReadResultByteSegment(out ArraySegment<byte> value);
 	}
 }
\ No newline at end of file
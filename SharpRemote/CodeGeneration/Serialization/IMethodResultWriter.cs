@@ -25,6 +25,15 @@ namespace SharpRemote
 		/// </summary>
 		void WriteResult(object value);
 
+		/// <summary>
+		///     Writes the result of the method invocation without boxing it.
+		///     The result can be read with either <see cref="IMethodResultReader.ReadResult(out object)" />
+		///     or <see cref="IMethodResultReader.ReadResultStruct{T}" />.
+		/// </summary>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="value"></param>
+		void WriteResult<T>(T value) where T : struct;
+
 		/// <summary>
 		///     Writes the result of the method invocation.
 		/// </summary>
@@ -87,6 +96,13 @@ namespace SharpRemote
 		/// <param name="value"></param>
 		void WriteResult(byte[] value);
 
+		/// <summary>
+		///     Writes the result of the method invocation.
+		///     The bytes are written straight from the segment's array, in the same format as a byte[].
+		/// </summary>
+		/// <param name="value"></param>
+		void WriteResult(ArraySegment<byte> value);
+
 		/// <summary>
 		///     Signals that the method call resulted in an unhandled exception being thrown.
 		///     The exception should be serialized.
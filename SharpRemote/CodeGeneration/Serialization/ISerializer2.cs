@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.Diagnostics.Contracts;
 using System.IO;
 using System.Runtime.Serialization;
@@ -61,6 +62,21 @@ namespace SharpRemote
 		/// </exception>
 		void RegisterType(Type type);
 
+		/// <summary>
+		///     Registers all of the given types with this serializer.
+		/// </summary>
+		/// <remarks>
+		///     Intended to be called during startup so that the first messages don't have to wait
+		///     for their types to be compiled. Contrary to <see cref="RegisterType(Type)" />, types which cannot be
+		///     registered are reported through <see cref="PreparedType.Exception" /> instead of throwing.
+		///     All methods are compiled into the same module and thus there's nothing to gain
+		///     from registering types in parallel: Types are registered one after the other.
+		/// </remarks>
+		/// <param name="types">The types to register</param>
+		/// <returns>The outcome of registering each type, in the same order as <paramref name="types" /></returns>
+		/// <exception cref="ArgumentNullException">When <paramref name="types" /> is null</exception>
+		IReadOnlyList<PreparedType> RegisterTypes(IEnumerable<Type> types);
+
 		/// <summary>
 		///     Tests if the given type <typeparamref name="T" /> has already been registered
 		///     with this serializer (either directly through <see cref="RegisterType" /> or indirectly
@@ -43,5 +43,20 @@ namespace SharpRemote
 		                    Action loadSerializer,
 		                    Action loadRemotingEndPoint,
 		                    Type valueType);
+
+		/// <summary>
+		///     Emits the code necessary to compute the number of bytes <see cref="EmitWriteValue" />
+		///     writes for a value of the given compile-time type: The computed size (a <see cref="long" />)
+		///     is pushed onto the evaluation stack.
+		///     The size is exact for fixed-size types and cheap to compute for some variable-sized
+		///     ones (strings, arrays of fixed-size values); nothing is emitted for all other types.
+		/// </summary>
+		/// <param name="gen"></param>
+		/// <param name="loadValue"></param>
+		/// <param name="valueType"></param>
+		/// <returns>True when code to compute the size was emitted, false otherwise</returns>
+		bool EmitGetSerializedSize(ILGenerator gen,
+		                           Action loadValue,
+		                           Type valueType);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,101 @@
+﻿namespace SharpRemote.CodeGeneration.Serialization.MessagePack
+{
+	/// <summary>
+	///     The format codes of the MessagePack specification (https://github.com/msgpack/msgpack/blob/master/spec.md)
+	///     which are used by the <see cref="MessagePackSerializer" />.
+	/// </summary>
+	internal static class MessagePackCode
+	{
+		public const byte MaxPositiveFixInt = 0x7f;
+		public const byte MinFixMap = 0x80;
+		public const byte MaxFixMap = 0x8f;
+		public const byte MinFixArray = 0x90;
+		public const byte MaxFixArray = 0x9f;
+		public const byte MinFixStr = 0xa0;
+		public const byte MaxFixStr = 0xbf;
+		public const byte Nil = 0xc0;
+		public const byte False = 0xc2;
+		public const byte True = 0xc3;
+		public const byte Bin8 = 0xc4;
+		public const byte Bin16 = 0xc5;
+		public const byte Bin32 = 0xc6;
+		public const byte Float32 = 0xca;
+		public const byte Float64 = 0xcb;
+		public const byte UInt8 = 0xcc;
+		public const byte UInt16 = 0xcd;
+		public const byte UInt32 = 0xce;
+		public const byte UInt64 = 0xcf;
+		public const byte Int8 = 0xd0;
+		public const byte Int16 = 0xd1;
+		public const byte Int32 = 0xd2;
+		public const byte Int64 = 0xd3;
+		public const byte FixExt8 = 0xd7;
+		public const byte FixExt16 = 0xd8;
+		public const byte Str8 = 0xd9;
+		public const byte Str16 = 0xda;
+		public const byte Str32 = 0xdb;
+		public const byte Array16 = 0xdc;
+		public const byte Array32 = 0xdd;
+		public const byte Map16 = 0xde;
+		public const byte Map32 = 0xdf;
+		public const byte MinNegativeFixInt = 0xe0;
+
+		/// <summary>
+		///     The application specific extension type of a <see cref="System.DateTime" />:
+		///     Its payload is the 8 byte big-endian result of <see cref="System.DateTime.ToBinary" />
+		///     which, unlike the predefined timestamp type, preserves the <see cref="System.DateTime.Kind" />.
+		/// </summary>
+		public const sbyte DateTimeExtension = 1;
+
+		/// <summary>
+		///     The application specific extension type of a <see cref="decimal" />:
+		///     Its payload are the four big-endian integers of <see cref="decimal.GetBits" />.
+		/// </summary>
+		public const sbyte DecimalExtension = 2;
+
+		public static bool IsFixArray(byte code)
+		{
+			return code >= MinFixArray && code <= MaxFixArray;
+		}
+
+		public static bool IsFixMap(byte code)
+		{
+			return code >= MinFixMap && code <= MaxFixMap;
+		}
+
+		public static bool IsFixStr(byte code)
+		{
+			return code >= MinFixStr && code <= MaxFixStr;
+		}
+
+		public static bool IsArray(byte code)
+		{
+			return IsFixArray(code) || code == Array16 || code == Array32;
+		}
+
+		public static bool IsMap(byte code)
+		{
+			return IsFixMap(code) || code == Map16 || code == Map32;
+		}
+
+		public static bool IsStr(byte code)
+		{
+			return IsFixStr(code) || code == Str8 || code == Str16 || code == Str32;
+		}
+
+		public static bool IsBin(byte code)
+		{
+			return code == Bin8 || code == Bin16 || code == Bin32;
+		}
+
+		public static bool IsUnsignedInteger(byte code)
+		{
+			return code <= MaxPositiveFixInt || (code >= UInt8 && code <= UInt64);
+		}
+
+		public static bool IsSignedInteger(byte code)
+		{
+			return code >= MinNegativeFixInt || (code >= Int8 && code <= Int64);
+		}
+	}
+}
@@ -0,0 +1,158 @@
+﻿using System;
+using System.IO;
+using System.Reflection;
+using log4net;
+using SharpRemote.CodeGeneration.Serialization.Binary;
+
+namespace SharpRemote.CodeGeneration.Serialization.MessagePack
+{
+	/// <summary>
+	///     Writes exceptions as a plain map which can be understood by any MessagePack implementation:
+	///     <code>
+	///     {"Type": string, "Message": string|nil, "StackTrace": string|nil, "InnerException": map|nil}
+	///     </code>
+	///     where "Type" is the assembly qualified name of the exception's type and "InnerException"
+	///     is again a map of the same layout.
+	/// </summary>
+	/// <remarks>
+	///     Exceptions are restored through their (string, Exception), (string) or parameterless constructor
+	///     (see <see cref="ExceptionCompiler.GetPlainFactory" />): Any additional state of an exception is lost.
+	///     Inner exceptions which are nested deeper than <see cref="BinaryExceptionSerializer.MaxDepth" />
+	///     are omitted when writing and rejected when reading.
+	/// </remarks>
+	internal static class MessagePackExceptionSerializer
+	{
+		private static readonly ILog Log = LogManager.GetLogger(MethodBase.GetCurrentMethod().DeclaringType);
+
+		private const string TypeKey = "Type";
+		private const string MessageKey = "Message";
+		private const string StackTraceKey = "StackTrace";
+		private const string InnerExceptionKey = "InnerException";
+
+		/// <summary>
+		///     Writes the given exception to the given writer.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="exception"></param>
+		public static void Write(BinaryWriter writer, Exception exception)
+		{
+			if (writer == null)
+				throw new ArgumentNullException(nameof(writer));
+			if (exception == null)
+				throw new ArgumentNullException(nameof(exception));
+
+			Write(writer, exception, 0);
+		}
+
+		private static void Write(BinaryWriter writer, Exception exception, int depth)
+		{
+			MessagePackSerializer.WriteMapHeader(writer, 4);
+			MessagePackSerializer.WriteValue(writer, TypeKey);
+			MessagePackSerializer.WriteTypeName(writer, exception.GetType());
+			MessagePackSerializer.WriteValue(writer, MessageKey);
+			MessagePackSerializer.WriteValue(writer, exception.Message);
+			MessagePackSerializer.WriteValue(writer, StackTraceKey);
+			MessagePackSerializer.WriteValue(writer, exception.StackTrace);
+			MessagePackSerializer.WriteValue(writer, InnerExceptionKey);
+
+			var innerException = exception.InnerException;
+			if (innerException != null && depth >= BinaryExceptionSerializer.MaxDepth)
+			{
+				Log.WarnFormat("Omitting inner exception '{0}': It's nested deeper than {1} levels",
+				               innerException.GetType(),
+				               BinaryExceptionSerializer.MaxDepth);
+				innerException = null;
+			}
+
+			if (innerException != null)
+				Write(writer, innerException, depth + 1);
+			else
+				MessagePackSerializer.WriteNil(writer);
+		}
+
+		/// <summary>
+		///     Reads an exception which has been written by <see cref="Write" />.
+		///     If the exception can't be restored (because its type can't be found, for example), then
+		///     an <see cref="UnserializableException" /> is returned instead.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static Exception Read(BinaryReader reader)
+		{
+			if (reader == null)
+				throw new ArgumentNullException(nameof(reader));
+
+			return Read(reader, reader.ReadByte(), 0);
+		}
+
+		private static Exception Read(BinaryReader reader, byte code, int depth)
+		{
+			string typeName = null;
+			string message = null;
+			string stackTrace = null;
+			Exception innerException = null;
+
+			var count = MessagePackSerializer.ReadMapLength(reader, code);
+			for (int i = 0; i < count; ++i)
+			{
+				var key = MessagePackSerializer.ReadValueAsString(reader);
+				switch (key)
+				{
+					case TypeKey:
+						typeName = MessagePackSerializer.ReadValueAsString(reader);
+						break;
+
+					case MessageKey:
+						message = MessagePackSerializer.ReadValueAsString(reader);
+						break;
+
+					case StackTraceKey:
+						stackTrace = MessagePackSerializer.ReadValueAsString(reader);
+						break;
+
+					case InnerExceptionKey:
+						var innerCode = reader.ReadByte();
+						if (innerCode == MessagePackCode.Nil)
+							break;
+						if (depth >= BinaryExceptionSerializer.MaxDepth)
+							throw new SerializationException(string.Format("Inner exceptions may not be nested deeper than {0} levels",
+							                                               BinaryExceptionSerializer.MaxDepth));
+						innerException = Read(reader, innerCode, depth + 1);
+						break;
+
+					default:
+						throw new SerializationException(string.Format("Unexpected key '{0}' in the map of an exception", key));
+				}
+			}
+
+			if (typeName == null)
+				throw new SerializationException("The map of an exception is missing its type");
+
+			return CreateException(typeName, message, stackTrace, innerException);
+		}
+
+		private static Exception CreateException(string typeName, string message, string stackTrace, Exception innerException)
+		{
+			var type = TypeResolver.GetType(typeName, false);
+			if (type == null)
+				return new UnserializableException(string.Format("Unable to find the type of the exception thrown by the remote method: {0}",
+				                                                 message));
+
+			var factory = ExceptionCompiler.GetPlainFactory(type);
+			if (factory == null)
+				return new UnserializableException(string.Format("The type '{0}' is missing a (string, Exception), (string) or parameterless constructor",
+				                                                 type));
+
+			try
+			{
+				var remoteStackTrace = stackTrace != null ? stackTrace + Environment.NewLine : null;
+				return factory(message, innerException, remoteStackTrace);
+			}
+			catch (Exception e)
+			{
+				Log.ErrorFormat("Caught unexpected exception while trying to deserialize an exception of type '{0}': {1}", type, e);
+				return new UnserializableException(string.Format("Unable to deserialize an exception of type '{0}'", type), e);
+			}
+		}
+	}
+}
@@ -0,0 +1,244 @@
+using System;
+using System.IO;
+
+namespace SharpRemote.CodeGeneration.Serialization.MessagePack
+{
+	internal sealed class MessagePackMethodCallReader
+		: IMethodCallReader
+	{
+		private readonly MessagePackSerializer _serializer;
+		private readonly BinaryReader _reader;
+		private readonly ulong _grainId;
+		private readonly string _methodName;
+		private readonly ulong _rpcId;
+
+		public MessagePackMethodCallReader(MessagePackSerializer serializer, BinaryReader reader)
+		{
+			if (reader == null)
+				throw new ArgumentNullException(nameof(reader));
+
+			_serializer = serializer;
+			_reader = reader;
+			_grainId = MessagePackSerializer.ReadValueAsUInt64(_reader);
+			_methodName = MessagePackSerializer.ReadValueAsString(_reader);
+			_rpcId = MessagePackSerializer.ReadValueAsUInt64(_reader);
+		}
+
+		private bool EndOfStream => _reader.BaseStream.Position >= _reader.BaseStream.Length;
+
+		public void Dispose()
+		{
+			_reader.Dispose();
+		}
+
+		public ulong GrainId => _grainId;
+
+		public string MethodName => _methodName;
+
+		public ulong RpcId => _rpcId;
+
+		public bool ReadNextArgument(out object value)
+		{
+			if (EndOfStream)
+			{
+				value = null;
+				return false;
+			}
+
+			value = _serializer.ReadObject(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsStruct<T>(out T value) where T : struct
+		{
+			if (EndOfStream)
+			{
+				value = default(T);
+				return false;
+			}
+
+			value = _serializer.ReadValue<T>(_reader, null);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsSByte(out sbyte value)
+		{
+			if (EndOfStream)
+			{
+				value = sbyte.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsSByte(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsByte(out byte value)
+		{
+			if (EndOfStream)
+			{
+				value = byte.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsByte(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsUInt16(out ushort value)
+		{
+			if (EndOfStream)
+			{
+				value = ushort.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsUInt16(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsInt16(out short value)
+		{
+			if (EndOfStream)
+			{
+				value = short.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsInt16(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsUInt32(out uint value)
+		{
+			if (EndOfStream)
+			{
+				value = uint.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsUInt32(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsInt32(out int value)
+		{
+			if (EndOfStream)
+			{
+				value = int.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsInt32(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsUInt64(out ulong value)
+		{
+			if (EndOfStream)
+			{
+				value = ulong.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsUInt64(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsInt64(out long value)
+		{
+			if (EndOfStream)
+			{
+				value = long.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsInt64(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsSingle(out float value)
+		{
+			if (EndOfStream)
+			{
+				value = float.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsSingle(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsDouble(out double value)
+		{
+			if (EndOfStream)
+			{
+				value = double.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsDouble(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsDecimal(out decimal value)
+		{
+			if (EndOfStream)
+			{
+				value = decimal.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsDecimal(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsDateTime(out DateTime value)
+		{
+			if (EndOfStream)
+			{
+				value = DateTime.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsDateTime(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsString(out string value)
+		{
+			if (EndOfStream)
+			{
+				value = null;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsString(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsBytes(out byte[] value)
+		{
+			if (EndOfStream)
+			{
+				value = null;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsBytes(_reader);
+			return true;
+		}
+
+		public bool ReadNextArgumentAsByteSegment(out ArraySegment<byte> value)
+		{
+			if (EndOfStream)
+			{
+				value = default(ArraySegment<byte>);
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsByteSegment(_reader);
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+using System;
+using System.IO;
+using SharpRemote.CodeGeneration.Serialization.Binary;
+
+namespace SharpRemote.CodeGeneration.Serialization.MessagePack
+{
+	internal sealed class MessagePackMethodCallWriter
+		: IMethodCallWriter
+	{
+		private readonly MessagePackSerializer _serializer;
+		private readonly IRemotingEndPoint _endPoint;
+		private readonly BinaryWriter _writer;
+
+		public MessagePackMethodCallWriter(MessagePackSerializer serializer, Stream stream, ulong grainId, string methodName, ulong rpcId, IRemotingEndPoint endPoint = null)
+		{
+			_serializer = serializer;
+			_endPoint = endPoint;
+			_writer = new BinaryMessageWriter(stream);
+			MessagePackSerializer.WriteValue(_writer, (byte)MessageType2.Call);
+			MessagePackSerializer.WriteValue(_writer, grainId);
+			MessagePackSerializer.WriteValue(_writer, methodName);
+			MessagePackSerializer.WriteValue(_writer, rpcId);
+		}
+
+		public void Dispose()
+		{
+			_writer.Dispose();
+		}
+
+		public void WriteArgument(object value)
+		{
+			_serializer.WriteObject(_writer, value, _endPoint);
+		}
+
+		public void WriteArgument<T>(T value) where T : struct
+		{
+			_serializer.WriteValue(_writer, value, _endPoint);
+		}
+
+		public void WriteArgument(sbyte value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteArgument(byte value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteArgument(ushort value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteArgument(short value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteArgument(uint value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteArgument(int value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteArgument(ulong value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteArgument(long value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteArgument(float value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteArgument(double value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteArgument(decimal value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteArgument(DateTime value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteArgument(string value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteArgument(byte[] value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteArgument(ArraySegment<byte> value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+	}
+}
\ No newline at end of file
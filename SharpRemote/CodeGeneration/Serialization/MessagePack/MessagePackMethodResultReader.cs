@@ -0,0 +1,224 @@
+using System;
+using System.IO;
+
+namespace SharpRemote.CodeGeneration.Serialization.MessagePack
+{
+	internal sealed class MessagePackMethodResultReader
+		: IMethodResultReader
+	{
+		private readonly MessagePackSerializer _serializer;
+		private readonly BinaryReader _reader;
+		private readonly ulong _rpcId;
+
+		public MessagePackMethodResultReader(MessagePackSerializer serializer, BinaryReader reader)
+		{
+			if (reader == null)
+				throw new ArgumentNullException(nameof(reader));
+
+			_serializer = serializer;
+			_reader = reader;
+			_rpcId = MessagePackSerializer.ReadValueAsUInt64(_reader);
+		}
+		
+		private bool EndOfStream => _reader.BaseStream.Position >= _reader.BaseStream.Length;
+
+		public void Dispose()
+		{
+			_reader.Dispose();
+		}
+
+		public ulong RpcId => _rpcId;
+
+		public bool ReadException(out Exception exception)
+		{
+			if (EndOfStream)
+			{
+				exception = null;
+				return false;
+			}
+
+			exception = MessagePackSerializer.ReadValueAsException(_reader);
+			return true;
+		}
+
+		public bool ReadResult(out object value)
+		{
+			if (EndOfStream)
+			{
+				value = null;
+				return false;
+			}
+
+			value = _serializer.ReadObject(_reader);
+			return true;
+		}
+
+		public bool ReadResultStruct<T>(out T value) where T : struct
+		{
+			if (EndOfStream)
+			{
+				value = default(T);
+				return false;
+			}
+
+			value = _serializer.ReadValue<T>(_reader, null);
+			return true;
+		}
+
+		public bool ReadResultSByte(out sbyte value)
+		{
+			if (EndOfStream)
+			{
+				value = SByte.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsSByte(_reader);
+			return true;
+		}
+
+		public bool ReadResultByte(out byte value)
+		{
+			if (EndOfStream)
+			{
+				value = byte.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsByte(_reader);
+			return true;
+		}
+
+		public bool ReadResultUInt16(out ushort value)
+		{
+			if (EndOfStream)
+			{
+				value = ushort.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsUInt16(_reader);
+			return true;
+		}
+
+		public bool ReadResultInt16(out short value)
+		{
+			if (EndOfStream)
+			{
+				value = short.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsInt16(_reader);
+			return true;
+		}
+
+		public bool ReadResultUInt32(out uint value)
+		{
+			if (EndOfStream)
+			{
+				value = uint.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsUInt32(_reader);
+			return true;
+		}
+
+		public bool ReadResultInt32(out int value)
+		{
+			if (EndOfStream)
+			{
+				value = int.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsInt32(_reader);
+			return true;
+		}
+
+		public bool ReadResultUInt64(out ulong value)
+		{
+			if (EndOfStream)
+			{
+				value = ulong.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsUInt64(_reader);
+			return true;
+		}
+
+		public bool ReadResultInt64(out long value)
+		{
+			if (EndOfStream)
+			{
+				value = long.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsInt64(_reader);
+			return true;
+		}
+
+		public bool ReadResultSingle(out float value)
+		{
+			if (EndOfStream)
+			{
+				value = float.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsSingle(_reader);
+			return true;
+		}
+
+		public bool ReadResultDouble(out double value)
+		{
+			if (EndOfStream)
+			{
+				value = float.MinValue;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsDouble(_reader);
+			return true;
+		}
+
+		public bool ReadResultString(out string value)
+		{
+			if (EndOfStream)
+			{
+				value = null;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsString(_reader);
+			return true;
+		}
+
+		public bool ReadResultBytes(out byte[] value)
+		{
+			if (EndOfStream)
+			{
+				value = null;
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsBytes(_reader);
+			return true;
+		}
+
+		public bool ReadResultByteSegment(out ArraySegment<byte> value)
+		{
+			if (EndOfStream)
+			{
+				value = default(ArraySegment<byte>);
+				return false;
+			}
+
+			value = MessagePackSerializer.ReadValueAsByteSegment(_reader);
+			return true;
+		}
+	}
+}
\ No newline at end of file
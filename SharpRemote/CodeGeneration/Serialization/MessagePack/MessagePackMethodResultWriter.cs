@@ -0,0 +1,127 @@
+using System;
+using System.IO;
+using SharpRemote.CodeGeneration.Serialization.Binary;
+
+namespace SharpRemote.CodeGeneration.Serialization.MessagePack
+{
+	internal sealed class MessagePackMethodResultWriter
+		: IMethodResultWriter
+	{
+		private readonly MessagePackSerializer _serializer;
+		private readonly IRemotingEndPoint _endPoint;
+		private readonly BinaryWriter _writer;
+		private readonly Stream _stream;
+		private readonly long _messageTypePosition;
+
+		public MessagePackMethodResultWriter(MessagePackSerializer serializer,
+		                                     Stream stream,
+		                                     ulong rpcId,
+		                                     IRemotingEndPoint endPoint = null)
+		{
+			_serializer = serializer;
+			_endPoint = endPoint;
+			_stream = stream;
+			_messageTypePosition = stream.Position;
+			_writer = new BinaryMessageWriter(stream);
+			// The message type is a positive fixint and can therefore be patched in place by WriteException
+			MessagePackSerializer.WriteValue(_writer, (byte)MessageType2.Result);
+			MessagePackSerializer.WriteValue(_writer, rpcId);
+		}
+
+		public void Dispose()
+		{
+			_writer.Dispose();
+		}
+
+		public void WriteFinished()
+		{
+			
+		}
+
+		public void WriteResult(object value)
+		{
+			_serializer.WriteObject(_writer, value, _endPoint);
+		}
+
+		public void WriteResult<T>(T value) where T : struct
+		{
+			_serializer.WriteValue(_writer, value, _endPoint);
+		}
+
+		public void WriteResult(sbyte value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteResult(byte value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteResult(ushort value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteResult(short value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteResult(uint value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteResult(int value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteResult(ulong value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteResult(long value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteResult(float value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteResult(double value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteResult(string value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteResult(byte[] value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteResult(ArraySegment<byte> value)
+		{
+			MessagePackSerializer.WriteValue(_writer, value);
+		}
+
+		public void WriteException(Exception e)
+		{
+			_writer.Flush();
+			var previousPosition = _stream.Position;
+			_stream.Position = _messageTypePosition;
+			MessagePackSerializer.WriteValue(_writer, (byte)(MessageType2.Result | MessageType2.Exception));
+			_writer.Flush();
+			_stream.Position = previousPosition;
+			MessagePackSerializer.WriteValue(_writer, e);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+﻿using System;
+using System.IO;
+using System.Reflection.Emit;
+
+namespace SharpRemote.CodeGeneration.Serialization.MessagePack
+{
+	internal sealed class MessagePackMethodsCompiler
+		: AbstractMethodsCompiler
+	{
+		private readonly CompilationContext _context;
+
+		public MessagePackMethodsCompiler(TypeBuilder typeBuilder,
+		                                  ITypeDescription typeDescription,
+		                                  CompilationContext context,
+		                                  MessagePackWriteValueMethodCompiler writeValueMethodCompiler,
+		                                  MessagePackWriteObjectMethodCompiler writeObjectMethodCompiler,
+		                                  MessagePackReadValueMethodCompiler readValueMethodCompiler,
+		                                  MessagePackReadObjectMethodCompiler readObjectMethodCompiler)
+			: base(typeBuilder,
+			       typeDescription,
+			       writeValueMethodCompiler,
+			       writeObjectMethodCompiler,
+			       readValueMethodCompiler,
+			       readObjectMethodCompiler)
+		{
+			_context = context;
+		}
+
+		protected override Type WriterType => typeof(BinaryWriter);
+
+		protected override Type ReaderType => typeof(BinaryReader);
+
+		public Action<BinaryWriter, object, MessagePackSerializer, IRemotingEndPoint> WriteDelegate { get; private set; }
+
+		public Func<BinaryReader, MessagePackSerializer, IRemotingEndPoint, object> ReadObjectDelegate { get; private set; }
+
+		/// <summary>
+		///     An Action{BinaryWriter, T, MessagePackSerializer, IRemotingEndPoint} which writes a value of type T
+		///     without boxing it or null when T is not a value type.
+		/// </summary>
+		public Delegate WriteValueDelegate { get; private set; }
+
+		/// <summary>
+		///     A Func{BinaryReader, MessagePackSerializer, IRemotingEndPoint, T} which reads a value of type T
+		///     without boxing it or null when T is not a value type.
+		/// </summary>
+		public Delegate ReadValueDelegate { get; private set; }
+
+		public static MessagePackMethodsCompiler Create(TypeBuilder typeBuilder,
+		                                                ITypeDescription typeDescription)
+		{
+			var context = new CompilationContext
+			{
+				TypeDescription = typeDescription,
+				SerializerType = typeof(MessagePackSerializer),
+				ReaderType = typeof(BinaryReader),
+				WriterType = typeof(BinaryWriter),
+				TypeBuilder = typeBuilder
+			};
+
+			return new MessagePackMethodsCompiler(typeBuilder,
+			                                      typeDescription,
+			                                      context,
+			                                      new MessagePackWriteValueMethodCompiler(context),
+			                                      new MessagePackWriteObjectMethodCompiler(context),
+			                                      new MessagePackReadValueMethodCompiler(context),
+			                                      new MessagePackReadObjectMethodCompiler(context));
+		}
+
+		public void Compile(ISerializationMethodStorage<MessagePackMethodsCompiler> storage)
+		{
+			base.Compile(storage);
+
+			WriteDelegate =
+				(Action<BinaryWriter, object, MessagePackSerializer, IRemotingEndPoint>)
+				_context.TypeBuilder.GetMethod("WriteObjectNotNull")
+				        .CreateDelegate(typeof(Action<BinaryWriter, object, MessagePackSerializer, IRemotingEndPoint>));
+
+			ReadObjectDelegate =
+				(Func<BinaryReader, MessagePackSerializer, IRemotingEndPoint, object>)
+				_context.TypeBuilder.GetMethod("ReadObjectNotNull")
+				        .CreateDelegate(typeof(Func<BinaryReader, MessagePackSerializer, IRemotingEndPoint, object>));
+
+			var type = _context.Type;
+			if (type.IsValueType)
+			{
+				WriteValueDelegate =
+					_context.TypeBuilder.GetMethod("WriteValueNotNull")
+					        .CreateDelegate(typeof(Action<,,,>).MakeGenericType(typeof(BinaryWriter), type, typeof(MessagePackSerializer), typeof(IRemotingEndPoint)));
+
+				ReadValueDelegate =
+					_context.TypeBuilder.GetMethod("ReadValueNotNull")
+					        .CreateDelegate(typeof(Func<,,,>).MakeGenericType(typeof(BinaryReader), typeof(MessagePackSerializer), typeof(IRemotingEndPoint), type));
+			}
+		}
+	}
+}
\ No newline at end of file
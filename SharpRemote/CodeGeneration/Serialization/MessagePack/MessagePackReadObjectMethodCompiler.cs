@@ -0,0 +1,10 @@
+﻿namespace SharpRemote.CodeGeneration.Serialization.MessagePack
+{
+	internal sealed class MessagePackReadObjectMethodCompiler
+		: AbstractReadObjectMethodCompiler
+	{
+		public MessagePackReadObjectMethodCompiler(CompilationContext context) : base(context)
+		{
+		}
+	}
+}
\ No newline at end of file
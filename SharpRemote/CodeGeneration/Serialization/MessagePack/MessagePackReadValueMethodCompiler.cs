@@ -0,0 +1,258 @@
+﻿using System;
+using System.IO;
+using System.Reflection;
+using System.Reflection.Emit;
+
+namespace SharpRemote.CodeGeneration.Serialization.MessagePack
+{
+	internal sealed class MessagePackReadValueMethodCompiler
+		: AbstractReadValueMethodCompiler
+	{
+		private static readonly MethodInfo MessagePackSerializerReadObject;
+		private static readonly MethodInfo MessagePackSerializerReadArrayHeader;
+		private static readonly MethodInfo MessagePackSerializerReadHint;
+		private static readonly MethodInfo MessagePackSerializerReadByte;
+		private static readonly MethodInfo MessagePackSerializerReadSByte;
+		private static readonly MethodInfo MessagePackSerializerReadDecimal;
+		private static readonly MethodInfo MessagePackSerializerReadInt16;
+		private static readonly MethodInfo MessagePackSerializerReadUInt16;
+		private static readonly MethodInfo MessagePackSerializerReadInt32;
+		private static readonly MethodInfo MessagePackSerializerReadUInt32;
+		private static readonly MethodInfo MessagePackSerializerReadInt64;
+		private static readonly MethodInfo MessagePackSerializerReadUInt64;
+		private static readonly MethodInfo MessagePackSerializerReadString;
+		private static readonly MethodInfo MessagePackSerializerReadDateTime;
+		private static readonly MethodInfo MessagePackSerializerReadFloat;
+		private static readonly MethodInfo MessagePackSerializerReadDouble;
+		private static readonly MethodInfo MessagePackSerializerReadException;
+
+		private readonly CompilationContext _context;
+
+		static MessagePackReadValueMethodCompiler()
+		{
+			MessagePackSerializerReadObject = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadObject));
+			MessagePackSerializerReadArrayHeader = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadArrayHeader), new[] {typeof(BinaryReader), typeof(int)});
+			MessagePackSerializerReadHint = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadHint));
+			MessagePackSerializerReadByte = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadValueAsByte));
+			MessagePackSerializerReadSByte = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadValueAsSByte));
+			MessagePackSerializerReadInt16 = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadValueAsInt16));
+			MessagePackSerializerReadUInt16 = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadValueAsUInt16));
+			MessagePackSerializerReadInt32 = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadValueAsInt32));
+			MessagePackSerializerReadUInt32 = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadValueAsUInt32));
+			MessagePackSerializerReadInt64 = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadValueAsInt64));
+			MessagePackSerializerReadUInt64 = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadValueAsUInt64));
+			MessagePackSerializerReadString = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadValueAsString));
+			MessagePackSerializerReadDateTime = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadValueAsDateTime));
+			MessagePackSerializerReadFloat = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadValueAsSingle));
+			MessagePackSerializerReadDouble = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadValueAsDouble));
+			MessagePackSerializerReadDecimal = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadValueAsDecimal));
+			MessagePackSerializerReadException = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.ReadValueAsException));
+		}
+
+		public MessagePackReadValueMethodCompiler(CompilationContext context)
+			: base(context)
+		{
+			_context = context;
+		}
+
+		protected override void EmitBeginRead(ILGenerator gen)
+		{
+			// MessagePackSerializer.ReadArrayHeader(reader, <number of members>)
+			var typeDescription = _context.TypeDescription;
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Ldc_I4, typeDescription.Fields.Count + typeDescription.Properties.Count);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadArrayHeader);
+		}
+
+		protected override void EmitDynamicDispatchReadObject(ILGenerator gen)
+		{
+			gen.Emit(OpCodes.Ldarg_1);
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadObject);
+		}
+
+		protected override void EmitBeginReadField(ILGenerator gen, IFieldDescription field)
+		{
+		}
+
+		protected override void EmitEndReadField(ILGenerator gen, IFieldDescription field)
+		{
+		}
+
+		protected override void EmitBeginReadProperty(ILGenerator gen, IPropertyDescription property)
+		{
+		}
+		
+		protected override void EmitEndReadProperty(ILGenerator gen, IPropertyDescription property)
+		{
+		}
+
+		protected override void EmitEndRead(ILGenerator gen)
+		{
+		}
+
+		protected override void EmitReadEnum(ILGenerator gen, ITypeDescription typeDescription)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+
+			var storageType = typeDescription.StorageType.Type;
+			if (storageType == typeof(byte))
+			{
+				gen.Emit(OpCodes.Call, MessagePackSerializerReadByte);
+			}
+			else if (storageType == typeof(sbyte))
+			{
+				gen.Emit(OpCodes.Call, MessagePackSerializerReadSByte);
+			}
+			else if (storageType == typeof(short))
+			{
+				gen.Emit(OpCodes.Call, MessagePackSerializerReadInt16);
+			}
+			else if (storageType == typeof(ushort))
+			{
+				gen.Emit(OpCodes.Call, MessagePackSerializerReadUInt16);
+			}
+			else if (storageType == typeof(int))
+			{
+				gen.Emit(OpCodes.Call, MessagePackSerializerReadInt32);
+			}
+			else if (storageType == typeof(uint))
+			{
+				gen.Emit(OpCodes.Call, MessagePackSerializerReadUInt32);
+			}
+			else if (storageType == typeof(long))
+			{
+				gen.Emit(OpCodes.Call, MessagePackSerializerReadInt64);
+			}
+			else if (storageType == typeof(ulong))
+			{
+				gen.Emit(OpCodes.Call, MessagePackSerializerReadUInt64);
+			}
+			else
+			{
+				throw new NotImplementedException();
+			}
+		}
+
+		protected override void EmitReadByte(ILGenerator gen)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadByte);
+		}
+
+		protected override void EmitReadSByte(ILGenerator gen)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadSByte);
+		}
+
+		protected override void EmitReadUInt16(ILGenerator gen)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadUInt16);
+		}
+
+		protected override void EmitReadInt16(ILGenerator gen)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadInt16);
+		}
+
+		protected override void EmitReadUInt32(ILGenerator gen)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadUInt32);
+		}
+
+		protected override void EmitReadInt32(ILGenerator gen)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadInt32);
+		}
+
+		protected override void EmitReadUInt64(ILGenerator gen)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadUInt64);
+		}
+
+		protected override void EmitReadInt64(ILGenerator gen)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadInt64);
+		}
+
+		protected override void EmitReadDecimal(ILGenerator gen)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadDecimal);
+		}
+
+		protected override void EmitReadFloat(ILGenerator gen)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadFloat);
+		}
+
+		protected override void EmitReadDouble(ILGenerator gen)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadDouble);
+		}
+
+		protected override void EmitReadString(ILGenerator gen)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadString);
+		}
+
+		protected override void EmitReadDateTime(ILGenerator gen)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadDateTime);
+		}
+
+		protected override void EmitReadLevel(ILGenerator gen)
+		{
+			var end = gen.DefineLabel();
+
+			var value = gen.DeclareLocal(typeof(byte));
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadByte);
+			gen.Emit(OpCodes.Stloc, value);
+
+			for (int i = 0; i < HardcodedLevels.Count; ++i)
+			{
+				var next = gen.DefineLabel();
+
+				gen.Emit(OpCodes.Ldloc, value);
+				gen.Emit(OpCodes.Ldc_I4, i);
+				gen.Emit(OpCodes.Bne_Un, next);
+
+				gen.Emit(OpCodes.Ldsfld, HardcodedLevels[i].Field);
+				gen.Emit(OpCodes.Br, end);
+
+				gen.MarkLabel(next);
+			}
+
+			gen.Emit(OpCodes.Newobj, Methods.NotImplementedCtor);
+			gen.Emit(OpCodes.Throw);
+
+			gen.MarkLabel(end);
+		}
+
+		protected override void EmitReadException(ILGenerator gen, Type exceptionType)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Call, MessagePackSerializerReadException);
+		}
+
+		protected override void EmitReadHintAndGrainId(ILGenerator generator)
+		{
+			generator.Emit(OpCodes.Ldarg_0);
+			generator.Emit(OpCodes.Call, MessagePackSerializerReadHint);
+			generator.Emit(OpCodes.Ldarg_0);
+			generator.Emit(OpCodes.Call, MessagePackSerializerReadUInt64);
+		}
+	}
+}
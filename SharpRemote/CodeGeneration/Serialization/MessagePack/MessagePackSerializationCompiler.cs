@@ -0,0 +1,27 @@
+﻿using System.Reflection;
+using System.Reflection.Emit;
+
+namespace SharpRemote.CodeGeneration.Serialization.MessagePack
+{
+	internal sealed class MessagePackSerializationCompiler
+		: ISerializationMethodCompiler<MessagePackMethodsCompiler>
+	{
+		private readonly ModuleBuilder _module;
+
+		public MessagePackSerializationCompiler(ModuleBuilder moduleBuilder)
+		{
+			_module = moduleBuilder;
+		}
+
+		public MessagePackMethodsCompiler Prepare(string typeName, ITypeDescription typeDescription)
+		{
+			TypeBuilder typeBuilder = _module.DefineType(typeName, TypeAttributes.Public | TypeAttributes.Class);
+			return MessagePackMethodsCompiler.Create(typeBuilder, typeDescription);
+		}
+
+		public void Compile(MessagePackMethodsCompiler methods, ISerializationMethodStorage<MessagePackMethodsCompiler> storage)
+		{
+			methods.Compile(storage);
+		}
+	}
+}
@@ -0,0 +1,1193 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.ComponentModel;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Reflection.Emit;
+using System.Runtime.InteropServices;
+using System.Runtime.Serialization;
+using System.Text;
+using log4net;
+using SharpRemote.CodeGeneration.Serialization;
+using SharpRemote.CodeGeneration.Serialization.Binary;
+using SharpRemote.CodeGeneration.Serialization.MessagePack;
+
+// ReSharper disable once CheckNamespace
+namespace SharpRemote
+{
+	/// <summary>
+	///     An <see cref="ISerializer2" /> implementation which produces MessagePack
+	///     (https://github.com/msgpack/msgpack/blob/master/spec.md) and can thus be read by other languages, too.
+	/// </summary>
+	/// <remarks>
+	///     A message is a sequence of MessagePack objects: The message type, followed by the grain id,
+	///     method name and rpc id for calls (or the rpc id for results) and then one object per value.
+	///     Members of a type are written as an array, in the order of their declaration, and values whose type
+	///     isn't known statically are written as an array of their type and the value itself: The first occurrence of a type
+	///     within a message is written as its assembly qualified name, every further occurrence as a positive integer which
+	///     refers to the n-th type name of that message (starting at 1).
+	///     <see cref="DateTime" /> and <see cref="decimal" /> are written as application specific extension types
+	///     (see <see cref="MessagePackCode.DateTimeExtension" /> and <see cref="MessagePackCode.DecimalExtension" />).
+	///     Neither reference preservation (<see cref="DataContractAttribute.IsReference" />) nor
+	///     <see cref="DeltaEncodedAttribute" /> are supported: Such values are always written in full.
+	/// </remarks>
+	public sealed class MessagePackSerializer
+		: ISerializer2
+	{
+		private static readonly ILog Log = LogManager.GetLogger(MethodBase.GetCurrentMethod().DeclaringType);
+		private static readonly ConcurrentDictionary<Type, byte[]> TypeNames = new ConcurrentDictionary<Type, byte[]>();
+		private static readonly Func<Type, byte[]> EncodeTypeName = type => Encode(type.AssemblyQualifiedName);
+
+		private readonly SerializationMethodStorage<MessagePackMethodsCompiler> _methodStorage;
+		private readonly MessagePackSerializationCompiler _methodCompiler;
+		private readonly ITypeResolver _typeResolver;
+		private readonly ConcurrentDictionary<string, Type> _typesByName;
+
+		/// <summary>
+		/// </summary>
+		public MessagePackSerializer(ITypeResolver typeResolver = null)
+			: this(CreateModule(), typeResolver)
+		{
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="moduleBuilder"></param>
+		/// <param name="typeResolver"></param>
+		public MessagePackSerializer(ModuleBuilder moduleBuilder, ITypeResolver typeResolver = null)
+		{
+			_methodCompiler = new MessagePackSerializationCompiler(moduleBuilder);
+			_methodStorage = new SerializationMethodStorage<MessagePackMethodsCompiler>("MessagePackSerializer", _methodCompiler);
+			_typeResolver = typeResolver;
+			_typesByName = new ConcurrentDictionary<string, Type>();
+		}
+
+		/// <inheritdoc />
+		public void RegisterType<T>()
+		{
+			RegisterType(typeof(T));
+		}
+
+		/// <inheritdoc />
+		public void RegisterType(Type type)
+		{
+			Log.DebugFormat("Registering type '{0}'", type);
+			_methodStorage.GetOrAdd(type);
+			Log.DebugFormat("Type '{0}' successfully registered", type);
+		}
+
+		/// <inheritdoc />
+		public IReadOnlyList<PreparedType> RegisterTypes(IEnumerable<Type> types)
+		{
+			if (types == null)
+				throw new ArgumentNullException(nameof(types));
+
+			return types.Select(x => PreparedType.Prepare(x, RegisterType)).ToList();
+		}
+
+		/// <inheritdoc />
+		public bool IsTypeRegistered<T>()
+		{
+			return IsTypeRegistered(typeof(T));
+		}
+
+		/// <inheritdoc />
+		public bool IsTypeRegistered(Type type)
+		{
+			return _methodStorage.Contains(type);
+		}
+
+		/// <inheritdoc />
+		public IMethodCallWriter CreateMethodCallWriter(Stream stream, ulong rpcId, ulong grainId, string methodName, IRemotingEndPoint endPoint = null)
+		{
+			return new MessagePackMethodCallWriter(this, stream, grainId, methodName, rpcId, endPoint);
+		}
+
+		/// <inheritdoc />
+		public IMethodResultWriter CreateMethodResultWriter(Stream stream, ulong rpcId, IRemotingEndPoint endPoint = null)
+		{
+			return new MessagePackMethodResultWriter(this, stream, rpcId, endPoint);
+		}
+
+		/// <inheritdoc />
+		public void CreateMethodReader(Stream stream,
+		                               out IMethodCallReader callReader,
+		                               out IMethodResultReader resultReader,
+		                               IRemotingEndPoint endPoint = null)
+		{
+			var reader = new BinaryMessageReader(stream);
+			var type = (MessageType2) ReadValueAsByte(reader);
+			if (type == MessageType2.Call)
+			{
+				callReader = new MessagePackMethodCallReader(this, reader);
+				resultReader = null;
+			}
+			else if ((type & MessageType2.Result) == MessageType2.Result)
+			{
+				callReader = null;
+				resultReader = new MessagePackMethodResultReader(this, reader);
+			}
+			else
+			{
+				throw new InvalidEnumArgumentException("type", (int) type, typeof(MessageType2));
+			}
+		}
+
+		#region Write Methods
+
+		/// <summary>
+		///     Writes the given value, preceded by its type, or nil if the value is null.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		/// <param name="endPoint"></param>
+		public void WriteObject(BinaryWriter writer, object value, IRemotingEndPoint endPoint)
+		{
+			if (value != null)
+			{
+				WriteObjectNotNull(writer, value, endPoint);
+			}
+			else
+			{
+				WriteNil(writer);
+			}
+		}
+
+		/// <summary>
+		///     Writes the given value as an array of its type and the value itself.
+		///     Singletons are written as an array which only contains their type.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		/// <param name="endPoint"></param>
+		public void WriteObjectNotNull(BinaryWriter writer, object value, IRemotingEndPoint endPoint)
+		{
+			var type = value.GetType();
+			var methods = _methodStorage.GetOrAdd(type);
+			var isSingleton = methods.TypeDescription.SerializationType == SerializationType.Singleton;
+			WriteArrayHeader(writer, isSingleton ? 1 : 2);
+			WriteTypeInformation(writer, type);
+			methods.WriteDelegate(writer, value, this, endPoint);
+		}
+
+		/// <summary>
+		///     Writes the given value, preceded by its type, without boxing it.
+		/// </summary>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		/// <param name="endPoint"></param>
+		public void WriteValue<T>(BinaryWriter writer, T value, IRemotingEndPoint endPoint) where T : struct
+		{
+			var methods = _methodStorage.GetOrAdd(typeof(T));
+			var writeValue = methods.WriteValueDelegate as Action<BinaryWriter, T, MessagePackSerializer, IRemotingEndPoint>;
+			if (writeValue == null)
+			{
+				WriteObject(writer, value, endPoint);
+				return;
+			}
+
+			WriteArrayHeader(writer, 2);
+			WriteTypeInformation(writer, typeof(T));
+			writeValue(writer, value, this, endPoint);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		public static void WriteNil(BinaryWriter writer)
+		{
+			writer.Write(MessagePackCode.Nil);
+		}
+
+		/// <summary>
+		///     Writes the header of an array with the given amount of elements.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="count"></param>
+		public static void WriteArrayHeader(BinaryWriter writer, int count)
+		{
+			if (count <= 15)
+			{
+				writer.Write((byte) (MessagePackCode.MinFixArray | count));
+			}
+			else if (count <= ushort.MaxValue)
+			{
+				writer.Write(MessagePackCode.Array16);
+				WriteBigEndian(writer, (ushort) count);
+			}
+			else
+			{
+				writer.Write(MessagePackCode.Array32);
+				WriteBigEndian(writer, (uint) count);
+			}
+		}
+
+		/// <summary>
+		///     Writes the header of a map with the given amount of key/value pairs.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="count"></param>
+		public static void WriteMapHeader(BinaryWriter writer, int count)
+		{
+			if (count <= 15)
+			{
+				writer.Write((byte) (MessagePackCode.MinFixMap | count));
+			}
+			else if (count <= ushort.MaxValue)
+			{
+				writer.Write(MessagePackCode.Map16);
+				WriteBigEndian(writer, (ushort) count);
+			}
+			else
+			{
+				writer.Write(MessagePackCode.Map32);
+				WriteBigEndian(writer, (uint) count);
+			}
+		}
+
+		/// <summary>
+		///     Writes the <see cref="ByReferenceHint" /> of a by-reference value, which is followed by its grain id.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="hint"></param>
+		public static void WriteHint(BinaryWriter writer, byte hint)
+		{
+			WriteArrayHeader(writer, 2);
+			WriteValue(writer, hint);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, bool value)
+		{
+			writer.Write(value ? MessagePackCode.True : MessagePackCode.False);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, sbyte value)
+		{
+			WriteValue(writer, (long) value);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, byte value)
+		{
+			WriteValue(writer, (ulong) value);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, ushort value)
+		{
+			WriteValue(writer, (ulong) value);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, short value)
+		{
+			WriteValue(writer, (long) value);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, uint value)
+		{
+			WriteValue(writer, (ulong) value);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, int value)
+		{
+			WriteValue(writer, (long) value);
+		}
+
+		/// <summary>
+		///     Writes the given value in the smallest integer format it fits in.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, ulong value)
+		{
+			if (value <= MessagePackCode.MaxPositiveFixInt)
+			{
+				writer.Write((byte) value);
+			}
+			else if (value <= byte.MaxValue)
+			{
+				writer.Write(MessagePackCode.UInt8);
+				writer.Write((byte) value);
+			}
+			else if (value <= ushort.MaxValue)
+			{
+				writer.Write(MessagePackCode.UInt16);
+				WriteBigEndian(writer, (ushort) value);
+			}
+			else if (value <= uint.MaxValue)
+			{
+				writer.Write(MessagePackCode.UInt32);
+				WriteBigEndian(writer, (uint) value);
+			}
+			else
+			{
+				writer.Write(MessagePackCode.UInt64);
+				WriteBigEndian(writer, value);
+			}
+		}
+
+		/// <summary>
+		///     Writes the given value in the smallest integer format it fits in.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, long value)
+		{
+			if (value >= 0)
+			{
+				WriteValue(writer, (ulong) value);
+			}
+			else if (value >= -32)
+			{
+				writer.Write((byte) value);
+			}
+			else if (value >= sbyte.MinValue)
+			{
+				writer.Write(MessagePackCode.Int8);
+				writer.Write((sbyte) value);
+			}
+			else if (value >= short.MinValue)
+			{
+				writer.Write(MessagePackCode.Int16);
+				WriteBigEndian(writer, (ushort) value);
+			}
+			else if (value >= int.MinValue)
+			{
+				writer.Write(MessagePackCode.Int32);
+				WriteBigEndian(writer, (uint) value);
+			}
+			else
+			{
+				writer.Write(MessagePackCode.Int64);
+				WriteBigEndian(writer, (ulong) value);
+			}
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, float value)
+		{
+			writer.Write(MessagePackCode.Float32);
+			WriteBigEndian(writer, new SingleBits {Single = value}.UInt32);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, double value)
+		{
+			writer.Write(MessagePackCode.Float64);
+			WriteBigEndian(writer, (ulong) BitConverter.DoubleToInt64Bits(value));
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, decimal value)
+		{
+			writer.Write(MessagePackCode.FixExt16);
+			writer.Write(MessagePackCode.DecimalExtension);
+			var bits = decimal.GetBits(value);
+			for (int i = 0; i < bits.Length; ++i)
+				WriteBigEndian(writer, (uint) bits[i]);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, DateTime value)
+		{
+			writer.Write(MessagePackCode.FixExt8);
+			writer.Write(MessagePackCode.DateTimeExtension);
+			WriteBigEndian(writer, (ulong) value.ToBinary());
+		}
+
+		/// <summary>
+		///     Writes the given string as UTF-8 or nil if it is null.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, string value)
+		{
+			if (value == null)
+			{
+				WriteNil(writer);
+				return;
+			}
+
+			var bytes = Encoding.UTF8.GetBytes(value);
+			WriteStringHeader(writer, bytes.Length);
+			writer.Write(bytes);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, byte[] value)
+		{
+			if (value == null)
+			{
+				WriteNil(writer);
+				return;
+			}
+
+			WriteBinaryHeader(writer, value.Length);
+			writer.Write(value);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(BinaryWriter writer, ArraySegment<byte> value)
+		{
+			if (value.Array == null)
+			{
+				WriteNil(writer);
+				return;
+			}
+
+			WriteBinaryHeader(writer, value.Count);
+			writer.Write(value.Array, value.Offset, value.Count);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="exception"></param>
+		public static void WriteValue(BinaryWriter writer, Exception exception)
+		{
+			MessagePackExceptionSerializer.Write(writer, exception);
+		}
+
+		private static void WriteStringHeader(BinaryWriter writer, int length)
+		{
+			if (length <= 31)
+			{
+				writer.Write((byte) (MessagePackCode.MinFixStr | length));
+			}
+			else if (length <= byte.MaxValue)
+			{
+				writer.Write(MessagePackCode.Str8);
+				writer.Write((byte) length);
+			}
+			else if (length <= ushort.MaxValue)
+			{
+				writer.Write(MessagePackCode.Str16);
+				WriteBigEndian(writer, (ushort) length);
+			}
+			else
+			{
+				writer.Write(MessagePackCode.Str32);
+				WriteBigEndian(writer, (uint) length);
+			}
+		}
+
+		private static void WriteBinaryHeader(BinaryWriter writer, int length)
+		{
+			if (length <= byte.MaxValue)
+			{
+				writer.Write(MessagePackCode.Bin8);
+				writer.Write((byte) length);
+			}
+			else if (length <= ushort.MaxValue)
+			{
+				writer.Write(MessagePackCode.Bin16);
+				WriteBigEndian(writer, (ushort) length);
+			}
+			else
+			{
+				writer.Write(MessagePackCode.Bin32);
+				WriteBigEndian(writer, (uint) length);
+			}
+		}
+
+		private static void WriteBigEndian(BinaryWriter writer, ushort value)
+		{
+			writer.Write((ushort) ((value << 8) | (value >> 8)));
+		}
+
+		private static void WriteBigEndian(BinaryWriter writer, uint value)
+		{
+			writer.Write(ReverseBytes(value));
+		}
+
+		private static void WriteBigEndian(BinaryWriter writer, ulong value)
+		{
+			writer.Write(((ulong) ReverseBytes((uint) value) << 32) | ReverseBytes((uint) (value >> 32)));
+		}
+
+		private static uint ReverseBytes(uint value)
+		{
+			return (value << 24) | ((value & 0xff00) << 8) | ((value >> 8) & 0xff00) | (value >> 24);
+		}
+
+		/// <summary>
+		///     Writes either the id of the given type (if it has already been written as part of the current message)
+		///     or its assembly qualified name.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="type"></param>
+		internal static void WriteTypeInformation(BinaryWriter writer, Type type)
+		{
+			var messageWriter = writer as BinaryMessageWriter;
+			if (messageWriter == null)
+			{
+				WriteTypeName(writer, type);
+				return;
+			}
+
+			int id;
+			if (messageWriter.TryGetTypeId(type, out id))
+			{
+				WriteValue(writer, id);
+			}
+			else
+			{
+				WriteTypeName(writer, type);
+				messageWriter.AddType(type);
+			}
+		}
+
+		/// <summary>
+		///     Writes the assembly qualified name of the given type.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="type"></param>
+		internal static void WriteTypeName(BinaryWriter writer, Type type)
+		{
+			// The name of a type never changes and hence it's encoded only once
+			writer.Write(TypeNames.GetOrAdd(type, EncodeTypeName));
+		}
+
+		private static byte[] Encode(string value)
+		{
+			using (var stream = new MemoryStream())
+			using (var writer = new BinaryWriter(stream))
+			{
+				WriteValue(writer, value);
+				writer.Flush();
+				return stream.ToArray();
+			}
+		}
+
+		#endregion
+
+		#region Read Methods
+
+		/// <summary>
+		///     Reads the header of an array and returns its amount of elements.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static int ReadArrayHeader(BinaryReader reader)
+		{
+			return ReadArrayLength(reader, reader.ReadByte());
+		}
+
+		/// <summary>
+		///     Reads the header of an array and throws if it doesn't have the given amount of elements.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <param name="count"></param>
+		/// <exception cref="SerializationException"></exception>
+		public static void ReadArrayHeader(BinaryReader reader, int count)
+		{
+			var actualCount = ReadArrayHeader(reader);
+			if (actualCount != count)
+				throw new SerializationException(string.Format("Expected an array of {0} elements but found {1}", count, actualCount));
+		}
+
+		/// <summary>
+		///     Reads the header of a map and returns its amount of key/value pairs.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static int ReadMapHeader(BinaryReader reader)
+		{
+			return ReadMapLength(reader, reader.ReadByte());
+		}
+
+		/// <summary>
+		///     Reads a hint which has been written by <see cref="WriteHint" />.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static byte ReadHint(BinaryReader reader)
+		{
+			ReadArrayHeader(reader, 2);
+			return ReadValueAsByte(reader);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static bool ReadValueAsBoolean(BinaryReader reader)
+		{
+			var code = reader.ReadByte();
+			switch (code)
+			{
+				case MessagePackCode.True:
+					return true;
+				case MessagePackCode.False:
+					return false;
+				default:
+					throw UnexpectedCode(code, "a boolean");
+			}
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static byte ReadValueAsByte(BinaryReader reader)
+		{
+			var value = ReadUInt64(reader, reader.ReadByte());
+			if (value > byte.MaxValue)
+				throw OutOfRange(value, typeof(byte));
+			return (byte) value;
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static sbyte ReadValueAsSByte(BinaryReader reader)
+		{
+			var value = ReadInt64(reader, reader.ReadByte());
+			if (value < sbyte.MinValue || value > sbyte.MaxValue)
+				throw OutOfRange(value, typeof(sbyte));
+			return (sbyte) value;
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static ushort ReadValueAsUInt16(BinaryReader reader)
+		{
+			var value = ReadUInt64(reader, reader.ReadByte());
+			if (value > ushort.MaxValue)
+				throw OutOfRange(value, typeof(ushort));
+			return (ushort) value;
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static short ReadValueAsInt16(BinaryReader reader)
+		{
+			var value = ReadInt64(reader, reader.ReadByte());
+			if (value < short.MinValue || value > short.MaxValue)
+				throw OutOfRange(value, typeof(short));
+			return (short) value;
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static uint ReadValueAsUInt32(BinaryReader reader)
+		{
+			var value = ReadUInt64(reader, reader.ReadByte());
+			if (value > uint.MaxValue)
+				throw OutOfRange(value, typeof(uint));
+			return (uint) value;
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static int ReadValueAsInt32(BinaryReader reader)
+		{
+			var value = ReadInt64(reader, reader.ReadByte());
+			if (value < int.MinValue || value > int.MaxValue)
+				throw OutOfRange(value, typeof(int));
+			return (int) value;
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static ulong ReadValueAsUInt64(BinaryReader reader)
+		{
+			return ReadUInt64(reader, reader.ReadByte());
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static long ReadValueAsInt64(BinaryReader reader)
+		{
+			return ReadInt64(reader, reader.ReadByte());
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static float ReadValueAsSingle(BinaryReader reader)
+		{
+			var code = reader.ReadByte();
+			if (code == MessagePackCode.Float64)
+				return (float) ReadDouble(reader);
+			if (code != MessagePackCode.Float32)
+				throw UnexpectedCode(code, "a float");
+
+			return ReadSingle(reader);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static double ReadValueAsDouble(BinaryReader reader)
+		{
+			var code = reader.ReadByte();
+			if (code == MessagePackCode.Float32)
+				return ReadSingle(reader);
+			if (code != MessagePackCode.Float64)
+				throw UnexpectedCode(code, "a float");
+
+			return ReadDouble(reader);
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static decimal ReadValueAsDecimal(BinaryReader reader)
+		{
+			return ReadDecimal(reader, reader.ReadByte());
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static DateTime ReadValueAsDateTime(BinaryReader reader)
+		{
+			return ReadDateTime(reader, reader.ReadByte());
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static string ReadValueAsString(BinaryReader reader)
+		{
+			return ReadString(reader, reader.ReadByte());
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static byte[] ReadValueAsBytes(BinaryReader reader)
+		{
+			return ReadBytes(reader, reader.ReadByte());
+		}
+
+		/// <summary>
+		///     Reads a binary value without copying it, if possible
+		///     (see <see cref="BinaryMessageReader.ReadByteSegment(BinaryReader, int)" />).
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static ArraySegment<byte> ReadValueAsByteSegment(BinaryReader reader)
+		{
+			var code = reader.ReadByte();
+			if (code == MessagePackCode.Nil)
+				return default(ArraySegment<byte>);
+
+			return BinaryMessageReader.ReadByteSegment(reader, ReadBinaryLength(reader, code));
+		}
+
+		/// <summary>
+		/// 
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public static Exception ReadValueAsException(BinaryReader reader)
+		{
+			return MessagePackExceptionSerializer.Read(reader);
+		}
+
+		/// <summary>
+		///     Reads a value which has been written by <see cref="WriteObject" />.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		public object ReadObject(BinaryReader reader)
+		{
+			var code = reader.ReadByte();
+			if (code == MessagePackCode.Nil)
+				return null;
+
+			var methods = ReadTypeInformation(reader, code);
+			return methods.ReadObjectDelegate(reader, this, null);
+		}
+
+		/// <summary>
+		///     Reads a value which has been written by <see cref="WriteValue{T}" />.
+		/// </summary>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="reader"></param>
+		/// <param name="endPoint"></param>
+		/// <returns></returns>
+		public T ReadValue<T>(BinaryReader reader, IRemotingEndPoint endPoint) where T : struct
+		{
+			var code = reader.ReadByte();
+			if (code == MessagePackCode.Nil)
+				throw new SerializationException(string.Format("Expected a value of type '{0}' but found null", typeof(T)));
+
+			var methods = ReadTypeInformation(reader, code);
+			var readValue = methods.ReadValueDelegate as Func<BinaryReader, MessagePackSerializer, IRemotingEndPoint, T>;
+			if (readValue == null)
+				return (T) methods.ReadObjectDelegate(reader, this, endPoint);
+
+			return readValue(reader, this, endPoint);
+		}
+
+		private MessagePackMethodsCompiler ReadTypeInformation(BinaryReader reader, byte code)
+		{
+			var count = ReadArrayLength(reader, code);
+			if (count != 1 && count != 2)
+				throw new SerializationException(string.Format("Expected an array of a type and its value but found {0} elements", count));
+
+			return _methodStorage.GetOrAdd(ReadTypeInformation(reader));
+		}
+
+		/// <summary>
+		///     Reads type information which has been written by <see cref="WriteTypeInformation" />.
+		/// </summary>
+		/// <param name="reader"></param>
+		/// <returns></returns>
+		private Type ReadTypeInformation(BinaryReader reader)
+		{
+			var messageReader = reader as BinaryMessageReader;
+			var code = reader.ReadByte();
+			if (MessagePackCode.IsUnsignedInteger(code))
+			{
+				var id = ReadUInt64(reader, code);
+				if (messageReader == null)
+					throw new SerializationException(
+						string.Format("The message refers to type #{0}, but type ids can only be resolved by a {1}",
+						              id,
+						              typeof(BinaryMessageReader).Name));
+
+				return messageReader.GetTypeById((int) Math.Min(id, int.MaxValue));
+			}
+
+			var typeName = ReadString(reader, code);
+			var type = ResolveType(typeName);
+			if (type == null)
+				throw new SerializationException(string.Format("Unable to resolve type '{0}'", typeName));
+
+			messageReader?.AddType(type);
+			return type;
+		}
+
+		internal static int ReadArrayLength(BinaryReader reader, byte code)
+		{
+			if (MessagePackCode.IsFixArray(code))
+				return code & 0x0f;
+			if (code == MessagePackCode.Array16)
+				return ReadBigEndianUInt16(reader);
+			if (code == MessagePackCode.Array32)
+				return ToLength(ReadBigEndianUInt32(reader));
+			throw UnexpectedCode(code, "an array");
+		}
+
+		internal static int ReadMapLength(BinaryReader reader, byte code)
+		{
+			if (MessagePackCode.IsFixMap(code))
+				return code & 0x0f;
+			if (code == MessagePackCode.Map16)
+				return ReadBigEndianUInt16(reader);
+			if (code == MessagePackCode.Map32)
+				return ToLength(ReadBigEndianUInt32(reader));
+			throw UnexpectedCode(code, "a map");
+		}
+
+		internal static ulong ReadUInt64(BinaryReader reader, byte code)
+		{
+			if (code <= MessagePackCode.MaxPositiveFixInt)
+				return code;
+
+			switch (code)
+			{
+				case MessagePackCode.UInt8:
+					return reader.ReadByte();
+				case MessagePackCode.UInt16:
+					return ReadBigEndianUInt16(reader);
+				case MessagePackCode.UInt32:
+					return ReadBigEndianUInt32(reader);
+				case MessagePackCode.UInt64:
+					return ReadBigEndianUInt64(reader);
+				default:
+					var value = ReadInt64(reader, code);
+					if (value < 0)
+						throw OutOfRange(value, typeof(ulong));
+					return (ulong) value;
+			}
+		}
+
+		internal static long ReadInt64(BinaryReader reader, byte code)
+		{
+			if (code <= MessagePackCode.MaxPositiveFixInt)
+				return code;
+			if (code >= MessagePackCode.MinNegativeFixInt)
+				return (sbyte) code;
+
+			switch (code)
+			{
+				case MessagePackCode.UInt8:
+					return reader.ReadByte();
+				case MessagePackCode.UInt16:
+					return ReadBigEndianUInt16(reader);
+				case MessagePackCode.UInt32:
+					return ReadBigEndianUInt32(reader);
+				case MessagePackCode.UInt64:
+					var value = ReadBigEndianUInt64(reader);
+					if (value > long.MaxValue)
+						throw OutOfRange(value, typeof(long));
+					return (long) value;
+				case MessagePackCode.Int8:
+					return reader.ReadSByte();
+				case MessagePackCode.Int16:
+					return (short) ReadBigEndianUInt16(reader);
+				case MessagePackCode.Int32:
+					return (int) ReadBigEndianUInt32(reader);
+				case MessagePackCode.Int64:
+					return (long) ReadBigEndianUInt64(reader);
+				default:
+					throw UnexpectedCode(code, "an integer");
+			}
+		}
+
+		internal static float ReadSingle(BinaryReader reader)
+		{
+			return new SingleBits {UInt32 = ReadBigEndianUInt32(reader)}.Single;
+		}
+
+		internal static double ReadDouble(BinaryReader reader)
+		{
+			return BitConverter.Int64BitsToDouble((long) ReadBigEndianUInt64(reader));
+		}
+
+		internal static decimal ReadDecimal(BinaryReader reader, byte code)
+		{
+			ReadExtensionType(reader, code, MessagePackCode.FixExt16, MessagePackCode.DecimalExtension, "a decimal");
+			var bits = new int[4];
+			for (int i = 0; i < bits.Length; ++i)
+				bits[i] = (int) ReadBigEndianUInt32(reader);
+			return new decimal(bits);
+		}
+
+		internal static DateTime ReadDateTime(BinaryReader reader, byte code)
+		{
+			ReadExtensionType(reader, code, MessagePackCode.FixExt8, MessagePackCode.DateTimeExtension, "a DateTime");
+			return DateTime.FromBinary((long) ReadBigEndianUInt64(reader));
+		}
+
+		internal static string ReadString(BinaryReader reader, byte code)
+		{
+			int length;
+			if (MessagePackCode.IsFixStr(code))
+				length = code & 0x1f;
+			else if (code == MessagePackCode.Str8)
+				length = reader.ReadByte();
+			else if (code == MessagePackCode.Str16)
+				length = ReadBigEndianUInt16(reader);
+			else if (code == MessagePackCode.Str32)
+				length = ToLength(ReadBigEndianUInt32(reader));
+			else if (code == MessagePackCode.Nil)
+				return null;
+			else
+				throw UnexpectedCode(code, "a string");
+
+			var bytes = BinaryMessageReader.ReadByteSegment(reader, length);
+			return Encoding.UTF8.GetString(bytes.Array, bytes.Offset, bytes.Count);
+		}
+
+		internal static byte[] ReadBytes(BinaryReader reader, byte code)
+		{
+			if (code == MessagePackCode.Nil)
+				return null;
+
+			var length = ReadBinaryLength(reader, code);
+			var value = reader.ReadBytes(length);
+			if (value.Length != length)
+				throw new EndOfStreamException();
+			return value;
+		}
+
+		private static int ReadBinaryLength(BinaryReader reader, byte code)
+		{
+			switch (code)
+			{
+				case MessagePackCode.Bin8:
+					return reader.ReadByte();
+				case MessagePackCode.Bin16:
+					return ReadBigEndianUInt16(reader);
+				case MessagePackCode.Bin32:
+					return ToLength(ReadBigEndianUInt32(reader));
+				default:
+					throw UnexpectedCode(code, "a binary value");
+			}
+		}
+
+		private static void ReadExtensionType(BinaryReader reader, byte code, byte expectedCode, sbyte expectedType, string expected)
+		{
+			if (code != expectedCode)
+				throw UnexpectedCode(code, expected);
+
+			var type = reader.ReadSByte();
+			if (type != expectedType)
+				throw new SerializationException(string.Format("Expected {0} but found extension type {1}", expected, type));
+		}
+
+		private static int ToLength(uint length)
+		{
+			if (length > int.MaxValue)
+				throw new SerializationException(string.Format("Invalid length: {0}", length));
+			return (int) length;
+		}
+
+		private static ushort ReadBigEndianUInt16(BinaryReader reader)
+		{
+			var value = reader.ReadUInt16();
+			return (ushort) ((value << 8) | (value >> 8));
+		}
+
+		private static uint ReadBigEndianUInt32(BinaryReader reader)
+		{
+			return ReverseBytes(reader.ReadUInt32());
+		}
+
+		private static ulong ReadBigEndianUInt64(BinaryReader reader)
+		{
+			var value = reader.ReadUInt64();
+			return ((ulong) ReverseBytes((uint) value) << 32) | ReverseBytes((uint) (value >> 32));
+		}
+
+		internal static SerializationException UnexpectedCode(byte code, string expected)
+		{
+			return new SerializationException(string.Format("Expected {0} but found format 0x{1:x2}", expected, code));
+		}
+
+		private static SerializationException OutOfRange(object value, Type type)
+		{
+			return new SerializationException(string.Format("The value {0} doesn't fit into a {1}", value, type.Name));
+		}
+
+		#endregion
+
+		private static ModuleBuilder CreateModule()
+		{
+			var assemblyName = new AssemblyName("SharpRemote.GeneratedCode.Serializer");
+
+#if DOTNETCORE
+			var access = AssemblyBuilderAccess.Run;
+#else
+			var access = AssemblyBuilderAccess.RunAndSave;
+#endif
+
+			var assembly = AssemblyBuilder.DefineDynamicAssembly(assemblyName, access);
+			var moduleName = assemblyName.Name + ".dll";
+			var module = assembly.DefineDynamicModule(moduleName);
+			return module;
+		}
+
+		private Type ResolveType(string typeName)
+		{
+			Type type;
+			if (_typesByName.TryGetValue(typeName, out type))
+				return type;
+
+			type = _typeResolver?.GetType(typeName) ?? Type.GetType(typeName);
+			if (type != null)
+				_typesByName.TryAdd(typeName, type);
+			return type;
+		}
+
+		[StructLayout(LayoutKind.Explicit)]
+		private struct SingleBits
+		{
+			[FieldOffset(0)] public float Single;
+			[FieldOffset(0)] public uint UInt32;
+		}
+	}
+}
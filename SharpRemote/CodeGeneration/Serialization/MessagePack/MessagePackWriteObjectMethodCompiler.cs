@@ -0,0 +1,10 @@
+﻿namespace SharpRemote.CodeGeneration.Serialization.MessagePack
+{
+	internal sealed class MessagePackWriteObjectMethodCompiler
+		: AbstractWriteObjectMethodCompiler
+	{
+		public MessagePackWriteObjectMethodCompiler(CompilationContext context) : base(context)
+		{
+		}
+	}
+}
@@ -0,0 +1,256 @@
+﻿using System;
+using System.IO;
+using System.Reflection;
+using System.Reflection.Emit;
+
+namespace SharpRemote.CodeGeneration.Serialization.MessagePack
+{
+	/// <summary>
+	///     Writes the members of a type as a MessagePack array: Members are identified by their position
+	///     and therefore no names are written.
+	/// </summary>
+	internal sealed class MessagePackWriteValueMethodCompiler
+		: AbstractWriteValueMethodCompiler
+	{
+		private static readonly MethodInfo MessagePackSerializerWriteObject;
+		private static readonly MethodInfo MessagePackSerializerWriteArrayHeader;
+		private static readonly MethodInfo MessagePackSerializerWriteHint;
+		private static readonly MethodInfo MessagePackSerializerWriteByte;
+		private static readonly MethodInfo MessagePackSerializerWriteSByte;
+		private static readonly MethodInfo MessagePackSerializerWriteDecimal;
+		private static readonly MethodInfo MessagePackSerializerWriteInt16;
+		private static readonly MethodInfo MessagePackSerializerWriteUInt16;
+		private static readonly MethodInfo MessagePackSerializerWriteInt32;
+		private static readonly MethodInfo MessagePackSerializerWriteUInt32;
+		private static readonly MethodInfo MessagePackSerializerWriteInt64;
+		private static readonly MethodInfo MessagePackSerializerWriteUInt64;
+		private static readonly MethodInfo MessagePackSerializerWriteSingle;
+		private static readonly MethodInfo MessagePackSerializerWriteDouble;
+		private static readonly MethodInfo MessagePackSerializerWriteString;
+		private static readonly MethodInfo MessagePackSerializerWriteDateTime;
+		private static readonly MethodInfo MessagePackSerializerWriteException;
+
+		private readonly CompilationContext _context;
+
+		static MessagePackWriteValueMethodCompiler()
+		{
+			MessagePackSerializerWriteObject = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.WriteObject), new []{typeof(BinaryWriter), typeof(object), typeof(IRemotingEndPoint)});
+			MessagePackSerializerWriteArrayHeader = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.WriteArrayHeader));
+			MessagePackSerializerWriteHint = typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.WriteHint));
+			MessagePackSerializerWriteByte = GetWriteValue(typeof(byte));
+			MessagePackSerializerWriteSByte = GetWriteValue(typeof(sbyte));
+			MessagePackSerializerWriteDecimal = GetWriteValue(typeof(decimal));
+			MessagePackSerializerWriteInt16 = GetWriteValue(typeof(Int16));
+			MessagePackSerializerWriteUInt16 = GetWriteValue(typeof(UInt16));
+			MessagePackSerializerWriteInt32 = GetWriteValue(typeof(Int32));
+			MessagePackSerializerWriteUInt32 = GetWriteValue(typeof(UInt32));
+			MessagePackSerializerWriteInt64 = GetWriteValue(typeof(Int64));
+			MessagePackSerializerWriteUInt64 = GetWriteValue(typeof(UInt64));
+			MessagePackSerializerWriteSingle = GetWriteValue(typeof(Single));
+			MessagePackSerializerWriteDouble = GetWriteValue(typeof(Double));
+			MessagePackSerializerWriteString = GetWriteValue(typeof(string));
+			MessagePackSerializerWriteDateTime = GetWriteValue(typeof(DateTime));
+			MessagePackSerializerWriteException = GetWriteValue(typeof(Exception));
+		}
+
+		public MessagePackWriteValueMethodCompiler(CompilationContext context)
+			: base(context)
+		{
+			_context = context;
+		}
+
+		private static MethodInfo GetWriteValue(Type type)
+		{
+			return typeof(MessagePackSerializer).GetMethod(nameof(MessagePackSerializer.WriteValue), new[] {typeof(BinaryWriter), type});
+		}
+
+		protected override void EmitBeginWrite(ILGenerator gen)
+		{
+			// MessagePackSerializer.WriteArrayHeader(writer, <number of members>)
+			var typeDescription = _context.TypeDescription;
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Ldc_I4, typeDescription.Fields.Count + typeDescription.Properties.Count);
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteArrayHeader);
+		}
+
+		protected override void EmitWriteHint(ILGenerator generator, ByReferenceHint hint)
+		{
+			generator.Emit(OpCodes.Ldarg_0);
+			generator.Emit(OpCodes.Ldc_I4, (int)hint);
+			generator.Emit(OpCodes.Call, MessagePackSerializerWriteHint);
+		}
+
+		protected override void EmitDynamicDispatchWriteObject(ILGenerator gen, Action loadMember)
+		{
+			gen.Emit(OpCodes.Ldarg_2);
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Ldarg_3);
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteObject);
+		}
+
+		protected override void EmitBeginWriteField(ILGenerator gen, IFieldDescription field)
+		{
+			
+		}
+
+		protected override void EmitEndWriteField(ILGenerator gen, IFieldDescription field)
+		{
+			
+		}
+
+		protected override void EmitBeginWriteProperty(ILGenerator gen, IPropertyDescription property)
+		{
+			
+		}
+
+		protected override void EmitEndWriteProperty(ILGenerator gen, IPropertyDescription property)
+		{
+			
+		}
+
+		protected override void EmitWriteEnum(ILGenerator gen, ITypeDescription typeDescription, Action loadMember, Action loadMemberAddress)
+		{
+			var storageType = typeDescription.StorageType.Type;
+			var method = GetWriteValue(storageType);
+			if (method == null)
+				throw new NotImplementedException();
+
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, method);
+		}
+
+		protected override void EmitWriteByte(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteByte);
+		}
+
+		protected override void EmitWriteSByte(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteSByte);
+		}
+
+		protected override void EmitWriteUInt16(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteUInt16);
+		}
+
+		protected override void EmitWriteInt16(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteInt16);
+		}
+
+		protected override void EmitWriteUInt32(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteUInt32);
+		}
+
+		protected override void EmitWriteInt32(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteInt32);
+		}
+
+		protected override void EmitWriteUInt64(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteUInt64);
+		}
+
+		protected override void EmitWriteInt64(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteInt64);
+		}
+
+		protected override void EmitWriteDecimal(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteDecimal);
+		}
+
+		protected override void EmitWriteSingle(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteSingle);
+		}
+
+		protected override void EmitWriteDouble(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteDouble);
+		}
+
+		protected override void EmitWriteString(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteString);
+		}
+
+		protected override void EmitWriteDateTime(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteDateTime);
+		}
+
+		protected override void EmitWriteLevel(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			var end = gen.DefineLabel();
+
+			for (int i = 0; i < HardcodedLevels.Count; ++i)
+			{
+				var next = gen.DefineLabel();
+
+				// if (ReferenceEquals(value, <fld>))
+				loadMember();
+				gen.Emit(OpCodes.Ldsfld, HardcodedLevels[i].Field);
+				gen.Emit(OpCodes.Call, Methods.ObjectReferenceEquals);
+				gen.Emit(OpCodes.Brfalse, next);
+
+				// MessagePackSerializer.WriteValue(writer, (byte)<constant>)
+				gen.Emit(OpCodes.Ldarg_0);
+				gen.Emit(OpCodes.Ldc_I4, i);
+				gen.Emit(OpCodes.Call, MessagePackSerializerWriteByte);
+				gen.Emit(OpCodes.Br, end);
+
+				gen.MarkLabel(next);
+			}
+
+			gen.MarkLabel(end);
+		}
+
+		protected override void EmitWriteException(ILGenerator gen, Action loadMember, Action loadMemberAddress)
+		{
+			gen.Emit(OpCodes.Ldarg_0);
+			loadMember();
+			gen.Emit(OpCodes.Call, MessagePackSerializerWriteException);
+		}
+
+		protected override void EmitWriteObjectId(ILGenerator generator, LocalBuilder proxy)
+		{
+			generator.Emit(OpCodes.Ldarg_0);
+			generator.Emit(OpCodes.Ldloc, proxy);
+			generator.Emit(OpCodes.Callvirt, Methods.GrainGetObjectId);
+			generator.Emit(OpCodes.Call, MessagePackSerializerWriteUInt64);
+		}
+	}
+}
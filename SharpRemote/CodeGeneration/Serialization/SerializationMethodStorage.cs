@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.Diagnostics.Contracts;
 using System.Linq;
@@ -13,6 +14,10 @@ namespace SharpRemote.CodeGeneration.Serialization
 	///     Provides access to already compiled serialization methods
 	///     and compiles new methods on-demand through a provided <see cref="ISerializationMethodCompiler{T}" />.
 	/// </summary>
+	/// <remarks>
+	///     Looking up methods which have already been compiled doesn't acquire any lock:
+	///     A lock is only taken when methods need to be compiled.
+	/// </remarks>
 	internal sealed class SerializationMethodStorage<T>
 		: ISerializationMethodStorage<T>
 		where T : ISerializationMethods
@@ -23,8 +28,10 @@ namespace SharpRemote.CodeGeneration.Serialization
 		private readonly ISerializationMethodCompiler<T> _compiler;
 		private readonly Dictionary<Type, MethodInfo> _getSingletonInstance;
 		private readonly Dictionary<Type, T> _serializationMethods;
+		private readonly ConcurrentDictionary<Type, T> _compiledMethods;
 		private readonly string _suffix;
 		private readonly object _syncRoot;
+		private int _compilationDepth;
 
 		/// <summary>
 		/// </summary>
@@ -42,54 +49,93 @@ namespace SharpRemote.CodeGeneration.Serialization
 			_syncRoot = new object();
 			_typeModel = new TypeModel();
 			_serializationMethods = new Dictionary<Type, T>();
+			_compiledMethods = new ConcurrentDictionary<Type, T>();
 			_getSingletonInstance = new Dictionary<Type, MethodInfo>();
 		}
 
 		public T GetOrAdd(Type type)
 		{
+			// Usually we already have generated the methods necessary to serialize / deserialize
+			// and thus we can simply retrieve them without acquiring the lock.
+			T serializationMethods;
+			if (_compiledMethods.TryGetValue(type, out serializationMethods))
+				return serializationMethods;
+
 			lock (_syncRoot)
 			{
-				// Usually we already have generated the methods necessary to serialize / deserialize
-				// and thus we can simply retrieve them from the dictionary
-				T serializationMethods;
-				if (!_serializationMethods.TryGetValue(type, out serializationMethods))
+				++_compilationDepth;
+				try
+				{
+					serializationMethods = GetOrAddUnderLock(type);
+				}
+				finally
+				{
+					--_compilationDepth;
+				}
+
+				// Methods of (recursive) types are registered with _serializationMethods
+				// BEFORE they have been compiled. We may only hand them out to other threads
+				// once the outermost compilation has finished.
+				if (_compilationDepth == 0)
+					PublishCompiledMethods();
+
+				return serializationMethods;
+			}
+		}
+
+		private void PublishCompiledMethods()
+		{
+			foreach (var pair in _serializationMethods)
+				_compiledMethods.TryAdd(pair.Key, pair.Value);
+		}
+
+		private T GetOrAddUnderLock(Type type)
+		{
+			T serializationMethods;
+			if (!_serializationMethods.TryGetValue(type, out serializationMethods))
+			{
+				// The methods haven't been generated yet, so we'll have to generate them.
+				// However we need to pay special attention to certain types, for example ByReference
+				// types where the serialization method is IDENTICAL for each implementation.
+				//
+				// Usually we would call PatchType() everytime, however this method is very time-expensive
+				// and therefore we will register both the type as well as the patched type, which
+				// causes subsequent calls to RegisterType to no longer invoke PatchType.
+				//
+				// In essence PatchType is only ever invoked ONCE per type instead of for every call to RegisterType.
+				var patchedType = PatchType(type);
+				if (!_serializationMethods.TryGetValue(patchedType, out serializationMethods))
 				{
-					var typeDescription = _typeModel.Add(type);
-
-					// If that's not the case, then we'll have to generate them.
-					// However we need to pay special attention to certain types, for example ByReference
-					// types where the serialization method is IDENTICAL for each implementation.
-					//
-					// Usually we would call PatchType() everytime, however this method is very time-expensive
-					// and therefore we will register both the type as well as the patched type, which
-					// causes subsequent calls to RegisterType to no longer invoke PatchType.
-					//
-					// In essence PatchType is only ever invoked ONCE per type instead of for every call to RegisterType.
-					var patchedType = PatchType(type);
-					if (!_serializationMethods.TryGetValue(patchedType, out serializationMethods))
+					// The methods are shared by all types which patch to the same type and therefore
+					// they have to be generated for that type: An implementation of a [ByReference]
+					// interface cannot even be described on its own.
+					var typeDescription = _typeModel.Add(patchedType);
+					var typeName = BuildTypeName(patchedType);
+					serializationMethods = _compiler.Prepare(typeName, typeDescription);
+
+					try
 					{
-						var typeName = BuildTypeName(type);
-						serializationMethods = _compiler.Prepare(typeName, typeDescription);
-
-						try
-						{
-							_serializationMethods.Add(type, serializationMethods);
-							_compiler.Compile(serializationMethods, this);
-						}
-						catch (Exception e)
-						{
-							Log.DebugFormat("Caught unexpected exception while trying to compile serialization methods for '{0}': {1}", typeDescription,
-							                e);
-							_serializationMethods.Remove(type);
-							throw;
-						}
-
-						if (type != patchedType)
-							_serializationMethods.Add(type, serializationMethods);
+						_serializationMethods.Add(patchedType, serializationMethods);
+						_compiler.Compile(serializationMethods, this);
 					}
+					catch (Exception e)
+					{
+						Log.DebugFormat("Caught unexpected exception while trying to compile serialization methods for '{0}': {1}", typeDescription,
+						                e);
+						_serializationMethods.Remove(patchedType);
+						throw;
+					}
+
+					if (type != patchedType)
+						_serializationMethods.Add(type, serializationMethods);
+				}
+				else
+				{
+					// Subsequent lookups of this type shouldn't have to patch it again.
+					_serializationMethods.Add(type, serializationMethods);
 				}
-				return serializationMethods;
 			}
+			return serializationMethods;
 		}
 
 		[Pure]
@@ -118,6 +118,20 @@ namespace SharpRemote.CodeGeneration.Serialization.Xml
 			return true;
 		}
 
+		public bool ReadNextArgumentAsStruct<T>(out T value) where T : struct
+		{
+			// Values are always deserialized through their ReadObject method and thus boxed.
+			object tmp;
+			if (!ReadNextArgument(out tmp))
+			{
+				value = default(T);
+				return false;
+			}
+
+			value = (T) tmp;
+			return true;
+		}
+
 		public bool ReadNextArgumentAsSByte(out sbyte value)
 		{
 			if (!ReadNextArgument())
@@ -274,6 +288,19 @@ namespace SharpRemote.CodeGeneration.Serialization.Xml
 			return true;
 		}
 
+		public bool ReadNextArgumentAsByteSegment(out ArraySegment<byte> value)
+		{
+			byte[] bytes;
+			if (!ReadNextArgumentAsBytes(out bytes))
+			{
+				value = default(ArraySegment<byte>);
+				return false;
+			}
+
+			value = bytes != null ? new ArraySegment<byte>(bytes) : default(ArraySegment<byte>);
+			return true;
+		}
+
 		private bool ReadNextArgument()
 		{
 			if (!_reader.Read())
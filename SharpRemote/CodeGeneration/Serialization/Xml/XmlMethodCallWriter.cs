@@ -1,5 +1,4 @@
 ﻿using System;
-using System.Globalization;
 using System.IO;
 using System.Xml;
 using SharpRemote.Extensions;
@@ -24,8 +23,8 @@ namespace SharpRemote.CodeGeneration.Serialization.Xml
 			_writer.WriteStartDocument();
 
 			_writer.WriteStartElement(XmlSerializer.MethodCallElementName);
-			_writer.WriteAttributeString(XmlSerializer.RpcIdAttributeName, rpcId.ToString(CultureInfo.InvariantCulture));
-			_writer.WriteAttributeString(XmlSerializer.GrainIdAttributeName, grainId.ToString(CultureInfo.InvariantCulture));
+			XmlSerializer.WriteAttribute(_writer, XmlSerializer.RpcIdAttributeName, rpcId);
+			XmlSerializer.WriteAttribute(_writer, XmlSerializer.GrainIdAttributeName, grainId);
 			_writer.WriteAttributeString(XmlSerializer.MethodAttributeName, methodName);
 		}
 
@@ -44,6 +43,11 @@ namespace SharpRemote.CodeGeneration.Serialization.Xml
 			_writer.WriteEndElement();
 		}
 
+		public void WriteArgument<T>(T value) where T : struct
+		{
+			WriteArgument((object) value);
+		}
+
 		public void WriteArgument(sbyte value)
 		{
 			_writer.WriteStartElement(XmlSerializer.ArgumentElementName);
@@ -142,5 +146,12 @@ namespace SharpRemote.CodeGeneration.Serialization.Xml
 			XmlSerializer.WriteValue(_writer, value);
 			_writer.WriteEndElement();
 		}
+
+		public void WriteArgument(ArraySegment<byte> value)
+		{
+			_writer.WriteStartElement(XmlSerializer.ArgumentElementName);
+			XmlSerializer.WriteValue(_writer, value);
+			_writer.WriteEndElement();
+		}
 	}
 }
\ No newline at end of file
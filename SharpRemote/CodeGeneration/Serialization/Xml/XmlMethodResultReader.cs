@@ -118,6 +118,20 @@ namespace SharpRemote.CodeGeneration.Serialization.Xml
 			return true;
 		}
 
+		public bool ReadResultStruct<T>(out T value) where T : struct
+		{
+			// Values are always deserialized through their ReadObject method and thus boxed.
+			object tmp;
+			if (!ReadResult(out tmp))
+			{
+				value = default(T);
+				return false;
+			}
+
+			value = (T) tmp;
+			return true;
+		}
+
 		public bool ReadResultSByte(out sbyte value)
 		{
 			value = sbyte.MinValue;
@@ -248,7 +262,27 @@ namespace SharpRemote.CodeGeneration.Serialization.Xml
 
 		public bool ReadResultBytes(out byte[] value)
 		{
-			throw new NotImplementedException();
+			if (!TryReadResult())
+			{
+				value = null;
+				return false;
+			}
+
+			value = XmlSerializer.ReadValueAsBytes(_reader);
+			return true;
+		}
+
+		public bool ReadResultByteSegment(out ArraySegment<byte> value)
+		{
+			byte[] bytes;
+			if (!ReadResultBytes(out bytes))
+			{
+				value = default(ArraySegment<byte>);
+				return false;
+			}
+
+			value = bytes != null ? new ArraySegment<byte>(bytes) : default(ArraySegment<byte>);
+			return true;
 		}
 
 		/// <summary>
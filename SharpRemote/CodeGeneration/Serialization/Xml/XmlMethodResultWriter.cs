@@ -1,5 +1,4 @@
 ﻿using System;
-using System.Globalization;
 using System.IO;
 using System.Xml;
 using SharpRemote.Extensions;
@@ -22,7 +21,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Xml
 			_writer = XmlWriter.Create(_textWriter, settings);
 			_writer.WriteStartDocument();
 			_writer.WriteStartElement(XmlSerializer.MethodResultElementName);
-			_writer.WriteAttributeString(XmlSerializer.RpcIdAttributeName, rpcId.ToString(CultureInfo.InvariantCulture));
+			XmlSerializer.WriteAttribute(_writer, XmlSerializer.RpcIdAttributeName, rpcId);
 		}
 
 		public void Dispose()
@@ -46,6 +45,11 @@ namespace SharpRemote.CodeGeneration.Serialization.Xml
 			_writer.WriteEndElement();
 		}
 
+		public void WriteResult<T>(T value) where T : struct
+		{
+			WriteResult((object) value);
+		}
+
 		public void WriteResult(sbyte value)
 		{
 			_writer.WriteStartElement(XmlSerializer.ReturnValueElementName);
@@ -130,6 +134,13 @@ namespace SharpRemote.CodeGeneration.Serialization.Xml
 			_writer.WriteEndElement();
 		}
 
+		public void WriteResult(ArraySegment<byte> value)
+		{
+			_writer.WriteStartElement(XmlSerializer.ReturnValueElementName);
+			XmlSerializer.WriteValue(_writer, value);
+			_writer.WriteEndElement();
+		}
+
 		public void WriteException(Exception e)
 		{
 			_writer.WriteStartElement(XmlSerializer.ExceptionElementName);
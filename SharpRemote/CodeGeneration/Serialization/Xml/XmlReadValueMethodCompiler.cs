@@ -231,25 +231,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Xml
 
 		protected override void EmitBeginReadField(ILGenerator gen, IFieldDescription field)
 		{
-			var correctField = gen.DefineLabel();
-			var actualElementName = gen.DeclareLocal(typeof(string));
-
-			// If reader.Name == FieldElementName goto correctField
-			gen.Emit(OpCodes.Ldarg_0);
-			gen.Emit(OpCodes.Callvirt, XmlReaderGetName);
-			gen.Emit(OpCodes.Stloc, actualElementName);
-			gen.Emit(OpCodes.Ldloc, actualElementName);
-			gen.Emit(OpCodes.Ldstr, XmlSerializer.FieldElementName);
-			gen.Emit(OpCodes.Call, StringEquals);
-			gen.Emit(OpCodes.Brtrue_S, correctField);
-			// throw new XmlParseException
-			EmitThrowXmlParseException(gen, actualElementName);
-
-			gen.MarkLabel(correctField);
-			gen.Emit(OpCodes.Ldarg_0);
-			gen.Emit(OpCodes.Ldstr, field.Name);
-			gen.Emit(OpCodes.Callvirt, XmlReaderMoveToAttributeByName);
-			gen.Emit(OpCodes.Pop);
+			EmitExpectElement(gen, XmlSerializer.FieldElementName);
 		}
 
 		protected override void EmitEndReadField(ILGenerator gen, IFieldDescription field)
@@ -261,25 +243,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Xml
 
 		protected override void EmitBeginReadProperty(ILGenerator gen, IPropertyDescription property)
 		{
-			var correctField = gen.DefineLabel();
-			var actualElementName = gen.DeclareLocal(typeof(string));
-
-			// If reader.Name == FieldElementName goto correctField
-			gen.Emit(OpCodes.Ldarg_0);
-			gen.Emit(OpCodes.Callvirt, XmlReaderGetName);
-			gen.Emit(OpCodes.Stloc, actualElementName);
-			gen.Emit(OpCodes.Ldloc, actualElementName);
-			gen.Emit(OpCodes.Ldstr, XmlSerializer.FieldElementName);
-			gen.Emit(OpCodes.Call, StringEquals);
-			gen.Emit(OpCodes.Brtrue_S, correctField);
-			// throw new XmlParseException
-			EmitThrowXmlParseException(gen, actualElementName);
-
-			gen.MarkLabel(correctField);
-			gen.Emit(OpCodes.Ldarg_0);
-			gen.Emit(OpCodes.Ldstr, property.Name);
-			gen.Emit(OpCodes.Callvirt, XmlReaderMoveToAttributeByName);
-			gen.Emit(OpCodes.Pop);
+			EmitExpectElement(gen, XmlSerializer.PropertyElementName);
 		}
 
 		protected override void EmitEndReadProperty(ILGenerator gen, IPropertyDescription property)
@@ -293,9 +257,43 @@ namespace SharpRemote.CodeGeneration.Serialization.Xml
 		{
 		}
 
-		private void EmitThrowXmlParseException(ILGenerator gen, LocalBuilder actualElementName)
+		/// <summary>
+		///     Emits code which throws unless the reader is positioned on an element of the given name.
+		/// </summary>
+		/// <remarks>
+		///     Readers created by the <see cref="XmlSerializer" /> atomize element names in a table which has been
+		///     seeded with the very same (interned) string instances as the ones loaded by ldstr and thus
+		///     the expected name is compared by reference and only compared by value if that fails
+		///     (for example because a reader created by someone else is used).
+		/// </remarks>
+		/// <param name="gen"></param>
+		/// <param name="expectedElementName"></param>
+		private void EmitExpectElement(ILGenerator gen, string expectedElementName)
+		{
+			var correctElement = gen.DefineLabel();
+			var actualElementName = gen.DeclareLocal(typeof(string));
+
+			// If ReferenceEquals(reader.Name, expectedElementName) goto correctElement
+			gen.Emit(OpCodes.Ldarg_0);
+			gen.Emit(OpCodes.Callvirt, XmlReaderGetName);
+			gen.Emit(OpCodes.Stloc, actualElementName);
+			gen.Emit(OpCodes.Ldloc, actualElementName);
+			gen.Emit(OpCodes.Ldstr, expectedElementName);
+			gen.Emit(OpCodes.Beq, correctElement);
+			// If reader.Name == expectedElementName goto correctElement
+			gen.Emit(OpCodes.Ldloc, actualElementName);
+			gen.Emit(OpCodes.Ldstr, expectedElementName);
+			gen.Emit(OpCodes.Call, StringEquals);
+			gen.Emit(OpCodes.Brtrue, correctElement);
+			// throw new XmlParseException
+			EmitThrowXmlParseException(gen, expectedElementName, actualElementName);
+
+			gen.MarkLabel(correctElement);
+		}
+
+		private void EmitThrowXmlParseException(ILGenerator gen, string expectedElementName, LocalBuilder actualElementName)
 		{
-			gen.Emit(OpCodes.Ldstr, "Expected to find element '"+ XmlSerializer.FieldElementName + "', but found '{0}' instead!");
+			gen.Emit(OpCodes.Ldstr, "Expected to find element '"+ expectedElementName + "', but found '{0}' instead!");
 			gen.Emit(OpCodes.Ldloc, actualElementName);
 			gen.Emit(OpCodes.Call, StringFormatObject);
 			gen.Emit(OpCodes.Ldarg_0);
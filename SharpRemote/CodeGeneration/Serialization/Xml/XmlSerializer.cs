@@ -33,6 +33,34 @@ namespace SharpRemote
 		private readonly XmlWriterSettings _writerSettings;
 		private readonly XmlReaderSettings _readerSettings;
 
+		/// <summary>
+		///     The maximum number of characters of a formatted 64-bit integer (20 digits and the sign).
+		/// </summary>
+		private const int MaxNumberLength = 21;
+
+		[ThreadStatic]
+		private static char[] _numberBuffer;
+
+		/// <summary>
+		///     The names of all elements and attributes written by this serializer, see <see cref="CreateNameTable" />.
+		/// </summary>
+		private static readonly string[] AtomizedNames =
+		{
+			MethodCallElementName,
+			MethodResultElementName,
+			RpcIdAttributeName,
+			GrainIdAttributeName,
+			MethodAttributeName,
+			FieldElementName,
+			PropertyElementName,
+			NameAttributeName,
+			ValueName,
+			ArgumentElementName,
+			ReturnValueElementName,
+			ExceptionElementName,
+			TypeAttributeName
+		};
+
 		/// <summary>
 		/// Name of the XML element which represents a method call.
 		/// </summary>
@@ -184,6 +212,15 @@ namespace SharpRemote
 			Log.DebugFormat("Type '{0}' successfully registered", type);
 		}
 
+		/// <inheritdoc />
+		public IReadOnlyList<PreparedType> RegisterTypes(IEnumerable<Type> types)
+		{
+			if (types == null)
+				throw new ArgumentNullException(nameof(types));
+
+			return types.Select(x => PreparedType.Prepare(x, RegisterType)).ToList();
+		}
+
 		/// <inheritdoc />
 		public bool IsTypeRegistered<T>()
 		{
@@ -220,7 +257,8 @@ namespace SharpRemote
 		{
 			var textReader = new StreamReader(stream, _writerSettings.Encoding, detectEncodingFromByteOrderMarks: true,
 			                                  bufferSize: 4096, leaveOpen: true);
-			var reader = XmlReader.Create(textReader, _readerSettings);
+			var context = new XmlParserContext(CreateNameTable(), null, null, XmlSpace.None);
+			var reader = XmlReader.Create(textReader, _readerSettings, context);
 			reader.MoveToContent();
 			switch (reader.Name)
 			{
@@ -239,6 +277,27 @@ namespace SharpRemote
 			}
 		}
 
+		/// <summary>
+		///     Creates the name table for a new reader which already contains the names of all elements and
+		///     attributes written by this serializer.
+		/// </summary>
+		/// <remarks>
+		///     The table atomizes these names to the very same (interned) string instances which are used as
+		///     constants throughout this serializer and the methods it compiles: The reader doesn't allocate
+		///     a new string for any of them and comparing a name with one of those constants
+		///     succeeds by reference.
+		///     The table isn't shared between readers because <see cref="NameTable" /> isn't thread-safe
+		///     and locking it for every single name costs more than what seeding a new table does.
+		/// </remarks>
+		/// <returns></returns>
+		private static XmlNameTable CreateNameTable()
+		{
+			var nameTable = new NameTable();
+			foreach (var name in AtomizedNames)
+				nameTable.Add(name);
+			return nameTable;
+		}
+
 		#region Writing
 
 		/// <summary>
@@ -298,7 +357,7 @@ namespace SharpRemote
 		/// <param name="value"></param>
 		public static void WriteValue(XmlWriter writer, sbyte value)
 		{
-			writer.WriteAttributeString(ValueName, value.ToString(CultureInfo.InvariantCulture));
+			WriteAttribute(writer, ValueName, value);
 		}
 
 		/// <summary>
@@ -307,7 +366,7 @@ namespace SharpRemote
 		/// <param name="value"></param>
 		public static void WriteValue(XmlWriter writer, byte value)
 		{
-			writer.WriteAttributeString(ValueName, value.ToString(CultureInfo.InvariantCulture));
+			WriteAttribute(writer, ValueName, value);
 		}
 
 		/// <summary>
@@ -316,7 +375,7 @@ namespace SharpRemote
 		/// <param name="value"></param>
 		public static void WriteValue(XmlWriter writer, ushort value)
 		{
-			writer.WriteAttributeString(ValueName, value.ToString(CultureInfo.InvariantCulture));
+			WriteAttribute(writer, ValueName, value);
 		}
 
 		/// <summary>
@@ -325,7 +384,7 @@ namespace SharpRemote
 		/// <param name="value"></param>
 		public static void WriteValue(XmlWriter writer, short value)
 		{
-			writer.WriteAttributeString(ValueName, value.ToString(CultureInfo.InvariantCulture));
+			WriteAttribute(writer, ValueName, value);
 		}
 
 		/// <summary>
@@ -334,7 +393,7 @@ namespace SharpRemote
 		/// <param name="value"></param>
 		public static void WriteValue(XmlWriter writer, uint value)
 		{
-			writer.WriteAttributeString(ValueName, value.ToString(CultureInfo.InvariantCulture));
+			WriteAttribute(writer, ValueName, value);
 		}
 
 		/// <summary>
@@ -343,7 +402,7 @@ namespace SharpRemote
 		/// <param name="value"></param>
 		public static void WriteValue(XmlWriter writer, int value)
 		{
-			writer.WriteAttributeString(ValueName, value.ToString(CultureInfo.InvariantCulture));
+			WriteAttribute(writer, ValueName, value);
 		}
 
 		/// <summary>
@@ -352,7 +411,7 @@ namespace SharpRemote
 		/// <param name="value"></param>
 		public static void WriteValue(XmlWriter writer, ulong value)
 		{
-			writer.WriteAttributeString(ValueName, value.ToString(CultureInfo.InvariantCulture));
+			WriteAttribute(writer, ValueName, value);
 		}
 
 		/// <summary>
@@ -361,7 +420,7 @@ namespace SharpRemote
 		/// <param name="value"></param>
 		public static void WriteValue(XmlWriter writer, long value)
 		{
-			writer.WriteAttributeString(ValueName, value.ToString(CultureInfo.InvariantCulture));
+			WriteAttribute(writer, ValueName, value);
 		}
 
 		/// <summary>
@@ -423,7 +482,70 @@ namespace SharpRemote
 				writer.WriteAttributeString("Value", HexFromBytes(value));
 			}
 		}
+
+		/// <summary>
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="value"></param>
+		public static void WriteValue(XmlWriter writer, ArraySegment<byte> value)
+		{
+			if (value.Array != null)
+			{
+				writer.WriteAttributeString("Value", HexFromBytes(value.Array, value.Offset, value.Count));
+			}
+		}
 		
+		/// <summary>
+		///     Writes an attribute with the given integer value.
+		/// </summary>
+		/// <remarks>
+		///     The digits are formatted into a buffer which is reused by the current thread and then handed
+		///     to the writer as is, which is considerably cheaper than allocating a new string for every value.
+		/// </remarks>
+		/// <param name="writer"></param>
+		/// <param name="name"></param>
+		/// <param name="value"></param>
+		internal static void WriteAttribute(XmlWriter writer, string name, long value)
+		{
+			if (value < 0)
+			{
+				WriteAttribute(writer, name, unchecked(0UL - (ulong) value), isNegative: true);
+			}
+			else
+			{
+				WriteAttribute(writer, name, (ulong) value, isNegative: false);
+			}
+		}
+
+		/// <summary>
+		///     Writes an attribute with the given integer value.
+		/// </summary>
+		/// <param name="writer"></param>
+		/// <param name="name"></param>
+		/// <param name="value"></param>
+		internal static void WriteAttribute(XmlWriter writer, string name, ulong value)
+		{
+			WriteAttribute(writer, name, value, isNegative: false);
+		}
+
+		private static void WriteAttribute(XmlWriter writer, string name, ulong value, bool isNegative)
+		{
+			var buffer = _numberBuffer ?? (_numberBuffer = new char[MaxNumberLength]);
+			var start = buffer.Length;
+			do
+			{
+				buffer[--start] = (char) ('0' + (int) (value % 10));
+				value /= 10;
+			} while (value != 0);
+
+			if (isNegative)
+				buffer[--start] = '-';
+
+			writer.WriteStartAttribute(name);
+			writer.WriteChars(buffer, start, buffer.Length - start);
+			writer.WriteEndAttribute();
+		}
+
 		/// <summary>
 		///     Writes the given <paramref name="exception" /> to the given <paramref name="writer" />.
 		/// </summary>
@@ -982,8 +1104,21 @@ namespace SharpRemote
 			if (value == null)
 				return null;
 
-			var builder = new StringBuilder(value.Length * 2);
-			for (var i = 0; i < value.Length; ++i)
+			return HexFromBytes(value, 0, value.Length);
+		}
+
+		/// <summary>
+		///     Returns a hex-string with the given range of <paramref name="value" />.
+		/// </summary>
+		/// <param name="value"></param>
+		/// <param name="offset"></param>
+		/// <param name="count"></param>
+		/// <returns></returns>
+		[Pure]
+		public static string HexFromBytes(byte[] value, int offset, int count)
+		{
+			var builder = new StringBuilder(count * 2);
+			for (var i = offset; i < offset + count; ++i)
 				builder.Append(LookupTable[value[i]]);
 			return builder.ToString();
 		}
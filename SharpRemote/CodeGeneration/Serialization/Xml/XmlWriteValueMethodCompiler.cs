@@ -58,7 +58,7 @@ namespace SharpRemote.CodeGeneration.Serialization.Xml
 		protected override void EmitWriteHint(ILGenerator generator, ByReferenceHint hint)
 		{ }
 
-		protected override void EmitDynamicDispatchWriteObject(ILGenerator gen)
+		protected override void EmitDynamicDispatchWriteObject(ILGenerator gen, Action loadMember)
 		{
 			throw new NotImplementedException();
 		}
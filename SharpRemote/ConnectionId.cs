@@ -66,5 +66,11 @@ namespace SharpRemote
 		{
 			_value = value;
 		}
+
+		/// <summary>
+		///     The numeric value of this id: Connections of the same endpoint are numbered
+		///     in ascending order, starting with 1.
+		/// </summary>
+		internal int Value => _value;
 	}
 }
\ No newline at end of file
@@ -53,5 +53,21 @@ namespace SharpRemote
 		/// This behaves exactly like locking all tagged methods with the same STATIC sync root / exclusive lock.
 		/// </remarks>
 		[EnumMember] SerializePerType = 3,
+
+		/// <summary>
+		/// Methods are executed directly on the thread which reads from the socket and their response is written
+		/// immediately, without creating a task or queueing the invocation.
+		/// </summary>
+		/// <remarks>
+		/// This mode should only be used for methods which complete in a very short amount of time (such as simple getters)
+		/// because no other message of the same connection can be read while the method executes.
+		/// Methods which exceed <see cref="EndPointSettings.InlineDispatchBudget"/> are logged.
+		/// An inline method must NEVER call back into the remote endpoint synchronously (i.e. call a method on one of its
+		/// proxies, or block on a task returned by one): The response to such a call would have to be read by the very
+		/// thread which is waiting for it and therefore the connection would deadlock. Such calls are rejected with an
+		/// <see cref="System.InvalidOperationException"/>, however blocking on an asynchronous call cannot be detected.
+		/// Methods returning a <see cref="Task"/> or <see cref="Task{T}"/> cannot be dispatched inline.
+		/// </remarks>
+		[EnumMember] Inline = 4,
 	}
 }
\ No newline at end of file
@@ -120,6 +120,8 @@ namespace SharpRemote
 			builder.AppendFormat("  Pending method calls: {0}", _endPoint.NumPendingMethodCalls);
 			builder.AppendLine();
 			builder.AppendFormat("  Pending method invocations: {0}", _endPoint.NumPendingMethodInvocations);
+			builder.AppendLine();
+			builder.AppendFormat("  Rejected method invocations: {0}", _endPoint.NumRejectedMethodInvocations);
 			var rtt = _endPoint.AverageRoundTripTime;
 			if (rtt != null)
 			{
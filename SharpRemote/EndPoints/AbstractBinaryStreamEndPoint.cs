@@ -1,4 +1,5 @@
 using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.ComponentModel;
 using System.Diagnostics;
@@ -59,6 +60,9 @@ namespace SharpRemote
 		private long _numMessagesSent;
 		private long _numCallsAnswered;
 		private long _numCallsInvoked;
+		private long _numQueuedMethodInvocations;
+		private long _numExecutingMethodInvocations;
+		private long _numRejectedMethodInvocations;
 		
 		/// <inheritdoc />
 		public long NumBytesSent => Interlocked.Read(ref _numBytesSent);
@@ -81,6 +85,15 @@ namespace SharpRemote
 		/// <inheritdoc />
 		public long NumPendingMethodCalls => _pendingMethodCalls.NumPendingCalls;
 
+		/// <inheritdoc />
+		public long NumQueuedMethodInvocations => Interlocked.Read(ref _numQueuedMethodInvocations);
+
+		/// <inheritdoc />
+		public long NumExecutingMethodInvocations => Interlocked.Read(ref _numExecutingMethodInvocations);
+
+		/// <inheritdoc />
+		public long NumRejectedMethodInvocations => Interlocked.Read(ref _numRejectedMethodInvocations);
+
 		/// <inheritdoc />
 		public TimeSpan? AverageRoundTripTime => _latencyMonitor?.RoundtripTime;
 
@@ -97,7 +110,9 @@ namespace SharpRemote
 
 		private readonly EndPointSettings _endpointSettings;
 		private readonly PendingMethodsQueue _pendingMethodCalls;
-		private readonly Dictionary<long, MethodInvocation> _pendingMethodInvocations;
+		private readonly ConcurrentDictionary<long, MethodInvocation> _pendingMethodInvocations;
+		private InvocationQuota _invocationQuota;
+		private readonly PriorityDispatcher _dispatcher;
 		private CancellationTokenSource _cancellationTokenSource;
 
 		#endregion
@@ -148,9 +163,15 @@ namespace SharpRemote
 		private Thread _readThread;
 		private Thread _writeThread;
 
+		/// <summary>
+		///     The read thread while it executes a method with <see cref="Dispatch.Inline" />, null otherwise.
+		/// </summary>
+		private volatile Thread _inlineDispatchThread;
+
 		#endregion
 
 		private int _previousConnectionId;
+		private int _currentConnectionId;
 		private readonly string _name;
 		private readonly object _syncRoot;
 		private readonly bool _waitUponReadWriteError;
@@ -208,7 +229,10 @@ namespace SharpRemote
 
 			_endpointSettings = endPointSettings ?? new EndPointSettings();
 			_pendingMethodCalls = new PendingMethodsQueue(_name, _endpointSettings.MaxConcurrentCalls);
-			_pendingMethodInvocations = new Dictionary<long, MethodInvocation>();
+			_pendingMethodInvocations = new ConcurrentDictionary<long, MethodInvocation>();
+			_invocationQuota = new InvocationQuota(_endpointSettings.MaxConcurrentInvocations);
+			if (_endpointSettings.MaxParallelInvocations > 0)
+				_dispatcher = new PriorityDispatcher(_endpointSettings.MaxParallelInvocations);
 
 			_clientAuthenticator = clientAuthenticator;
 			_serverAuthenticator = serverAuthenticator;
@@ -285,16 +309,24 @@ namespace SharpRemote
 		/// <inheritdoc />
 		public EndPointSettings EndPointSettings => _endpointSettings;
 
+		/// <summary>
+		///     Limits the amount of method invocations of this endpoint not only by
+		///     <see cref="SharpRemote.EndPointSettings.MaxConcurrentInvocations" />, but also by the given quota
+		///     which is shared with other endpoints.
+		/// </summary>
+		/// <remarks>
+		///     Must be called before this endpoint is connected.
+		/// </remarks>
+		/// <param name="sharedQuota"></param>
+		internal void ShareInvocationQuota(InvocationQuota sharedQuota)
+		{
+			_invocationQuota = new InvocationQuota(_endpointSettings.MaxConcurrentInvocations, sharedQuota);
+		}
+
 		/// <inheritdoc />
 		public long NumPendingMethodInvocations
 		{
-			get
-			{
-				lock (_pendingMethodInvocations)
-				{
-					return _pendingMethodInvocations.Count;
-				}
-			}
+			get { return _pendingMethodInvocations.Count; }
 		}
 
 		/// <summary>
@@ -345,7 +377,31 @@ namespace SharpRemote
 				                methodName);
 			}
 
-			return CallRemoteMethodAsync(rpcId, servantId, interfaceType, methodName, arguments);
+			return CallRemoteMethodAsync(rpcId, servantId, interfaceType, methodName, arguments, Priority.Normal);
+		}
+
+		/// <inheritdoc />
+		public Task<MemoryStream> CallRemoteMethodAsync(ulong servantId,
+		                                                string interfaceType,
+		                                                string methodName,
+		                                                MemoryStream arguments,
+		                                                Priority priority)
+		{
+			long rpcId = Interlocked.Increment(ref _nextRpcId);
+
+			if (Log.IsDebugEnabled)
+			{
+				Log.DebugFormat("{0}: {1} to {2}, sending RPC #{3} to {4}.{5} ({6})",
+				                Name,
+				                InternalLocalEndPoint,
+				                InternalRemoteEndPoint,
+				                rpcId,
+				                servantId,
+				                methodName,
+				                priority);
+			}
+
+			return CallRemoteMethodAsync(rpcId, servantId, interfaceType, methodName, arguments, priority);
 		}
 
 		/// <inheritdoc />
@@ -364,7 +420,27 @@ namespace SharpRemote
 				                methodName);
 			}
 
-			return CallRemoteMethod(rpcId, servantId, interfaceType, methodName, arguments);
+			return CallRemoteMethod(rpcId, servantId, interfaceType, methodName, arguments, Priority.Normal);
+		}
+
+		/// <inheritdoc />
+		public MemoryStream CallRemoteMethod(ulong servantId, string interfaceType, string methodName, MemoryStream arguments, Priority priority)
+		{
+			long rpcId = Interlocked.Increment(ref _nextRpcId);
+
+			if (Log.IsDebugEnabled)
+			{
+				Log.DebugFormat("{0}: {1} to {2}, sending RPC #{3} to {4}.{5} ({6})",
+				                Name,
+				                InternalLocalEndPoint,
+				                InternalRemoteEndPoint,
+				                rpcId,
+				                servantId,
+				                methodName,
+				                priority);
+			}
+
+			return CallRemoteMethod(rpcId, servantId, interfaceType, methodName, arguments, priority);
 		}
 
 		/// <inheritdoc />
@@ -408,7 +484,15 @@ namespace SharpRemote
 		public bool IsConnected => InternalRemoteEndPoint != null;
 
 		/// <inheritdoc />
-		public ConnectionId CurrentConnectionId { get; protected set; }
+		/// <remarks>
+		///     Is changed under <see cref="SyncRoot" />, but may be read without acquiring it:
+		///     This allows method invocations to be admitted without contending with connection management.
+		/// </remarks>
+		public ConnectionId CurrentConnectionId
+		{
+			get { return new ConnectionId(Volatile.Read(ref _currentConnectionId)); }
+			protected set { Volatile.Write(ref _currentConnectionId, value.Value); }
+		}
 
 		/// <summary>
 		///    The average roundtrip time of empty method calls between this and the remote
@@ -598,7 +682,8 @@ namespace SharpRemote
 		                                                 ulong servantId,
 		                                                 string interfaceType,
 		                                                 string methodName,
-		                                                 MemoryStream arguments)
+		                                                 MemoryStream arguments,
+		                                                 Priority priority)
 		{
 			var taskSource = new TaskCompletionSource<MemoryStream>();
 			Action<PendingMethodCall> onCallFinished = finishedCall =>
@@ -633,15 +718,25 @@ namespace SharpRemote
 			                            methodName,
 			                            arguments,
 			                            rpcId,
-			                            onCallFinished);
+			                            onCallFinished,
+			                            priority);
 			Interlocked.Increment(ref _numCallsInvoked);
 
 			return taskSource.Task;
 		}
 
 		private MemoryStream CallRemoteMethod(long rpcId, ulong servantId, string interfaceType, string methodName,
-		                                      MemoryStream arguments)
+		                                      MemoryStream arguments, Priority priority)
 		{
+			// The response to this call would have to be read by the very thread which is about to wait for it...
+			if (_inlineDispatchThread == Thread.CurrentThread)
+				throw new InvalidOperationException(
+					string.Format("{0}: Unable to call {1}.{2} (#{3}) because a method with Dispatch.Inline may not synchronously call back into the remote endpoint: This would deadlock the thread reading from the connection",
+					              Name,
+					              interfaceType,
+					              methodName,
+					              servantId));
+
 			PendingMethodCall call = null;
 			try
 			{
@@ -649,7 +744,8 @@ namespace SharpRemote
 				                                   interfaceType,
 				                                   methodName,
 				                                   arguments,
-				                                   rpcId);
+				                                   rpcId,
+				                                   priority: priority);
 
 				Interlocked.Add(ref _numBytesSent, call.MessageLength);
 				Interlocked.Increment(ref _numCallsInvoked);
@@ -769,6 +865,12 @@ namespace SharpRemote
 
 				connectionId = CurrentConnectionId;
 
+				// The connection id MUST be reset before pending invocations are cleared: Inbound calls are
+				// admitted without acquiring the SyncRoot and re-check the connection id after having been
+				// added to the table of pending invocations. Any call admitted after this point is thus
+				// rejected by that check, while those admitted before are removed by the clear below.
+				CurrentConnectionId = ConnectionId.None;
+
 				if (socket != null)
 				{
 					HeartbeatMonitor heartbeatMonitor = _heartbeatMonitor;
@@ -833,8 +935,6 @@ namespace SharpRemote
 					}
 					DisposeAfterDisconnect(socket);
 				}
-
-				CurrentConnectionId = ConnectionId.None;
 			}
 
 			if (emitOnFailure)
@@ -906,10 +1006,7 @@ namespace SharpRemote
 		/// </summary>
 		protected void ClearPendingMethodInvocations()
 		{
-			lock (_pendingMethodInvocations)
-			{
-				_pendingMethodInvocations.Clear();
-			}
+			_pendingMethodInvocations.Clear();
 		}
 
 		/// <summary>
@@ -1015,10 +1112,10 @@ namespace SharpRemote
 			BinaryReader reader,
 			out EndPointDisconnectReason? reason)
 		{
-			if (type == MessageType.Call)
+			if ((type & ~MessageType.PriorityMask) == MessageType.Call)
 			{
 				Interlocked.Increment(ref _numCallsAnswered);
-				return HandleRequest(currentConnectionId, rpcId, reader, out reason);
+				return HandleRequest(currentConnectionId, rpcId, GetPriority(type), reader, out reason);
 			}
 			if ((type & MessageType.Return) != 0)
 			{
@@ -1064,6 +1161,7 @@ namespace SharpRemote
 			IGrain grain,
 			string typeName,
 			string methodName,
+			Priority priority,
 			BinaryReader reader,
 			out EndPointDisconnectReason? reason)
 		{
@@ -1078,8 +1176,27 @@ namespace SharpRemote
 				return true;
 			}
 
+			if (grain.GetDispatchingStrategy(methodName) == Dispatch.Inline)
+			{
+				InvokeInline(connectionId, rpcId, grain, typeName, methodName, reader);
+
+				reason = null;
+				return true;
+			}
+
 			SerialTaskScheduler taskScheduler = grain.GetTaskScheduler(methodName);
 
+			// Heartbeat & latency measurements must never be rejected: Doing so would cause the other
+			// endpoint to assume that we're dead and to tear down the connection.
+			InvocationQuota quota = IsInternalServant(grain.ObjectId) ? null : _invocationQuota;
+
+			// However if those 2 things don't throw, then we dispatch the rest of the method invocation
+			// on the task dispatcher and be done with it here...
+			var completionSource = new TaskCompletionSource<int>();
+			Task task = completionSource.Task;
+
+			var methodInvocation = new MethodInvocation(connectionId, rpcId, grain, methodName, task);
+
 			Action executeMethod = () =>
 				{
 					if (Log.IsDebugEnabled)
@@ -1089,62 +1206,17 @@ namespace SharpRemote
 						                rpcId);
 					}
 
+					Interlocked.Decrement(ref _numQueuedMethodInvocations);
+					Interlocked.Increment(ref _numExecutingMethodInvocations);
 					try
 					{
-						TTransport socket = _socket;
-						if (socket == null)
-						{
-							if (Log.IsDebugEnabled)
-								Log.DebugFormat("{0}: RPC #{1} interrupted because the socket was disconnected",
-								                Name,
-								                rpcId);
-
-							return;
-						}
-
-						var response = new MemoryStream();
-						var writer = new BinaryWriter(response, Encoding.UTF8);
-						try
-						{
-							WriteResponseHeader(rpcId, writer, MessageType.Return);
-							grain.Invoke(methodName, reader, writer);
-							PatchResponseMessageLength(response, writer);
-						}
-						catch (Exception e)
-						{
-							if (Log.IsErrorEnabled)
-							{
-								Log.ErrorFormat("{0}: Caught exception while executing RPC #{1} on {2}.{3} (#{4}): {5}",
-								                Name,
-								                rpcId,
-								                typeName,
-								                methodName,
-								                grain.ObjectId,
-								                e);
-							}
-
-							response.Position = 0;
-							WriteResponseHeader(rpcId, writer, MessageType.Return | MessageType.Exception);
-							WriteException(writer, e);
-							PatchResponseMessageLength(response, writer);
-						}
-
-						var responseLength = (int) response.Length;
-						byte[] data = response.GetBuffer();
-
-						EndPointDisconnectReason error;
-						if (!SynchronizedWrite(socket, data, responseLength, out error))
-						{
-							Disconnect(connectionId, error);
-						}
-					}
-					catch (Exception e)
-					{
-						Log.FatalFormat("{0}: Caught exception while dispatching method invocation, disconnecting: {1}", Name, e);
-						Disconnect(connectionId, EndPointDisconnectReason.UnhandledException);
+						InvokeMethod(connectionId, rpcId, grain, typeName, methodName, reader);
 					}
 					finally
 					{
+						Interlocked.Decrement(ref _numExecutingMethodInvocations);
+						quota?.Leave();
+
 						if (Log.IsDebugEnabled)
 						{
 							Log.DebugFormat("{0}: Invocation of RPC #{1} finished",
@@ -1154,28 +1226,10 @@ namespace SharpRemote
 
 						// Once we've created the task, we remember that there's a method invocation
 						// that's yet to be executed (which tremendously helps debugging problems)
-						lock (_pendingMethodInvocations)
-						{
-							_pendingMethodInvocations.Remove(rpcId);
-						}
+						RemovePendingMethodInvocation(methodInvocation);
 					}
 				};
 
-			// However if those 2 things don't throw, then we dispatch the rest of the method invocation
-			// on the task dispatcher and be done with it here...
-			Task task;
-			TaskCompletionSource<int> completionSource;
-			if (taskScheduler != null)
-			{
-				completionSource = new TaskCompletionSource<int>();
-				task = completionSource.Task;
-			}
-			else
-			{
-				completionSource = null;
-				task = new Task(executeMethod);
-			}
-
 			if (Log.IsDebugEnabled)
 			{
 				Log.DebugFormat("{0}: Queueing RPC #{1}",
@@ -1183,56 +1237,70 @@ namespace SharpRemote
 				                rpcId);
 			}
 
-			var methodInvocation = new MethodInvocation(rpcId, grain, methodName, task);
-			lock (_syncRoot)
-				lock (_pendingMethodInvocations)
-				{
-					if (connectionId != CurrentConnectionId)
-					{
-						// When this is the case then we're about to queue AND execute
-						// a method invocation of a connection that is no longer the current
-						// connection, most likely because this endpoint was disconnected
-						// between retrieving the message from the socket, and this point.
-						// Now that we're disconnected, we can simply ignore this method invocation,
-						// NEITHER queueing it NOR executing it.
+			if (connectionId != CurrentConnectionId)
+			{
+				IgnoreMethodInvocation(connectionId, rpcId);
 
-						if (Log.IsDebugEnabled)
-						{
-							Log.DebugFormat(
-								"{0}: Ignoring RPC invocation request #{1} because it was retrieved from connection '{2}' but now we're in connection '{3}'",
-								Name,
-								rpcId,
-								connectionId,
-								CurrentConnectionId);
-						}
+				reason = null;
+				return true;
+			}
 
-						reason = null;
-						return true;
-					}
+			// Admission doesn't synchronize with connect/disconnect: The table of pending invocations
+			// is concurrent and the connection id is re-checked after an invocation has been added, so
+			// inbound calls neither serialize against each other nor against connection management.
+			if (!TryAddPendingMethodInvocation(methodInvocation))
+			{
+				MethodInvocation existingMethodInvocation;
+				_pendingMethodInvocations.TryGetValue(rpcId, out existingMethodInvocation);
+				IGrain tmp = existingMethodInvocation?.Grain;
+				ulong? grainId = tmp?.ObjectId;
+
+				var builder = new StringBuilder();
+				builder.AppendFormat("{0}: Received RPC invocation request #{1}, but one with the same id is already pending!",
+				                     Name,
+				                     rpcId);
+				builder.AppendFormat("The original request was made '{0}' on '{1}.{2}",
+				                     existingMethodInvocation?.RequestTime,
+				                     grainId,
+				                     existingMethodInvocation?.MethodName);
+				builder.AppendFormat(" (Total pending requests: {0})", _pendingMethodInvocations.Count);
+				Log.Error(builder.ToString());
+
+				reason = EndPointDisconnectReason.RpcDuplicateRequest;
+				return false;
+			}
 
-					MethodInvocation existingMethodInvocation;
-					if (_pendingMethodInvocations.TryGetValue(rpcId, out existingMethodInvocation))
-					{
-						IGrain tmp = existingMethodInvocation.Grain;
-						ulong? grainId = tmp?.ObjectId;
-
-						var builder = new StringBuilder();
-						builder.AppendFormat("{0}: Received RPC invocation request #{1}, but one with the same id is already pending!",
-						                     Name,
-						                     rpcId);
-						builder.AppendFormat("The original request was made '{0}' on '{1}.{2}",
-						                     existingMethodInvocation.RequestTime,
-						                     grainId,
-						                     existingMethodInvocation.MethodName);
-						builder.AppendFormat(" (Total pending requests: {0})", _pendingMethodInvocations.Count);
-						Log.Error(builder.ToString());
-
-						reason = EndPointDisconnectReason.RpcDuplicateRequest;
-						return false;
-					}
+			if (connectionId != CurrentConnectionId)
+			{
+				// We've been disconnected while adding the invocation: It may or may not have been
+				// removed by the disconnect, but it certainly must not be executed anymore.
+				RemovePendingMethodInvocation(methodInvocation);
+				IgnoreMethodInvocation(connectionId, rpcId);
 
-					_pendingMethodInvocations.Add(rpcId, methodInvocation);
-				}
+				reason = null;
+				return true;
+			}
+
+			bool admitted = quota == null || quota.TryEnter();
+			if (admitted)
+			{
+				Interlocked.Increment(ref _numQueuedMethodInvocations);
+			}
+			else
+			{
+				RemovePendingMethodInvocation(methodInvocation);
+			}
+
+			if (!admitted)
+			{
+				// Queueing this invocation would only make matters worse for everyone, hence
+				// we reject it right away and let the caller decide what to do.
+				Interlocked.Increment(ref _numRejectedMethodInvocations);
+				HandleServerBusy(connectionId, rpcId, grain, methodName);
+
+				reason = null;
+				return true;
+			}
 
 			// And then finally start the task to deserialize all method parameters, invoke the mehtod
 			// and then seralize either the return value of the thrown exception...
@@ -1240,15 +1308,214 @@ namespace SharpRemote
 			{
 				taskScheduler.QueueTask(executeMethod, completionSource);
 			}
+			else if (_dispatcher != null)
+			{
+				_dispatcher.QueueTask(executeMethod, completionSource, priority);
+			}
 			else
 			{
-				task.Start(TaskScheduler.Default);
+				Task.Factory.StartNew(() => ExecuteMethodInvocation(executeMethod, completionSource),
+				                      CancellationToken.None,
+				                      TaskCreationOptions.None,
+				                      TaskScheduler.Default);
 			}
 
 			reason = null;
 			return true;
 		}
 
+		/// <summary>
+		///     Adds the given invocation to the table of pending invocations.
+		///     An invocation that is left over from a previous connection is replaced.
+		/// </summary>
+		/// <param name="methodInvocation"></param>
+		/// <returns>False when an invocation with the same id is already pending on the same connection</returns>
+		private bool TryAddPendingMethodInvocation(MethodInvocation methodInvocation)
+		{
+			while (true)
+			{
+				if (_pendingMethodInvocations.TryAdd(methodInvocation.RpcId, methodInvocation))
+					return true;
+
+				MethodInvocation existingMethodInvocation;
+				if (!_pendingMethodInvocations.TryGetValue(methodInvocation.RpcId, out existingMethodInvocation))
+					continue;
+
+				if (existingMethodInvocation.ConnectionId == methodInvocation.ConnectionId)
+					return false;
+
+				if (_pendingMethodInvocations.TryUpdate(methodInvocation.RpcId, methodInvocation, existingMethodInvocation))
+					return true;
+			}
+		}
+
+		/// <summary>
+		///     Removes the given invocation from the table of pending invocations, unless it
+		///     has already been replaced by an invocation of a newer connection.
+		/// </summary>
+		/// <param name="methodInvocation"></param>
+		private void RemovePendingMethodInvocation(MethodInvocation methodInvocation)
+		{
+			((ICollection<KeyValuePair<long, MethodInvocation>>) _pendingMethodInvocations).Remove(
+				new KeyValuePair<long, MethodInvocation>(methodInvocation.RpcId, methodInvocation));
+		}
+
+		private void IgnoreMethodInvocation(ConnectionId connectionId, long rpcId)
+		{
+			// When this is the case then we're about to queue AND execute
+			// a method invocation of a connection that is no longer the current
+			// connection, most likely because this endpoint was disconnected
+			// between retrieving the message from the socket, and this point.
+			// Now that we're disconnected, we can simply ignore this method invocation,
+			// NEITHER queueing it NOR executing it.
+
+			if (Log.IsDebugEnabled)
+			{
+				Log.DebugFormat(
+					"{0}: Ignoring RPC invocation request #{1} because it was retrieved from connection '{2}' but now we're in connection '{3}'",
+					Name,
+					rpcId,
+					connectionId,
+					CurrentConnectionId);
+			}
+		}
+
+		/// <summary>
+		///     Invokes the given method on the calling thread and writes its response (or exception)
+		///     to the socket before returning.
+		/// </summary>
+		/// <param name="connectionId"></param>
+		/// <param name="rpcId"></param>
+		/// <param name="grain"></param>
+		/// <param name="typeName"></param>
+		/// <param name="methodName"></param>
+		/// <param name="reader"></param>
+		private void InvokeMethod(ConnectionId connectionId,
+		                          long rpcId,
+		                          IGrain grain,
+		                          string typeName,
+		                          string methodName,
+		                          BinaryReader reader)
+		{
+			try
+			{
+				TTransport socket = _socket;
+				if (socket == null)
+				{
+					if (Log.IsDebugEnabled)
+						Log.DebugFormat("{0}: RPC #{1} interrupted because the socket was disconnected",
+						                Name,
+						                rpcId);
+
+					return;
+				}
+
+				var response = new MemoryStream();
+				var writer = new BinaryWriter(response, Encoding.UTF8);
+				try
+				{
+					WriteResponseHeader(rpcId, writer, MessageType.Return);
+					grain.Invoke(methodName, reader, writer);
+					PatchResponseMessageLength(response, writer);
+				}
+				catch (Exception e)
+				{
+					if (Log.IsErrorEnabled)
+					{
+						Log.ErrorFormat("{0}: Caught exception while executing RPC #{1} on {2}.{3} (#{4}): {5}",
+						                Name,
+						                rpcId,
+						                typeName,
+						                methodName,
+						                grain.ObjectId,
+						                e);
+					}
+
+					response.Position = 0;
+					WriteResponseHeader(rpcId, writer, MessageType.Return | MessageType.Exception);
+					WriteException(writer, e);
+					PatchResponseMessageLength(response, writer);
+				}
+
+				var responseLength = (int) response.Length;
+				byte[] data = response.GetBuffer();
+
+				EndPointDisconnectReason error;
+				if (!SynchronizedWrite(socket, data, responseLength, out error))
+				{
+					Disconnect(connectionId, error);
+				}
+			}
+			catch (Exception e)
+			{
+				Log.FatalFormat("{0}: Caught exception while dispatching method invocation, disconnecting: {1}", Name, e);
+				Disconnect(connectionId, EndPointDisconnectReason.UnhandledException);
+			}
+		}
+
+		/// <summary>
+		///     Invokes a method with <see cref="Dispatch.Inline" /> directly on the read thread:
+		///     No task is created and the invocation isn't tracked as a pending method invocation.
+		///     Synchronous calls made back into the remote endpoint during the invocation are rejected
+		///     because their response could never be read.
+		/// </summary>
+		/// <param name="connectionId"></param>
+		/// <param name="rpcId"></param>
+		/// <param name="grain"></param>
+		/// <param name="typeName"></param>
+		/// <param name="methodName"></param>
+		/// <param name="reader"></param>
+		private void InvokeInline(ConnectionId connectionId,
+		                          long rpcId,
+		                          IGrain grain,
+		                          string typeName,
+		                          string methodName,
+		                          BinaryReader reader)
+		{
+			// The read thread only ever reads messages of its own connection, hence there's no need
+			// to synchronize with connect/disconnect here: If we've been disconnected in the meantime,
+			// then the response is simply dropped by InvokeMethod.
+			if (connectionId != CurrentConnectionId)
+			{
+				if (Log.IsDebugEnabled)
+				{
+					Log.DebugFormat(
+						"{0}: Ignoring RPC invocation request #{1} because it was retrieved from connection '{2}' but now we're in connection '{3}'",
+						Name,
+						rpcId,
+						connectionId,
+						CurrentConnectionId);
+				}
+
+				return;
+			}
+
+			long start = Stopwatch.GetTimestamp();
+			_inlineDispatchThread = Thread.CurrentThread;
+			try
+			{
+				InvokeMethod(connectionId, rpcId, grain, typeName, methodName, reader);
+			}
+			finally
+			{
+				_inlineDispatchThread = null;
+			}
+			long elapsedTicks = Stopwatch.GetTimestamp() - start;
+
+			var elapsed = TimeSpan.FromSeconds((double) elapsedTicks / Stopwatch.Frequency);
+			if (elapsed > _endpointSettings.InlineDispatchBudget)
+			{
+				Log.WarnFormat("{0}: Inline RPC #{1} on {2}.{3} (#{4}) took {5}ms which exceeds its budget of {6}ms: No other message could be read in the meantime, consider not dispatching this method inline",
+				               Name,
+				               rpcId,
+				               typeName,
+				               methodName,
+				               grain.ObjectId,
+				               elapsed.TotalMilliseconds,
+				               _endpointSettings.InlineDispatchBudget.TotalMilliseconds);
+			}
+		}
+
 		private void HandleNoSuchServant(ConnectionId connectionId,
 		                                 long rpcId,
 		                                 ulong servantId,
@@ -1284,6 +1551,58 @@ namespace SharpRemote
 			}
 		}
 
+		private static bool IsInternalServant(ulong objectId)
+		{
+			return objectId >= ClientHeartbeatServantId;
+		}
+
+		private void HandleServerBusy(ConnectionId connectionId,
+		                              long rpcId,
+		                              IGrain grain,
+		                              string methodName)
+		{
+			TTransport socket = _socket;
+			if (socket == null)
+			{
+				if (Log.IsDebugEnabled)
+					Log.DebugFormat("{0}: RPC #{1} interrupted because the socket was disconnected", Name, rpcId);
+				return;
+			}
+
+			if (Log.IsDebugEnabled)
+			{
+				Log.DebugFormat("{0}: Rejecting RPC #{1} '{2}' on grain #{3} because too many invocations are pending",
+				                Name,
+				                rpcId,
+				                methodName,
+				                grain.ObjectId);
+			}
+
+			var response = new MemoryStream();
+			var writer = new BinaryWriter(response, Encoding.UTF8);
+			WriteResponseHeader(rpcId, writer, MessageType.Return | MessageType.Exception);
+
+			var e = new ServerBusyException(
+				string.Format(
+					"{0}: RPC #{1} '{2}' on grain #{3} has been rejected because too many invocations are pending",
+					Name,
+					rpcId,
+					methodName,
+					grain.ObjectId));
+
+			WriteException(writer, e);
+			PatchResponseMessageLength(response, writer);
+
+			var responseLength = (int) response.Length;
+			byte[] data = response.GetBuffer();
+
+			EndPointDisconnectReason error;
+			if (!SynchronizedWrite(socket, data, responseLength, out error))
+			{
+				Disconnect(connectionId, error);
+			}
+		}
+
 		private void HandleTypeMismatch(ConnectionId connectionId,
 		                                long rpcId,
 		                                IGrain grain,
@@ -1321,6 +1640,7 @@ namespace SharpRemote
 
 		private bool HandleRequest(ConnectionId connectionId,
 		                           long rpcId,
+		                           Priority priority,
 		                           BinaryReader reader,
 		                           out EndPointDisconnectReason? disconnectReason)
 		{
@@ -1339,6 +1659,7 @@ namespace SharpRemote
 				                                servant,
 				                                typeName,
 				                                methodName,
+				                                priority,
 				                                reader,
 				                                out disconnectReason);
 			}
@@ -1354,6 +1675,7 @@ namespace SharpRemote
 				                                proxy,
 				                                typeName,
 				                                methodName,
+				                                priority,
 				                                reader,
 				                                out disconnectReason);
 			}
@@ -1372,6 +1694,34 @@ namespace SharpRemote
 			return true;
 		}
 
+		private static Priority GetPriority(MessageType type)
+		{
+			switch (type & MessageType.PriorityMask)
+			{
+				case MessageType.HighPriority:
+					return Priority.High;
+
+				case MessageType.BulkPriority:
+					return Priority.Bulk;
+
+				default:
+					return Priority.Normal;
+			}
+		}
+
+		private static void ExecuteMethodInvocation(Action executeMethod, TaskCompletionSource<int> completionSource)
+		{
+			try
+			{
+				executeMethod();
+				completionSource.SetResult(0);
+			}
+			catch (Exception e)
+			{
+				completionSource.SetException(e);
+			}
+		}
+
 		private static bool IsTypeSafe(Type getType, string typeName)
 		{
 			string actualTypeName = getType.FullName;
@@ -2005,7 +2355,9 @@ namespace SharpRemote
 							break;
 						}
 
-						var stream = new MemoryStream(buffer, false);
+						// Every message gets its own buffer which is publicly visible so that
+						// byte segments can be handed out as slices of it instead of copies.
+						var stream = new MemoryStream(buffer, 0, length, false, true);
 						var reader = new BinaryReader(stream);
 						long rpcId = reader.ReadInt64();
 						var type = (MessageType) reader.ReadByte();
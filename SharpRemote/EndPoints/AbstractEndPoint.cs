@@ -1,9 +1,6 @@
 ﻿using System;
 using System.IO;
-using System.Reflection;
-using System.Runtime.Serialization;
-using System.Runtime.Serialization.Formatters.Binary;
-using log4net;
+using SharpRemote.CodeGeneration.Serialization.Binary;
 
 // ReSharper disable CheckNamespace
 namespace SharpRemote
@@ -14,8 +11,6 @@ namespace SharpRemote
 	/// </summary>
 	public abstract class AbstractEndPoint
 	{
-		private static readonly ILog Log = LogManager.GetLogger(MethodBase.GetCurrentMethod().DeclaringType);
-
 		#region Static Methods
 
 		/// <summary>
@@ -25,37 +20,12 @@ namespace SharpRemote
 		/// <param name="e"></param>
 		internal static void WriteException(BinaryWriter writer, Exception e)
 		{
-			Stream stream = writer.BaseStream;
-			long start = stream.Position;
-			var formatter = new BinaryFormatter();
-
-			try
-			{
-				formatter.Serialize(stream, e);
-			}
-			catch (Exception exception)
-			{
-				Log.WarnFormat("Unable to serialize exception: {0}", exception);
-
-				// TODO: Log this..
-				writer.Flush();
-				stream.Position = start;
-				formatter.Serialize(stream, new UnserializableException(e));
-			}
-			// TODO: Catch SecurityException and serialize it along with the original exception (plus figure out when it'll be thrown)
+			BinaryExceptionSerializer.Write(writer, e);
 		}
 
 		internal static Exception ReadException(BinaryReader reader)
 		{
-			// I will never understand why the remote stacktrace is ONLY ever preserved for
-			// exceptions which cross app domains. Wouldn't it also be useful when traversing machines?!
-			// Anyways, this feature is super important when working with distributed software so we'll
-			// have to lie here in order to get what we want...
-			// (Proof: https://referencesource.microsoft.com/#mscorlib/system/exception.cs)
-			var formatter = new BinaryFormatter(null, new StreamingContext(StreamingContextStates.CrossAppDomain));
-			var e = (Exception)formatter.Deserialize(reader.BaseStream);
-			// TODO: Catch both exceptions and throw an appropriate replacement informing the user of this problem
-			return e;
+			return BinaryExceptionSerializer.Read(reader);
 		}
 
 		#endregion
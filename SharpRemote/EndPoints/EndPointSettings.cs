@@ -1,3 +1,5 @@
+using System;
+
 // ReSharper disable CheckNamespace
 namespace SharpRemote
 // ReSharper restore CheckNamespace
@@ -15,5 +17,55 @@ namespace SharpRemote
 		/// Defaults to 2000.
 		/// </remarks>
 		public int MaxConcurrentCalls = 2000;
+
+		/// <summary>
+		/// The maximum number of method invocations (issued by the remote endpoint) which may be queued
+		/// or executing at any given time. Any further invocation is rejected immediately and the caller's
+		/// method call throws a <see cref="ServerBusyException"/>.
+		/// </summary>
+		/// <remarks>
+		/// Defaults to 10000.
+		/// </remarks>
+		/// <remarks>
+		/// Methods with <see cref="Dispatch.Inline"/> are never queued and therefore not affected by this limit.
+		/// </remarks>
+		public int MaxConcurrentInvocations = 10000;
+
+		/// <summary>
+		/// The maximum number of method invocations which may be queued or executing at any given time,
+		/// summed over all connections of a <see cref="SocketServer"/>. Any further invocation is rejected
+		/// immediately and the caller's method call throws a <see cref="ServerBusyException"/>.
+		/// </summary>
+		/// <remarks>
+		/// Defaults to 50000.
+		/// </remarks>
+		/// <remarks>
+		/// Only used by <see cref="SocketServer"/>, ignored otherwise.
+		/// </remarks>
+		public int MaxConcurrentServerInvocations = 50000;
+
+		/// <summary>
+		/// The maximum number of method invocations which are executed in parallel or 0 when
+		/// the number of parallel invocations shall not be limited.
+		/// When set, further invocations are queued by their <see cref="Priority"/> and executed
+		/// as soon as a previous invocation has finished.
+		/// </summary>
+		/// <remarks>
+		/// Defaults to 0 (unlimited): Every invocation is started on the thread pool right away
+		/// and <see cref="PriorityAttribute"/> has no effect on the order in which invocations are started.
+		/// Setting a limit may deadlock servants whose methods block until another invocation arrives:
+		/// Once all workers are occupied by such methods, the invocation they're waiting for is never started.
+		/// Methods with a <see cref="Dispatch"/> other than <see cref="Dispatch.DoNotSerialize"/>
+		/// are not affected by this limit.
+		/// </remarks>
+		public int MaxParallelInvocations;
+
+		/// <summary>
+		/// The amount of time a method with <see cref="Dispatch.Inline"/> may take before a warning is logged.
+		/// </summary>
+		/// <remarks>
+		/// Defaults to 10 milliseconds.
+		/// </remarks>
+		public TimeSpan InlineDispatchBudget = TimeSpan.FromMilliseconds(10);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+﻿using System.Threading;
+
+// ReSharper disable CheckNamespace
+namespace SharpRemote
+// ReSharper restore CheckNamespace
+{
+	/// <summary>
+	///     Limits the amount of method invocations which may be queued or executing at the same time.
+	///     A quota may be nested in another one (for example all endpoints of a <see cref="SocketServer" />
+	///     share one quota), in which case an invocation is only admitted if both quotas admit it.
+	/// </summary>
+	/// <remarks>
+	///     This class is thread-safe.
+	/// </remarks>
+	internal sealed class InvocationQuota
+	{
+		private readonly int _maximum;
+		private readonly InvocationQuota _parent;
+		private int _count;
+
+		public InvocationQuota(int maximum, InvocationQuota parent = null)
+		{
+			_maximum = maximum;
+			_parent = parent;
+		}
+
+		/// <summary>
+		///     The amount of method invocations which have been admitted, but not yet left.
+		/// </summary>
+		public int Count => Volatile.Read(ref _count);
+
+		/// <summary>
+		///     Tries to admit another method invocation.
+		///     Every successful call must be followed by exactly one call to <see cref="Leave" />
+		///     once the invocation has finished.
+		/// </summary>
+		/// <returns>True when the invocation was admitted, false when the quota is exhausted</returns>
+		public bool TryEnter()
+		{
+			if (Interlocked.Increment(ref _count) > _maximum)
+			{
+				Interlocked.Decrement(ref _count);
+				return false;
+			}
+
+			if (_parent != null && !_parent.TryEnter())
+			{
+				Interlocked.Decrement(ref _count);
+				return false;
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		///     Releases a method invocation previously admitted by <see cref="TryEnter" />.
+		/// </summary>
+		public void Leave()
+		{
+			_parent?.Leave();
+			Interlocked.Decrement(ref _count);
+		}
+	}
+}
\ No newline at end of file
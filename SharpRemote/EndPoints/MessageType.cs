@@ -10,6 +10,18 @@ namespace SharpRemote.EndPoints
 		Exception = 0x4,
 		Goodbye = 0x8,
 
+		/// <summary>
+		/// May be combined with <see cref="Call"/> to indicate that the call has <see cref="Priority.High"/>.
+		/// </summary>
+		HighPriority = 0x10,
+
+		/// <summary>
+		/// May be combined with <see cref="Call"/> to indicate that the call has <see cref="Priority.Bulk"/>.
+		/// </summary>
+		BulkPriority = 0x20,
+
+		PriorityMask = HighPriority | BulkPriority,
+
 		None = 0
 	}
 }
\ No newline at end of file
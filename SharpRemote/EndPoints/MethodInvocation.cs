@@ -8,8 +8,13 @@ namespace SharpRemote
 	/// <summary>
 	///     Represents a currently executing or pending method invocation.
 	/// </summary>
-	internal struct MethodInvocation
+	internal sealed class MethodInvocation
 	{
+		/// <summary>
+		/// The connection from which the method invocation request was received.
+		/// </summary>
+		public readonly ConnectionId ConnectionId;
+
 		/// <summary>
 		/// The time the method invocation request was initially processed (but not yet executed).
 		/// </summary>
@@ -35,8 +40,9 @@ namespace SharpRemote
 		/// </summary>
 		public readonly Task Task;
 
-		public MethodInvocation(long rpcId, IGrain grain, string methodName, Task task)
+		public MethodInvocation(ConnectionId connectionId, long rpcId, IGrain grain, string methodName, Task task)
 		{
+			ConnectionId = connectionId;
 			RequestTime = DateTime.Now;
 			RpcId = rpcId;
 			Grain = grain;
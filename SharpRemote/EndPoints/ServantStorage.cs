@@ -72,6 +72,8 @@ namespace SharpRemote.EndPoints
 			lock (_syncRoot)
 			{
 				_servantsBySubject?.Dispose();
+				foreach (var servant in _servantsById.Values)
+					(servant as IDisposable)?.Dispose();
 				_servantsById.Clear();
 			}
 		}
@@ -156,6 +158,7 @@ namespace SharpRemote.EndPoints
 							                servant.ObjectId);
 
 						_servantsById.Remove(servant.ObjectId);
+						(servant as IDisposable)?.Dispose();
 					}
 
 					_numServantsCollected += collectedServants.Count;
@@ -35,6 +35,7 @@ namespace SharpRemote
 		private readonly string _name;
 
 		private readonly Dictionary<ulong, ISubjectRegistration> _subjects;
+		private readonly InvocationQuota _invocationQuota;
 		private readonly object _syncRoot;
 		private bool _isDisposed;
 		private IPEndPoint _localEndPoint;
@@ -69,6 +70,8 @@ namespace SharpRemote
 			_latencySettings = latencySettings;
 			_endPointSettings = endPointSettings;
 
+			_invocationQuota = new InvocationQuota((endPointSettings ?? new EndPointSettings()).MaxConcurrentServerInvocations);
+
 			_syncRoot = new object();
 			_subjects = new Dictionary<ulong, ISubjectRegistration>();
 			_internalEndPoints = new HashSet<ISocketEndPoint>();
@@ -191,6 +194,24 @@ namespace SharpRemote
 			get { return Connections.Sum(x => x.NumPendingMethodInvocations); }
 		}
 
+		/// <inheritdoc />
+		public long NumQueuedMethodInvocations
+		{
+			get { return Connections.Sum(x => x.NumQueuedMethodInvocations); }
+		}
+
+		/// <inheritdoc />
+		public long NumExecutingMethodInvocations
+		{
+			get { return Connections.Sum(x => x.NumExecutingMethodInvocations); }
+		}
+
+		/// <inheritdoc />
+		public long NumRejectedMethodInvocations
+		{
+			get { return Connections.Sum(x => x.NumRejectedMethodInvocations); }
+		}
+
 		/// <inheritdoc />
 		public TimeSpan? AverageRoundTripTime
 		{
@@ -376,6 +397,7 @@ namespace SharpRemote
 			                                  heartbeatSettings: _heartbeatSettings,
 			                                  latencySettings: _latencySettings,
 			                                  endPointSettings: _endPointSettings);
+			endPoint.ShareInvocationQuota(_invocationQuota);
 			try
 			{
 				var stopwatch = Stopwatch.StartNew();
@@ -0,0 +1,52 @@
+﻿using System;
+using System.Runtime.Serialization;
+
+// ReSharper disable CheckNamespace
+namespace SharpRemote
+// ReSharper restore CheckNamespace
+{
+	/// <summary>
+	///     This exception is thrown when a synchronous call on a proxy, or an event on a subject is invoked, but the other endpoint
+	///     refused to execute it because it already has too many pending method invocations.
+	/// </summary>
+	/// <remarks>
+	///     The method has NOT been executed and it is safe to call it again at a later time.
+	/// </remarks>
+	/// <remarks>
+	///     The amount of concurrent method invocations is limited by <see cref="EndPointSettings.MaxConcurrentInvocations" />
+	///     and <see cref="EndPointSettings.MaxConcurrentServerInvocations" />.
+	/// </remarks>
+	[Serializable]
+	public class ServerBusyException
+		: RemoteProcedureCallCanceledException
+	{
+		/// <summary>
+		///     Deserialization ctor.
+		/// </summary>
+		/// <param name="info"></param>
+		/// <param name="context"></param>
+		public ServerBusyException(SerializationInfo info, StreamingContext context)
+			: base(info, context)
+		{
+		}
+
+		/// <summary>
+		///     Initializes a new instance of this exception with the given message and inner exception
+		///     that is the cause of this exception.
+		/// </summary>
+		/// <param name="message"></param>
+		/// <param name="innerException"></param>
+		public ServerBusyException(string message, Exception innerException = null)
+			: base(message, innerException)
+		{
+		}
+
+		/// <summary>
+		///     Initializes a new instance of this exception.
+		/// </summary>
+		public ServerBusyException()
+			: base("The remote procedure call has been rejected because the server is busy")
+		{
+		}
+	}
+}
\ No newline at end of file
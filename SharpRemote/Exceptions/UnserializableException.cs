@@ -54,7 +54,7 @@ namespace SharpRemote
 			_originalStacktrace = originalException.StackTrace;
 			_originalTypename = originalException.GetType().AssemblyQualifiedName;
 			_originalSource = originalException.Source;
-			_originalTargetSite = originalException.TargetSite.Name;
+			_originalTargetSite = originalException.TargetSite?.Name;
 
 			HResult = originalException.HResult;
 		}
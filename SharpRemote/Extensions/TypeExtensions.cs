@@ -1,6 +1,7 @@
 ﻿using System;
 using System.Linq;
 using System.Reflection;
+using System.Text;
 
 // ReSharper disable CheckNamespace
 namespace SharpRemote
@@ -53,5 +54,39 @@ namespace SharpRemote
 
 			return null;
 		}
+
+		/// <summary>
+		/// Returns the name of the given type, including the full names of its generic arguments
+		/// (if there are any), in a form which may be used as part of the name of a generated type.
+		/// </summary>
+		/// <param name="type"></param>
+		/// <returns></returns>
+		public static string GetGeneratedTypeName(this Type type)
+		{
+			if (!type.IsGenericType)
+				return type.Name;
+
+			var builder = new StringBuilder(type.Name);
+			builder.Append('<');
+			var arguments = type.GetGenericArguments();
+			for (int i = 0; i < arguments.Length; ++i)
+			{
+				if (i != 0)
+					builder.Append(';');
+
+				var argument = arguments[i];
+				builder.Append(argument.Namespace);
+				builder.Append('.');
+				builder.Append(argument.GetGeneratedTypeName());
+			}
+			builder.Append('>');
+
+			// These characters have a special meaning in type names and would prevent the generated
+			// type from being found again via Assembly.GetType()
+			foreach (var c in "[],+&*\\")
+				builder.Replace(c, '_');
+
+			return builder.ToString();
+		}
 	}
 }
\ No newline at end of file
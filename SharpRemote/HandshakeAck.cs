@@ -33,6 +33,20 @@ namespace SharpRemote
 		/// </summary>
 		[DataMember] public Serializer Serializer;
 
+		/// <summary>
+		///     The integer encoding the server wants to use for this connection (in case the
+		///     <see cref="SharpRemote.Serializer.BinarySerializer" /> is used).
+		///     See <see cref="BinarySerializer2.ChooseIntegerEncoding" /> for how it is chosen.
+		/// </summary>
+		[DataMember] public IntegerEncoding IntegerEncoding;
+
+		/// <summary>
+		///     The string encoding the server wants to use for this connection (in case the
+		///     <see cref="SharpRemote.Serializer.BinarySerializer" /> is used).
+		///     See <see cref="BinarySerializer2.ChooseStringEncoding" /> for how it is chosen.
+		/// </summary>
+		[DataMember] public StringEncoding StringEncoding;
+
 		/// <summary>
 		///     A model of all types the server expects the client to know.
 		/// </summary>
@@ -24,6 +24,16 @@ namespace SharpRemote
 		/// </summary>
 		[DataMember] public Serializer SupportedSerializers;
 
+		/// <summary>
+		///     The integer encodings supported by the client (in case the <see cref="SharpRemote.Serializer.BinarySerializer" /> is used).
+		/// </summary>
+		[DataMember] public IntegerEncoding SupportedIntegerEncodings;
+
+		/// <summary>
+		///     The string encodings supported by the client (in case the <see cref="SharpRemote.Serializer.BinarySerializer" /> is used).
+		/// </summary>
+		[DataMember] public StringEncoding SupportedStringEncodings;
+
 		/// <summary>
 		///     A model of all types the client expects the server to know.
 		/// </summary>
@@ -169,6 +169,15 @@ namespace SharpRemote.Hosting
 		/// <inheritdoc />
 		public long NumPendingMethodInvocations => _endPoint.NumPendingMethodInvocations;
 
+		/// <inheritdoc />
+		public long NumQueuedMethodInvocations => _endPoint.NumQueuedMethodInvocations;
+
+		/// <inheritdoc />
+		public long NumExecutingMethodInvocations => _endPoint.NumExecutingMethodInvocations;
+
+		/// <inheritdoc />
+		public long NumRejectedMethodInvocations => _endPoint.NumRejectedMethodInvocations;
+
 		/// <inheritdoc />
 		public TimeSpan? AverageRoundTripTime => _endPoint.AverageRoundTripTime;
 
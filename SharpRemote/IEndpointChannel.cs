@@ -41,5 +41,33 @@ namespace SharpRemote
 		/// <param name="arguments"></param>
 		/// <returns></returns>
 		MemoryStream CallRemoteMethod(ulong servantId, string interfaceType, string methodName, MemoryStream arguments);
+
+		/// <summary>
+		/// Forwards a method call with the given priority to the given servant or proxy.
+		/// </summary>
+		/// <remarks>
+		/// Calls with a higher priority are sent before, and invoked in favour of, calls with a lower priority.
+		/// </remarks>
+		/// <param name="servantId"></param>
+		/// <param name="interfaceType"></param>
+		/// <param name="methodName"></param>
+		/// <param name="arguments"></param>
+		/// <param name="priority"></param>
+		/// <returns></returns>
+		Task<MemoryStream> CallRemoteMethodAsync(ulong servantId, string interfaceType, string methodName, MemoryStream arguments, Priority priority);
+
+		/// <summary>
+		/// Forwards a method call with the given priority to the given servant or proxy.
+		/// </summary>
+		/// <remarks>
+		/// Calls with a higher priority are sent before, and invoked in favour of, calls with a lower priority.
+		/// </remarks>
+		/// <param name="servantId"></param>
+		/// <param name="interfaceType"></param>
+		/// <param name="methodName"></param>
+		/// <param name="arguments"></param>
+		/// <param name="priority"></param>
+		/// <returns></returns>
+		MemoryStream CallRemoteMethod(ulong servantId, string interfaceType, string methodName, MemoryStream arguments, Priority priority);
 	}
 }
\ No newline at end of file
@@ -50,6 +50,14 @@ namespace SharpRemote
 		/// <param name="eventOrMethodName"></param>
 		/// <returns></returns>
 		SerialTaskScheduler GetTaskScheduler(string eventOrMethodName);
+
+		/// <summary>
+		/// Returns the strategy with which the given method shall be dispatched, as specified by its
+		/// <see cref="InvokeAttribute"/> (or <see cref="Dispatch.DoNotSerialize"/> if none was specified).
+		/// </summary>
+		/// <param name="eventOrMethodName"></param>
+		/// <returns></returns>
+		Dispatch GetDispatchingStrategy(string eventOrMethodName);
 #endif
 #endif
 	}
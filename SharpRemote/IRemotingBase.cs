@@ -64,6 +64,26 @@ namespace SharpRemote
 		/// </summary>
 		long NumPendingMethodInvocations { get; }
 
+		/// <summary>
+		///     The current number of method invocations that have been retrieved from the underlying stream,
+		///     but have not started executing yet.
+		/// </summary>
+		long NumQueuedMethodInvocations { get; }
+
+		/// <summary>
+		///     The current number of method invocations that are executing.
+		/// </summary>
+		long NumExecutingMethodInvocations { get; }
+
+		/// <summary>
+		///     The total number of method invocations that have been rejected with a <see cref="ServerBusyException" />
+		///     because too many invocations were already pending.
+		/// </summary>
+		/// <remarks>
+		///     See <see cref="SharpRemote.EndPointSettings.MaxConcurrentInvocations" />.
+		/// </remarks>
+		long NumRejectedMethodInvocations { get; }
+
 		/// <summary>
 		///     The average roundtrip time of messages.
 		/// </summary>
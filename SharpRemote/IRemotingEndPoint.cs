@@ -149,6 +149,7 @@ namespace SharpRemote
 		///     - <see cref="NotConnectedException" />: At the time of calling the proxy's method, no connection to a remote end point was available
 		///     - <see cref="ConnectionLostException" />: The method call was canceled because the connection between proxy and servant was interrupted / lost / disconnected
 		///     - <see cref="UnserializableException" />: The remote method was executed, threw an exception, but the exception could not be serialized
+		///     - <see cref="ServerBusyException" />: The remote method was not executed because the remote endpoint has too many pending method invocations
 		/// </remarks>
 		/// <remarks>
 		///     This method is thread-safe.
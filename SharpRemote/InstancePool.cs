@@ -0,0 +1,163 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Reflection;
+using System.Runtime.CompilerServices;
+using System.Threading;
+
+namespace SharpRemote
+{
+	/// <summary>
+	///     Process-wide pools of instances of types marked with the <see cref="PooledAttribute" />.
+	///     The deserializer rents instances from these pools and the receiver of such an instance returns it
+	///     by calling <see cref="Return" /> once it's done with it.
+	/// </summary>
+	public static class InstancePool
+	{
+		private static readonly ConcurrentDictionary<Type, IPool> Pools;
+
+		static InstancePool()
+		{
+			Pools = new ConcurrentDictionary<Type, IPool>();
+		}
+
+		/// <summary>
+		///     Returns an instance of the given type, either one which has been returned previously
+		///     or a new one if the pool is empty.
+		/// </summary>
+		/// <remarks>
+		///     Called by the generated code, shouldn't be called directly.
+		/// </remarks>
+		/// <typeparam name="T"></typeparam>
+		/// <returns></returns>
+		public static T Rent<T>() where T : class, new()
+		{
+			return Pool<T>.Instance.Rent();
+		}
+
+		/// <summary>
+		///     Returns the given instance to the pool of its type.
+		///     Neither the instance, nor any array it references (if <see cref="PooledAttribute.ReuseArrays" /> is set),
+		///     may be used by the caller afterwards.
+		/// </summary>
+		/// <remarks>
+		///     An instance must be returned AT MOST ONCE per time it has been rented: Returning it twice puts it
+		///     into the pool twice, hence it's handed out to two deserializations at the same time which then
+		///     silently overwrite each other's values.
+		///     Debug builds detect this and throw an <see cref="InvalidOperationException" />, release builds don't.
+		/// </remarks>
+		/// <param name="instance"></param>
+		/// <exception cref="ArgumentNullException">When <paramref name="instance" /> is null</exception>
+		/// <exception cref="ArgumentException">When the type of <paramref name="instance" /> isn't marked with the <see cref="PooledAttribute" /></exception>
+		/// <exception cref="InvalidOperationException">When <paramref name="instance" /> is already in the pool (debug builds only)</exception>
+		public static void Return(object instance)
+		{
+			if (instance == null)
+				throw new ArgumentNullException(nameof(instance));
+
+			GetPool(instance.GetType()).Return(instance);
+		}
+
+		/// <summary>
+		///     The number of instances of the given type which are currently waiting to be rented again.
+		/// </summary>
+		/// <param name="type"></param>
+		/// <returns></returns>
+		public static int GetCount(Type type)
+		{
+			return GetPool(type).Count;
+		}
+
+		private static IPool GetPool(Type type)
+		{
+			IPool pool;
+			if (Pools.TryGetValue(type, out pool))
+				return pool;
+
+			if (type.GetCustomAttribute<PooledAttribute>(false) == null)
+				throw new ArgumentException(string.Format("The type '{0}' is not marked with the [Pooled] attribute", type));
+
+			var instance = typeof(Pool<>).MakeGenericType(type).GetField("Instance", BindingFlags.Public | BindingFlags.Static);
+			return (IPool) instance.GetValue(null);
+		}
+
+		private interface IPool
+		{
+			int Count { get; }
+			void Return(object instance);
+		}
+
+		private sealed class Pool<T>
+			: IPool
+			where T : class, new()
+		{
+			public static readonly Pool<T> Instance = new Pool<T>();
+
+			private readonly ConcurrentBag<T> _instances;
+			private readonly int _maximumSize;
+			private int _count;
+#if DEBUG
+			private readonly ConditionalWeakTable<T, object> _pooledInstances;
+#endif
+
+			private Pool()
+			{
+				var attribute = typeof(T).GetCustomAttribute<PooledAttribute>(false);
+				_maximumSize = attribute != null ? attribute.MaximumSize : PooledAttribute.DefaultMaximumSize;
+				_instances = new ConcurrentBag<T>();
+#if DEBUG
+				_pooledInstances = new ConditionalWeakTable<T, object>();
+#endif
+				Pools.TryAdd(typeof(T), this);
+			}
+
+			public int Count => Volatile.Read(ref _count);
+
+			public T Rent()
+			{
+				T instance;
+				if (_instances.TryTake(out instance))
+				{
+					Interlocked.Decrement(ref _count);
+#if DEBUG
+					lock (_pooledInstances)
+					{
+						_pooledInstances.Remove(instance);
+					}
+#endif
+					return instance;
+				}
+
+				return new T();
+			}
+
+			public void Return(object instance)
+			{
+				var value = (T) instance;
+#if DEBUG
+				lock (_pooledInstances)
+				{
+					object unused;
+					if (_pooledInstances.TryGetValue(value, out unused))
+						throw new InvalidOperationException(string.Format("This instance of '{0}' has already been returned to the pool", typeof(T)));
+
+					_pooledInstances.Add(value, null);
+				}
+#endif
+
+				if (Interlocked.Increment(ref _count) > _maximumSize)
+				{
+					Interlocked.Decrement(ref _count);
+#if DEBUG
+					lock (_pooledInstances)
+					{
+						_pooledInstances.Remove(value);
+					}
+#endif
+					return;
+				}
+
+				_instances.Add(value);
+			}
+		}
+	}
+}
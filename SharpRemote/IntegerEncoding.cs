@@ -0,0 +1,33 @@
+﻿using System;
+using System.Runtime.Serialization;
+
+namespace SharpRemote
+{
+	/// <summary>
+	///     Defines how integers (and enums) are encoded by the <see cref="BinarySerializer2" />.
+	///     Both endpoints announce the encodings they support during the handshake
+	///     (<see cref="HandshakeSyn.SupportedIntegerEncodings" />) and the server picks the one
+	///     used for the connection (<see cref="HandshakeAck.IntegerEncoding" />).
+	/// </summary>
+	[Flags]
+	[DataContract]
+	public enum IntegerEncoding : byte
+	{
+		/// <summary>
+		///     No encoding.
+		/// </summary>
+		[EnumMember] None = 0,
+
+		/// <summary>
+		///     Every value is written with the fixed width of its type, e.g. 4 bytes for an <see cref="int" />.
+		/// </summary>
+		[EnumMember] Fixed = 0x01,
+
+		/// <summary>
+		///     32 and 64 bit values are written as LEB128 variable length integers (signed values are zigzag encoded first)
+		///     which requires between 1 and 5 (or 10) bytes: Small values, such as ids, counts and most enum values
+		///     only require one or two bytes.
+		/// </summary>
+		[EnumMember] Varint = 0x02
+	}
+}
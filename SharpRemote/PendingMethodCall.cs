@@ -1,5 +1,6 @@
 ﻿using System;
 using System.IO;
+using System.Text;
 using System.Threading;
 using SharpRemote.EndPoints;
 
@@ -16,6 +17,19 @@ namespace SharpRemote
 	internal sealed class PendingMethodCall
 		: IDisposable
 	{
+		/// <summary>
+		///     The largest buffer a recycled call keeps around: Anything bigger is released
+		///     once a smaller message is written again.
+		/// </summary>
+		private const int MaximumRetainedCapacity = 4 * 1024 * 1024;
+
+		private const int MinimumCapacity = 256;
+
+		/// <summary>
+		///     Length, rpc id, message type and servant id.
+		/// </summary>
+		private const int FixedHeaderSize = 4 + 8 + 1 + 8;
+
 		private readonly MemoryStream _message;
 		private readonly ManualResetEvent _waitHandle;
 		private readonly BinaryWriter _writer;
@@ -87,13 +101,16 @@ namespace SharpRemote
 		                  string methodName,
 		                  MemoryStream arguments,
 		                  long rpcId,
-		                  Action<PendingMethodCall> callback)
+		                  Action<PendingMethodCall> callback,
+		                  Priority priority = Priority.Normal)
 		{
+			EnsureCapacity(GetMessageSize(interfaceType, methodName, arguments));
+
 			// The first 4 bytes of the message shall contain its length which we only
 			// know after writing the message, hence we offset the stream by 4 bytes first
 			_message.Position = 4;
 			_writer.Write(rpcId);
-			_writer.Write((byte) MessageType.Call);
+			_writer.Write((byte) (MessageType.Call | GetPriorityFlag(priority)));
 			_writer.Write(servantId);
 			_writer.Write(interfaceType);
 			_writer.Write(methodName);
@@ -120,6 +137,58 @@ namespace SharpRemote
 			_reader = null;
 		}
 
+		private static long GetMessageSize(string interfaceType, string methodName, MemoryStream arguments)
+		{
+			// Strings are preceded by their 7-bit encoded length which occupies at most 5 bytes
+			long size = FixedHeaderSize +
+			            5 + Encoding.UTF8.GetByteCount(interfaceType) +
+			            5 + Encoding.UTF8.GetByteCount(methodName);
+			if (arguments != null)
+				size += arguments.Length;
+			return size;
+		}
+
+		/// <summary>
+		///     Allocates a buffer which is large enough to hold the given message in one go: Letting
+		///     the stream grow by itself would copy a large message several times over (and leave
+		///     a buffer of up to twice its size on the large object heap).
+		/// </summary>
+		/// <param name="messageSize"></param>
+		private void EnsureCapacity(long messageSize)
+		{
+			var capacity = _message.Capacity;
+			if (messageSize > capacity ||
+			    capacity > MaximumRetainedCapacity && messageSize <= MaximumRetainedCapacity)
+			{
+				if (messageSize > int.MaxValue)
+					return;
+
+				// Small messages still grow the buffer geometrically so that a call which is recycled
+				// over and over doesn't re-allocate for every slightly larger message.
+				long newCapacity = Math.Max(messageSize,
+				                            Math.Min(Math.Max(2L * capacity, MinimumCapacity), MaximumRetainedCapacity));
+
+				// The previous message's contents are of no interest anymore and shall not be copied over
+				_message.SetLength(0);
+				_message.Capacity = (int) newCapacity;
+			}
+		}
+
+		private static MessageType GetPriorityFlag(Priority priority)
+		{
+			switch (priority)
+			{
+				case Priority.High:
+					return MessageType.HighPriority;
+
+				case Priority.Bulk:
+					return MessageType.BulkPriority;
+
+				default:
+					return MessageType.None;
+			}
+		}
+
 		public void Wait()
 		{
 			if (!_waitHandle.WaitOne())
@@ -216,7 +216,8 @@ namespace SharpRemote
 		                                 string methodName,
 		                                 MemoryStream arguments,
 		                                 long rpcId,
-		                                 Action<PendingMethodCall> callback = null)
+		                                 Action<PendingMethodCall> callback = null,
+		                                 Priority priority = Priority.Normal)
 		{
 			PendingMethodCall message;
 
@@ -236,13 +237,13 @@ namespace SharpRemote
 				PendingMethodsEventSource.Instance.QueueCountChanged(_endPointName, numPendingRpcs);
 			}
 
-			message.Reset(servantId, interfaceType, methodName, arguments, rpcId, callback);
+			message.Reset(servantId, interfaceType, methodName, arguments, rpcId, callback, priority);
 
 			// _pendingWrites can be null, if immediately after we leave this lock, IsConnected is set to false
 			BlockingQueue<PendingMethodCall> pendingWrites = _pendingWrites;
 			if (pendingWrites != null)
 			{
-				pendingWrites.Enqueue(message);
+				pendingWrites.Enqueue(message, priority);
 			}
 
 			return message;
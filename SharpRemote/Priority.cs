@@ -0,0 +1,32 @@
+﻿using System.Runtime.Serialization;
+
+namespace SharpRemote
+{
+	/// <summary>
+	/// Defines the priorities with which method calls are transmitted and invoked.
+	/// </summary>
+	/// <remarks>
+	/// Invocations of different priorities are scheduled in a weighted fair manner: Higher priorities
+	/// are preferred, but no priority is starved completely.
+	/// </remarks>
+	[DataContract]
+	public enum Priority
+	{
+		/// <summary>
+		/// The default priority of every method, event and property.
+		/// </summary>
+		[EnumMember] Normal = 0,
+
+		/// <summary>
+		/// Calls are sent before, and invoked in favour of, calls with a lower priority.
+		/// Should be used for methods which are latency sensitive and short.
+		/// </summary>
+		[EnumMember] High = 1,
+
+		/// <summary>
+		/// Calls are sent after, and invoked less often than, calls with a higher priority.
+		/// Should be used for methods which move large amounts of data or take a long time.
+		/// </summary>
+		[EnumMember] Bulk = 2,
+	}
+}
\ No newline at end of file
@@ -23,12 +23,18 @@ namespace SharpRemote
 		/// <summary>
 		/// NOT YET SUPPORTED.
 		/// </summary>
-		[EnumMember] XmlSerializer = 0x0002
+		[EnumMember] XmlSerializer = 0x0002,
 
 		// <summary>
 		// NOT YET SUPPORTED.
 		// </summary>
 		//[EnumMember]
 		//JsonSerializer = 0x0004
+
+		/// <summary>
+		///     A serializer which produces MessagePack and can thus be read by peers written in other languages,
+		///     see <see cref="SharpRemote.MessagePackSerializer" />.
+		/// </summary>
+		[EnumMember] MessagePackSerializer = 0x0008
 	}
 }
\ No newline at end of file
@@ -0,0 +1,30 @@
+﻿using System.Threading.Tasks;
+using SharpRemote.Attributes;
+
+namespace SharpRemote.Streaming
+{
+	/// <summary>
+	///     The interface through which the caller of a method attributed with the <see cref="StreamedAttribute" />
+	///     pulls the result of that method from the servant, chunk by chunk.
+	/// </summary>
+	/// <remarks>
+	///     Used by generated proxies and servants, not intended to be used directly.
+	/// </remarks>
+	/// <typeparam name="T"></typeparam>
+	public interface IStreamedEnumerator<T>
+	{
+		/// <summary>
+		///     Retrieves the next chunk of at most <paramref name="maxCount" /> items.
+		///     A chunk of less than <paramref name="maxCount" /> items is the last chunk of the sequence.
+		/// </summary>
+		/// <param name="maxCount"></param>
+		/// <returns></returns>
+		Task<T[]> Next(int maxCount);
+
+		/// <summary>
+		///     Stops the enumeration before the end of the sequence has been reached.
+		/// </summary>
+		[AsyncRemote]
+		void Close();
+	}
+}
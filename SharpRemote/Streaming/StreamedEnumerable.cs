@@ -0,0 +1,173 @@
+﻿using System;
+using System.Collections;
+using System.Collections.Generic;
+using System.IO;
+using System.Reflection;
+using System.Runtime.ExceptionServices;
+using System.Threading;
+using System.Threading.Tasks;
+using log4net;
+
+namespace SharpRemote.Streaming
+{
+	/// <summary>
+	///     Responsible for transmitting the result of a method attributed with the <see cref="StreamedAttribute" />.
+	/// </summary>
+	/// <remarks>
+	///     Used by generated proxies and servants, not intended to be used directly.
+	/// </remarks>
+	public static class StreamedEnumerable
+	{
+		/// <summary>
+		///     Registers a servant which produces the given sequence on demand and writes its id to the given writer.
+		/// </summary>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="writer"></param>
+		/// <param name="endPoint"></param>
+		/// <param name="values"></param>
+		/// <param name="idleTimeoutMilliseconds">See <see cref="StreamedAttribute.IdleTimeoutMilliseconds" /></param>
+		public static void Write<T>(BinaryWriter writer, IRemotingEndPoint endPoint, IEnumerable<T> values, int idleTimeoutMilliseconds)
+		{
+			if (values == null)
+			{
+				writer.Write(false);
+				return;
+			}
+
+			IStreamedEnumerator<T> enumerator = new StreamedEnumerator<T>(endPoint, values, idleTimeoutMilliseconds);
+			var servant = endPoint.GetExistingOrCreateNewServant(enumerator);
+			writer.Write(true);
+			writer.Write(servant.ObjectId);
+		}
+
+		/// <summary>
+		///     Reads the id of a servant written by <see cref="Write{T}" /> and returns a lazy sequence
+		///     which pulls its items from that servant.
+		/// </summary>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="reader"></param>
+		/// <param name="endPoint"></param>
+		/// <param name="chunkSize"></param>
+		/// <returns></returns>
+		public static IEnumerable<T> Read<T>(BinaryReader reader, IRemotingEndPoint endPoint, int chunkSize)
+		{
+			if (!reader.ReadBoolean())
+				return null;
+
+			var objectId = reader.ReadUInt64();
+			var enumerator = endPoint.GetExistingOrCreateNewProxy<IStreamedEnumerator<T>>(objectId);
+			return new StreamedEnumerable<T>(enumerator, chunkSize);
+		}
+	}
+
+	/// <summary>
+	///     The caller side of a streamed result: Pulls the items from the servant while it is being enumerated.
+	///     The next chunk is requested as soon as the current one arrived so that the servant can produce it
+	///     while the current chunk is being consumed.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	internal sealed class StreamedEnumerable<T>
+		: IEnumerable<T>
+	{
+		private static readonly ILog Log = LogManager.GetLogger(MethodBase.GetCurrentMethod().DeclaringType);
+
+		private readonly IStreamedEnumerator<T> _enumerator;
+		private readonly int _chunkSize;
+		private int _isEnumerated;
+
+		public StreamedEnumerable(IStreamedEnumerator<T> enumerator, int chunkSize)
+		{
+			if (chunkSize <= 0)
+				throw new ArgumentOutOfRangeException(nameof(chunkSize));
+
+			_enumerator = enumerator;
+			_chunkSize = chunkSize;
+		}
+
+		public IEnumerator<T> GetEnumerator()
+		{
+			if (Interlocked.Exchange(ref _isEnumerated, 1) != 0)
+				throw new InvalidOperationException("A streamed result can only be enumerated once");
+
+			return Enumerate();
+		}
+
+		IEnumerator IEnumerable.GetEnumerator()
+		{
+			return GetEnumerator();
+		}
+
+		private IEnumerator<T> Enumerate()
+		{
+			int requested = 1;
+			var pending = _enumerator.Next(requested);
+			bool isFinished = false;
+			try
+			{
+				while (true)
+				{
+					var chunk = GetResult(pending);
+					if (chunk.Length < requested)
+					{
+						isFinished = true;
+					}
+					else
+					{
+						requested = Math.Min(requested * 2, _chunkSize);
+						pending = _enumerator.Next(requested);
+					}
+
+					foreach (var item in chunk)
+						yield return item;
+
+					if (isFinished)
+						yield break;
+				}
+			}
+			finally
+			{
+				if (!isFinished)
+					Close(pending);
+			}
+		}
+
+		private void Close(Task<T[]> pending)
+		{
+			// The chunk which has been requested ahead of time is no longer of interest, but if its retrieval
+			// failed (for example because the servant ended the enumeration in the meantime), then that failure
+			// must be observed or it will be reported as an unobserved task exception later on.
+			pending.ContinueWith(ObserveException, TaskContinuationOptions.OnlyOnFaulted);
+
+			try
+			{
+				_enumerator.Close();
+			}
+			catch (Exception e)
+			{
+				// Not being able to tell the servant is no reason to fail the caller's Dispose():
+				// The servant ends the enumeration on its own once the connection is dropped or it timed out.
+				Log.DebugFormat("Unable to close streamed result: {0}", e);
+			}
+		}
+
+		private static void ObserveException(Task<T[]> task)
+		{
+			var unused = task.Exception;
+		}
+
+		private static T[] GetResult(Task<T[]> task)
+		{
+			try
+			{
+				return task.Result;
+			}
+			catch (AggregateException e)
+			{
+				var inner = e.Flatten().InnerExceptions;
+				if (inner.Count == 1)
+					ExceptionDispatchInfo.Capture(inner[0]).Throw();
+				throw;
+			}
+		}
+	}
+}
@@ -0,0 +1,132 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Net;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace SharpRemote.Streaming
+{
+	/// <summary>
+	///     The servant side of a streamed result: Produces the chunks of the enumerated sequence on demand.
+	/// </summary>
+	/// <remarks>
+	///     Servants only hold a weak reference to their subject and therefore this object keeps itself alive
+	///     by subscribing to <see cref="IRemotingEndPoint.OnDisconnected" /> until the enumeration has ended.
+	///     An enumeration which the caller didn't ask for another chunk of for the idle timeout is ended as well,
+	///     so that a caller who abandons the result without disposing of it doesn't keep it alive until
+	///     the connection is dropped.
+	/// </remarks>
+	/// <typeparam name="T"></typeparam>
+	internal sealed class StreamedEnumerator<T>
+		: IStreamedEnumerator<T>
+	{
+		private readonly IRemotingEndPoint _endPoint;
+		private readonly object _syncRoot;
+		private readonly int _idleTimeout;
+		private readonly Timer _idleTimer;
+		private IEnumerator<T> _enumerator;
+		private int _lastAccess;
+		private bool _isTimedOut;
+
+		public StreamedEnumerator(IRemotingEndPoint endPoint, IEnumerable<T> values, int idleTimeoutMilliseconds)
+		{
+			_endPoint = endPoint;
+			_syncRoot = new object();
+			_enumerator = values.GetEnumerator();
+			_endPoint.OnDisconnected += OnDisconnected;
+
+			if (idleTimeoutMilliseconds > 0)
+			{
+				_idleTimeout = idleTimeoutMilliseconds;
+				_lastAccess = Environment.TickCount;
+				_idleTimer = new Timer(OnIdleTimer, null, idleTimeoutMilliseconds, Timeout.Infinite);
+			}
+		}
+
+		public Task<T[]> Next(int maxCount)
+		{
+			if (maxCount <= 0)
+				throw new ArgumentOutOfRangeException(nameof(maxCount));
+
+			lock (_syncRoot)
+			{
+				if (_isTimedOut)
+					throw new InvalidOperationException(
+						string.Format("The streamed result has been closed because no chunk has been requested for {0}ms",
+						              _idleTimeout));
+				if (_enumerator == null)
+					return Task.FromResult(new T[0]);
+
+				var chunk = new T[maxCount];
+				int count = 0;
+				try
+				{
+					while (count < maxCount && _enumerator.MoveNext())
+					{
+						chunk[count++] = _enumerator.Current;
+					}
+				}
+				catch (Exception)
+				{
+					Release();
+					throw;
+				}
+
+				if (count < maxCount)
+				{
+					Release();
+					Array.Resize(ref chunk, count);
+				}
+
+				// The enumeration is idle from the moment the chunk has been produced, not requested
+				_lastAccess = Environment.TickCount;
+				return Task.FromResult(chunk);
+			}
+		}
+
+		public void Close()
+		{
+			lock (_syncRoot)
+			{
+				Release();
+			}
+		}
+
+		private void OnDisconnected(EndPoint endPoint, ConnectionId connectionId)
+		{
+			Close();
+		}
+
+		private void OnIdleTimer(object unused)
+		{
+			lock (_syncRoot)
+			{
+				if (_enumerator == null)
+					return;
+
+				// The timer isn't restarted on every chunk, instead it checks upon expiry if the enumeration
+				// has been idle for long enough and if not, waits for the remainder.
+				var idle = unchecked(Environment.TickCount - _lastAccess);
+				if (idle < _idleTimeout)
+				{
+					_idleTimer.Change(_idleTimeout - idle, Timeout.Infinite);
+					return;
+				}
+
+				_isTimedOut = true;
+				Release();
+			}
+		}
+
+		private void Release()
+		{
+			if (_enumerator == null)
+				return;
+
+			_endPoint.OnDisconnected -= OnDisconnected;
+			_idleTimer?.Dispose();
+			_enumerator.Dispose();
+			_enumerator = null;
+		}
+	}
+}
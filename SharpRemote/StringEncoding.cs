@@ -0,0 +1,34 @@
+﻿using System;
+using System.Runtime.Serialization;
+
+namespace SharpRemote
+{
+	/// <summary>
+	///     Defines how strings are encoded by the <see cref="BinarySerializer2" />.
+	///     Both endpoints announce the encodings they support during the handshake
+	///     (<see cref="HandshakeSyn.SupportedStringEncodings" />) and the server picks the one
+	///     used for the connection (<see cref="HandshakeAck.StringEncoding" />).
+	/// </summary>
+	[Flags]
+	[DataContract]
+	public enum StringEncoding : byte
+	{
+		/// <summary>
+		///     No encoding.
+		/// </summary>
+		[EnumMember] None = 0,
+
+		/// <summary>
+		///     Every string is written in full, no matter how often it occurs within a message.
+		/// </summary>
+		[EnumMember] Inline = 0x01,
+
+		/// <summary>
+		///     Every message carries its own (bounded) table of strings: The first occurrence of a string is written
+		///     in full, every further occurrence is written as a small index into that table and deserialized
+		///     into the very same instance. Pays off for messages which repeat the same values over and over,
+		///     such as status or category names of many records.
+		/// </summary>
+		[EnumMember] Table = 0x02
+	}
+}
@@ -0,0 +1,195 @@
+﻿using System;
+using System.Diagnostics;
+using System.IO;
+using System.Reflection;
+using System.Threading;
+using System.Threading.Tasks;
+using log4net;
+
+namespace SharpRemote.Tasks
+{
+	/// <summary>
+	///     Responsible for delivering the raises of a single event attributed with the <see cref="CoalesceAttribute" />
+	///     to the remote endpoint: At most one raise is delivered per interval and the latest raise wins.
+	/// </summary>
+	/// <remarks>
+	///     Used by generated servants, not intended to be used directly.
+	///     The arguments of a raise are only serialized when they're actually delivered, hence
+	///     raises which are superseded by a later one cost no more than boxing their arguments.
+	/// </remarks>
+	public sealed class EventCoalescer
+		: IDisposable
+	{
+		private static readonly ILog Log = LogManager.GetLogger(MethodBase.GetCurrentMethod().DeclaringType);
+
+		private readonly IEndPointChannel _channel;
+		private readonly ulong _objectId;
+		private readonly string _interfaceType;
+		private readonly string _eventName;
+		private readonly Priority _priority;
+		private readonly Func<object[], MemoryStream> _writeArguments;
+		private readonly TimeSpan _interval;
+		private readonly Stopwatch _stopwatch;
+		private readonly Timer _timer;
+		private readonly object _syncRoot;
+
+		private object[] _pendingArguments;
+		private bool _hasPendingArguments;
+		private bool _isScheduled;
+		private bool _isDisposed;
+		private TimeSpan _lastDelivery;
+		private long _numRaised;
+		private long _numDelivered;
+
+		/// <summary>
+		///     Initializes this object.
+		/// </summary>
+		/// <param name="channel">The channel over which the event is delivered</param>
+		/// <param name="objectId">The id of the servant which raises the event</param>
+		/// <param name="interfaceType">The full name of the interface which declares the event</param>
+		/// <param name="eventName">The name of the event</param>
+		/// <param name="priority">The priority with which the event is delivered</param>
+		/// <param name="maxRate">The maximum amount of deliveries per second</param>
+		/// <param name="writeArguments">Serializes the arguments of a raise, is only invoked for raises which are delivered</param>
+		public EventCoalescer(IEndPointChannel channel,
+		                      ulong objectId,
+		                      string interfaceType,
+		                      string eventName,
+		                      Priority priority,
+		                      int maxRate,
+		                      Func<object[], MemoryStream> writeArguments)
+		{
+			if (channel == null) throw new ArgumentNullException(nameof(channel));
+			if (writeArguments == null) throw new ArgumentNullException(nameof(writeArguments));
+			if (maxRate <= 0)
+				throw new ArgumentOutOfRangeException(nameof(maxRate),
+				                                      string.Format("The maximum rate of event {0}.{1} must be greater than zero",
+				                                                    interfaceType,
+				                                                    eventName));
+
+			_channel = channel;
+			_objectId = objectId;
+			_interfaceType = interfaceType;
+			_eventName = eventName;
+			_priority = priority;
+			_writeArguments = writeArguments;
+			_interval = TimeSpan.FromTicks(TimeSpan.TicksPerSecond / maxRate);
+			_stopwatch = Stopwatch.StartNew();
+			_lastDelivery = -_interval;
+			_timer = new Timer(OnTimer);
+			_syncRoot = new object();
+		}
+
+		/// <summary>
+		///     The amount of times the event has been raised.
+		/// </summary>
+		public long NumRaised => Interlocked.Read(ref _numRaised);
+
+		/// <summary>
+		///     The amount of times the event has been delivered to the remote endpoint.
+		/// </summary>
+		public long NumDelivered => Interlocked.Read(ref _numDelivered);
+
+		/// <summary>
+		///     Is called whenever the event is raised: The given arguments are either delivered
+		///     immediately (if the previous delivery is at least one interval ago) or replace
+		///     any arguments which are still waiting to be delivered.
+		/// </summary>
+		/// <param name="arguments">The arguments of the event or null if the event has no arguments</param>
+		public void Post(object[] arguments)
+		{
+			Interlocked.Increment(ref _numRaised);
+
+			lock (_syncRoot)
+			{
+				if (_isDisposed)
+					return;
+
+				_pendingArguments = arguments;
+				_hasPendingArguments = true;
+
+				if (_isScheduled)
+					return;
+
+				var elapsed = _stopwatch.Elapsed - _lastDelivery;
+				if (elapsed < _interval)
+				{
+					_isScheduled = true;
+					_timer.Change(_interval - elapsed, Timeout.InfiniteTimeSpan);
+					return;
+				}
+			}
+
+			Deliver();
+		}
+
+		private void OnTimer(object unused)
+		{
+			lock (_syncRoot)
+			{
+				_isScheduled = false;
+			}
+
+			Deliver();
+		}
+
+		/// <summary>
+		///     Stops this coalescer: Pending arguments are dropped and future raises are ignored.
+		/// </summary>
+		public void Dispose()
+		{
+			lock (_syncRoot)
+			{
+				if (_isDisposed)
+					return;
+
+				_isDisposed = true;
+				_pendingArguments = null;
+				_hasPendingArguments = false;
+				_timer.Dispose();
+			}
+		}
+
+		private void Deliver()
+		{
+			object[] arguments;
+			lock (_syncRoot)
+			{
+				if (_isDisposed || !_hasPendingArguments)
+					return;
+
+				arguments = _pendingArguments;
+				_pendingArguments = null;
+				_hasPendingArguments = false;
+				_lastDelivery = _stopwatch.Elapsed;
+			}
+
+			Interlocked.Increment(ref _numDelivered);
+			try
+			{
+				var stream = _writeArguments(arguments);
+				_channel.CallRemoteMethodAsync(_objectId, _interfaceType, _eventName, stream, _priority)
+				        .ContinueWith(ObserveException, TaskContinuationOptions.OnlyOnFaulted);
+			}
+			catch (Exception e)
+			{
+				// There's nobody to report this exception to: The event was raised on a different
+				// thread (if not on the timer's thread) and is already gone.
+				Log.WarnFormat("Unable to deliver event {0}.{1} of servant #{2}: {3}",
+				               _interfaceType,
+				               _eventName,
+				               _objectId,
+				               e);
+			}
+		}
+
+		private void ObserveException(Task<MemoryStream> task)
+		{
+			Log.WarnFormat("Delivery of event {0}.{1} of servant #{2} failed: {3}",
+			               _interfaceType,
+			               _eventName,
+			               _objectId,
+			               task.Exception);
+		}
+	}
+}
@@ -0,0 +1,149 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Threading;
+using System.Threading.Tasks;
+using log4net;
+
+namespace SharpRemote.Tasks
+{
+	/// <summary>
+	///     Executes queued delegates on the <see cref="TaskScheduler.Default" /> with a limited degree of parallelism.
+	///     Delegates which can't be executed immediately are queued in one lane per <see cref="Priority" /> and
+	///     the lanes are served in a weighted fair manner: A flood of <see cref="Priority.Bulk" /> invocations
+	///     cannot delay <see cref="Priority.High" /> invocations for more than a single worker's turn.
+	/// </summary>
+	internal sealed class PriorityDispatcher
+	{
+		private static readonly ILog Log = LogManager.GetLogger(MethodBase.GetCurrentMethod().DeclaringType);
+
+		private readonly Queue<PendingTask>[] _lanes;
+		private readonly WeightedRoundRobin _roundRobin;
+		private readonly int _maximumConcurrencyLevel;
+		private readonly object _syncRoot;
+		private int _numWorkers;
+		private int _readyLanes;
+
+		public PriorityDispatcher(int maximumConcurrencyLevel)
+		{
+			if (maximumConcurrencyLevel <= 0)
+				throw new ArgumentOutOfRangeException(nameof(maximumConcurrencyLevel));
+
+			_maximumConcurrencyLevel = maximumConcurrencyLevel;
+			_syncRoot = new object();
+			_roundRobin = WeightedRoundRobin.ForPriorities();
+			_lanes = new Queue<PendingTask>[_roundRobin.Count];
+			for (int i = 0; i < _lanes.Length; ++i)
+				_lanes[i] = new Queue<PendingTask>();
+		}
+
+		/// <summary>
+		///     The number of delegates which have been queued, but not yet started.
+		/// </summary>
+		public int NumQueuedTasks
+		{
+			get
+			{
+				lock (_syncRoot)
+				{
+					int count = 0;
+					foreach (var lane in _lanes)
+						count += lane.Count;
+					return count;
+				}
+			}
+		}
+
+		/// <summary>
+		///     Enqueues the given delegate: It will be executed as soon as a worker
+		///     is available and no delegates of its priority's lane are due before it.
+		/// </summary>
+		/// <param name="fn"></param>
+		/// <param name="completionSource"></param>
+		/// <param name="priority"></param>
+		public void QueueTask(Action fn, TaskCompletionSource<int> completionSource, Priority priority)
+		{
+			var lane = (int) priority;
+			lock (_syncRoot)
+			{
+				_lanes[lane].Enqueue(new PendingTask(fn, completionSource));
+				_readyLanes |= 1 << lane;
+
+				if (_numWorkers >= _maximumConcurrencyLevel)
+					return;
+
+				++_numWorkers;
+			}
+
+			Task.Factory.StartNew(ExecuteTasks,
+			                      CancellationToken.None,
+			                      TaskCreationOptions.None,
+			                      TaskScheduler.Default);
+		}
+
+		private void ExecuteTasks()
+		{
+			PendingTask task;
+			while (TryDequeueNextTask(out task))
+			{
+				try
+				{
+					task.Execute();
+				}
+				catch (Exception e)
+				{
+					Log.ErrorFormat("Caught exception while executing task: {0}", e);
+				}
+			}
+		}
+
+		private bool TryDequeueNextTask(out PendingTask task)
+		{
+			lock (_syncRoot)
+			{
+				int lane = _roundRobin.Next(_readyLanes);
+				if (lane == -1)
+				{
+					--_numWorkers;
+					task = null;
+					return false;
+				}
+
+				var queue = _lanes[lane];
+				task = queue.Dequeue();
+				if (queue.Count == 0)
+					_readyLanes &= ~(1 << lane);
+
+				return true;
+			}
+		}
+
+		private sealed class PendingTask
+		{
+			private readonly TaskCompletionSource<int> _completionSource;
+			private readonly Action _task;
+
+			public PendingTask(Action task, TaskCompletionSource<int> completionSource)
+			{
+				if (task == null) throw new ArgumentNullException(nameof(task));
+				if (completionSource == null) throw new ArgumentNullException(nameof(completionSource));
+
+				_task = task;
+				_completionSource = completionSource;
+			}
+
+			public void Execute()
+			{
+				try
+				{
+					_task();
+					_completionSource.SetResult(0);
+				}
+				catch (Exception e)
+				{
+					_completionSource.SetException(e);
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+﻿namespace SharpRemote.Tasks
+{
+	/// <summary>
+	///     Decides which of several lanes shall be served next so that, over time, each lane is served
+	///     proportionally to its weight (smooth weighted round robin).
+	///     Lanes which are empty don't accumulate any credit and therefore can't starve other lanes later on.
+	/// </summary>
+	/// <remarks>
+	///     This class is NOT thread-safe.
+	/// </remarks>
+	internal sealed class WeightedRoundRobin
+	{
+		private readonly int[] _credits;
+		private readonly int[] _weights;
+
+		public WeightedRoundRobin(params int[] weights)
+		{
+			_weights = weights;
+			_credits = new int[weights.Length];
+		}
+
+		/// <summary>
+		///     Creates a new object which is used to choose between the lanes of each <see cref="Priority" />,
+		///     where lane i holds items of priority i.
+		/// </summary>
+		/// <returns></returns>
+		public static WeightedRoundRobin ForPriorities()
+		{
+			return new WeightedRoundRobin(
+				4, // Normal
+				16, // High
+				1 // Bulk
+			);
+		}
+
+		/// <summary>
+		///     The number of lanes.
+		/// </summary>
+		public int Count => _weights.Length;
+
+		/// <summary>
+		///     Chooses the next lane to be served.
+		/// </summary>
+		/// <param name="readyLanes">A bitmask where bit i is set when lane i has at least one item</param>
+		/// <returns>The index of the chosen lane or -1 if no lane is ready</returns>
+		public int Next(int readyLanes)
+		{
+			int chosen = -1;
+			int totalWeight = 0;
+			for (int i = 0; i < _weights.Length; ++i)
+			{
+				if ((readyLanes & (1 << i)) == 0)
+					continue;
+
+				_credits[i] += _weights[i];
+				totalWeight += _weights[i];
+				if (chosen == -1 || _credits[i] > _credits[chosen])
+					chosen = i;
+			}
+
+			if (chosen != -1)
+				_credits[chosen] -= totalWeight;
+
+			return chosen;
+		}
+	}
+}
\ No newline at end of file
@@ -460,7 +460,9 @@ namespace SharpRemote
 			{
 				isEnumerable = false;
 				singletonAccessor = null;
-				byReferenceInterface = type.GetInterfaces().FirstOrDefault(x => x.GetCustomAttribute<ByReferenceAttribute>() != null);
+				// [ByReference] may only be applied to interfaces and therefore this is the interface
+				// proxies are created for: GetInterfaces() wouldn't even include it.
+				byReferenceInterface = type;
 				return SerializationType.ByReference;
 			}
 